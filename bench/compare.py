@@ -0,0 +1,105 @@
+#!/usr/bin/python3
+
+"""
+  Compares two google-benchmark JSON outputs of size-sweep benchmarks ( see
+  `make sweep` ), say stored baseline & current run, flagging each benchmark
+  whose cycles/ byte ( cycles/ op, for empty messages ) grew beyond given
+  threshold.
+
+  When runs were repeated ( --benchmark_repetitions ), median aggregate is
+  compared, otherwise the only run of each benchmark. Exits with status 1,
+  when some benchmark regressed, so that it can gate CI jobs.
+
+  Usage: python3 bench/compare.py baseline.json current.json [--threshold 5]
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """
+    Reads benchmark JSON output, returning its context & mapping of run name
+    to compared metric ( cycles/ byte or cycles/ op )
+    """
+    with open(path) as fd:
+        doc = json.load(fd)
+
+    runs = {}
+    medians = {}
+    for bm in doc.get("benchmarks", []):
+        name = bm.get("run_name", bm["name"])
+        metric = bm.get("cycles/byte", bm.get("cycles/op"))
+        if metric is None:
+            continue
+
+        if bm.get("run_type") == "aggregate":
+            if bm.get("aggregate_name") == "median":
+                medians[name] = metric
+        else:
+            runs.setdefault(name, metric)
+
+    runs.update(medians)
+    return doc.get("context", {}), runs
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Flags size-sweep benchmark regressions against a baseline"
+    )
+    parser.add_argument("baseline", help="baseline benchmark JSON")
+    parser.add_argument("current", help="current benchmark JSON")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=5.0,
+        help="regression threshold, in percent ( default: 5 )",
+    )
+    args = parser.parse_args()
+
+    bctx, base = load(args.baseline)
+    cctx, curr = load(args.current)
+
+    bhz, chz = float(bctx.get("tsc_hz", 0)), float(cctx.get("tsc_hz", 0))
+    if bhz > 0 and chz > 0 and abs(bhz - chz) > 0.01 * bhz:
+        print(
+            f"warning: TSC frequency differs ( {bhz / 1e9:.3f} GHz vs. "
+            f"{chz / 1e9:.3f} GHz ), runs may be from different machines"
+        )
+
+    common = [name for name in curr if name in base]
+    width = max([len(name) for name in common] + [9])
+
+    print(f"{'benchmark':<{width}}  {'baseline':>12}  {'current':>12}  {'change':>8}")
+
+    regressed = 0
+    for name in common:
+        b, c = base[name], curr[name]
+        change = (c - b) / b * 100 if b > 0 else 0.0
+
+        mark = ""
+        if change > args.threshold:
+            mark = "  REGRESSION"
+            regressed += 1
+        elif change < -args.threshold:
+            mark = "  improved"
+
+        print(f"{name:<{width}}  {b:>12.2f}  {c:>12.2f}  {change:>+7.1f}%{mark}")
+
+    for name in base:
+        if name not in curr:
+            print(f"missing in current run: {name}")
+    for name in curr:
+        if name not in base:
+            print(f"missing in baseline: {name}")
+
+    print(
+        f"{len(common)} compared, {regressed} regressed beyond "
+        f"{args.threshold}% threshold"
+    )
+    return 1 if regressed > 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,65 @@
+#include "bench_latency.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include <cstring>
+#include <string>
+
+// Latency distribution benchmarks of Dumbo, Jumbo & Delirium, on small ( 16 -
+// 256 -bytes ) messages, with warm & cold caches, see `make latency`
+//
+// Besides google-benchmark flags, takes
+//
+// --latency_samples=<n> : # -of timed calls per benchmark ( default 10000 )
+// --latency_scrub=<bytes> : bytes touched between cold calls ( default 8 MiB )
+// --latency_hgrm=<dir> : writes full percentile distribution of every
+// benchmark into <dir>/<name>.hgrm, plottable with HdrHistogram tools
+int
+main(int argc, char** argv)
+{
+  int64_t samples = 10000;
+  auto& opts = bench_elephant::latency_opts();
+
+  auto value = [](const char* const arg, const char* const flag) {
+    const size_t len = std::strlen(flag);
+    return std::strncmp(arg, flag, len) == 0 ? arg + len : nullptr;
+  };
+
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (const char* v = value(argv[i], "--latency_samples=")) {
+      samples = std::stoll(v);
+    } else if (const char* v = value(argv[i], "--latency_scrub=")) {
+      opts.scrub_len = std::stoull(v);
+    } else if (const char* v = value(argv[i], "--latency_hgrm=")) {
+      opts.hgrm_dir = v;
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+
+  using namespace bench_elephant;
+
+  const std::vector<int64_t> dlens{ 16 };
+  const std::vector<int64_t> ctlens{ 16, 32, 64, 128, 256 };
+
+  register_latency<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>(
+    "dumbo", dlens, ctlens, samples);
+  register_latency<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>(
+    "jumbo", dlens, ctlens, samples);
+  register_latency<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>(
+    "delirium", dlens, ctlens, samples);
+
+  benchmark::AddCustomContext("tsc_hz", std::to_string(tsc_hz()));
+  benchmark::AddCustomContext("latency_unit", "ns");
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -10,6 +10,21 @@ BENCHMARK(bench_elephant::spongent_permutation<176, 90>);
 BENCHMARK(bench_elephant::keccak_permutation<1>);
 BENCHMARK(bench_elephant::keccak_permutation<18>);
 
+// register bulk ( multi-state ) permutations for benchmarking
+BENCHMARK(bench_elephant::permutation_bulk<160, 80>)
+  ->Args({ 1 << 16, 1 })
+  ->Args({ 1 << 16, 4 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::permutation_bulk<176, 90>)
+  ->Args({ 1 << 16, 1 })
+  ->Args({ 1 << 16, 4 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::permutation_bulk<200, 18>)
+  ->Args({ 1 << 16, 1 })
+  ->Args({ 1 << 16, 4 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::permutation_bulk<200, 4>)->Args({ 1 << 16, 1 });
+
 // register Dumbo AEAD for benchmarking
 BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 32, 64 });
 BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 32, 64 });
@@ -26,6 +41,77 @@ BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 32, 2048 });
 BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 32, 4096 });
 BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 32, 4096 });
 
+// register Dumbo AEAD on small messages, with runtime & compile-time lengths
+BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::dumbo_encrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::dumbo_decrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::dumbo_encrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::dumbo_decrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::dumbo_encrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::dumbo_decrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::dumbo_encrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::dumbo_encrypt_fixed<16, 128>);
+BENCHMARK(bench_elephant::dumbo_decrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::dumbo_decrypt_fixed<16, 128>);
+
+// register Dumbo authentication-only mode, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::dumbo_mac)->Args({ 4096, 1 })->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_mac)->Args({ 4096, 2 })->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_mac)->Args({ 4096, 4 })->UseRealTime();
+
+// register awaitable Dumbo encryption, completing inline & on worker pool
+BENCHMARK(bench_elephant::dumbo_async_encrypt)->Args({ 4096, 1 });
+BENCHMARK(bench_elephant::dumbo_async_encrypt)
+  ->Args({ 1 << 18, 1 })
+  ->Args({ 1 << 18, 4 })
+  ->UseRealTime();
+
+// register Dumbo micro-batching scheduler, with 20 µs & 200 µs deadlines
+BENCHMARK(bench_elephant::dumbo_batch_encrypt)
+  ->Args({ 64, 4, 20 })
+  ->Args({ 64, 4, 200 })
+  ->UseRealTime();
+
+// register Dumbo batch job over skewed record sizes, static partitioning vs.
+// work-stealing, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::dumbo_steal_batch)
+  ->ArgsProduct({ { 1, 2, 4 }, { 0, 1 } })
+  ->UseRealTime();
+
+// register Dumbo sector encryption, serial baseline vs. multi-state lanes
+BENCHMARK(bench_elephant::dumbo_encrypt_sectors_serial)->Args({ 512, 32 });
+BENCHMARK(bench_elephant::dumbo_encrypt_sectors)->Args({ 512, 32, 1 });
+BENCHMARK(bench_elephant::dumbo_encrypt_sectors_serial)->Args({ 4096, 32 });
+BENCHMARK(bench_elephant::dumbo_encrypt_sectors)->Args({ 4096, 32, 1 });
+BENCHMARK(bench_elephant::dumbo_encrypt_sectors)
+  ->Args({ 4096, 128, 4 })
+  ->UseRealTime();
+
+// register Dumbo file {en, de}cryption pipeline, with blocking I/O & io_uring
+BENCHMARK(bench_elephant::dumbo_pipeline_encrypt)
+  ->Args({ 64, 4, 16, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_pipeline_encrypt)
+  ->Args({ 64, 4, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_pipeline_encrypt)
+  ->Args({ 64, 16, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_pipeline_decrypt)
+  ->Args({ 64, 4, 16, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_pipeline_decrypt)
+  ->Args({ 64, 4, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::dumbo_pipeline_decrypt)
+  ->Args({ 64, 16, 16, 1 })
+  ->UseRealTime();
+
 // register Jumbo AEAD for benchmarking
 BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 32, 64 });
 BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 32, 64 });
@@ -42,6 +128,77 @@ BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 32, 2048 });
 BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 32, 4096 });
 BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 32, 4096 });
 
+// register Jumbo AEAD on small messages, with runtime & compile-time lengths
+BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::jumbo_encrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::jumbo_decrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::jumbo_encrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::jumbo_decrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::jumbo_encrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::jumbo_decrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::jumbo_encrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::jumbo_encrypt_fixed<16, 128>);
+BENCHMARK(bench_elephant::jumbo_decrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::jumbo_decrypt_fixed<16, 128>);
+
+// register Jumbo authentication-only mode, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::jumbo_mac)->Args({ 4096, 1 })->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_mac)->Args({ 4096, 2 })->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_mac)->Args({ 4096, 4 })->UseRealTime();
+
+// register awaitable Jumbo encryption, completing inline & on worker pool
+BENCHMARK(bench_elephant::jumbo_async_encrypt)->Args({ 4096, 1 });
+BENCHMARK(bench_elephant::jumbo_async_encrypt)
+  ->Args({ 1 << 18, 1 })
+  ->Args({ 1 << 18, 4 })
+  ->UseRealTime();
+
+// register Jumbo micro-batching scheduler, with 20 µs & 200 µs deadlines
+BENCHMARK(bench_elephant::jumbo_batch_encrypt)
+  ->Args({ 64, 4, 20 })
+  ->Args({ 64, 4, 200 })
+  ->UseRealTime();
+
+// register Jumbo batch job over skewed record sizes, static partitioning vs.
+// work-stealing, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::jumbo_steal_batch)
+  ->ArgsProduct({ { 1, 2, 4 }, { 0, 1 } })
+  ->UseRealTime();
+
+// register Jumbo sector encryption, serial baseline vs. multi-state lanes
+BENCHMARK(bench_elephant::jumbo_encrypt_sectors_serial)->Args({ 512, 32 });
+BENCHMARK(bench_elephant::jumbo_encrypt_sectors)->Args({ 512, 32, 1 });
+BENCHMARK(bench_elephant::jumbo_encrypt_sectors_serial)->Args({ 4096, 32 });
+BENCHMARK(bench_elephant::jumbo_encrypt_sectors)->Args({ 4096, 32, 1 });
+BENCHMARK(bench_elephant::jumbo_encrypt_sectors)
+  ->Args({ 4096, 128, 4 })
+  ->UseRealTime();
+
+// register Jumbo file {en, de}cryption pipeline, with blocking I/O & io_uring
+BENCHMARK(bench_elephant::jumbo_pipeline_encrypt)
+  ->Args({ 64, 4, 16, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_pipeline_encrypt)
+  ->Args({ 64, 4, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_pipeline_encrypt)
+  ->Args({ 64, 16, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_pipeline_decrypt)
+  ->Args({ 64, 4, 16, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_pipeline_decrypt)
+  ->Args({ 64, 4, 16, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::jumbo_pipeline_decrypt)
+  ->Args({ 64, 16, 16, 1 })
+  ->UseRealTime();
+
 // register Delirium AEAD for benchmarking
 BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 32, 64 });
 BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 32, 64 });
@@ -58,5 +215,91 @@ BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 32, 2048 });
 BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 32, 4096 });
 BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 32, 4096 });
 
+// register Delirium AEAD on small messages, with runtime & compile-time lengths
+BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::delirium_encrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 8, 16 });
+BENCHMARK(bench_elephant::delirium_decrypt_fixed<8, 16>);
+BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::delirium_encrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 8, 32 });
+BENCHMARK(bench_elephant::delirium_decrypt_fixed<8, 32>);
+BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::delirium_encrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 16, 64 });
+BENCHMARK(bench_elephant::delirium_decrypt_fixed<16, 64>);
+BENCHMARK(bench_elephant::delirium_encrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::delirium_encrypt_fixed<16, 128>);
+BENCHMARK(bench_elephant::delirium_decrypt)->Args({ 16, 128 });
+BENCHMARK(bench_elephant::delirium_decrypt_fixed<16, 128>);
+
+// register Delirium authentication-only mode, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::delirium_mac)->Args({ 4096, 1 })->UseRealTime();
+BENCHMARK(bench_elephant::delirium_mac)->Args({ 4096, 2 })->UseRealTime();
+BENCHMARK(bench_elephant::delirium_mac)->Args({ 4096, 4 })->UseRealTime();
+
+// register awaitable Delirium encryption, completing inline & on worker pool
+BENCHMARK(bench_elephant::delirium_async_encrypt)->Args({ 4096, 1 });
+BENCHMARK(bench_elephant::delirium_async_encrypt)
+  ->Args({ 1 << 18, 1 })
+  ->Args({ 1 << 18, 4 })
+  ->UseRealTime();
+
+// register Delirium micro-batching scheduler, with 20 µs & 200 µs deadlines
+BENCHMARK(bench_elephant::delirium_batch_encrypt)
+  ->Args({ 64, 4, 20 })
+  ->Args({ 64, 4, 200 })
+  ->UseRealTime();
+
+// register Delirium batch job over skewed record sizes, static partitioning vs.
+// work-stealing, with 1, 2 & 4 threads
+BENCHMARK(bench_elephant::delirium_steal_batch)
+  ->ArgsProduct({ { 1, 2, 4 }, { 0, 1 } })
+  ->UseRealTime();
+
+// register Delirium sector encryption, serial baseline vs. multi-state lanes
+BENCHMARK(bench_elephant::delirium_encrypt_sectors_serial)->Args({ 512, 32 });
+BENCHMARK(bench_elephant::delirium_encrypt_sectors)->Args({ 512, 32, 1 });
+BENCHMARK(bench_elephant::delirium_encrypt_sectors_serial)->Args({ 4096, 32 });
+BENCHMARK(bench_elephant::delirium_encrypt_sectors)->Args({ 4096, 32, 1 });
+BENCHMARK(bench_elephant::delirium_encrypt_sectors)
+  ->Args({ 4096, 128, 4 })
+  ->UseRealTime();
+
+// register Delirium file {en, de}cryption pipeline, over blocking I/O & uring
+BENCHMARK(bench_elephant::delirium_pipeline_encrypt)
+  ->Args({ 4096, 4, 64, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::delirium_pipeline_encrypt)
+  ->Args({ 4096, 4, 64, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::delirium_pipeline_encrypt)
+  ->Args({ 4096, 16, 64, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::delirium_pipeline_decrypt)
+  ->Args({ 4096, 4, 64, 0 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::delirium_pipeline_decrypt)
+  ->Args({ 4096, 4, 64, 1 })
+  ->UseRealTime();
+BENCHMARK(bench_elephant::delirium_pipeline_decrypt)
+  ->Args({ 4096, 16, 64, 1 })
+  ->UseRealTime();
+
+// register nonce generation, from 1 to 64 threads sharing one generator
+BENCHMARK(bench_elephant::nonce_mutex)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK(bench_elephant::nonce_lease)
+  ->Arg(1)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+BENCHMARK(bench_elephant::nonce_lease)
+  ->Arg(1024)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+BENCHMARK(bench_elephant::nonce_tls)
+  ->Arg(1024)
+  ->ThreadRange(1, 64)
+  ->UseRealTime();
+
 // benchmark runner main function
 BENCHMARK_MAIN();
@@ -0,0 +1,64 @@
+#include "bench_scaling.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include <cstring>
+#include <string>
+#include <thread>
+
+// Multithreaded throughput scaling benchmarks of Dumbo, Jumbo & Delirium, see
+// `make scaling`
+//
+// Besides google-benchmark flags, takes
+//
+// --scaling_threads=<n> : most threads to run on ( default all hardware
+// threads )
+// --scaling_large=<bytes> : length of large messages ( default 1 MiB ), which
+// should make threads' working sets exceed last level cache, for them to
+// contend on memory bandwidth
+int
+main(int argc, char** argv)
+{
+  int max_threads = static_cast<int>(std::thread::hardware_concurrency());
+  int64_t large_len = int64_t{ 1 } << 20;
+
+  auto value = [](const char* const arg, const char* const flag) {
+    const size_t len = std::strlen(flag);
+    return std::strncmp(arg, flag, len) == 0 ? arg + len : nullptr;
+  };
+
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (const char* v = value(argv[i], "--scaling_threads=")) {
+      max_threads = std::stoi(v);
+    } else if (const char* v = value(argv[i], "--scaling_large=")) {
+      large_len = std::stoll(v);
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+
+  using namespace bench_elephant;
+
+  register_scaling<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>(
+    "dumbo", max_threads, large_len);
+  register_scaling<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>(
+    "jumbo", max_threads, large_len);
+  register_scaling<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>(
+    "delirium", max_threads, large_len);
+
+  const unsigned hw = std::thread::hardware_concurrency();
+
+  benchmark::AddCustomContext("hardware_threads", std::to_string(hw));
+  benchmark::AddCustomContext("scaling_large", std::to_string(large_len));
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,73 @@
+#include "bench_stages.hpp"
+
+// Per-stage microbenchmarks of Elephant AEAD internals, see `make stages`
+
+// register Spongent-π[W] round steps for benchmarking
+BENCHMARK(bench_elephant::spongent_apply_rc<160>);
+BENCHMARK(bench_elephant::spongent_apply_sbox<160>);
+BENCHMARK(bench_elephant::spongent_apply_permutation<160>);
+BENCHMARK(bench_elephant::spongent_round<160>);
+BENCHMARK(bench_elephant::spongent_apply_rc<176>);
+BENCHMARK(bench_elephant::spongent_apply_sbox<176>);
+BENCHMARK(bench_elephant::spongent_apply_permutation<176>);
+BENCHMARK(bench_elephant::spongent_round<176>);
+
+// register Keccak-f[200] step mappings for benchmarking
+BENCHMARK(bench_elephant::keccak_theta);
+BENCHMARK(bench_elephant::keccak_rho);
+BENCHMARK(bench_elephant::keccak_pi);
+BENCHMARK(bench_elephant::keccak_chi);
+BENCHMARK(bench_elephant::keccak_iota);
+BENCHMARK(bench_elephant::keccak_round);
+
+// register mask generation for benchmarking
+BENCHMARK(bench_elephant::elephant_lfsr<160>);
+BENCHMARK(bench_elephant::elephant_lfsr<176>);
+BENCHMARK(bench_elephant::elephant_lfsr<200>);
+BENCHMARK(bench_elephant::elephant_next_mask<160, 0>);
+BENCHMARK(bench_elephant::elephant_next_mask<160, 1>);
+BENCHMARK(bench_elephant::elephant_next_mask<160, 2>);
+BENCHMARK(bench_elephant::elephant_next_mask<176, 0>);
+BENCHMARK(bench_elephant::elephant_next_mask<176, 1>);
+BENCHMARK(bench_elephant::elephant_next_mask<176, 2>);
+BENCHMARK(bench_elephant::elephant_next_mask<200, 0>);
+BENCHMARK(bench_elephant::elephant_next_mask<200, 1>);
+BENCHMARK(bench_elephant::elephant_next_mask<200, 2>);
+
+// register padded block extraction ( first & some later block ) for
+// benchmarking
+BENCHMARK(bench_elephant::elephant_get_ith_data_block<160>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 1 });
+BENCHMARK(bench_elephant::elephant_get_ith_data_block<176>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 1 });
+BENCHMARK(bench_elephant::elephant_get_ith_data_block<200>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 1 });
+BENCHMARK(bench_elephant::elephant_get_ith_cipher_block<160>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 3 });
+BENCHMARK(bench_elephant::elephant_get_ith_cipher_block<176>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 2 });
+BENCHMARK(bench_elephant::elephant_get_ith_cipher_block<200>)
+  ->Args({ 64, 0 })
+  ->Args({ 64, 2 });
+
+// register breakdown of Dumbo, Jumbo & Delirium encryption for benchmarking
+BENCHMARK(bench_elephant::aead_breakdown<160, 80, 64>)
+  ->Args({ 16, 64 })
+  ->Args({ 16, 1024 })
+  ->Args({ 16, 16384 });
+BENCHMARK(bench_elephant::aead_breakdown<176, 90, 64>)
+  ->Args({ 16, 64 })
+  ->Args({ 16, 1024 })
+  ->Args({ 16, 16384 });
+BENCHMARK(bench_elephant::aead_breakdown<200, 18, 128>)
+  ->Args({ 16, 64 })
+  ->Args({ 16, 1024 })
+  ->Args({ 16, 16384 });
+
+// benchmark runner main function
+BENCHMARK_MAIN();
@@ -0,0 +1,47 @@
+#include "bench_sweep.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include <cstring>
+#include <string>
+
+// Size-sweep benchmarks of Dumbo, Jumbo & Delirium, see `make sweep`
+//
+// Besides google-benchmark flags, takes `--sweep_max=<bytes>`, capping
+// associated data & text lengths ( default 16 MiB ), as Dumbo & Jumbo take
+// minutes to get through largest ones.
+int
+main(int argc, char** argv)
+{
+  constexpr const char* flag = "--sweep_max=";
+  int64_t max_len = int64_t{ 1 } << 24;
+
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (std::strncmp(argv[i], flag, std::strlen(flag)) == 0) {
+      max_len = std::stoll(argv[i] + std::strlen(flag));
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+
+  using namespace bench_elephant;
+
+  register_sweeps<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>("dumbo", max_len);
+  register_sweeps<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>("jumbo", max_len);
+  register_sweeps<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>(
+    "delirium", max_len);
+
+  benchmark::AddCustomContext("tsc_hz", std::to_string(tsc_hz()));
+  benchmark::AddCustomContext("sweep_max", std::to_string(max_len));
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
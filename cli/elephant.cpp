@@ -0,0 +1,635 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <string>
+#include <sys/mman.h>
+#include <sys/random.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define ELEPHANT_HAS_TSC
+#endif
+
+// Command-line tool, which {en, de}crypts files ( or directories of files )
+// using Dumbo/ Jumbo/ Delirium AEAD, in segmented stream format
+//
+// Build with
+//
+// make elephant
+//
+// Usage
+//
+// elephant enc|dec|enc-dir|dec-dir -v dumbo|jumbo|delirium
+//          (-k <32 hex chars> | -K <key file>)
+//          [-t threads] [-s segment bytes] [--no-nt] <input> <output>
+namespace fs = std::filesystem;
+
+// Outputs larger than this are written using non-temporal stores, because they
+// won't be read back soon & would only evict useful cache lines
+constexpr size_t NT_THRESHOLD = 1ul << 22;
+
+// Suffix of encrypted files, produced in directory mode
+constexpr const char* SUFFIX = ".elph";
+
+struct options_t
+{
+  std::string mode;
+  std::string variant = "dumbo";
+  std::string input;
+  std::string output;
+  uint8_t key[16]{};
+  bool has_key = false;
+  size_t nthreads = std::max(std::thread::hardware_concurrency(), 1u);
+  uint32_t seg_len = 1u << 20;
+  bool nt = true;
+};
+
+struct stats_t
+{
+  std::atomic<uint64_t> bytes{ 0 };
+  std::atomic<uint64_t> files{ 0 };
+  std::atomic<uint64_t> failed{ 0 };
+  std::atomic<uint64_t> cycles{ 0 }; // spent {en, de}crypting, over all threads
+};
+
+// Read-only/ read-write memory mapping of a file, unmapped on destruction
+struct mapping_t
+{
+  uint8_t* ptr = nullptr;
+  size_t len = 0;
+  int fd = -1;
+
+  mapping_t() = default;
+  mapping_t(const mapping_t&) = delete;
+  mapping_t& operator=(const mapping_t&) = delete;
+
+  ~mapping_t()
+  {
+    if (ptr != nullptr) {
+      munmap(ptr, len);
+    }
+    if (fd >= 0) {
+      close(fd);
+    }
+  }
+};
+
+// Asks kernel to back large mappings with huge pages, where supported
+static void
+advise_huge(uint8_t* const ptr, const size_t len)
+{
+#if defined(MADV_HUGEPAGE)
+  if (len >= (1ul << 21)) {
+    madvise(ptr, len, MADV_HUGEPAGE);
+  }
+#else
+  (void)ptr;
+  (void)len;
+#endif
+}
+
+// Maps whole input file read-only; empty files are left unmapped
+static bool
+map_input(const std::string& path, mapping_t& m)
+{
+  m.fd = open(path.c_str(), O_RDONLY);
+  if (m.fd < 0) {
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(m.fd, &st) != 0) {
+    return false;
+  }
+
+  m.len = static_cast<size_t>(st.st_size);
+  if (m.len == 0) {
+    return true;
+  }
+
+  void* p = mmap(nullptr, m.len, PROT_READ, MAP_SHARED, m.fd, 0);
+  if (p == MAP_FAILED) {
+    return false;
+  }
+
+  m.ptr = static_cast<uint8_t*>(p);
+  madvise(m.ptr, m.len, MADV_SEQUENTIAL);
+  advise_huge(m.ptr, m.len);
+
+  return true;
+}
+
+// Creates ( or truncates ) output file of given length & maps it read-write;
+// empty files are left unmapped
+static bool
+map_output(const std::string& path, const size_t len, mapping_t& m)
+{
+  m.fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (m.fd < 0) {
+    return false;
+  }
+  if (ftruncate(m.fd, static_cast<off_t>(len)) != 0) {
+    return false;
+  }
+
+  m.len = len;
+  if (m.len == 0) {
+    return true;
+  }
+
+  void* p = mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED, m.fd, 0);
+  if (p == MAP_FAILED) {
+    return false;
+  }
+
+  m.ptr = static_cast<uint8_t*>(p);
+  advise_huge(m.ptr, m.len);
+
+  return true;
+}
+
+// Copies `len` -bytes to output mapping, bypassing cache ( when requested &
+// supported ), so that streaming output doesn't pollute cache
+static void
+copy_out(uint8_t* const __restrict dst,
+         const uint8_t* const __restrict src,
+         const size_t len,
+         const bool nt)
+{
+#if defined(__SSE2__)
+  if (nt) {
+    size_t off = 0;
+
+    const size_t head = (16 - (reinterpret_cast<uintptr_t>(dst) & 15)) & 15;
+    const size_t hlen = std::min(head, len);
+
+    std::memcpy(dst, src, hlen);
+    off += hlen;
+
+    for (; off + 16 <= len; off += 16) {
+      const __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + off));
+      _mm_stream_si128(reinterpret_cast<__m128i*>(dst + off), v);
+    }
+
+    std::memcpy(dst + off, src + off, len - off);
+    return;
+  }
+#endif
+
+  (void)nt;
+  std::memcpy(dst, src, len);
+}
+
+// Makes non-temporal stores, issued by this thread, globally visible
+static void
+fence_out()
+{
+#if defined(__SSE2__)
+  _mm_sfence();
+#endif
+}
+
+static uint64_t
+read_tsc()
+{
+#if defined(ELEPHANT_HAS_TSC)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
+
+// Splits `cnt` -many segments into `nthreads` contiguous ranges & runs `f(beg,
+// end)` on each of them, in parallel
+template<typename F>
+static void
+parallel_segments(const uint64_t cnt, const size_t nthreads, F&& f)
+{
+  const size_t nparts =
+    std::max<uint64_t>(1, std::min<uint64_t>(nthreads, cnt));
+
+  std::vector<std::thread> workers;
+  workers.reserve(nparts - 1);
+
+  for (size_t t = 0; t < nparts; t++) {
+    const uint64_t beg = cnt * t / nparts;
+    const uint64_t end = cnt * (t + 1) / nparts;
+
+    if (t + 1 < nparts) {
+      workers.emplace_back([&f, beg, end]() { f(beg, end); });
+    } else {
+      f(beg, end);
+    }
+  }
+
+  for (auto& w : workers) {
+    w.join();
+  }
+}
+
+// Encrypts input file into output file, in segmented stream format, sealing
+// segments on `nthreads` -many threads, straight from input mapping
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+encrypt_file(const elephant::key_ctx_t<slen, rounds>& ctx,
+             const options_t& opt,
+             const std::string& in_path,
+             const std::string& out_path,
+             const size_t nthreads,
+             stats_t& st)
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  mapping_t in;
+  if (!map_input(in_path, in)) {
+    std::fprintf(stderr, "failed to read %s\n", in_path.c_str());
+    return false;
+  }
+
+  elephant::segment_header_t h;
+  h.sbytes = slen >> 3;
+  h.tbytes = tbytes;
+  h.seg_len = opt.seg_len;
+
+  if (getrandom(h.nonce, sizeof(h.nonce), 0) != sizeof(h.nonce)) {
+    std::fprintf(stderr, "failed to generate nonce\n");
+    return false;
+  }
+
+  uint8_t hdr[elephant::SEGMENT_HEADER_LEN];
+  h.encode(hdr);
+
+  const uint64_t seg_cnt =
+    std::max<uint64_t>(1, (in.len + opt.seg_len - 1) / opt.seg_len);
+  const size_t out_len = sizeof(hdr) + in.len + seg_cnt * tbytes;
+  const bool nt = opt.nt && (out_len >= NT_THRESHOLD);
+
+  mapping_t out;
+  if (!map_output(out_path, out_len, out)) {
+    std::fprintf(stderr, "failed to create %s\n", out_path.c_str());
+    return false;
+  }
+
+  std::memcpy(out.ptr, hdr, sizeof(hdr));
+
+  parallel_segments(seg_cnt, nthreads, [&](uint64_t beg, uint64_t end) {
+    std::vector<uint8_t> buf(nt ? opt.seg_len + tbytes : 0);
+    uint64_t cycles = 0;
+
+    for (uint64_t i = beg; i < end; i++) {
+      const size_t off = i * opt.seg_len;
+      const size_t len = std::min<size_t>(opt.seg_len, in.len - off);
+      const bool final = (i + 1) == seg_cnt;
+
+      uint8_t* const dst =
+        out.ptr + elephant::segment_offset<tlen>(opt.seg_len, i);
+      uint8_t* const seg = nt ? buf.data() : dst;
+
+      const uint64_t c0 = read_tsc();
+      elephant::seal_segment<slen, rounds, tlen>(
+        ctx, hdr, i, final, in.ptr + off, len, seg);
+      cycles += read_tsc() - c0;
+
+      if (nt) {
+        copy_out(dst, seg, len + tbytes, true);
+      }
+    }
+
+    if (nt) {
+      fence_out();
+    }
+
+    st.cycles += cycles;
+  });
+
+  st.bytes += in.len;
+  return true;
+}
+
+// Verifies & decrypts segmented stream in input file, into output file,
+// opening segments on `nthreads` -many threads, straight from input mapping;
+// output file is removed, if any segment fails verification
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decrypt_file(const elephant::key_ctx_t<slen, rounds>& ctx,
+             const options_t& opt,
+             const std::string& in_path,
+             const std::string& out_path,
+             const size_t nthreads,
+             stats_t& st)
+{
+  mapping_t in;
+  if (!map_input(in_path, in)) {
+    std::fprintf(stderr, "failed to read %s\n", in_path.c_str());
+    return false;
+  }
+
+  auto src = [&in](uint64_t off, uint8_t* buf, size_t len) -> size_t {
+    if (off >= in.len) {
+      return 0;
+    }
+
+    const size_t n = std::min<uint64_t>(len, in.len - off);
+    std::memcpy(buf, in.ptr + off, n);
+    return n;
+  };
+
+  elephant::segment_reader_t<slen, rounds, tlen> rd(ctx, src, in.len);
+  if (!rd.valid()) {
+    std::fprintf(stderr, "%s is not a valid stream\n", in_path.c_str());
+    return false;
+  }
+
+  const uint32_t seg_len = rd.segment_len();
+  const uint64_t seg_cnt = rd.segment_count();
+  const size_t out_len = rd.plain_len();
+  const bool nt = opt.nt && (out_len >= NT_THRESHOLD);
+
+  mapping_t out;
+  if (!map_output(out_path, out_len, out)) {
+    std::fprintf(stderr, "failed to create %s\n", out_path.c_str());
+    return false;
+  }
+
+  std::atomic<bool> ok{ true };
+
+  parallel_segments(seg_cnt, nthreads, [&](uint64_t beg, uint64_t end) {
+    std::vector<uint8_t> buf(nt ? seg_len : 0);
+    uint64_t cycles = 0;
+
+    for (uint64_t i = beg; (i < end) && ok.load(std::memory_order_relaxed);
+         i++) {
+      const size_t len = rd.segment_plain_len(i);
+      const bool final = (i + 1) == seg_cnt;
+
+      const uint8_t* const seg =
+        in.ptr + elephant::segment_offset<tlen>(seg_len, i);
+      uint8_t* const dst = out.ptr + i * seg_len;
+      uint8_t* const txt = nt ? buf.data() : dst;
+
+      const uint64_t c0 = read_tsc();
+      const bool flg = elephant::open_segment<slen, rounds, tlen>(
+        ctx, in.ptr, i, final, seg, len, txt);
+      cycles += read_tsc() - c0;
+
+      if (!flg) {
+        ok = false;
+        break;
+      }
+
+      if (nt) {
+        copy_out(dst, txt, len, true);
+      }
+    }
+
+    if (nt) {
+      fence_out();
+    }
+
+    elephant::secure_zero(buf.data(), buf.size());
+    st.cycles += cycles;
+  });
+
+  if (!ok) {
+    std::fprintf(stderr, "%s failed authentication\n", in_path.c_str());
+    unlink(out_path.c_str());
+    return false;
+  }
+
+  st.bytes += out_len;
+  return true;
+}
+
+// {En, De}crypts every regular file under input directory ( recursively ),
+// into same relative path under output directory, using a work queue of files,
+// drained by `opt.nthreads` -many workers, each handling one file at a time
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+process_dir(const elephant::key_ctx_t<slen, rounds>& ctx,
+            const options_t& opt,
+            const bool enc,
+            stats_t& st)
+{
+  const fs::path in_root(opt.input);
+  const fs::path out_root(opt.output);
+
+  std::vector<fs::path> files;
+  for (const auto& e : fs::recursive_directory_iterator(in_root)) {
+    if (e.is_regular_file()) {
+      files.emplace_back(e.path());
+    }
+  }
+
+  elephant::thread_pool_t pool(opt.nthreads);
+  std::vector<std::future<void>> futs;
+  futs.reserve(files.size());
+
+  for (const auto& f : files) {
+    futs.emplace_back(pool.submit([&, f]() {
+      fs::path dst = out_root / fs::relative(f, in_root);
+
+      if (enc) {
+        dst += SUFFIX;
+      } else if (dst.extension() == SUFFIX) {
+        dst.replace_extension();
+      }
+
+      std::error_code ec;
+      fs::create_directories(dst.parent_path(), ec);
+
+      const bool flg =
+        enc ? encrypt_file<slen, rounds, tlen>(ctx, opt, f, dst, 1, st)
+            : decrypt_file<slen, rounds, tlen>(ctx, opt, f, dst, 1, st);
+
+      st.files++;
+      st.failed += !flg;
+    }));
+  }
+
+  for (auto& f : futs) {
+    f.wait();
+  }
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static int
+run(const options_t& opt)
+{
+  elephant::key_ctx_t<slen, rounds> ctx{ opt.key };
+  stats_t st;
+
+  const auto t0 = std::chrono::steady_clock::now();
+
+  if (opt.mode == "enc") {
+    st.failed += !encrypt_file<slen, rounds, tlen>(
+      ctx, opt, opt.input, opt.output, opt.nthreads, st);
+    st.files++;
+  } else if (opt.mode == "dec") {
+    st.failed += !decrypt_file<slen, rounds, tlen>(
+      ctx, opt, opt.input, opt.output, opt.nthreads, st);
+    st.files++;
+  } else {
+    process_dir<slen, rounds, tlen>(ctx, opt, opt.mode == "enc-dir", st);
+  }
+
+  const auto t1 = std::chrono::steady_clock::now();
+
+  const double secs = std::chrono::duration<double>(t1 - t0).count();
+  const double bytes = static_cast<double>(st.bytes.load());
+  const double mbps = bytes / (1024.0 * 1024.0) / std::max(secs, 1e-9);
+
+  // throughput is end-to-end ( including mapping, page faults & writeback ),
+  // while cycles/byte counts only {en, de}cryption, summed over threads
+  std::printf("%s: %lu file(s), %lu failed, %.0f bytes in %.3f s, "
+              "%.2f MB/s end-to-end",
+              opt.variant.c_str(),
+              st.files.load(),
+              st.failed.load(),
+              bytes,
+              secs,
+              mbps);
+
+#if defined(ELEPHANT_HAS_TSC)
+  if (bytes > 0) {
+    const double cycles = static_cast<double>(st.cycles.load());
+    std::printf(", %.2f cycles/byte crypto", cycles / bytes);
+  }
+#endif
+  std::printf("\n");
+
+  return st.failed.load() == 0 ? 0 : 1;
+}
+
+static void
+usage(const char* prog)
+{
+  std::fprintf(stderr,
+               "usage: %s enc|dec|enc-dir|dec-dir -v dumbo|jumbo|delirium\n"
+               "       (-k <32 hex chars> | -K <key file>)\n"
+               "       [-t threads] [-s segment bytes] [--no-nt] "
+               "<input> <output>\n",
+               prog);
+}
+
+static bool
+parse_hex_key(const char* hex, uint8_t* const key)
+{
+  if (std::strlen(hex) != 32) {
+    return false;
+  }
+
+  for (size_t i = 0; i < 16; i++) {
+    unsigned v = 0;
+    if (std::sscanf(hex + 2 * i, "%2x", &v) != 1) {
+      return false;
+    }
+    key[i] = static_cast<uint8_t>(v);
+  }
+
+  return true;
+}
+
+// Parses whole of `str` as unsigned decimal count, returning false, if it's
+// not a number or doesn't fit
+static bool
+parse_count(const char* str, size_t& out)
+{
+  const char* const end = str + std::strlen(str);
+  const auto [ptr, ec] = std::from_chars(str, end, out);
+
+  return (ec == std::errc{}) && (ptr == end) && (ptr != str);
+}
+
+static bool
+read_key_file(const char* path, uint8_t* const key)
+{
+  FILE* f = std::fopen(path, "rb");
+  if (f == nullptr) {
+    return false;
+  }
+
+  const size_t n = std::fread(key, 1, 16, f);
+  std::fclose(f);
+
+  return n == 16;
+}
+
+int
+main(int argc, char** argv)
+{
+  options_t opt;
+  std::vector<std::string> pos;
+
+  for (int i = 1; i < argc; i++) {
+    const std::string a = argv[i];
+    const bool has_val = (i + 1) < argc;
+
+    if (a == "-v" && has_val) {
+      opt.variant = argv[++i];
+    } else if (a == "-k" && has_val) {
+      opt.has_key = parse_hex_key(argv[++i], opt.key);
+    } else if (a == "-K" && has_val) {
+      opt.has_key = read_key_file(argv[++i], opt.key);
+    } else if (a == "-t" && has_val) {
+      size_t v = 0;
+      if (!parse_count(argv[++i], v)) {
+        usage(argv[0]);
+        return 2;
+      }
+      opt.nthreads = std::max(v, 1ul);
+    } else if (a == "-s" && has_val) {
+      size_t v = 0;
+      if (!parse_count(argv[++i], v)) {
+        usage(argv[0]);
+        return 2;
+      }
+      opt.seg_len = static_cast<uint32_t>(
+        std::clamp<size_t>(v, 1, elephant::SEGMENT_MAX_LEN));
+    } else if (a == "--no-nt") {
+      opt.nt = false;
+    } else {
+      pos.emplace_back(a);
+    }
+  }
+
+  if (pos.size() != 3 || !opt.has_key) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  opt.mode = pos[0];
+  opt.input = pos[1];
+  opt.output = pos[2];
+
+  if (opt.mode != "enc" && opt.mode != "dec" && opt.mode != "enc-dir" &&
+      opt.mode != "dec-dir") {
+    usage(argv[0]);
+    return 2;
+  }
+
+  int ret = 2;
+
+  if (opt.variant == "dumbo") {
+    ret = run<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>(opt);
+  } else if (opt.variant == "jumbo") {
+    ret = run<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>(opt);
+  } else if (opt.variant == "delirium") {
+    ret = run<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>(opt);
+  } else {
+    usage(argv[0]);
+  }
+
+  elephant::secure_zero(opt.key, sizeof(opt.key));
+  return ret;
+}
@@ -0,0 +1,126 @@
+#pragma once
+#include "context.hpp"
+
+// Cached associated data digest for Elephant Authenticated Encryption with
+// Associated Data, when same ( static ) associated data is authenticated along
+// with many messages, under same key
+namespace elephant {
+
+// Only very first block of 12 -bytes nonce prepended & padded associated data
+// depends on nonce & that block is never masked/ permuted, it's simply XOR-ed
+// into tag accumulator. Every other associated data block contributes
+// P(A_i ⊕ mask(K, i, 0)) ⊕ mask(K, i, 0), which depends only on key & data.
+//
+// So this digest holds XOR of all those contributions, along with very first
+// block, computed with all zero nonce. Finally for some specific nonce, XOR-ing
+// nonce into first 12 -bytes of digest, gives us same tag accumulator state as
+// authenticating full associated data would. That takes away all associated
+// data permutations from hot path.
+//
+// Note, digest is only valid under the key context it was computed with.
+//
+// See step {5, 9} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen>
+struct ad_digest_t
+{
+  uint8_t acc[slen >> 3]{};
+};
+
+// Precomputes associated data digest, for given key context & N -bytes
+// associated data | N >= 0
+template<const size_t slen, const size_t rounds>
+static void
+compute_ad_digest(
+  const key_ctx_t<slen, rounds>& ctx,   // expanded key context
+  const uint8_t* const __restrict data, // N -bytes associated data
+  const size_t dlen,                    // len(data) = N | >= 0
+  ad_digest_t<slen>& digest             // associated data digest
+  ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr uint8_t zeros[12]{};
+
+  absorb_data<slen, rounds>(ctx.ekey, zeros, data, dlen, digest.acc);
+}
+
+// Initializes tag accumulator from precomputed associated data digest, for
+// given 12 -bytes public message nonce
+template<const size_t slen>
+inline static void
+absorb_digest(const ad_digest_t<slen>& digest,       // associated data digest
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              uint8_t* const __restrict acc          // tag accumulator
+)
+{
+  std::memcpy(acc, digest.acc, sizeof(digest.acc));
+
+  for (size_t i = 0; i < 12; i++) {
+    acc[i] ^= nonce[i];
+  }
+}
+
+// Given key context, 12 -bytes public message nonce, precomputed associated
+// data digest & M -bytes plain text, this routine computes M -bytes encrypted
+// text & (tlen >> 3) -bytes authentication tag, using Dumbo/ Jumbo/ Delirium
+// AEAD scheme | M >= 0
+//
+// Produces same output as `elephant::encrypt`, called with the associated data
+// digest was computed on.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+encrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const ad_digest_t<slen>& digest,       // associated data digest
+        const uint8_t* const __restrict txt,   // M -bytes plain text
+        uint8_t* const __restrict enc,         // M -bytes encrypted text
+        const size_t ctlen,                    // len(txt) = len(enc) = M | >= 0
+        uint8_t* const __restrict tag          // `tlen` -bit authentication tag
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen))
+{
+  uint8_t acc[slen >> 3];
+
+  xor_keystream<slen, rounds>(ctx.ekey, nonce, txt, enc, ctlen);
+  absorb_digest<slen>(digest, nonce, acc);
+  absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+}
+
+// Given key context, 12 -bytes public message nonce, (tlen >> 3) -bytes
+// authentication tag, precomputed associated data digest & M -bytes encrypted
+// text, this routine computes M -bytes plain text & boolean verification flag,
+// using Dumbo/ Jumbo/ Delirium AEAD scheme | M >= 0
+//
+// Note, authentication tag is verified before decrypting, so unverified plain
+// text is never released; on failure plain text is zeroed.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // `tlen` -bit authentication tag
+        const ad_digest_t<slen>& digest,       // associated data digest
+        const uint8_t* const __restrict enc,   // M -bytes encrypted text
+        uint8_t* const __restrict txt,         // M -bytes plain text
+        const size_t ctlen                     // len(enc) = len(txt) = M | >= 0
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen))
+{
+  uint8_t acc[slen >> 3];
+  uint8_t tag_[tlen >> 3];
+
+  absorb_digest<slen>(digest, nonce, acc);
+  absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag_);
+
+  const bool flg = verify_tag<tlen>(tag, tag_);
+
+  if (flg) {
+    xor_keystream<slen, rounds>(ctx.ekey, nonce, enc, txt, ctlen);
+  } else {
+    std::memset(txt, 0, ctlen);
+  }
+
+  return flg;
+}
+
+}
@@ -126,8 +126,10 @@ get_ith_data_block(
   const size_t tot_to_read = blk_len - off;
   const size_t data_to_read = std::min(tot_to_read, dlen - doff);
 
-  std::memcpy(blk + off, data + doff, data_to_read);
-  off += data_to_read;
+  if (data_to_read > 0) {
+    std::memcpy(blk + off, data + doff, data_to_read);
+    off += data_to_read;
+  }
 
   const size_t rm_to_read = blk_len - off;
   const size_t rd_bytes = std::min(rm_to_read, 1ul);
@@ -195,6 +197,249 @@ check_tag_bit_len(const size_t tlen)
   return (tlen == 64) || (tlen == 128);
 }
 
+// Applies `rounds` -many rounds of underlying permutation on (slen >> 3) -bytes
+// state, choosing Spongent-π[{160, 176}] or Keccak-f[200], based on `slen`
+template<const size_t slen, const size_t rounds>
+inline static void
+permute(uint8_t* const state) requires(spongent::check_state_bit_len(slen))
+{
+  if constexpr ((slen == 160) || (slen == 176)) {
+    spongent::permute<slen, rounds>(state);
+  } else if constexpr (slen == 200) {
+    keccak::permute<rounds>(state);
+  }
+}
+
+// Expands 16 -bytes secret key into (slen >> 3) -bytes masking key, by zero
+// padding it & applying underlying permutation, which is used as `key` in very
+// first invocation of `next_mask` routine
+//
+// See section 2.2 of Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+inline static void
+expand_key(const uint8_t* const __restrict key, // 128 -bit secret key
+           uint8_t* const __restrict ekey       // expanded masking key
+           ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  std::memset(ekey, 0, sbytes);
+  std::memcpy(ekey, key, 16);
+  permute<slen, rounds>(ekey);
+}
+
+// Computes single (slen >> 3) -bytes keystream block, by permuting zero padded
+// 12 -bytes nonce, masked ( both before & after permutation ) with `fmask`
+//
+// See step 4 of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+inline static void
+keystream_block(const uint8_t* const __restrict nonce, // 96 -bit nonce
+                const uint8_t* const __restrict fmask, // mask(K, i, 1)
+                uint8_t* const __restrict ks           // keystream block
+                ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  for (size_t i = 0; i < 12; i++) {
+    ks[i] = nonce[i] ^ fmask[i];
+  }
+  std::memcpy(ks + 12, fmask + 12, sbytes - 12);
+
+  permute<slen, rounds>(ks);
+
+  for (size_t i = 0; i < sbytes; i++) {
+    ks[i] ^= fmask[i];
+  }
+}
+
+// Authenticates single already padded (slen >> 3) -bytes block of associated
+// data/ cipher text, by masking ( both before & after permutation ) it with
+// `fmask` & XOR-ing permuted block into tag accumulator
+//
+// Note, block is used as scratch space, so its content is clobbered.
+//
+// See step {9, 10} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+inline static void
+absorb_block(uint8_t* const __restrict blk,         // padded block
+             const uint8_t* const __restrict fmask, // mask(K, i, {0, 2})
+             uint8_t* const __restrict acc          // tag accumulator
+             ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  for (size_t i = 0; i < sbytes; i++) {
+    blk[i] ^= fmask[i];
+  }
+
+  permute<slen, rounds>(blk);
+
+  for (size_t i = 0; i < sbytes; i++) {
+    acc[i] ^= blk[i] ^ fmask[i];
+  }
+}
+
+// Computes (tlen >> 3) -bytes authentication tag from accumulated tag state,
+// by masking ( both before & after permutation ) it with expanded key
+//
+// See step 12 of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds, const size_t tlen>
+inline static void
+finalize_tag(const uint8_t* const __restrict ekey, // expanded masking key
+             const uint8_t* const __restrict acc,  // tag accumulator
+             uint8_t* const __restrict tag         // `tlen` -bit tag
+             ) requires(spongent::check_state_bit_len(slen) &&
+                        check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  uint8_t tmp[sbytes];
+
+  for (size_t i = 0; i < sbytes; i++) {
+    tmp[i] = acc[i] ^ ekey[i];
+  }
+
+  permute<slen, rounds>(tmp);
+
+  for (size_t i = 0; i < tbytes; i++) {
+    tag[i] = tmp[i] ^ ekey[i];
+  }
+}
+
+// Compares two (tlen >> 3) -bytes authentication tags, without early exit,
+// returning truth value only when they're equal
+template<const size_t tlen>
+inline static bool
+verify_tag(const uint8_t* const __restrict tag0, // authentication tag
+           const uint8_t* const __restrict tag1  // authentication tag
+           ) requires(check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  uint8_t flg = 0;
+  for (size_t i = 0; i < tbytes; i++) {
+    flg |= tag0[i] ^ tag1[i];
+  }
+
+  return flg == 0;
+}
+
+// XORs keystream, generated using 12 -bytes nonce & expanded masking key, with
+// M -bytes input text, producing M -bytes output text | M >= 0
+//
+// See step {4, 7} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+static void
+xor_keystream(const uint8_t* const __restrict ekey,  // expanded masking key
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict in,    // M -bytes input text
+              uint8_t* const __restrict out,         // M -bytes output text
+              const size_t len                       // len(in) = len(out) = M
+              ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t ks[sbytes];
+
+  std::memcpy(key, ekey, sbytes);
+
+  size_t off = 0;
+  while (off < len) {
+    const size_t elen = std::min(sbytes, len - off);
+
+    next_mask<slen, 1>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    keystream_block<slen, rounds>(nonce, fmask, ks);
+
+    for (size_t i = 0; i < elen; i++) {
+      out[off + i] = in[off + i] ^ ks[i];
+    }
+
+    off += elen;
+  }
+}
+
+// Authenticates 12 -bytes nonce prepended & padded N -bytes associated data,
+// initializing tag accumulator with result | N >= 0
+//
+// See step {5, 9} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+static void
+absorb_data(const uint8_t* const __restrict ekey,  // expanded masking key
+            const uint8_t* const __restrict nonce, // 96 -bit nonce
+            const uint8_t* const __restrict data,  // N -bytes associated data
+            const size_t dlen,                     // len(data) = N | >= 0
+            uint8_t* const __restrict acc          // tag accumulator
+            ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t tot_blk_cnt = (12 + dlen + 1 + sbytes - 1) / sbytes;
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  get_ith_data_block<slen>(data, dlen, nonce, 0, acc);
+  std::memcpy(key, ekey, sbytes);
+
+  for (size_t i = 1; i < tot_blk_cnt; i++) {
+    get_ith_data_block<slen>(data, dlen, nonce, i, blk);
+
+    next_mask<slen, 0>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    absorb_block<slen, rounds>(blk, fmask, acc);
+  }
+}
+
+// Authenticates padded M -bytes cipher text, XOR-ing result into tag
+// accumulator | M >= 0
+//
+// See step {6, 10} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+static void
+absorb_cipher(const uint8_t* const __restrict ekey, // expanded masking key
+              const uint8_t* const __restrict enc,  // M -bytes cipher text
+              const size_t ctlen,                   // len(enc) = M | >= 0
+              uint8_t* const __restrict acc         // tag accumulator
+              ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t tot_blk_cnt = (ctlen + 1 + sbytes - 1) / sbytes;
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  std::memcpy(key, ekey, sbytes);
+
+  for (size_t i = 0; i < tot_blk_cnt; i++) {
+    get_ith_cipher_block<slen>(enc, ctlen, i, blk);
+
+    next_mask<slen, 2>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    absorb_block<slen, rounds>(blk, fmask, acc);
+  }
+}
+
 // Given 16 -bytes secret key, 12 -bytes public message nonce, N -bytes
 // associated data & M -bytes plain text, this routine computes M -bytes
 // encrypted text & (tlen >> 3) -bytes authentication tag, using Dumbo/ Jumbo/
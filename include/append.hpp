@@ -0,0 +1,199 @@
+#pragma once
+#include "context.hpp"
+
+// Incremental ( append-only ) Elephant Authenticated Encryption with Associated
+// Data, for records which keep growing under same key & nonce
+namespace elephant {
+
+// Elephant's authentication tag is computed by permuting XOR of per-block
+// terms, where i-th cipher text block contributes P(C_i ⊕ mask(K, i, 2)) ⊕
+// mask(K, i, 2) & only last ( padded ) cipher text block depends on where
+// cipher text ends. Similarly i-th keystream block depends only on key, nonce
+// & mask(K, i, 1).
+//
+// So this state carries XOR of associated data terms & all full cipher text
+// block terms, except the last partially filled ( tail ) block, along with
+// φ_1^k(K) from which masks of tail block k are derived. Appending bytes then
+// needs keystream for those bytes, terms of cipher text blocks which get
+// filled up, term of new padded tail block & final permutation; cost scales
+// with # -of appended bytes, not with total record length.
+//
+// Note, tail block's term is never accumulated, so it doesn't need to be
+// removed once that block grows.
+//
+// Also note, this state holds secret material ( keystream & tag accumulator ),
+// treat it like you treat secret key.
+template<const size_t slen>
+struct append_state_t
+{
+  static constexpr size_t sbytes = slen >> 3;
+
+  uint8_t acc[sbytes]{};   // terms of associated data & full cipher blocks
+  uint8_t lmask[sbytes]{}; // φ_1^k(K), where k = index of tail block
+  uint8_t ks[sbytes]{};    // keystream of tail block, valid if tail non-empty
+  uint8_t tail[sbytes]{};  // cipher text bytes of tail block
+  size_t ctlen = 0;        // # -of cipher text bytes, appended so far
+
+  ~append_state_t()
+  {
+    secure_zero(acc, sizeof(acc));
+    secure_zero(lmask, sizeof(lmask));
+    secure_zero(ks, sizeof(ks));
+  }
+};
+
+// Folds just filled up tail block of cipher text into tag accumulator & moves
+// on to next block
+template<const size_t slen, const size_t rounds>
+inline static void
+close_tail_block(append_state_t<slen>& st)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  next_mask<slen, 2>(st.lmask, hmask, fmask);
+  std::memcpy(blk, st.tail, sbytes);
+  absorb_block<slen, rounds>(blk, fmask, st.acc);
+
+  lfsr<slen>(st.lmask);
+}
+
+// Computes (tlen >> 3) -bytes authentication tag over whole record, using
+// append state, without modifying it
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+append_tag(const key_ctx_t<slen, rounds>& ctx, // expanded key context
+           const append_state_t<slen>& st,     // append state
+           uint8_t* const __restrict tag       // `tlen` -bit tag
+           ) requires(spongent::check_state_bit_len(slen) &&
+                      check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t acc[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  const size_t pos = st.ctlen % sbytes;
+
+  std::memcpy(acc, st.acc, sbytes);
+  std::memcpy(blk, st.tail, pos);
+  blk[pos] = 0x01;
+  std::memset(blk + pos + 1, 0, sbytes - pos - 1);
+
+  next_mask<slen, 2>(st.lmask, hmask, fmask);
+  absorb_block<slen, rounds>(blk, fmask, acc);
+
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+}
+
+// Begins an append-only record, under given key context & 12 -bytes public
+// message nonce, authenticating N -bytes associated data | N >= 0
+template<const size_t slen, const size_t rounds>
+static void
+append_init(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+            const uint8_t* const __restrict nonce, // 96 -bit nonce
+            const uint8_t* const __restrict data,  // N -bytes associated data
+            const size_t dlen,                     // len(data) = N | >= 0
+            append_state_t<slen>& st               // append state
+            ) requires(spongent::check_state_bit_len(slen))
+{
+  absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, st.acc);
+  std::memcpy(st.lmask, ctx.ekey, sizeof(st.lmask));
+  st.ctlen = 0;
+}
+
+// Encrypts M -bytes plain text, to be appended to record, producing M -bytes
+// encrypted text ( to be appended to stored cipher text ) & (tlen >> 3) -bytes
+// authentication tag, covering whole record i.e. same tag `elephant::encrypt`
+// would produce on full record | M >= 0
+//
+// Note, same nonce must be passed, which was used during `append_init`.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+append(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+       const uint8_t* const __restrict nonce, // 96 -bit nonce
+       append_state_t<slen>& st,              // append state
+       const uint8_t* const __restrict txt,   // M -bytes plain text
+       uint8_t* const __restrict enc,         // M -bytes encrypted text
+       const size_t len,                      // len(txt) = len(enc) = M | >= 0
+       uint8_t* const __restrict tag          // `tlen` -bit authentication tag
+       ) requires(spongent::check_state_bit_len(slen) &&
+                  check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+
+  size_t off = 0;
+  while (off < len) {
+    const size_t pos = st.ctlen % sbytes;
+    const size_t take = std::min(sbytes - pos, len - off);
+
+    if (pos == 0) {
+      next_mask<slen, 1>(st.lmask, hmask, fmask);
+      keystream_block<slen, rounds>(nonce, fmask, st.ks);
+    }
+
+    for (size_t i = 0; i < take; i++) {
+      enc[off + i] = txt[off + i] ^ st.ks[pos + i];
+    }
+    std::memcpy(st.tail + pos, enc + off, take);
+
+    off += take;
+    st.ctlen += take;
+
+    if ((pos + take) == sbytes) {
+      close_tail_block<slen, rounds>(st);
+    }
+  }
+
+  append_tag<slen, rounds, tlen>(ctx, st, tag);
+}
+
+// Reconstructs append state of an already stored record, from its N -bytes
+// associated data & M -bytes cipher text, so that it can be extended further
+// using `append` | M, N >= 0
+//
+// Note, this costs as much as authenticating whole record, so prefer keeping
+// append state around, when possible.
+template<const size_t slen, const size_t rounds>
+static void
+append_resume(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              append_state_t<slen>& st               // append state
+              ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+
+  append_init<slen, rounds>(ctx, nonce, data, dlen, st);
+
+  const size_t full_blk_cnt = ctlen / sbytes;
+  for (size_t i = 0; i < full_blk_cnt; i++) {
+    std::memcpy(st.tail, enc + i * sbytes, sbytes);
+    close_tail_block<slen, rounds>(st);
+  }
+
+  const size_t pos = ctlen % sbytes;
+  std::memcpy(st.tail, enc + full_blk_cnt * sbytes, pos);
+  st.ctlen = ctlen;
+
+  if (pos > 0) {
+    next_mask<slen, 1>(st.lmask, hmask, fmask);
+    keystream_block<slen, rounds>(nonce, fmask, st.ks);
+  }
+}
+
+}
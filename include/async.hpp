@@ -0,0 +1,866 @@
+#pragma once
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "split.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Asynchronous ( C++20 coroutine based ) API of Elephant Authenticated
+// Encryption with Associated Data, so that {en, de}crypting large messages
+// doesn't stall event loop of caller
+namespace elephant {
+
+// Pooled allocator for coroutine frames, keeping per thread free lists of
+// power of 2 sized blocks ( 64 B to 8 KiB, including a 16 -bytes header ), so
+// that frames of short lived coroutines are recycled, instead of hitting global
+// allocator on every call
+//
+// Every block remembers thread ( owner ) which allocated it. Freeing thread
+// caches block only when it owns it, otherwise block is pushed onto owner's
+// lock-free return list, which owner drains into its free lists, once they run
+// dry. So frames of coroutines started on producer thread, but finishing on
+// workers, keep coming back to producer, instead of piling up on workers.
+// Each free list caches at most `MAX_CACHED` -many blocks, rest are returned to
+// global allocator. Owner outlives its thread until all of its blocks are back.
+struct frame_pool_t
+{
+  static constexpr size_t MIN_SHIFT = 6;
+  static constexpr size_t CLASSES = 8;
+  static constexpr size_t MAX_CACHED = 64;
+
+  struct owner_t;
+
+  // Prefix of every block, keeping frames 16 -bytes aligned
+  struct alignas(16) header_t
+  {
+    owner_t* owner; // allocating thread, null for oversized blocks
+    size_t cls;     // size class
+  };
+
+  struct node_t
+  {
+    node_t* next;
+  };
+
+  // Free lists of a thread, along with return list of blocks, freed by others
+  struct owner_t
+  {
+    node_t* heads[CLASSES]{};
+    size_t cnt[CLASSES]{};
+    size_t out = 0; // # -of blocks allocated, but not back in free lists
+
+    // blocks freed by other threads, set to `orphaned()` once thread exits
+    alignas(64) std::atomic<node_t*> returned{ nullptr };
+    std::atomic<size_t> left{ 0 }; // blocks still out, after thread exits
+
+    static inline node_t* orphaned()
+    {
+      return reinterpret_cast<node_t*>(alignof(node_t));
+    }
+
+    // Caches block into its free list, unless list is full
+    inline void put(node_t* const blk)
+    {
+      const size_t c = reinterpret_cast<header_t*>(blk)->cls;
+
+      if (cnt[c] == MAX_CACHED) {
+        ::operator delete(blk);
+      } else {
+        blk->next = heads[c];
+        heads[c] = blk;
+        cnt[c]++;
+      }
+    }
+
+    // Moves blocks freed by other threads into free lists
+    inline void drain()
+    {
+      node_t* n = returned.exchange(nullptr, std::memory_order_acquire);
+
+      while (n != nullptr) {
+        node_t* const next = n->next;
+        put(n);
+        out--;
+        n = next;
+      }
+    }
+
+    // Called from other threads, hands block back to its owner
+    inline void give_back(node_t* const blk)
+    {
+      node_t* head = returned.load(std::memory_order_acquire);
+
+      while (true) {
+        if (head == orphaned()) {
+          ::operator delete(blk);
+          if (left.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+          }
+          return;
+        }
+
+        blk->next = head;
+        if (returned.compare_exchange_weak(head,
+                                           blk,
+                                           std::memory_order_release,
+                                           std::memory_order_acquire)) {
+          return;
+        }
+      }
+    }
+
+    // Called at thread exit, frees cached blocks & leaves deleting owner to
+    // whoever returns its last block
+    inline void retire()
+    {
+      while (true) {
+        drain();
+        left.store(out, std::memory_order_relaxed);
+
+        node_t* expected = nullptr;
+        if (returned.compare_exchange_strong(
+              expected, orphaned(), std::memory_order_acq_rel)) {
+          break;
+        }
+      }
+
+      for (size_t c = 0; c < CLASSES; c++) {
+        while (heads[c] != nullptr) {
+          node_t* const n = heads[c];
+          heads[c] = n->next;
+          ::operator delete(n);
+        }
+      }
+
+      if (out == 0) {
+        delete this;
+      }
+    }
+  };
+
+  // Owner of calling thread, created on its first allocation
+  static inline owner_t*& self()
+  {
+    struct holder_t
+    {
+      owner_t* o = nullptr;
+
+      ~holder_t()
+      {
+        if (o != nullptr) {
+          o->retire();
+        }
+      }
+    };
+    thread_local holder_t h;
+    return h.o;
+  }
+
+  // Index of smallest size class holding `n` -bytes, CLASSES if none does
+  static constexpr inline size_t size_class(const size_t n)
+  {
+    size_t c = 0;
+    while ((c < CLASSES) && ((1ul << (MIN_SHIFT + c)) < n)) {
+      c++;
+    }
+    return c;
+  }
+
+  static inline void* alloc(const size_t n)
+  {
+    const size_t c = size_class(n + sizeof(header_t));
+    if (c == CLASSES) {
+      void* const ptr = ::operator new(n + sizeof(header_t));
+      new (ptr) header_t{ nullptr, c };
+      return static_cast<header_t*>(ptr) + 1;
+    }
+
+    owner_t*& o = self();
+    if (o == nullptr) {
+      o = new owner_t;
+    }
+
+    if ((o->heads[c] == nullptr) &&
+        (o->returned.load(std::memory_order_relaxed) != nullptr)) {
+      o->drain();
+    }
+
+    void* ptr = o->heads[c];
+    if (ptr != nullptr) {
+      o->heads[c] = o->heads[c]->next;
+      o->cnt[c]--;
+    } else {
+      ptr = ::operator new(1ul << (MIN_SHIFT + c));
+    }
+
+    o->out++;
+    new (ptr) header_t{ o, c };
+    return static_cast<header_t*>(ptr) + 1;
+  }
+
+  static inline void dealloc(void* const ptr, const size_t)
+  {
+    header_t* const hdr = static_cast<header_t*>(ptr) - 1;
+    owner_t* const o = hdr->owner;
+    node_t* const blk = reinterpret_cast<node_t*>(hdr);
+
+    if (o == nullptr) {
+      ::operator delete(hdr);
+    } else if (o == self()) {
+      o->put(blk);
+      o->out--;
+    } else {
+      o->give_back(blk);
+    }
+  }
+};
+
+// Base of coroutine promise types, whose frames should come from
+// `frame_pool_t`; caller's own task types can inherit it too
+struct pooled_frame_t
+{
+  static void* operator new(const size_t n) { return frame_pool_t::alloc(n); }
+
+  static void operator delete(void* const ptr, const size_t n)
+  {
+    frame_pool_t::dealloc(ptr, n);
+  }
+};
+
+// Lazily started coroutine, returning value of type T ( or void ), whose frame
+// is allocated from `frame_pool_t`
+//
+// Awaiting a task starts it & resumes awaiter once task completes, using
+// symmetric transfer, while `sync_wait` drives it from non-coroutine code.
+template<typename T = void>
+class task_t
+{
+private:
+  // Completion signal of task driven by `sync_wait`, living on its stack
+  struct waiter_t
+  {
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool done = false;
+  };
+
+  struct promise_base_t : public pooled_frame_t
+  {
+    std::coroutine_handle<> cont;
+    waiter_t* waiter = nullptr;
+
+    struct final_awaiter_t
+    {
+      bool await_ready() const noexcept { return false; }
+
+      template<typename P>
+      std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<P> h) const noexcept
+      {
+        promise_base_t& p = h.promise();
+
+        if (p.cont) {
+          return p.cont;
+        }
+
+        // notified under lock, so that waiter ( along with its mutex ) can't
+        // go away, before notification is done
+        waiter_t* const w = p.waiter;
+        std::lock_guard<std::mutex> lock(w->mtx);
+        w->done = true;
+        w->cv.notify_one();
+
+        return std::noop_coroutine();
+      }
+
+      void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    final_awaiter_t final_suspend() const noexcept { return {}; }
+    void unhandled_exception() const noexcept { std::terminate(); }
+  };
+
+  struct value_promise_t : public promise_base_t
+  {
+    T value{};
+    void return_value(T v) { value = std::move(v); }
+  };
+
+  struct void_promise_t : public promise_base_t
+  {
+    void return_void() const noexcept {}
+  };
+
+public:
+  struct promise_type
+    : public std::conditional_t<std::is_void_v<T>,
+                                void_promise_t,
+                                value_promise_t>
+  {
+    task_t get_return_object()
+    {
+      return task_t{ std::coroutine_handle<promise_type>::from_promise(*this) };
+    }
+  };
+
+  using handle_t = std::coroutine_handle<promise_type>;
+
+  explicit task_t(const handle_t h_)
+    : h(h_)
+  {
+  }
+
+  task_t(task_t&& t) noexcept
+    : h(std::exchange(t.h, {}))
+  {
+  }
+
+  task_t(const task_t&) = delete;
+  task_t& operator=(const task_t&) = delete;
+  task_t& operator=(task_t&&) = delete;
+
+  ~task_t()
+  {
+    if (h) {
+      h.destroy();
+    }
+  }
+
+  bool await_ready() const noexcept { return false; }
+
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<> c) noexcept
+  {
+    h.promise().cont = c;
+    return h;
+  }
+
+  T await_resume()
+  {
+    if constexpr (!std::is_void_v<T>) {
+      return std::move(h.promise().value);
+    }
+  }
+
+  // Starts task on calling thread & blocks until it completes ( possibly on
+  // another thread ), returning its result
+  T sync_wait()
+  {
+    waiter_t w;
+
+    h.promise().waiter = &w;
+    h.resume();
+
+    std::unique_lock<std::mutex> lock(w.mtx);
+    w.cv.wait(lock, [&w]() { return w.done; });
+
+    return await_resume();
+  }
+
+private:
+  handle_t h;
+};
+
+// Job, which can be posted to `async_pool_t`, without allocating; it's owned
+// by poster & must stay alive until `fn` is invoked on it
+struct async_job_t
+{
+  async_job_t* next = nullptr;
+  void (*fn)(async_job_t*) = nullptr;
+};
+
+// Fixed size pool of worker threads, executing intrusively linked jobs in FIFO
+// order, so that handing work off to it doesn't allocate
+class async_pool_t
+{
+private:
+  std::vector<std::thread> workers;
+  std::mutex mtx;
+  std::condition_variable cv;
+  async_job_t* head = nullptr;
+  async_job_t* tail = nullptr;
+  bool stopping = false;
+
+  inline void run()
+  {
+    while (true) {
+      async_job_t* job = nullptr;
+
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return stopping || (head != nullptr); });
+
+        if (head == nullptr) {
+          return;
+        }
+
+        job = head;
+        head = job->next;
+        if (head == nullptr) {
+          tail = nullptr;
+        }
+      }
+
+      // job may be destroyed as soon as it's run, so it's not touched again
+      job->fn(job);
+    }
+  }
+
+public:
+  // Spawns `n` -many worker threads | n > 0
+  explicit async_pool_t(
+    const size_t n = std::max(std::thread::hardware_concurrency(), 1u))
+  {
+    workers.reserve(n);
+
+    for (size_t i = 0; i < n; i++) {
+      workers.emplace_back([this]() { run(); });
+    }
+  }
+
+  async_pool_t(const async_pool_t&) = delete;
+  async_pool_t& operator=(const async_pool_t&) = delete;
+
+  // Waits for all posted jobs to finish & joins worker threads
+  ~async_pool_t()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cv.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of worker threads
+  size_t size() const { return workers.size(); }
+
+  // Enqueues `cnt` -many jobs, under a single lock acquisition
+  void post(async_job_t* const* const jobs, const size_t cnt)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+
+      for (size_t i = 0; i < cnt; i++) {
+        jobs[i]->next = nullptr;
+
+        if (tail == nullptr) {
+          head = jobs[i];
+        } else {
+          tail->next = jobs[i];
+        }
+        tail = jobs[i];
+      }
+    }
+
+    if (cnt == 1) {
+      cv.notify_one();
+    } else {
+      cv.notify_all();
+    }
+  }
+};
+
+// Process wide worker pool, used by `async_{en, de}crypt`, unless caller
+// passes its own, with one worker per hardware thread
+inline async_pool_t&
+default_async_pool()
+{
+  static async_pool_t pool;
+  return pool;
+}
+
+// Knobs of `async_{en, de}crypt`
+//
+// - inline_len : messages with at most these many bytes ( associated data &
+// text, together ) are {en, de}crypted inline, without suspending
+// - part_len : larger messages are split into parts of roughly these many
+// bytes, at most one part per worker & at most `MAX_PARTS` -many
+struct async_opts_t
+{
+  static constexpr size_t MAX_PARTS = 32;
+
+  size_t inline_len = 1ul << 14;
+  size_t part_len = 1ul << 16;
+};
+
+// Awaitable {en, de}cryption of a single message, returned by
+// `async_{en, de}crypt`
+//
+// It lives in awaiting coroutine's frame & embeds everything in-flight
+// {en, de}cryption needs ( jobs, partial tag accumulators ), so that
+// suspending & offloading doesn't allocate. Blocks of associated data ( but
+// very first one ) & of text are independent of each other, given masks
+// computed using jump-ahead, so they are split into contiguous ranges, each
+// processed as a job on worker pool, producing partial tag accumulator. Job
+// finishing last XOR-merges accumulators, finalizes ( or verifies ) tag &
+// resumes awaiting coroutine, on its own worker thread.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+class aead_awaiter_t
+{
+private:
+  static constexpr size_t sbytes = slen >> 3;
+  static constexpr size_t MAX_PARTS = async_opts_t::MAX_PARTS;
+
+  struct part_job_t : public async_job_t
+  {
+    aead_awaiter_t* self = nullptr;
+    size_t idx = 0;
+  };
+
+  const key_ctx_t<slen, rounds>& ctx;
+  const uint8_t* const nonce;
+  const uint8_t* const itag;
+  uint8_t* const otag;
+  const uint8_t* const data;
+  const size_t dlen;
+  const uint8_t* const in;
+  uint8_t* const out;
+  const size_t ctlen;
+  async_pool_t& pool;
+  const async_opts_t opts;
+
+  split_plan_t<slen> plan;
+  size_t nparts = 0;
+  bool flag = true;
+
+  std::coroutine_handle<> cont;
+  std::atomic<size_t> pending{ 0 };
+  part_job_t jobs[MAX_PARTS];
+  uint8_t accs[MAX_PARTS][sbytes];
+
+  // Processes p -th range of work units, into its partial tag accumulator
+  inline void run_part(const size_t p)
+  {
+    process_units<slen, rounds, decrypting>(ctx.ekey,
+                                            nonce,
+                                            data,
+                                            dlen,
+                                            in,
+                                            out,
+                                            ctlen,
+                                            plan,
+                                            plan.bound(p, nparts),
+                                            plan.bound(p + 1, nparts),
+                                            accs[p]);
+  }
+
+  // Merges partial accumulators, finalizes tag & resumes awaiting coroutine
+  inline void finish()
+  {
+    flag = finish_units<slen, rounds, tlen, decrypting>(
+      ctx.ekey, nonce, data, dlen, out, ctlen, accs[0], nparts, itag, otag);
+
+    // awaiter ( living in coroutine frame ) may be gone, once this returns
+    cont.resume();
+  }
+
+  static void run_job(async_job_t* const job)
+  {
+    part_job_t* const pj = static_cast<part_job_t*>(job);
+    aead_awaiter_t* const self = pj->self;
+
+    self->run_part(pj->idx);
+    if (self->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      self->finish();
+    }
+  }
+
+public:
+  aead_awaiter_t(const key_ctx_t<slen, rounds>& ctx_,
+                 const uint8_t* const nonce_,
+                 const uint8_t* const itag_,
+                 uint8_t* const otag_,
+                 const uint8_t* const data_,
+                 const size_t dlen_,
+                 const uint8_t* const in_,
+                 uint8_t* const out_,
+                 const size_t ctlen_,
+                 async_pool_t& pool_,
+                 const async_opts_t opts_)
+    : ctx(ctx_)
+    , nonce(nonce_)
+    , itag(itag_)
+    , otag(otag_)
+    , data(data_)
+    , dlen(dlen_)
+    , in(in_)
+    , out(out_)
+    , ctlen(ctlen_)
+    , pool(pool_)
+    , opts(opts_)
+  {
+  }
+
+  aead_awaiter_t(const aead_awaiter_t&) = delete;
+  aead_awaiter_t& operator=(const aead_awaiter_t&) = delete;
+
+  // Small messages are {en, de}crypted right here, without suspending
+  bool await_ready()
+  {
+    if (dlen + ctlen > opts.inline_len) {
+      return false;
+    }
+
+    if constexpr (decrypting) {
+      flag = decrypt<slen, rounds, tlen>(
+        ctx, nonce, itag, data, dlen, in, out, ctlen);
+    } else {
+      encrypt<slen, rounds, tlen>(ctx, nonce, data, dlen, in, out, ctlen, otag);
+    }
+
+    return true;
+  }
+
+  void await_suspend(const std::coroutine_handle<> h)
+  {
+    plan = split_plan_t<slen>(dlen, ctlen);
+
+    const size_t want = (dlen + ctlen + opts.part_len - 1) /
+                        std::max<size_t>(opts.part_len, 1);
+    nparts = std::min({ want, pool.size(), MAX_PARTS });
+    nparts = std::max<size_t>(nparts, 1);
+
+    cont = h;
+    pending.store(nparts, std::memory_order_relaxed);
+
+    async_job_t* ptrs[MAX_PARTS];
+    for (size_t p = 0; p < nparts; p++) {
+      jobs[p].fn = run_job;
+      jobs[p].self = this;
+      jobs[p].idx = p;
+      ptrs[p] = &jobs[p];
+    }
+
+    // awaiter may be resumed ( & destroyed ) before `post` even returns
+    pool.post(ptrs, nparts);
+  }
+
+  // Returns boolean verification flag, when decrypting
+  auto await_resume() const
+  {
+    if constexpr (decrypting) {
+      return flag;
+    }
+  }
+};
+
+// Awaitable encryption of M -bytes plain text, authenticating N -bytes
+// associated data, under given key context & 12 -bytes nonce | M, N >= 0
+//
+// Produces same cipher text & tag as `elephant::encrypt`. Small messages (
+// see `async_opts_t` ) complete inline, while larger ones are split across
+// workers of `pool` & awaiting coroutine is resumed on a worker thread, once
+// all parts are done. All buffers must stay alive until `co_await` returns.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static aead_awaiter_t<slen, rounds, tlen, false>
+async_encrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict txt,   // M -bytes plain text
+              uint8_t* const __restrict enc,         // M -bytes cipher text
+              const size_t ctlen,                    // len(txt) = M | >= 0
+              uint8_t* const __restrict tag,         // `tlen` -bit tag
+              async_pool_t& pool = default_async_pool(), // worker pool
+              const async_opts_t opts = {}               // knobs
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  return aead_awaiter_t<slen, rounds, tlen, false>(
+    ctx, nonce, nullptr, tag, data, dlen, txt, enc, ctlen, pool, opts);
+}
+
+// Awaitable verified decryption of M -bytes cipher text, authenticating N
+// -bytes associated data, under given key context & 12 -bytes nonce, whose
+// result is boolean verification flag | M, N >= 0
+//
+// Produces same plain text ( zeroed, if verification fails ) as
+// `elephant::decrypt`, completing inline or on workers of `pool`, just like
+// `async_encrypt`.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static aead_awaiter_t<slen, rounds, tlen, true>
+async_decrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // `tlen` -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              uint8_t* const __restrict txt,         // M -bytes plain text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              async_pool_t& pool = default_async_pool(), // worker pool
+              const async_opts_t opts = {}               // knobs
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  return aead_awaiter_t<slen, rounds, tlen, true>(
+    ctx, nonce, tag, nullptr, data, dlen, enc, txt, ctlen, pool, opts);
+}
+
+}
+
+// Dumbo, Jumbo & Delirium flavours of awaitable {en, de}cryption; they live
+// here, not in variant headers, as including this header needs compiler
+// support for coroutines ( say -fcoroutines, on GCC 10 )
+namespace dumbo {
+
+// Awaitable encryption of M -bytes plain text & authentication of N -bytes
+// associated data, using Dumbo AEAD, completing inline for small messages &
+// on workers of `pool` otherwise, see `elephant::async_encrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, false>
+async_encrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict txt,   // M -bytes plain text
+              uint8_t* const __restrict enc,         // M -bytes cipher text
+              const size_t ctlen,                    // len(txt) = M | >= 0
+              uint8_t* const __restrict tag,         // 64 -bit tag
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_encrypt<a, b, c>(
+    ctx, nonce, data, dlen, txt, enc, ctlen, tag, pool, opts);
+}
+
+// Awaitable verified decryption of M -bytes cipher text, using Dumbo AEAD,
+// resulting in boolean verification flag, see `elephant::async_decrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, true>
+async_decrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // 64 -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              uint8_t* const __restrict txt,         // M -bytes plain text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_decrypt<a, b, c>(
+    ctx, nonce, tag, data, dlen, enc, txt, ctlen, pool, opts);
+}
+
+}
+
+namespace jumbo {
+
+// Awaitable encryption of M -bytes plain text & authentication of N -bytes
+// associated data, using Jumbo AEAD, completing inline for small messages &
+// on workers of `pool` otherwise, see `elephant::async_encrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, false>
+async_encrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict txt,   // M -bytes plain text
+              uint8_t* const __restrict enc,         // M -bytes cipher text
+              const size_t ctlen,                    // len(txt) = M | >= 0
+              uint8_t* const __restrict tag,         // 64 -bit tag
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_encrypt<a, b, c>(
+    ctx, nonce, data, dlen, txt, enc, ctlen, tag, pool, opts);
+}
+
+// Awaitable verified decryption of M -bytes cipher text, using Jumbo AEAD,
+// resulting in boolean verification flag, see `elephant::async_decrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, true>
+async_decrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // 64 -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              uint8_t* const __restrict txt,         // M -bytes plain text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_decrypt<a, b, c>(
+    ctx, nonce, tag, data, dlen, enc, txt, ctlen, pool, opts);
+}
+
+}
+
+namespace delirium {
+
+// Awaitable encryption of M -bytes plain text & authentication of N -bytes
+// associated data, using Delirium AEAD, completing inline for small messages &
+// on workers of `pool` otherwise, see `elephant::async_encrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, false>
+async_encrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict txt,   // M -bytes plain text
+              uint8_t* const __restrict enc,         // M -bytes cipher text
+              const size_t ctlen,                    // len(txt) = M | >= 0
+              uint8_t* const __restrict tag,         // 128 -bit tag
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_encrypt<a, b, c>(
+    ctx, nonce, data, dlen, txt, enc, ctlen, tag, pool, opts);
+}
+
+// Awaitable verified decryption of M -bytes cipher text, using Delirium AEAD,
+// resulting in boolean verification flag, see `elephant::async_decrypt`
+inline static elephant::aead_awaiter_t<SLEN, ROUNDS, TLEN, true>
+async_decrypt(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // 128 -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              uint8_t* const __restrict txt,         // M -bytes plain text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              elephant::async_pool_t& pool = elephant::default_async_pool(),
+              const elephant::async_opts_t opts = {})
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::async_decrypt<a, b, c>(
+    ctx, nonce, tag, data, dlen, enc, txt, ctlen, pool, opts);
+}
+
+}
@@ -0,0 +1,693 @@
+#pragma once
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "multi.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Micro-batching scheduler for Elephant Authenticated Encryption with
+// Associated Data, grouping individually submitted messages into batches, so
+// that multi-state permutation lanes stay full
+namespace elephant {
+
+// Slab allocator of byte buffers, in power of 2 size classes ( 64 B to 64 KiB
+// ), carved out of 64 KiB ( or one buffer, for larger classes ) chunks, which
+// are only returned to system when allocator goes away
+//
+// Buffers can be allocated & freed from any thread. Allocation takes a mutex,
+// guarding per class free lists, while freed buffers are pushed on a per class
+// lock-free stack, which allocator takes over as a whole ( with single atomic
+// exchange, so there's no ABA ), once its free list runs empty. Requests larger
+// than 64 KiB go straight to global allocator.
+//
+// Allocator is reference counted: its creator holds one reference & every live
+// buffer holds another, so that it goes away ( using `delete` ) only once its
+// creator has called `release` & all buffers are freed back. Hence it must be
+// created using `new`, while buffers may safely outlive their creator.
+class slab_pool_t
+{
+public:
+  static constexpr size_t MIN_SHIFT = 6;
+  static constexpr size_t CLASSES = 11;
+  static constexpr size_t CHUNK = 1ul << 16;
+
+private:
+  struct node_t
+  {
+    node_t* next;
+  };
+
+  std::mutex mtx;
+  node_t* owned[CLASSES]{};
+  std::vector<void*> chunks;
+
+  std::atomic<node_t*> freed[CLASSES]{};
+  std::atomic<size_t> refs{ 1 };
+
+  static constexpr inline size_t size_class(const size_t n)
+  {
+    size_t c = 0;
+    while ((c < CLASSES) && ((1ul << (MIN_SHIFT + c)) < n)) {
+      c++;
+    }
+    return c;
+  }
+
+  ~slab_pool_t()
+  {
+    for (void* const c : chunks) {
+      ::operator delete(c);
+    }
+  }
+
+  // Drops one reference, deleting allocator, if it was last one
+  void unref()
+  {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+public:
+  slab_pool_t() = default;
+  slab_pool_t(const slab_pool_t&) = delete;
+  slab_pool_t& operator=(const slab_pool_t&) = delete;
+
+  // Drops creator's reference; allocator goes away, once all buffers are
+  // freed back
+  void release() { unref(); }
+
+  // Allocates buffer of at least `n` -bytes | can be called from any thread
+  uint8_t* alloc(const size_t n)
+  {
+    refs.fetch_add(1, std::memory_order_relaxed);
+
+    const size_t c = size_class(n);
+    if (c == CLASSES) {
+      return static_cast<uint8_t*>(::operator new(n));
+    }
+
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (owned[c] == nullptr) {
+      owned[c] = freed[c].exchange(nullptr, std::memory_order_acquire);
+    }
+
+    if (owned[c] == nullptr) {
+      const size_t bsize = 1ul << (MIN_SHIFT + c);
+      const size_t csize = std::max(CHUNK, bsize);
+
+      uint8_t* const chunk = static_cast<uint8_t*>(::operator new(csize));
+      chunks.push_back(chunk);
+
+      for (size_t off = csize; off > 0; off -= bsize) {
+        node_t* const blk = reinterpret_cast<node_t*>(chunk + off - bsize);
+        blk->next = owned[c];
+        owned[c] = blk;
+      }
+    }
+
+    node_t* const blk = owned[c];
+    owned[c] = blk->next;
+    return reinterpret_cast<uint8_t*>(blk);
+  }
+
+  // Frees buffer of `n` -bytes, allocated using this allocator | can be
+  // called from any thread
+  void dealloc(uint8_t* const ptr, const size_t n)
+  {
+    const size_t c = size_class(n);
+    if (c == CLASSES) {
+      ::operator delete(ptr);
+    } else {
+      node_t* const blk = reinterpret_cast<node_t*>(ptr);
+      blk->next = freed[c].load(std::memory_order_relaxed);
+
+      while (!freed[c].compare_exchange_weak(
+        blk->next, blk, std::memory_order_release, std::memory_order_relaxed)) {
+      }
+    }
+
+    unref();
+  }
+};
+
+// Standard allocator interface on top of `slab_pool_t`, so that shared state
+// of promise/ future pairs also comes from slab
+template<typename T>
+struct slab_alloc_t
+{
+  using value_type = T;
+
+  slab_pool_t* pool;
+
+  explicit slab_alloc_t(slab_pool_t* const pool_)
+    : pool(pool_)
+  {
+  }
+
+  template<typename U>
+  slab_alloc_t(const slab_alloc_t<U>& a)
+    : pool(a.pool)
+  {
+  }
+
+  T* allocate(const size_t n)
+  {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    return reinterpret_cast<T*>(pool->alloc(n * sizeof(T)));
+  }
+
+  void deallocate(T* const ptr, const size_t n)
+  {
+    pool->dealloc(reinterpret_cast<uint8_t*>(ptr), n * sizeof(T));
+  }
+
+  template<typename U>
+  bool operator==(const slab_alloc_t<U>& a) const
+  {
+    return pool == a.pool;
+  }
+};
+
+// Owning handle of a buffer, allocated from `slab_pool_t`, which frees it
+// back, when it goes out of scope
+class slab_buf_t
+{
+private:
+  slab_pool_t* pool = nullptr;
+  uint8_t* ptr = nullptr;
+  size_t len = 0;
+
+public:
+  slab_buf_t() = default;
+
+  slab_buf_t(slab_pool_t& pool_, const size_t len_)
+    : pool(&pool_)
+    , ptr(len_ > 0 ? pool_.alloc(len_) : nullptr)
+    , len(len_)
+  {
+  }
+
+  slab_buf_t(slab_buf_t&& b) noexcept
+    : pool(std::exchange(b.pool, nullptr))
+    , ptr(std::exchange(b.ptr, nullptr))
+    , len(std::exchange(b.len, 0))
+  {
+  }
+
+  slab_buf_t& operator=(slab_buf_t&& b) noexcept
+  {
+    if (this != &b) {
+      reset();
+      pool = std::exchange(b.pool, nullptr);
+      ptr = std::exchange(b.ptr, nullptr);
+      len = std::exchange(b.len, 0);
+    }
+    return *this;
+  }
+
+  slab_buf_t(const slab_buf_t&) = delete;
+  slab_buf_t& operator=(const slab_buf_t&) = delete;
+
+  ~slab_buf_t() { reset(); }
+
+  // Frees buffer back to its allocator
+  void reset()
+  {
+    if (ptr != nullptr) {
+      pool->dealloc(ptr, len);
+    }
+
+    pool = nullptr;
+    ptr = nullptr;
+    len = 0;
+  }
+
+  uint8_t* data() const { return ptr; }
+  size_t size() const { return len; }
+};
+
+// Operation requested by a submission
+enum class batch_op_t : uint8_t
+{
+  encrypt,
+  decrypt
+};
+
+// Single submission to `batch_scheduler_t`, owned by submitter, which must
+// keep it ( along with associated data & input text ) alive until `done` is
+// invoked on it
+//
+// When encrypting, `tag` receives authentication tag, while when decrypting,
+// it holds expected tag & `ok` receives verification flag. In both cases,
+// output text is written to `out`, a buffer allocated from scheduler's slab,
+// now owned by submission.
+struct batch_req_t
+{
+  batch_op_t op = batch_op_t::encrypt;
+  uint8_t nonce[12]{};           // 96 -bit nonce
+  const uint8_t* data = nullptr; // N -bytes associated data
+  size_t dlen = 0;               // len(data) = N | >= 0
+  const uint8_t* in = nullptr;   // M -bytes input text
+  size_t len = 0;                // len(in) = M | >= 0
+  uint8_t tag[16]{};             // 64/ 128 -bit authentication tag
+  slab_buf_t out;                // M -bytes output text
+  bool ok = false;               // verification flag, when decrypting
+
+  // Invoked on scheduler thread, once request is done, so it must be quick
+  void (*done)(batch_req_t*, void*) = nullptr;
+  void* arg = nullptr;
+
+  batch_req_t* next = nullptr;
+  std::chrono::steady_clock::time_point t_enq;
+};
+
+// Outcome of a submission, delivered through future
+struct batch_result_t
+{
+  slab_buf_t out;    // M -bytes output text
+  uint8_t tag[16]{}; // authentication tag, when encrypting
+  bool ok = false;   // verification flag, when decrypting
+};
+
+// Knobs of `batch_scheduler_t`
+//
+// - deadline : longest any submission waits in queue, before its batch is
+// dispatched, even if batch is not full
+// - max_batch : # -of submissions, which are dispatched right away, as soon as
+// that many are waiting
+struct batch_opts_t
+{
+  std::chrono::nanoseconds deadline{ 20'000 };
+  size_t max_batch = 4 * LANES;
+};
+
+// Counters of `batch_scheduler_t`, for tuning latency/ throughput tradeoff
+struct batch_metrics_t
+{
+  uint64_t batches = 0;      // # -of dispatched batches
+  uint64_t requests = 0;     // # -of completed submissions
+  uint64_t full_batches = 0; // # -of batches dispatched because they're full
+  uint64_t lane_calls = 0;   // # -of multi-state permutation calls
+  uint64_t lanes_used = 0;   // # -of lanes carrying some state
+  uint64_t delay_sum_ns = 0; // total queueing delay of all submissions
+  uint64_t delay_max_ns = 0; // longest queueing delay of any submission
+
+  // Fraction of permutation lanes doing useful work | [0, 1]
+  double fill_ratio() const
+  {
+    return lane_calls == 0
+             ? 0.
+             : static_cast<double>(lanes_used) / (lane_calls * LANES);
+  }
+
+  // Mean # -of submissions per batch
+  double mean_batch() const
+  {
+    return batches == 0 ? 0. : static_cast<double>(requests) / batches;
+  }
+
+  // Mean time, a submission waits in queue, before its batch is dispatched
+  double mean_delay_ns() const
+  {
+    return requests == 0 ? 0. : static_cast<double>(delay_sum_ns) / requests;
+  }
+};
+
+// Scheduler, accepting individual {en, de}cryption submissions from any
+// number of threads, under a single key context, & running them in batches
+// through multi-buffer {en, de}cryption, on its own thread
+//
+// Submissions are pushed on a lock-free ( multi-producer, single-consumer )
+// stack, which scheduler thread takes over as a whole & reverses, so that they
+// are served in arrival order. Scheduler dispatches a batch, as soon as
+// `max_batch` submissions are waiting or oldest of them has waited for
+// `deadline`. Meanwhile it sleeps on a condition variable, with timeout at
+// the deadline, & submitters wake it only once enough submissions are queued
+// to fill the batch; when there's nothing to do, it sleeps until next
+// submission. Output buffers come from a reference counted slab, so they
+// stay valid after scheduler goes away.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class batch_scheduler_t
+{
+private:
+  using clock_t = std::chrono::steady_clock;
+
+  static constexpr size_t tbytes = tlen >> 3;
+
+  const batch_opts_t opts;
+
+  alignas(64) std::atomic<batch_req_t*> incoming{ nullptr };
+  alignas(64) std::atomic<int64_t> queued{ 0 }; // # -of submissions on stack
+  std::atomic<int64_t> want{ 1 };  // # -of queued ones, worth waking up for
+  std::atomic<bool> sleeping{ false };
+  std::atomic<bool> stopping{ false };
+
+  std::mutex mtx;
+  std::condition_variable cv;
+
+  slab_pool_t* const slab;
+  mb_table_t<slen, rounds> tab;
+  std::vector<batch_req_t*> pending;
+  std::vector<batch_req_t*> batch;
+  std::vector<mb_msg_t> msgs;
+
+  mutable std::mutex metrics_mtx;
+  batch_metrics_t stats;
+
+  std::thread worker;
+
+  // Moves all submissions from lock-free stack to pending list, in arrival
+  // order, returning # -of moved submissions
+  size_t drain()
+  {
+    batch_req_t* r = incoming.exchange(nullptr, std::memory_order_acquire);
+
+    const size_t beg = pending.size();
+    for (; r != nullptr; r = r->next) {
+      pending.push_back(r);
+    }
+
+    std::reverse(pending.begin() + beg, pending.end());
+
+    const size_t moved = pending.size() - beg;
+    queued.fetch_sub(static_cast<int64_t>(moved), std::memory_order_seq_cst);
+    return moved;
+  }
+
+  // Sleeps until at least `n` -many submissions are queued, scheduler is
+  // stopping or, when given, `due` has passed
+  void sleep(const int64_t n, const clock_t::time_point* const due)
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    want.store(n, std::memory_order_seq_cst);
+    sleeping.store(true, std::memory_order_seq_cst);
+
+    auto ready = [&]() {
+      return stopping.load(std::memory_order_seq_cst) ||
+             (queued.load(std::memory_order_seq_cst) >= n);
+    };
+
+    if (due != nullptr) {
+      cv.wait_until(lock, *due, ready);
+    } else {
+      cv.wait(lock, ready);
+    }
+
+    sleeping.store(false, std::memory_order_relaxed);
+  }
+
+  // Runs first ( at most ) `max_batch` pending submissions of one kind
+  // through multi-buffer path
+  template<const bool decrypting>
+  void run(const size_t n, mb_stats_t& ms)
+  {
+    constexpr batch_op_t op = decrypting ? batch_op_t::decrypt
+                                         : batch_op_t::encrypt;
+
+    batch.clear();
+    msgs.clear();
+
+    for (size_t i = 0; i < n; i++) {
+      batch_req_t* const r = pending[i];
+      if (r->op != op) {
+        continue;
+      }
+
+      r->out = slab_buf_t(*slab, r->len);
+
+      batch.push_back(r);
+      msgs.push_back(mb_msg_t{
+        r->nonce, r->data, r->dlen, r->in, r->out.data(), r->len, r->tag });
+    }
+
+    if (batch.empty()) {
+      return;
+    }
+
+    mb_run<slen, rounds, tlen, decrypting>(tab, msgs.data(), msgs.size(), ms);
+
+    for (size_t i = 0; i < batch.size(); i++) {
+      batch[i]->ok = msgs[i].ok;
+    }
+  }
+
+  // Dispatches one batch, out of pending submissions
+  void dispatch(const bool full)
+  {
+    const size_t n = std::min(pending.size(), opts.max_batch);
+    const auto now = clock_t::now();
+
+    mb_stats_t ms;
+    run<false>(n, ms);
+    run<true>(n, ms);
+
+    uint64_t dsum = 0;
+    uint64_t dmax = 0;
+
+    for (size_t i = 0; i < n; i++) {
+      const auto d = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now - pending[i]->t_enq);
+      const uint64_t dns = static_cast<uint64_t>(std::max<int64_t>(
+        d.count(), 0));
+
+      dsum += dns;
+      dmax = std::max(dmax, dns);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(metrics_mtx);
+
+      stats.batches++;
+      stats.requests += n;
+      stats.full_batches += full;
+      stats.lane_calls += ms.calls;
+      stats.lanes_used += ms.used;
+      stats.delay_sum_ns += dsum;
+      stats.delay_max_ns = std::max(stats.delay_max_ns, dmax);
+    }
+
+    // request may be gone, as soon as its completion callback returns
+    for (size_t i = 0; i < n; i++) {
+      batch_req_t* const r = pending[i];
+      r->done(r, r->arg);
+    }
+
+    pending.erase(pending.begin(), pending.begin() + n);
+  }
+
+  void loop()
+  {
+    while (true) {
+      drain();
+
+      if (pending.empty()) {
+        if (stopping.load(std::memory_order_acquire)) {
+          return;
+        }
+
+        sleep(1, nullptr);
+        continue;
+      }
+
+      const auto due = pending.front()->t_enq + opts.deadline;
+
+      while ((pending.size() < opts.max_batch) && (clock_t::now() < due) &&
+             !stopping.load(std::memory_order_relaxed)) {
+        sleep(static_cast<int64_t>(opts.max_batch - pending.size()), &due);
+        drain();
+      }
+
+      dispatch(pending.size() >= opts.max_batch);
+    }
+  }
+
+  // Future based submission, living in scheduler's slab, along with shared
+  // state of its promise
+  struct future_req_t
+  {
+    batch_req_t req;
+    std::promise<batch_result_t> prom;
+    slab_pool_t* const pool;
+
+    explicit future_req_t(slab_pool_t* const pool_)
+      : prom(std::allocator_arg, slab_alloc_t<batch_result_t>(pool_))
+      , pool(pool_)
+    {
+    }
+
+    // Completion callback
+    static void done(batch_req_t* const r, void* const arg)
+    {
+      future_req_t* const fr = static_cast<future_req_t*>(arg);
+
+      batch_result_t res;
+      res.out = std::move(r->out);
+      std::memcpy(res.tag, r->tag, sizeof(res.tag));
+      res.ok = r->ok;
+
+      fr->prom.set_value(std::move(res));
+
+      slab_pool_t* const pool = fr->pool;
+      fr->~future_req_t();
+      pool->dealloc(reinterpret_cast<uint8_t*>(fr), sizeof(future_req_t));
+    }
+  };
+
+  std::future<batch_result_t> submit_future(const batch_op_t op,
+                                            const uint8_t* const nonce,
+                                            const uint8_t* const tag,
+                                            const uint8_t* const data,
+                                            const size_t dlen,
+                                            const uint8_t* const in,
+                                            const size_t len)
+  {
+    static_assert(alignof(future_req_t) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
+    uint8_t* const mem = slab->alloc(sizeof(future_req_t));
+    future_req_t* const fr = new (mem) future_req_t(slab);
+    auto fut = fr->prom.get_future();
+
+    batch_req_t& r = fr->req;
+    r.op = op;
+    std::memcpy(r.nonce, nonce, sizeof(r.nonce));
+    if (tag != nullptr) {
+      std::memcpy(r.tag, tag, tbytes);
+    }
+    r.data = data;
+    r.dlen = dlen;
+    r.in = in;
+    r.len = len;
+    r.done = future_req_t::done;
+    r.arg = fr;
+
+    submit(&r);
+    return fut;
+  }
+
+public:
+  // Spawns scheduler thread, serving submissions under given key context,
+  // which must outlive scheduler
+  explicit batch_scheduler_t(const key_ctx_t<slen, rounds>& ctx_,
+                             const batch_opts_t opts_ = {})
+    : opts{ opts_.deadline, std::max<size_t>(opts_.max_batch, 1) }
+    , slab(new slab_pool_t)
+    , tab(ctx_)
+  {
+    pending.reserve(opts.max_batch);
+    worker = std::thread([this]() { loop(); });
+  }
+
+  batch_scheduler_t(const batch_scheduler_t&) = delete;
+  batch_scheduler_t& operator=(const batch_scheduler_t&) = delete;
+
+  // Completes all submitted requests ( without waiting for deadlines ) &
+  // joins scheduler thread; output buffers handed out keep slab alive, so
+  // they can be freed after scheduler goes away
+  ~batch_scheduler_t()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping.store(true, std::memory_order_seq_cst);
+    }
+    cv.notify_one();
+
+    worker.join();
+    slab->release();
+  }
+
+  // Enqueues a request, without taking any lock; its `done` callback is
+  // invoked on scheduler thread, once it's processed
+  void submit(batch_req_t* const r)
+  {
+    r->t_enq = clock_t::now();
+    r->next = incoming.load(std::memory_order_relaxed);
+
+    while (!incoming.compare_exchange_weak(
+      r->next, r, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    }
+
+    // wake scheduler only once enough submissions are queued, taking mutex so
+    // that wakeup can't slip in between its check & wait
+    const int64_t q = queued.fetch_add(1, std::memory_order_seq_cst) + 1;
+    if (sleeping.load(std::memory_order_seq_cst) &&
+        (q >= want.load(std::memory_order_seq_cst))) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+      }
+      cv.notify_one();
+    }
+  }
+
+  // Enqueues encryption of M -bytes plain text & N -bytes associated data,
+  // which must stay alive until returned future is ready
+  std::future<batch_result_t> encrypt(
+    const uint8_t* const nonce, // 96 -bit nonce
+    const uint8_t* const data,  // N -bytes associated data
+    const size_t dlen,          // len(data) = N | >= 0
+    const uint8_t* const txt,   // M -bytes plain text
+    const size_t len            // len(txt) = M | >= 0
+  )
+  {
+    return submit_future(
+      batch_op_t::encrypt, nonce, nullptr, data, dlen, txt, len);
+  }
+
+  // Enqueues verified decryption of M -bytes cipher text & N -bytes
+  // associated data, which must stay alive until returned future is ready
+  std::future<batch_result_t> decrypt(
+    const uint8_t* const nonce, // 96 -bit nonce
+    const uint8_t* const tag,   // `tlen` -bit authentication tag
+    const uint8_t* const data,  // N -bytes associated data
+    const size_t dlen,          // len(data) = N | >= 0
+    const uint8_t* const enc,   // M -bytes cipher text
+    const size_t len            // len(enc) = M | >= 0
+  )
+  {
+    return submit_future(batch_op_t::decrypt, nonce, tag, data, dlen, enc, len);
+  }
+
+  // Snapshot of counters, so far
+  batch_metrics_t metrics() const
+  {
+    std::lock_guard<std::mutex> lock(metrics_mtx);
+    return stats;
+  }
+};
+
+}
+
+// Dumbo, Jumbo & Delirium flavours of batching scheduler, kept out of variant
+// headers, as each scheduler runs a thread of its own
+namespace dumbo {
+
+// Micro-batching scheduler of Dumbo {en, de}cryption submissions
+using batch_scheduler_t = elephant::batch_scheduler_t<SLEN, ROUNDS, TLEN>;
+
+}
+
+namespace jumbo {
+
+// Micro-batching scheduler of Jumbo {en, de}cryption submissions
+using batch_scheduler_t = elephant::batch_scheduler_t<SLEN, ROUNDS, TLEN>;
+
+}
+
+namespace delirium {
+
+// Micro-batching scheduler of Delirium {en, de}cryption submissions
+using batch_scheduler_t = elephant::batch_scheduler_t<SLEN, ROUNDS, TLEN>;
+
+}
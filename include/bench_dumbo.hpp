@@ -1,8 +1,16 @@
 #pragma once
+#include "async.hpp"
+#include "batch.hpp"
+#include "bench_perf.hpp"
 #include "dumbo.hpp"
+#include "io_pipeline.hpp"
+#include "steal.hpp"
 #include "utils.hpp"
 #include <benchmark/benchmark.h>
 #include <cassert>
+#include <random>
+#include <thread>
+#include <vector>
 
 // Benchmarks Elephant AEAD functions on CPU
 namespace bench_elephant {
@@ -31,6 +39,7 @@ dumbo_encrypt(benchmark::State& state)
   random_data(data, dlen);
   random_data(txt, ctlen);
 
+  perf_scope_t perf(state);
   for (auto _ : state) {
     dumbo::encrypt(key, nonce, data, dlen, txt, enc, ctlen, tag);
 
@@ -38,6 +47,8 @@ dumbo_encrypt(benchmark::State& state)
     benchmark::DoNotOptimize(tag);
     benchmark::ClobberMemory();
   }
+  perf.report(static_cast<double>(ctlen + dlen),
+              aead_perm_calls<dumbo::SLEN>(dlen, ctlen));
 
   bool f = dumbo::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
   assert(f);
@@ -84,6 +95,7 @@ dumbo_decrypt(benchmark::State& state)
 
   dumbo::encrypt(key, nonce, data, dlen, txt, enc, ctlen, tag);
 
+  perf_scope_t perf(state);
   for (auto _ : state) {
     bool f = dumbo::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
 
@@ -91,6 +103,8 @@ dumbo_decrypt(benchmark::State& state)
     benchmark::DoNotOptimize(f);
     benchmark::ClobberMemory();
   }
+  perf.report(static_cast<double>(ctlen + dlen),
+              aead_perm_calls<dumbo::SLEN>(dlen, ctlen));
 
   for (size_t i = 0; i < ctlen; i++) {
     assert((txt[i] ^ dec[i]) == 0);
@@ -108,4 +122,633 @@ dumbo_decrypt(benchmark::State& state)
   std::free(dec);
 }
 
+// Benchmark fixed-length ( compile-time message size ) Dumbo authenticated
+// encryption on CPU system
+template<const size_t dlen, const size_t ctlen>
+static void
+dumbo_encrypt_fixed(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+  constexpr size_t tlen = 8;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(nlen));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(tlen));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dlen));
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(ctlen));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(ctlen));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(ctlen));
+
+  random_data(key, klen);
+  random_data(nonce, nlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    dumbo::encrypt<dlen, ctlen>(key, nonce, data, txt, enc, tag);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(ctlen + dlen),
+              aead_perm_calls<dumbo::SLEN>(dlen, ctlen));
+
+  bool f = dumbo::decrypt(key, nonce, tag, data, dlen, enc, dec, ctlen);
+  assert(f);
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  const size_t per_itr = ctlen + dlen;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * per_itr));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
+// Benchmark fixed-length ( compile-time message size ) Dumbo verified
+// decryption on CPU system
+template<const size_t dlen, const size_t ctlen>
+static void
+dumbo_decrypt_fixed(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+  constexpr size_t tlen = 8;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(nlen));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(tlen));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dlen));
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(ctlen));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(ctlen));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(ctlen));
+
+  random_data(key, klen);
+  random_data(nonce, nlen);
+  random_data(data, dlen);
+  random_data(txt, ctlen);
+
+  dumbo::encrypt(key, nonce, data, dlen, txt, enc, ctlen, tag);
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    bool f = dumbo::decrypt<dlen, ctlen>(key, nonce, tag, data, enc, dec);
+
+    benchmark::DoNotOptimize(dec);
+    benchmark::DoNotOptimize(f);
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(ctlen + dlen),
+              aead_perm_calls<dumbo::SLEN>(dlen, ctlen));
+
+  for (size_t i = 0; i < ctlen; i++) {
+    assert((txt[i] ^ dec[i]) == 0);
+  }
+
+  const size_t per_itr = ctlen + dlen;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * per_itr));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+}
+
+// Benchmark Dumbo authentication-only ( MAC ) mode on CPU system, using
+// `state.range(1)` -many threads
+static void
+dumbo_mac(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+  constexpr size_t tlen = 8;
+
+  const size_t dlen = state.range(0);
+  const size_t nthreads = state.range(1);
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(nlen));
+  uint8_t* tag = static_cast<uint8_t*>(std::malloc(tlen));
+  uint8_t* data = static_cast<uint8_t*>(std::malloc(dlen));
+
+  random_data(key, klen);
+  random_data(nonce, nlen);
+  random_data(data, dlen);
+
+  dumbo::key_ctx_t ctx{ key };
+
+  // helpers run on process wide pool, which counters don't follow, so counts
+  // are normalized only when calling thread does all the work
+  const bool alone = nthreads == 1;
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    dumbo::mac(ctx, nonce, data, dlen, tag, nthreads);
+
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+  perf.report(alone ? static_cast<double>(dlen) : 0.,
+              alone ? ctx_perm_calls<dumbo::SLEN>(dlen, 0) : 0);
+
+  bool f = dumbo::mac_verify(ctx, nonce, tag, data, dlen, nthreads);
+  assert(f);
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * dlen));
+
+  std::free(key);
+  std::free(nonce);
+  std::free(tag);
+  std::free(data);
+}
+
+// Benchmark Dumbo file encryption, through I/O pipeline ( io_uring or
+// blocking I/O ), on local file, using all available cores
+//
+// Arguments: file length ( KiB ), queue depth, buffer length ( KiB ) & whether
+// to use io_uring.
+static void
+dumbo_pipeline_encrypt(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+
+  const size_t flen = static_cast<size_t>(state.range(0)) << 10;
+
+  elephant::io_pipeline_opts_t opts;
+  opts.queue_depth = state.range(1);
+  opts.buf_size = static_cast<size_t>(state.range(2)) << 10;
+  opts.use_uring = state.range(3) != 0;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(nlen));
+
+  random_data(key, klen);
+  random_data(nonce, nlen);
+
+  dumbo::key_ctx_t ctx{ key };
+  elephant::thread_pool_t pool;
+
+  const int in_fd = random_file(flen);
+  const int out_fd = random_file(0);
+  assert(in_fd >= 0 && out_fd >= 0);
+
+  for (auto _ : state) {
+    bool f = dumbo::pipeline_encrypt(ctx, nonce, in_fd, out_fd, pool, opts);
+    assert(f);
+
+    benchmark::DoNotOptimize(f);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * flen));
+
+  close(in_fd);
+  close(out_fd);
+
+  std::free(key);
+  std::free(nonce);
+}
+
+// Benchmark Dumbo file decryption, through I/O pipeline ( io_uring or
+// blocking I/O ), on local file, using all available cores
+//
+// Arguments: file length ( KiB ), queue depth, buffer length ( KiB ) & whether
+// to use io_uring.
+static void
+dumbo_pipeline_decrypt(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+
+  const size_t flen = static_cast<size_t>(state.range(0)) << 10;
+
+  elephant::io_pipeline_opts_t opts;
+  opts.queue_depth = state.range(1);
+  opts.buf_size = static_cast<size_t>(state.range(2)) << 10;
+  opts.use_uring = state.range(3) != 0;
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* nonce = static_cast<uint8_t*>(std::malloc(nlen));
+
+  random_data(key, klen);
+  random_data(nonce, nlen);
+
+  dumbo::key_ctx_t ctx{ key };
+  elephant::thread_pool_t pool;
+
+  const int txt_fd = random_file(flen);
+  const int enc_fd = random_file(0);
+  const int out_fd = random_file(0);
+  assert(txt_fd >= 0 && enc_fd >= 0 && out_fd >= 0);
+
+  bool f = dumbo::pipeline_encrypt(ctx, nonce, txt_fd, enc_fd, pool, opts);
+  assert(f);
+
+  for (auto _ : state) {
+    f = dumbo::pipeline_decrypt(ctx, enc_fd, out_fd, pool, opts);
+    assert(f);
+
+    benchmark::DoNotOptimize(f);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * flen));
+
+  close(txt_fd);
+  close(enc_fd);
+  close(out_fd);
+
+  std::free(key);
+  std::free(nonce);
+}
+
+// Benchmark Dumbo sector encryption, with all sectors sharing one key
+// context & mask table
+//
+// Arguments: sector length, # -of consecutive sectors & # -of threads.
+static void
+dumbo_encrypt_sectors(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t tlen = 8;
+
+  const size_t seclen = state.range(0);
+  const size_t cnt = state.range(1);
+  const size_t nthreads = state.range(2);
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(seclen * cnt));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(seclen * cnt));
+  uint8_t* dec = static_cast<uint8_t*>(std::malloc(seclen * cnt));
+  uint8_t* tags = static_cast<uint8_t*>(std::malloc(tlen * cnt));
+  uint32_t* gens = static_cast<uint32_t*>(std::calloc(cnt, sizeof(uint32_t)));
+
+  random_data(key, klen);
+  random_data(txt, seclen * cnt);
+
+  dumbo::key_ctx_t ctx{ key };
+  dumbo::sector_table_t tab{ ctx, seclen };
+
+  // helpers run on process wide pool, which counters don't follow, so counts
+  // are normalized only when calling thread does all the work
+  const bool alone = nthreads == 1;
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    dumbo::encrypt_sectors(tab, 0, gens, txt, enc, cnt, tags, nthreads);
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tags);
+    benchmark::ClobberMemory();
+  }
+  perf.report(alone ? static_cast<double>(seclen * cnt) : 0.,
+              alone ? cnt * ctx_perm_calls<dumbo::SLEN>(0, seclen) : 0);
+
+  bool f = false;
+  f = dumbo::decrypt_sectors(tab, 0, gens, tags, enc, dec, cnt, nthreads);
+  assert(f);
+
+  const size_t bytes = seclen * cnt;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+
+  std::free(key);
+  std::free(txt);
+  std::free(enc);
+  std::free(dec);
+  std::free(tags);
+  std::free(gens);
+}
+
+// Benchmark Dumbo sector encryption, one sector at a time, using key context
+// ( i.e. without multi-state permutation & mask table ), as baseline
+//
+// Arguments: sector length & # -of consecutive sectors.
+static void
+dumbo_encrypt_sectors_serial(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t tlen = 8;
+
+  const size_t seclen = state.range(0);
+  const size_t cnt = state.range(1);
+
+  uint8_t* key = static_cast<uint8_t*>(std::malloc(klen));
+  uint8_t* txt = static_cast<uint8_t*>(std::malloc(seclen * cnt));
+  uint8_t* enc = static_cast<uint8_t*>(std::malloc(seclen * cnt));
+  uint8_t* tags = static_cast<uint8_t*>(std::malloc(tlen * cnt));
+
+  random_data(key, klen);
+  random_data(txt, seclen * cnt);
+
+  dumbo::key_ctx_t ctx{ key };
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    for (size_t i = 0; i < cnt; i++) {
+      uint8_t nonce[12];
+      elephant::sector_nonce(i, 0, nonce);
+
+      // empty associated data
+      dumbo::encrypt(ctx,
+                     nonce,
+                     txt,
+                     0,
+                     txt + i * seclen,
+                     enc + i * seclen,
+                     seclen,
+                     tags + i * tlen);
+    }
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tags);
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(seclen * cnt),
+              cnt * ctx_perm_calls<dumbo::SLEN>(0, seclen));
+
+  const size_t bytes = seclen * cnt;
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+
+  std::free(key);
+  std::free(txt);
+  std::free(enc);
+  std::free(tags);
+}
+
+// Benchmark awaitable Dumbo encryption, driving a coroutine which awaits
+// `async_encrypt` to completion, with M -bytes plain text & 32 -bytes
+// associated data, on pool of T -many workers | M = state.range(0), T =
+// state.range(1)
+//
+// Messages of at most 16 KiB complete inline, without suspending.
+static void
+dumbo_async_encrypt(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+  constexpr size_t tlen = 8;
+  constexpr size_t dlen = 32;
+
+  const size_t ctlen = state.range(0);
+  const size_t nworkers = state.range(1);
+
+  std::vector<uint8_t> key(klen), nonce(nlen), tag(tlen), data(dlen);
+  std::vector<uint8_t> txt(ctlen), enc(ctlen), dec(ctlen);
+
+  random_data(key.data(), klen);
+  random_data(nonce.data(), nlen);
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  dumbo::key_ctx_t ctx{ key.data() };
+  // opened before workers are spawned, so that they're counted too
+  perf_scope_t perf(state);
+  elephant::async_pool_t pool(nworkers);
+
+  auto task = [&]() -> elephant::task_t<> {
+    co_await dumbo::async_encrypt(ctx,
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc.data(),
+                                  ctlen,
+                                  tag.data(),
+                                  pool);
+  };
+
+  perf.restart();
+  for (auto _ : state) {
+    task().sync_wait();
+
+    benchmark::DoNotOptimize(enc.data());
+    benchmark::DoNotOptimize(tag.data());
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(dlen + ctlen),
+              ctx_perm_calls<dumbo::SLEN>(dlen, ctlen));
+
+  bool f = dumbo::decrypt(ctx,
+                          nonce.data(),
+                          tag.data(),
+                          data.data(),
+                          dlen,
+                          enc.data(),
+                          dec.data(),
+                          ctlen);
+  assert(f);
+  assert(txt == dec);
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(state.iterations() * (dlen + ctlen)));
+}
+
+// Benchmark Dumbo micro-batching scheduler, where P -many producer threads
+// submit 256 messages each ( M -bytes plain text & 16 -bytes associated data,
+// every one under its own nonce ), with batches held for at most D µs | M =
+// state.range(0), P = state.range(1), D = state.range(2)
+//
+// Reports mean batch size, lane fill ratio & mean queueing delay, so that
+// deadline can be tuned.
+static void
+dumbo_batch_encrypt(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t dlen = 16;
+  constexpr size_t per_producer = 256;
+
+  const size_t ctlen = state.range(0);
+  const size_t producers = state.range(1);
+  const auto deadline = std::chrono::microseconds(state.range(2));
+
+  std::vector<uint8_t> key(klen), data(dlen), txt(ctlen);
+  random_data(key.data(), klen);
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  dumbo::key_ctx_t ctx{ key.data() };
+
+  // opened before scheduler's thread is spawned, so that it's counted too
+  perf_scope_t perf(state);
+  dumbo::batch_scheduler_t sched{ ctx, { deadline, 4 * elephant::LANES } };
+
+  std::vector<elephant::batch_req_t> reqs(producers * per_producer);
+  for (size_t i = 0; i < reqs.size(); i++) {
+    random_data(reqs[i].nonce, sizeof(reqs[i].nonce));
+    reqs[i].data = data.data();
+    reqs[i].dlen = dlen;
+    reqs[i].in = txt.data();
+    reqs[i].len = ctlen;
+  }
+
+  std::atomic<size_t> left{ 0 };
+  auto done = [](elephant::batch_req_t* const r, void* const arg) {
+    r->out.reset();
+    static_cast<std::atomic<size_t>*>(arg)->fetch_sub(1);
+  };
+
+  const double nreqs = static_cast<double>(reqs.size());
+
+  perf.restart();
+  for (auto _ : state) {
+    left.store(reqs.size());
+
+    std::vector<std::thread> ths;
+    for (size_t p = 0; p < producers; p++) {
+      ths.emplace_back([&, p]() {
+        for (size_t i = 0; i < per_producer; i++) {
+          elephant::batch_req_t& r = reqs[p * per_producer + i];
+          r.done = done;
+          r.arg = &left;
+          sched.submit(&r);
+        }
+      });
+    }
+
+    for (auto& t : ths) {
+      t.join();
+    }
+    while (left.load() > 0) {
+      std::this_thread::yield();
+    }
+  }
+  perf.report(nreqs * (dlen + ctlen),
+              nreqs * ctx_perm_calls<dumbo::SLEN>(dlen, ctlen),
+              nreqs);
+
+  const auto m = sched.metrics();
+
+  state.counters["batch"] = m.mean_batch();
+  state.counters["fill"] = m.fill_ratio();
+  state.counters["delay_us"] = m.mean_delay_ns() / 1e3;
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() *
+                                               reqs.size()));
+  state.SetBytesProcessed(static_cast<int64_t>(
+    state.iterations() * reqs.size() * (dlen + ctlen)));
+}
+
+// Benchmark Dumbo batch job over skewed record size distribution ( mostly
+// small records, few medium ones & handful of huge ones, under 4 keys ), on
+// given # -of threads, either statically partitioned into equal count slices
+// ( mode = 0 ) or on work-stealing executor ( mode = 1 )
+static void
+dumbo_steal_batch(benchmark::State& state)
+{
+  constexpr size_t klen = 16;
+  constexpr size_t nlen = 12;
+  constexpr size_t tlen = 8;
+  constexpr size_t nkeys = 4;
+  constexpr size_t nrecs = 256;
+
+  const size_t nthreads = state.range(0);
+  const bool stealing = state.range(1) != 0;
+
+  // huge records up front, so that static partitioning hands them all to one
+  // thread, as it happens with tables sorted by insertion time
+  std::mt19937_64 rng(nrecs);
+  std::vector<size_t> lens(nrecs);
+  for (size_t i = 0; i < nrecs; i++) {
+    if (i < 4) {
+      lens[i] = 1ul << 14;
+    } else if (i % 32 == 0) {
+      lens[i] = 1024 + rng() % 3072;
+    } else {
+      lens[i] = 64 + rng() % 448;
+    }
+  }
+
+  std::vector<uint8_t> keys(nkeys * klen);
+  random_data(keys.data(), keys.size());
+
+  std::vector<std::vector<uint8_t>> txt(nrecs), enc(nrecs);
+  std::vector<uint8_t> nonces(nrecs * nlen), tags(nrecs * tlen);
+  std::vector<elephant::ws_record_t> recs(nrecs);
+  random_data(nonces.data(), nonces.size());
+
+  size_t bytes = 0, perms = 0;
+  for (size_t i = 0; i < nrecs; i++) {
+    txt[i].resize(lens[i]);
+    enc[i].resize(lens[i]);
+    random_data(txt[i].data(), lens[i]);
+
+    const size_t k = i % nkeys;
+
+    recs[i].key_id = k;
+    recs[i].key = keys.data() + k * klen;
+    recs[i].nonce = nonces.data() + i * nlen;
+    recs[i].in = txt[i].data();
+    recs[i].out = enc[i].data();
+    recs[i].len = lens[i];
+    recs[i].tag = tags.data() + i * tlen;
+
+    bytes += lens[i];
+    perms += ctx_perm_calls<dumbo::SLEN>(0, lens[i]);
+  }
+
+  std::vector<dumbo::key_ctx_t> ctxs(nkeys);
+  for (size_t k = 0; k < nkeys; k++) {
+    ctxs[k].init(keys.data() + k * klen);
+  }
+
+  // huge records are split into 4 KiB parts, so that they can be spread
+  elephant::ws_opts_t opts;
+  opts.part_len = 1ul << 12;
+
+  // opened before executor's workers are spawned, so that they're counted too
+  perf_scope_t perf(state);
+  dumbo::ws_executor_t ex{ nthreads, opts };
+
+  perf.restart();
+  for (auto _ : state) {
+    if (stealing) {
+      ex.encrypt(recs.data(), nrecs);
+    } else {
+      std::vector<std::thread> ths;
+      for (size_t t = 0; t < nthreads; t++) {
+        ths.emplace_back([&, t]() {
+          const size_t s = (nrecs * t) / nthreads;
+          const size_t e = (nrecs * (t + 1)) / nthreads;
+
+          for (size_t i = s; i < e; i++) {
+            const elephant::ws_record_t& r = recs[i];
+            dumbo::encrypt(
+              ctxs[r.key_id], r.nonce, r.data, 0, r.in, r.out, r.len, r.tag);
+          }
+        });
+      }
+
+      for (auto& t : ths) {
+        t.join();
+      }
+    }
+
+    benchmark::DoNotOptimize(tags.data());
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(bytes), static_cast<double>(perms), nrecs);
+
+  if (stealing) {
+    const auto s = ex.stats();
+
+    state.counters["steals"] = static_cast<double>(s.steals);
+    state.counters["fill"] = s.lanes.fill_ratio();
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nrecs));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
 }
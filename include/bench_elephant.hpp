@@ -2,4 +2,5 @@
 #include "bench_delirium.hpp"
 #include "bench_dumbo.hpp"
 #include "bench_jumbo.hpp"
+#include "bench_nonce.hpp"
 #include "bench_permutation.hpp"
@@ -0,0 +1,354 @@
+#pragma once
+#include "aead.hpp"
+#include "bench_tsc.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <bit>
+#include <cassert>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Latency distribution benchmarks of Elephant AEAD, timing individual {en,
+// de}cryption calls, for small message request paths
+namespace bench_elephant {
+
+// HDR-style ( log-linear ) histogram of 64 -bit values, keeping 2^k -many
+// linear buckets per power of two, so that values are recorded with relative
+// error < 2^-k, in constant time & memory, no matter how long tail gets
+//
+// Values < 2^(k + 1) get a bucket each, while value v with most significant
+// bit m ( >= k + 1 ) lands in bucket (m - k) * 2^k + (v >> (m - k)).
+template<const size_t k = 7>
+class latency_hist_t
+{
+public:
+  static constexpr size_t sub = size_t{ 1 } << k;
+
+  latency_hist_t()
+    : counts((64 - k + 1) * sub)
+  {
+  }
+
+  // Records one value
+  inline void record(const uint64_t v)
+  {
+    counts[index(v)]++;
+    total++;
+    vmin = std::min(vmin, v);
+    vmax = std::max(vmax, v);
+    sum += static_cast<double>(v);
+    sumsq += static_cast<double>(v) * static_cast<double>(v);
+  }
+
+  inline uint64_t count() const { return total; }
+  inline uint64_t min() const { return total == 0 ? 0 : vmin; }
+  inline uint64_t max() const { return vmax; }
+  inline double mean() const { return total == 0 ? 0. : sum / total; }
+
+  inline double stddev() const
+  {
+    const double m = mean();
+    return total == 0 ? 0. : std::sqrt(std::max(0., sumsq / total - m * m));
+  }
+
+  // Smallest ( highest equivalent ) value, which at least `p` percent of
+  // recorded values don't exceed | p ∈ [0, 100]
+  uint64_t percentile(const double p) const
+  {
+    if (total == 0) {
+      return 0;
+    }
+
+    const double want = std::max(1., std::ceil(p / 100. * total));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+      seen += counts[i];
+      if (static_cast<double>(seen) >= want) {
+        return std::min(highest_equivalent(i), vmax);
+      }
+    }
+
+    return vmax;
+  }
+
+  // Writes percentile distribution, in HdrHistogram's .hgrm text format, with
+  // values scaled by `scale` ( say TSC cycles to nanoseconds )
+  void write_hgrm(std::FILE* const fd, const double scale) const
+  {
+    std::fprintf(fd,
+                 "%12s %14s %10s %14s\n\n",
+                 "Value",
+                 "Percentile",
+                 "TotalCount",
+                 "1/(1-Percentile)");
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < counts.size(); i++) {
+      if (counts[i] == 0) {
+        continue;
+      }
+      seen += counts[i];
+
+      const double q = static_cast<double>(seen) / total;
+      const double v = std::min(highest_equivalent(i), vmax) * scale;
+
+      if (seen < total) {
+        std::fprintf(fd,
+                     "%12.3f %2.12f %10" PRIu64 " %14.2f\n",
+                     v,
+                     q,
+                     seen,
+                     1. / (1. - q));
+      } else {
+        std::fprintf(fd, "%12.3f %2.12f %10" PRIu64 "\n", v, q, seen);
+      }
+    }
+
+    std::fprintf(fd,
+                 "#[Mean    = %12.3f, StdDeviation   = %12.3f]\n"
+                 "#[Max     = %12.3f, Total count    = %12" PRIu64 "]\n",
+                 mean() * scale,
+                 stddev() * scale,
+                 vmax * scale,
+                 total);
+  }
+
+private:
+  std::vector<uint64_t> counts;
+  uint64_t total = 0;
+  uint64_t vmin = UINT64_MAX;
+  uint64_t vmax = 0;
+  double sum = 0;
+  double sumsq = 0;
+
+  static inline size_t index(const uint64_t v)
+  {
+    if (v < 2 * sub) {
+      return static_cast<size_t>(v);
+    }
+
+    const size_t m = static_cast<size_t>(std::bit_width(v)) - 1;
+    const size_t shift = m - k;
+    return shift * sub + static_cast<size_t>(v >> shift);
+  }
+
+  static inline uint64_t highest_equivalent(const size_t i)
+  {
+    if (i < 2 * sub) {
+      return i;
+    }
+
+    const size_t shift = i / sub - 1;
+    const uint64_t top = i - shift * sub;
+    return ((top + 1) << shift) - 1;
+  }
+};
+
+// Knobs of latency benchmarks, set from command line, see bench/latency.cpp
+struct latency_opts_t
+{
+  size_t scrub_len = size_t{ 8 } << 20; // bytes touched between cold calls
+  std::string hgrm_dir;                 // where .hgrm files go, if non-empty
+};
+
+inline latency_opts_t&
+latency_opts()
+{
+  static latency_opts_t opts;
+  return opts;
+}
+
+// Evicts [ptr, ptr + len) from all cache levels
+inline void
+flush_range(const void* const ptr, const size_t len)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  const auto* const p = static_cast<const char*>(ptr);
+  for (size_t off = 0; off < len; off += 64) {
+    _mm_clflush(p + off);
+  }
+  if (len > 0) {
+    _mm_clflush(p + len - 1);
+  }
+  _mm_mfence();
+#else
+  (void)ptr;
+  (void)len;
+#endif
+}
+
+// Benchmarks latency of individual Dumbo/ Jumbo/ Delirium encryption ( or
+// verified decryption ) calls, on message with range(0) -bytes associated
+// data & range(1) -bytes text, each timed using rdtscp & recorded in
+// histogram, whose p50, p90, p99, p99.9 & max ( along with mean ) are reported
+// in nanoseconds
+//
+// When range(2) is non-zero, caches are made cold before every call, by
+// flushing its buffers out of all cache levels & touching a large scrub buffer
+// ( evicting permutation tables, stack & code out of private caches );
+// otherwise calls run back to back, after warming up.
+//
+// `name` is used for naming .hgrm file, if asked for, see `latency_opts_t`.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+static void
+aead_latency(benchmark::State& state, const std::string& name)
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t dlen = static_cast<size_t>(state.range(0));
+  const size_t ctlen = static_cast<size_t>(state.range(1));
+  const bool cold = state.range(2) != 0;
+
+  std::vector<uint8_t> key(16), nonce(12), tag(tbytes);
+  std::vector<uint8_t> data(dlen), txt(ctlen), enc(ctlen), dec(ctlen);
+
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  auto call = [&] {
+    if constexpr (decrypting) {
+      return elephant::decrypt<slen, rounds, tlen>(key.data(),
+                                                   nonce.data(),
+                                                   tag.data(),
+                                                   data.data(),
+                                                   dlen,
+                                                   enc.data(),
+                                                   dec.data(),
+                                                   ctlen);
+    } else {
+      elephant::encrypt<slen, rounds, tlen>(key.data(),
+                                            nonce.data(),
+                                            data.data(),
+                                            dlen,
+                                            txt.data(),
+                                            enc.data(),
+                                            ctlen,
+                                            tag.data());
+      return true;
+    }
+  };
+
+  elephant::encrypt<slen, rounds, tlen>(key.data(),
+                                        nonce.data(),
+                                        data.data(),
+                                        dlen,
+                                        txt.data(),
+                                        enc.data(),
+                                        ctlen,
+                                        tag.data());
+
+  std::vector<uint8_t> scrub(cold ? latency_opts().scrub_len : 0);
+  auto make_cold = [&] {
+    for (size_t i = 0; i < scrub.size(); i += 64) {
+      scrub[i]++;
+    }
+    benchmark::DoNotOptimize(scrub.data());
+
+    for (auto* v : { &key, &nonce, &tag, &data, &txt, &enc, &dec }) {
+      flush_range(v->data(), v->size());
+    }
+  };
+
+  // cost of timing an empty region, subtracted from every sample
+  uint64_t ovh = UINT64_MAX;
+  for (size_t i = 0; i < 1000; i++) {
+    const uint64_t t0 = tsc_begin();
+    const uint64_t t1 = tsc_end();
+    ovh = std::min(ovh, t1 - t0);
+  }
+
+  if (!cold) {
+    for (size_t i = 0; i < 100; i++) {
+      benchmark::DoNotOptimize(call());
+    }
+  }
+
+  latency_hist_t hist;
+  bool ok = true;
+
+  for (auto _ : state) {
+    if (cold) {
+      state.PauseTiming();
+      make_cold();
+      state.ResumeTiming();
+    }
+
+    const uint64_t t0 = tsc_begin();
+    const bool f = call();
+    const uint64_t t1 = tsc_end();
+
+    benchmark::DoNotOptimize(f);
+    ok = ok && f;
+    hist.record(t1 - t0 > ovh ? t1 - t0 - ovh : 0);
+  }
+
+  assert(ok);
+  if constexpr (decrypting) {
+    assert(dec == txt);
+  }
+  (void)ok;
+
+  const double ns = 1e9 / tsc_hz();
+
+  state.counters["mean"] = hist.mean() * ns;
+  state.counters["p50"] = hist.percentile(50) * ns;
+  state.counters["p90"] = hist.percentile(90) * ns;
+  state.counters["p99"] = hist.percentile(99) * ns;
+  state.counters["p99.9"] = hist.percentile(99.9) * ns;
+  state.counters["max"] = hist.max() * ns;
+  state.SetBytesProcessed(
+    static_cast<int64_t>(state.iterations() * (dlen + ctlen)));
+
+  const std::string& dir = latency_opts().hgrm_dir;
+  if (!dir.empty()) {
+    std::string file = name + "_ad=" + std::to_string(dlen) +
+                       "_msg=" + std::to_string(ctlen) +
+                       "_cold=" + std::to_string(cold ? 1 : 0);
+    std::replace(file.begin(), file.end(), '/', '_');
+
+    const std::string path = dir + "/" + file + ".hgrm";
+
+    std::FILE* const fd = std::fopen(path.c_str(), "w");
+    if (fd != nullptr) {
+      hist.write_hgrm(fd, ns);
+      std::fclose(fd);
+    }
+  }
+}
+
+// Registers latency benchmarks of encryption & decryption, for one Elephant
+// variant, named `{name}/{encrypt, decrypt}/latency`, over given associated
+// data & text lengths, with warm & cold caches, taking `samples` -many
+// samples each
+template<const size_t slen, const size_t rounds, const size_t tlen>
+void
+register_latency(const std::string& name,
+                 const std::vector<int64_t>& dlens,
+                 const std::vector<int64_t>& ctlens,
+                 const int64_t samples)
+{
+  auto add = [&](const char* const op, auto fn) {
+    const std::string bname = name + "/" + op + "/latency";
+
+    benchmark::RegisterBenchmark(bname.c_str(), fn, bname)
+      ->ArgsProduct({ dlens, ctlens, { 0, 1 } })
+      ->ArgNames({ "ad", "msg", "cold" })
+      ->Iterations(samples)
+      ->Unit(benchmark::kMicrosecond);
+  };
+
+  add("encrypt", aead_latency<slen, rounds, tlen, false>);
+  add("decrypt", aead_latency<slen, rounds, tlen, true>);
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "bench_perf.hpp"
+#include "nonce.hpp"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <mutex>
+
+// Benchmarks Elephant AEAD functions on CPU
+namespace bench_elephant {
+
+// Generator shared by all threads of a nonce benchmark, in counter mode, so
+// that it never runs out
+static elephant::nonce_gen_t&
+shared_nonce_gen(const uint64_t lease_len)
+{
+  static std::mutex mtx;
+  static std::unique_ptr<elephant::nonce_gen_t> gen;
+  static uint64_t cur_lease = 0;
+
+  std::lock_guard<std::mutex> lock(mtx);
+  if (!gen || cur_lease != lease_len) {
+    gen = std::make_unique<elephant::nonce_gen_t>(
+      elephant::nonce_mode_t::counter, 0, lease_len);
+    cur_lease = lease_len;
+  }
+
+  return *gen;
+}
+
+// Benchmark handing out nonces from explicit per-thread leases of shared
+// generator, under contention of `state.threads()` -many threads
+//
+// Argument: lease length ( 1 means every nonce hits shared counter ).
+static void
+nonce_lease(benchmark::State& state)
+{
+  const uint64_t lease_len = state.range(0);
+
+  elephant::nonce_gen_t& gen = shared_nonce_gen(lease_len);
+  elephant::nonce_gen_t::lease_t lease;
+  uint8_t nonce[12];
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    bool f = gen.next(lease, nonce);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(nonce);
+  }
+  perf.report(0, 0, 1);
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmark handing out nonces from thread local leases of shared generator,
+// under contention of `state.threads()` -many threads
+//
+// Argument: lease length.
+static void
+nonce_tls(benchmark::State& state)
+{
+  const uint64_t lease_len = state.range(0);
+
+  elephant::nonce_gen_t& gen = shared_nonce_gen(lease_len);
+  uint8_t nonce[12];
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    bool f = gen.next(nonce);
+
+    benchmark::DoNotOptimize(f);
+    benchmark::DoNotOptimize(nonce);
+  }
+  perf.report(0, 0, 1);
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmark mutex protected nonce counter, under contention of
+// `state.threads()` -many threads, as baseline
+static void
+nonce_mutex(benchmark::State& state)
+{
+  static std::mutex mtx;
+  static uint64_t ctr = 0;
+
+  uint8_t nonce[12]{};
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    uint64_t c;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      c = ctr++;
+    }
+    std::memcpy(nonce + 4, &c, sizeof(c));
+
+    benchmark::DoNotOptimize(nonce);
+  }
+  perf.report(0, 0, 1);
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+}
@@ -0,0 +1,308 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__NR_perf_event_open)
+#define ELEPHANT_HAS_PERF_EVENT
+#endif
+#endif
+
+// Optional hardware performance counters ( opened using raw perf_event_open
+// system call, no external tools needed ), reported as google-benchmark user
+// counters, when environment variable ELEPHANT_PERF is set ( to anything but
+// 0 )
+namespace bench_elephant {
+
+// Hardware event to be counted, see perf_event_open(2)
+struct perf_event_desc_t
+{
+  const char* name; // user counter name prefix
+  uint32_t type;    // PERF_TYPE_*
+  uint64_t config;  // event of given type
+};
+
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+
+// CPU cycles, retired instructions, mispredicted branches & L1 data cache
+// read misses, named same as perf(1) does
+inline const std::vector<perf_event_desc_t>&
+default_perf_events()
+{
+  static const std::vector<perf_event_desc_t> events{
+    { "cpu-cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { "L1-dcache-load-misses",
+      PERF_TYPE_HW_CACHE,
+      PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+        (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+  };
+
+  return events;
+}
+
+#else
+
+inline const std::vector<perf_event_desc_t>&
+default_perf_events()
+{
+  static const std::vector<perf_event_desc_t> events;
+  return events;
+}
+
+#endif
+
+// Set of counters of user space events, counting calling thread ( & threads
+// it spawns, while counters are open ), each opened on its own, so that ones
+// which can't be opened ( say unsupported on this CPU/ hypervisor, or denied
+// by perf_event_paranoid ) are just left out
+class perf_counters_t
+{
+public:
+  explicit perf_counters_t(
+    const std::vector<perf_event_desc_t>& events = default_perf_events())
+  {
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+    for (const auto& ev : events) {
+      perf_event_attr attr{};
+      attr.size = sizeof(attr);
+      attr.type = ev.type;
+      attr.config = ev.config;
+      attr.disabled = 1;
+      attr.inherit = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      const long fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      if (fd >= 0) {
+        ctrs.push_back({ ev.name, static_cast<int>(fd) });
+      }
+    }
+#else
+    (void)events;
+#endif
+  }
+
+  perf_counters_t(const perf_counters_t&) = delete;
+  perf_counters_t& operator=(const perf_counters_t&) = delete;
+
+  ~perf_counters_t()
+  {
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+    for (const auto& c : ctrs) {
+      close(c.fd);
+    }
+#endif
+  }
+
+  // Whether at least one counter could be opened
+  inline bool available() const { return !ctrs.empty(); }
+
+  // Zeroes & starts all counters
+  void start()
+  {
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+    for (const auto& c : ctrs) {
+      ioctl(c.fd, PERF_EVENT_IOC_RESET, 0);
+      ioctl(c.fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+  }
+
+  // Stops all counters
+  void stop()
+  {
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+    for (const auto& c : ctrs) {
+      ioctl(c.fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+  }
+
+  // Counts since last `start`, scaled up, when kernel had to multiplex
+  // counters ( i.e. they weren't running all the time they were enabled )
+  std::vector<std::pair<const char*, double>> read() const
+  {
+    std::vector<std::pair<const char*, double>> res;
+
+#if defined(ELEPHANT_HAS_PERF_EVENT)
+    for (const auto& c : ctrs) {
+      uint64_t vals[3]{}; // value, time enabled, time running
+
+      const ssize_t n = ::read(c.fd, vals, sizeof(vals));
+      if ((n != static_cast<ssize_t>(sizeof(vals))) || (vals[2] == 0)) {
+        continue;
+      }
+
+      const double scale = static_cast<double>(vals[1]) / vals[2];
+      res.emplace_back(c.name, static_cast<double>(vals[0]) * scale);
+    }
+#endif
+
+    return res;
+  }
+
+private:
+  struct counter_t
+  {
+    const char* name;
+    int fd;
+  };
+
+  std::vector<counter_t> ctrs;
+};
+
+// Whether hardware counters were asked for, using ELEPHANT_PERF environment
+// variable
+inline bool
+perf_enabled()
+{
+  static const bool enabled = [] {
+    const char* const v = std::getenv("ELEPHANT_PERF");
+    return (v != nullptr) && (std::strcmp(v, "") != 0) &&
+           (std::strcmp(v, "0") != 0);
+  }();
+
+  return enabled;
+}
+
+// # -of permutation calls reference `encrypt`/ `decrypt` make on message with
+// N -bytes associated data & M -bytes text, expanding key four times
+template<const size_t slen>
+constexpr size_t
+aead_perm_calls(const size_t dlen, const size_t ctlen)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t ks_blks = (ctlen + sbytes - 1) / sbytes;
+  const size_t ad_blks = (12 + dlen + 1 + sbytes - 1) / sbytes - 1;
+  const size_t ct_blks = (ctlen + 1 + sbytes - 1) / sbytes;
+
+  return 4 + ks_blks + ad_blks + ct_blks + 1;
+}
+
+// # -of permutation calls {en, de}crypting same message takes, when key was
+// already expanded, in key context ( see `elephant::key_ctx_t` )
+template<const size_t slen>
+constexpr size_t
+ctx_perm_calls(const size_t dlen, const size_t ctlen)
+{
+  return aead_perm_calls<slen>(dlen, ctlen) - 4;
+}
+
+// Hardware counters around benchmark loop, opened ( & started ) on
+// construction, when enabled, & reported as user counters `{event}/byte`,
+// `{event}/perm` & `{event}/op` ( along with IPC ), by `report`, which must be
+// called right after benchmark loop
+//
+// Counters follow only threads spawned after they were opened, so benchmarks
+// driving worker threads open scope before starting workers & `restart` it
+// right before benchmark loop, leaving setup out. In multi-threaded benchmarks
+// ( see `ThreadRange` ) every thread has its own scope & counters are averaged
+// over threads.
+//
+// When counters are enabled, but none of them could be opened, it's noted on
+// stderr, once, while benchmarks run as usual.
+class perf_scope_t
+{
+public:
+  explicit perf_scope_t(benchmark::State& state_)
+    : state(state_)
+  {
+    if (!perf_enabled()) {
+      return;
+    }
+
+    ctrs = std::make_unique<perf_counters_t>();
+    if (!ctrs->available()) {
+      static const bool noted = [] {
+        std::fputs("note: ELEPHANT_PERF is set, but no hardware counter "
+                   "could be opened ( see perf_event_paranoid ), skipping\n",
+                   stderr);
+        return true;
+      }();
+      (void)noted;
+
+      ctrs.reset();
+      return;
+    }
+
+    ctrs->start();
+  }
+
+  // Zeroes counters & starts them again, say once workers are up
+  void restart()
+  {
+    if (ctrs != nullptr) {
+      ctrs->start();
+    }
+  }
+
+  // Stops counters & reports them, normalized by `bytes`, `perms` ( say
+  // permutation calls ) & `ops` ( say messages ) processed per iteration of
+  // benchmark loop, skipping ones which are zero
+  void report(const double bytes, const double perms, const double ops = 0)
+  {
+    if (ctrs == nullptr) {
+      return;
+    }
+
+    ctrs->stop();
+
+    const double itrs = static_cast<double>(state.iterations());
+    double cycles = 0, instrs = 0;
+
+    for (const auto& [name, count] : ctrs->read()) {
+      const double per_itr = count / itrs;
+      const std::string key(name);
+
+      if (bytes > 0) {
+        state.counters[key + "/byte"] = avg(per_itr / bytes);
+      }
+      if (perms > 0) {
+        state.counters[key + "/perm"] = avg(per_itr / perms);
+      }
+      if (ops > 0) {
+        state.counters[key + "/op"] = avg(per_itr / ops);
+      }
+
+      if (key == "cpu-cycles") {
+        cycles = count;
+      } else if (key == "instructions") {
+        instrs = count;
+      }
+    }
+
+    if ((cycles > 0) && (instrs > 0)) {
+      state.counters["IPC"] = avg(instrs / cycles);
+    }
+
+    ctrs.reset();
+  }
+
+private:
+  benchmark::State& state;
+  std::unique_ptr<perf_counters_t> ctrs;
+
+  // Counter averaged over threads running benchmark, instead of summed
+  static benchmark::Counter avg(const double v)
+  {
+    return benchmark::Counter(v, benchmark::Counter::kAvgThreads);
+  }
+};
+
+}
@@ -1,4 +1,6 @@
 #pragma once
+#include "bench_perf.hpp"
+#include "bulk.hpp"
 #include "keccak.hpp"
 #include "spongent.hpp"
 #include "utils.hpp"
@@ -18,12 +20,14 @@ spongent_permutation(benchmark::State& state)
   uint8_t st[sbytes]{};
   random_data(st, sizeof(st));
 
+  perf_scope_t perf(state);
   for (auto _ : state) {
     spongent::permute<slen, rounds>(st);
 
     benchmark::DoNotOptimize(st);
     benchmark::ClobberMemory();
   }
+  perf.report(sbytes, 1);
 
   state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * sbytes));
 }
@@ -36,14 +40,45 @@ keccak_permutation(benchmark::State& state)
   uint8_t st[25]{};
   random_data(st, sizeof(st));
 
+  perf_scope_t perf(state);
   for (auto _ : state) {
     keccak::permute<rounds>(st);
 
     benchmark::DoNotOptimize(st);
     benchmark::ClobberMemory();
   }
+  perf.report(25, 1);
 
   state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * 25));
 }
 
+// Benchmarks bulk permutation, applying `rounds` -many rounds of Spongent-π[W]
+// ( W = slen ∈ {160, 176} ) or Keccak-f[200] ( slen = 200 ) on N -many states,
+// using T -many threads | N = state.range(0), T = state.range(1)
+template<const size_t slen, const size_t rounds>
+static void
+permutation_bulk(benchmark::State& state)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t cnt = static_cast<size_t>(state.range(0));
+  const size_t nthreads = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> st(cnt * sbytes);
+  random_data(st.data(), st.size());
+
+  perf_scope_t perf(state);
+  for (auto _ : state) {
+    elephant::permute_bulk<slen>(st.data(), cnt, 0, rounds, nthreads);
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+  perf.report(static_cast<double>(cnt * sbytes), static_cast<double>(cnt));
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * cnt));
+  state.SetBytesProcessed(
+    static_cast<int64_t>(state.iterations() * cnt * sbytes));
+}
+
 }
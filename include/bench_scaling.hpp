@@ -0,0 +1,437 @@
+#pragma once
+#include "handle.hpp"
+#include "key_cache.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <vector>
+
+// Multithreaded throughput scaling benchmarks of Elephant AEAD, for finding
+// out how {en, de}cryption scales with # -of threads, when they share key
+// state, & whether their data layout makes them fight over cache lines
+namespace bench_elephant {
+
+// How benchmark threads get to expanded key
+//
+// - own : each thread has its own key context ( same key )
+// - shared : all threads read one key context
+// - cache : all threads look up same ( hot ) key in one shared key cache,
+// before every call, holding on to context while using it
+// - handle : all threads go through one AEAD context handle, whose mask table
+// only one of them can use at a time
+enum class scaling_key_t : int64_t
+{
+  own,
+  shared,
+  cache,
+  handle
+};
+
+// Everything a benchmark run's threads work on, built before threads are
+// started ( see `Setup` of google-benchmark ) & torn down after they're done
+//
+// Shared key context comes first, followed by each thread's slot of state,
+// holding its own key context, nonce, tag, associated data, plain text,
+// cipher text & decrypted text, in this order. When packed, all of them are
+// laid back to back, so that one thread's written bytes share cache lines
+// with its neighbours' ( or shared key context ); otherwise shared key context
+// & each slot start on a cache line of their own.
+//
+// Cache lines threads access are tracked by address, so that ones of key
+// cache ( epoch records, hit counters, shard's mutex & bucket arrays ) &
+// AEAD context handle ( table's mutex ) internals, which threads fight over
+// in those modes, are accounted for too. Key cache internals depend on
+// calling thread, so benchmark threads mark them themselves.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+struct scaling_fixture_t
+{
+  using ctx_t = elephant::key_ctx_t<slen, rounds>;
+
+  static constexpr size_t LINE = 64;
+  static constexpr size_t tbytes = tlen >> 3;
+  static constexpr size_t dlen = 16;
+
+  struct slot_t
+  {
+    ctx_t* ctx;
+    uint8_t* nonce;
+    uint8_t* tag;
+    uint8_t* data;
+    uint8_t* txt;
+    uint8_t* enc;
+    uint8_t* dec;
+  };
+
+  const scaling_key_t mode;
+  const size_t ctlen;
+  const size_t nthreads;
+
+  uint8_t key[16];
+  std::vector<uint8_t> arena;
+  ctx_t* shared_ctx = nullptr;
+  std::vector<slot_t> slots;
+
+  std::unique_ptr<elephant::key_cache_t<slen, rounds>> cache;
+  std::unique_ptr<elephant::aead_ctx_t<slen, rounds, tlen>> handle;
+
+  // Access of a thread to byte range [beg, end), on some cache line
+  struct access_t
+  {
+    size_t t;
+    uintptr_t beg;
+    uintptr_t end;
+    bool writes;
+  };
+
+  std::map<uintptr_t, std::vector<access_t>> lines; // keyed by address / LINE
+  std::mutex lines_mtx;
+
+  scaling_fixture_t(const scaling_key_t mode_,
+                    const size_t ctlen_,
+                    const size_t nthreads_,
+                    const bool packed,
+                    const bool decrypting)
+    : mode(mode_)
+    , ctlen(ctlen_)
+    , nthreads(nthreads_)
+  {
+    random_data(key, sizeof(key));
+
+    auto round = [&](const size_t len) {
+      return packed ? len : (len + LINE - 1) & ~(LINE - 1);
+    };
+
+    const size_t ctx_off = 0;
+    const size_t nonce_off = ctx_off + sizeof(ctx_t);
+    const size_t tag_off = nonce_off + 12;
+    const size_t data_off = tag_off + tbytes;
+    const size_t txt_off = data_off + dlen;
+    const size_t enc_off = txt_off + ctlen;
+    const size_t dec_off = enc_off + ctlen;
+    const size_t slot_len = round(dec_off + ctlen);
+    const size_t head_len = round(sizeof(ctx_t));
+
+    const size_t used = head_len + nthreads * slot_len;
+    arena.resize(used + LINE);
+
+    auto* const base = reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(arena.data()) + LINE - 1) & ~(LINE - 1));
+
+    shared_ctx = new (base) ctx_t(key);
+
+    for (size_t t = 0; t < nthreads; t++) {
+      uint8_t* const s = base + head_len + t * slot_len;
+
+      slot_t slot{ new (s + ctx_off) ctx_t(key),
+                   s + nonce_off,
+                   s + tag_off,
+                   s + data_off,
+                   s + txt_off,
+                   s + enc_off,
+                   s + dec_off };
+
+      random_data(slot.nonce, 12);
+      random_data(slot.data, dlen);
+      random_data(slot.txt, ctlen);
+
+      elephant::encrypt<slen, rounds, tlen>(
+        *slot.ctx, slot.nonce, slot.data, dlen, slot.txt, slot.enc, ctlen,
+        slot.tag);
+
+      slots.push_back(slot);
+    }
+
+    if (mode == scaling_key_t::cache) {
+      cache = std::make_unique<elephant::key_cache_t<slen, rounds>>(1ul << 16);
+    } else if (mode == scaling_key_t::handle) {
+      handle =
+        std::make_unique<elephant::aead_ctx_t<slen, rounds, tlen>>(key, ctlen);
+    }
+
+    for (size_t t = 0; t < nthreads; t++) {
+      const slot_t& s = slots[t];
+
+      if (mode == scaling_key_t::own) {
+        mark(s.ctx, sizeof(ctx_t), t, false);
+      } else if (mode == scaling_key_t::shared) {
+        mark(shared_ctx, sizeof(ctx_t), t, false);
+      }
+
+      mark(s.nonce, 12, t, false);
+      mark(s.tag, tbytes, t, !decrypting);
+      mark(s.data, dlen, t, false);
+      mark(s.enc, ctlen, t, !decrypting);
+      mark(decrypting ? s.dec : s.txt, ctlen, t, decrypting);
+
+      if (mode == scaling_key_t::handle) {
+        handle->footprint(
+          [&](const void* const ptr, const size_t len, const bool writes) {
+            mark(ptr, len, t, writes);
+          });
+      }
+    }
+  }
+
+  // Notes that thread `t` accesses ( writes to, when `writes` is set ) `len`
+  // -bytes starting at `ptr`
+  void mark(const void* const ptr,
+            const size_t len,
+            const size_t t,
+            const bool writes)
+  {
+    if (len == 0) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(lines_mtx);
+
+    const uintptr_t beg = reinterpret_cast<uintptr_t>(ptr);
+    const uintptr_t end = beg + len;
+
+    for (uintptr_t l = beg / LINE; l <= (end - 1) / LINE; l++) {
+      lines[l].push_back({ t,
+                           std::max(beg, l * LINE),
+                           std::min(end, (l + 1) * LINE),
+                           writes });
+    }
+  }
+
+  // # -of cache lines, where some thread writes bytes, while some other thread
+  // accesses other ( disjoint ) bytes, as per marked accesses; threads fighting
+  // over same bytes ( say a mutex ) share those truly, not falsely
+  size_t false_shared_lines()
+  {
+    std::lock_guard<std::mutex> lock(lines_mtx);
+
+    size_t n = 0;
+    for (const auto& [_, accs] : lines) {
+      bool shared = false;
+
+      for (const auto& w : accs) {
+        for (const auto& a : accs) {
+          shared = shared || (w.writes && (w.t != a.t) &&
+                              ((w.end <= a.beg) || (a.end <= w.beg)));
+        }
+      }
+
+      n += shared;
+    }
+
+    return n;
+  }
+
+  ~scaling_fixture_t()
+  {
+    for (auto& s : slots) {
+      s.ctx->~ctx_t();
+    }
+    shared_ctx->~ctx_t();
+  }
+
+  scaling_fixture_t(const scaling_fixture_t&) = delete;
+  scaling_fixture_t& operator=(const scaling_fixture_t&) = delete;
+};
+
+// Fixture of currently running scaling benchmark, one per instantiation
+template<const size_t slen, const size_t rounds, const size_t tlen>
+inline std::unique_ptr<scaling_fixture_t<slen, rounds, tlen>>&
+scaling_fixture()
+{
+  static std::unique_ptr<scaling_fixture_t<slen, rounds, tlen>> fx;
+  return fx;
+}
+
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+static void
+scaling_setup(const benchmark::State& state)
+{
+  scaling_fixture<slen, rounds, tlen>() =
+    std::make_unique<scaling_fixture_t<slen, rounds, tlen>>(
+      static_cast<scaling_key_t>(state.range(0)),
+      static_cast<size_t>(state.range(1)),
+      static_cast<size_t>(state.threads()),
+      state.range(2) != 0,
+      decrypting);
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+scaling_teardown(const benchmark::State&)
+{
+  scaling_fixture<slen, rounds, tlen>().reset();
+}
+
+// Benchmarks Dumbo/ Jumbo/ Delirium encryption ( or verified decryption ) of
+// 16 -bytes associated data & range(1) -bytes text, on every benchmark
+// thread at once, getting to key as range(0) says ( see `scaling_key_t` ),
+// with per-thread state packed together, when range(2) is non-zero
+//
+// Besides aggregate bytes/ second, reports aggregate `GB/s` ( as seen by
+// first thread, timing its own loop ), `efficiency` i.e. aggregate
+// throughput over # -of threads times single threaded throughput of same
+// configuration ( when that one ran earlier ), & `false_shared_lines`, which
+// is # -of cache lines written by one thread, while others access them,
+// including ones of key cache & context handle internals.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+static void
+aead_scaling(benchmark::State& state)
+{
+  using clock = std::chrono::steady_clock;
+
+  auto& fx = *scaling_fixture<slen, rounds, tlen>();
+  const auto& s = fx.slots[static_cast<size_t>(state.thread_index())];
+  const size_t dlen = fx.dlen;
+  const size_t ctlen = fx.ctlen;
+
+  auto run = [&](const auto& ctx) {
+    if constexpr (decrypting) {
+      return elephant::decrypt<slen, rounds, tlen>(
+        ctx, s.nonce, s.tag, s.data, dlen, s.enc, s.dec, ctlen);
+    } else {
+      elephant::encrypt<slen, rounds, tlen>(
+        ctx, s.nonce, s.data, dlen, s.txt, s.enc, ctlen, s.tag);
+      return true;
+    }
+  };
+
+  auto call = [&] {
+    switch (fx.mode) {
+      case scaling_key_t::own:
+        return run(*s.ctx);
+      case scaling_key_t::shared:
+        return run(*fx.shared_ctx);
+      case scaling_key_t::cache: {
+        const auto ctx = fx.cache->get(1, fx.key);
+        return run(*ctx);
+      }
+      case scaling_key_t::handle:
+        if constexpr (decrypting) {
+          return fx.handle->decrypt(
+            s.nonce, s.tag, s.data, dlen, s.enc, s.dec, ctlen);
+        } else {
+          fx.handle->encrypt(
+            s.nonce, s.data, dlen, s.txt, s.enc, ctlen, s.tag);
+          return true;
+        }
+    }
+    return false;
+  };
+
+  // benchmark loop starts all threads together, so every one of them has
+  // marked its key cache accesses, by the time first one is done
+  if (fx.mode == scaling_key_t::cache) {
+    const size_t t = static_cast<size_t>(state.thread_index());
+
+    fx.cache->get(1, fx.key).reset();
+    fx.cache->footprint(
+      1, [&](const void* const ptr, const size_t len, const bool writes) {
+        fx.mark(ptr, len, t, writes);
+      });
+  }
+
+  bool ok = true;
+  const auto t0 = clock::now();
+
+  for (auto _ : state) {
+    const bool f = call();
+
+    benchmark::DoNotOptimize(f);
+    benchmark::ClobberMemory();
+    ok = ok && f;
+  }
+
+  const auto t1 = clock::now();
+
+  assert(ok);
+  (void)ok;
+
+  const size_t bytes = dlen + ctlen;
+  state.SetBytesProcessed(static_cast<int64_t>(bytes * state.iterations()));
+
+  if (state.thread_index() != 0) {
+    return;
+  }
+
+  // keyed by benchmark arguments, holding single threaded throughput
+  static std::map<std::array<int64_t, 3>, double> single;
+
+  const std::array<int64_t, 3> args{ state.range(0),
+                                     state.range(1),
+                                     state.range(2) };
+  const double secs = std::chrono::duration<double>(t1 - t0).count();
+  const double gbps = static_cast<double>(fx.nthreads * bytes) *
+                      static_cast<double>(state.iterations()) / secs / 1e9;
+
+  if (fx.nthreads == 1) {
+    single[args] = gbps;
+  }
+
+  state.counters["GB/s"] = gbps;
+  if (const auto it = single.find(args); it != single.end()) {
+    state.counters["efficiency"] = gbps / (fx.nthreads * it->second);
+  }
+  state.counters["false_shared_lines"] =
+    static_cast<double>(fx.false_shared_lines());
+}
+
+// Registers scaling benchmarks of encryption & decryption, for one Elephant
+// variant, named `{name}/{encrypt, decrypt}/scaling`, running on 1, 2, 4 ...
+// up to `max_threads` -many threads, for each way of getting to key, 64
+// -bytes & `large_len` -bytes text, with padded & packed per-thread state
+template<const size_t slen, const size_t rounds, const size_t tlen>
+void
+register_scaling(const std::string& name,
+                 const int max_threads,
+                 const int64_t large_len)
+{
+  std::vector<int> threads;
+  for (int t = 1; t < max_threads; t *= 2) {
+    threads.push_back(t);
+  }
+  threads.push_back(std::max(max_threads, 1));
+
+  auto add = [&](const char* const op, auto fn, auto setup) {
+    const std::string bname = name + "/" + op + "/scaling";
+
+    auto* const b =
+      benchmark::RegisterBenchmark(bname.c_str(), fn)
+        ->ArgsProduct({ { static_cast<int64_t>(scaling_key_t::own),
+                          static_cast<int64_t>(scaling_key_t::shared),
+                          static_cast<int64_t>(scaling_key_t::cache),
+                          static_cast<int64_t>(scaling_key_t::handle) },
+                        { 64, large_len },
+                        { 0, 1 } })
+        ->ArgNames({ "key", "msg", "packed" })
+        ->Setup(setup)
+        ->Teardown(scaling_teardown<slen, rounds, tlen>)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    for (const int t : threads) {
+      b->Threads(t);
+    }
+  };
+
+  add("encrypt",
+      aead_scaling<slen, rounds, tlen, false>,
+      scaling_setup<slen, rounds, tlen, false>);
+  add("decrypt",
+      aead_scaling<slen, rounds, tlen, true>,
+      scaling_setup<slen, rounds, tlen, true>);
+}
+
+}
@@ -0,0 +1,424 @@
+#pragma once
+#include "aead.hpp"
+#include "bench_perf.hpp"
+#include "bench_tsc.hpp"
+#include "keccak.hpp"
+#include "spongent.hpp"
+#include "utils.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+
+// Per-stage microbenchmarks of Elephant AEAD internals ( permutation round
+// steps, mask & block extraction routines ), along with breakdown of where
+// time goes in one full encryption call
+namespace bench_elephant {
+
+// Runs benchmark loop, calling `f` ( which updates `st` ) once per iteration,
+// reporting TSC cycles/ op & ops/ second
+template<typename F>
+static inline void
+run_stage(benchmark::State& state, uint8_t* const st, F&& f)
+{
+  const uint64_t c0 = rdtsc();
+  for (auto _ : state) {
+    f();
+
+    benchmark::DoNotOptimize(st);
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = rdtsc();
+
+  const double itrs = static_cast<double>(state.iterations());
+  state.counters["cycles/op"] = static_cast<double>(c1 - c0) / itrs;
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+
+// Round index, hidden from compiler, so that round constant lookups aren't
+// folded away
+static inline size_t
+opaque_round(const size_t r_idx)
+{
+  size_t r = r_idx;
+  benchmark::DoNotOptimize(r);
+  return r;
+}
+
+// Benchmarks round constant addition step of Spongent-π[W] | W = slen ∈ {160,
+// 176}
+template<const size_t slen>
+static void
+spongent_apply_rc(benchmark::State& state)
+{
+  uint8_t st[slen >> 3];
+  random_data(st, sizeof(st));
+
+  const size_t r = opaque_round(1);
+  run_stage(state, st, [&] { spongent::apply_rc<slen>(st, r); });
+}
+
+// Benchmarks substitution layer of Spongent-π[W] | W = slen ∈ {160, 176}
+template<const size_t slen>
+static void
+spongent_apply_sbox(benchmark::State& state)
+{
+  uint8_t st[slen >> 3];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] { spongent::apply_sbox<slen>(st); });
+}
+
+// Benchmarks bit permutation layer of Spongent-π[W] | W = slen ∈ {160, 176}
+template<const size_t slen>
+static void
+spongent_apply_permutation(benchmark::State& state)
+{
+  uint8_t st[slen >> 3];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] { spongent::apply_permutation<slen>(st); });
+}
+
+// Benchmarks single round of Spongent-π[W] | W = slen ∈ {160, 176}
+template<const size_t slen>
+static void
+spongent_round(benchmark::State& state)
+{
+  uint8_t st[slen >> 3];
+  random_data(st, sizeof(st));
+
+  const size_t r = opaque_round(1);
+  run_stage(state, st, [&] { spongent::round<slen>(st, r); });
+}
+
+// Benchmarks θ step mapping of Keccak-f[200]
+static void
+keccak_theta(benchmark::State& state)
+{
+  uint8_t st[25];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] { keccak::theta(st); });
+}
+
+// Benchmarks ρ step mapping of Keccak-f[200]
+static void
+keccak_rho(benchmark::State& state)
+{
+  uint8_t st[25];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] { keccak::rho(st); });
+}
+
+// Benchmarks π step mapping of Keccak-f[200]
+static void
+keccak_pi(benchmark::State& state)
+{
+  uint8_t st[25], tmp[25];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] {
+    keccak::pi(st, tmp);
+    std::memcpy(st, tmp, sizeof(tmp));
+  });
+}
+
+// Benchmarks χ step mapping of Keccak-f[200]
+static void
+keccak_chi(benchmark::State& state)
+{
+  uint8_t st[25], tmp[25];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] {
+    keccak::chi(st, tmp);
+    std::memcpy(st, tmp, sizeof(tmp));
+  });
+}
+
+// Benchmarks ι step mapping of Keccak-f[200]
+static void
+keccak_iota(benchmark::State& state)
+{
+  uint8_t st[25];
+  random_data(st, sizeof(st));
+
+  const size_t r = opaque_round(1);
+  run_stage(state, st, [&] { keccak::iota(st, r); });
+}
+
+// Benchmarks single round of Keccak-f[200]
+static void
+keccak_round(benchmark::State& state)
+{
+  uint8_t st[25];
+  random_data(st, sizeof(st));
+
+  const size_t r = opaque_round(1);
+  run_stage(state, st, [&] { keccak::round(st, r); });
+}
+
+// Benchmarks one step of mask generating linear feedback shift register | slen
+// ∈ {160, 176, 200}
+template<const size_t slen>
+static void
+elephant_lfsr(benchmark::State& state)
+{
+  uint8_t st[slen >> 3];
+  random_data(st, sizeof(st));
+
+  run_stage(state, st, [&] { elephant::lfsr<slen>(st); });
+}
+
+// Benchmarks computation of next mask(K, a, b), along with carrying `hmask`
+// over to next round, as {en, de}cryption routines do | slen ∈ {160, 176, 200}
+template<const size_t slen, const size_t b>
+static void
+elephant_next_mask(benchmark::State& state)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t key[sbytes], hmask[sbytes], fmask[sbytes];
+  random_data(key, sizeof(key));
+
+  run_stage(state, fmask, [&] {
+    elephant::next_mask<slen, b>(key, hmask, fmask);
+    std::memcpy(key, hmask, sizeof(hmask));
+  });
+}
+
+// Benchmarks extraction of i -th padded block of N -bytes associated data,
+// prepended with nonce | N = state.range(0), i = state.range(1)
+template<const size_t slen>
+static void
+elephant_get_ith_data_block(benchmark::State& state)
+{
+  const size_t dlen = static_cast<size_t>(state.range(0));
+  const size_t i = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> data(dlen);
+  uint8_t nonce[12], blk[slen >> 3];
+
+  random_data(data.data(), dlen);
+  random_data(nonce, sizeof(nonce));
+
+  run_stage(state, blk, [&] {
+    elephant::get_ith_data_block<slen>(data.data(), dlen, nonce, i, blk);
+  });
+}
+
+// Benchmarks extraction of i -th padded block of M -bytes cipher text | M =
+// state.range(0), i = state.range(1)
+template<const size_t slen>
+static void
+elephant_get_ith_cipher_block(benchmark::State& state)
+{
+  const size_t ctlen = static_cast<size_t>(state.range(0));
+  const size_t i = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> enc(ctlen);
+  uint8_t blk[slen >> 3];
+
+  random_data(enc.data(), ctlen);
+
+  run_stage(state, blk, [&] {
+    elephant::get_ith_cipher_block<slen>(enc.data(), ctlen, i, blk);
+  });
+}
+
+// TSC cycles taken by one call of `f`, amortized over `calls` -many back to
+// back calls
+template<typename F>
+static inline double
+batch_cycles(F&& f, const size_t calls)
+{
+  const uint64_t c0 = tsc_begin();
+  for (size_t i = 0; i < calls; i++) {
+    f();
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = tsc_end();
+
+  return static_cast<double>(c1 - c0) / static_cast<double>(calls);
+}
+
+// Stage of some larger routine, timed on its own, in batches of back to back
+// calls, which take >= 2^20 cycles, so that cost of reading TSC vanishes, while
+// slow stages ( say Spongent permutation ) aren't run needlessly many times
+template<typename F>
+struct stage_t
+{
+  F f;
+  size_t calls = 1;
+
+  explicit stage_t(F f_)
+    : f(f_)
+  {
+    while ((batch_cycles(f, calls) * calls < double(1ul << 20)) &&
+           (calls < (1ul << 20))) {
+      calls <<= 1;
+    }
+  }
+
+  // TSC cycles per call, over one batch
+  inline double cycles() { return batch_cycles(f, calls); }
+};
+
+// Median of given samples | non-empty
+static inline double
+median(std::vector<double> v)
+{
+  const auto mid = v.begin() + static_cast<ptrdiff_t>(v.size() / 2);
+  std::nth_element(v.begin(), mid, v.end());
+  return *mid;
+}
+
+// Benchmarks reference Dumbo/ Jumbo/ Delirium encryption of N -bytes
+// associated data & M -bytes text, then breaks its cost down ( Amdahl-style )
+// into share of time spent in
+//
+// - perm : permutation calls ( including four key expansions )
+// - mask : mask(K, a, b) computation & carrying it over to next block
+// - copy : key/ nonce loading & padded block extraction
+// - xor : masking blocks, XOR-ing keystream & accumulating tag
+//
+// by timing each stage on its own ( see `stage_t` ) & multiplying with # -of
+// times one encryption call runs it, relative to cost of whole call. Whole
+// call & stages are timed one right after another, few rounds, with median
+// share ( over rounds ) being reported, so that CPU frequency shifts don't
+// skew them. Whatever isn't covered by the model ( loop control, effects of
+// inlining stages into one another ) shows up as `other_share`, which may be
+// negative. Also reports `perm_speedup_bound` i.e. largest speedup of whole
+// call, which making permutation infinitely fast would bring ( left out, when
+// permutation seems to take all of it ) | N = state.range(0), M =
+// state.range(1)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+aead_breakdown(benchmark::State& state)
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t dlen = static_cast<size_t>(state.range(0));
+  const size_t ctlen = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> key(16), nonce(12), tag(tbytes);
+  std::vector<uint8_t> data(dlen), txt(ctlen), enc(ctlen);
+
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  auto encrypt = [&] {
+    elephant::encrypt<slen, rounds, tlen>(key.data(),
+                                          nonce.data(),
+                                          data.data(),
+                                          dlen,
+                                          txt.data(),
+                                          enc.data(),
+                                          ctlen,
+                                          tag.data());
+  };
+
+  const uint64_t c0 = rdtsc();
+  for (auto _ : state) {
+    encrypt();
+
+    benchmark::DoNotOptimize(enc);
+    benchmark::DoNotOptimize(tag);
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = rdtsc();
+
+  // # -of blocks of keystream, padded associated data & padded cipher text
+  const size_t ks_blks = (ctlen + sbytes - 1) / sbytes;
+  const size_t ad_blks = (12 + dlen + 1 + sbytes - 1) / sbytes;
+  const size_t ct_blks = (ctlen + 1 + sbytes - 1) / sbytes;
+  const size_t perms = aead_perm_calls<slen>(dlen, ctlen);
+
+  // when there's only one associated data block, later block isn't counted
+  const size_t ad_i = ad_blks > 1 ? 1 : 0;
+
+  uint8_t a[sbytes], b[sbytes], c[sbytes];
+  random_data(a, sizeof(a));
+  random_data(b, sizeof(b));
+
+  stage_t whole(encrypt);
+  stage_t perm([&] { elephant::permute<slen, rounds>(a); });
+  stage_t mask0([&] {
+    elephant::next_mask<slen, 0>(a, b, c);
+    std::memcpy(a, b, sizeof(b));
+  });
+  stage_t mask1([&] {
+    elephant::next_mask<slen, 1>(a, b, c);
+    std::memcpy(a, b, sizeof(b));
+  });
+  stage_t mask2([&] {
+    elephant::next_mask<slen, 2>(a, b, c);
+    std::memcpy(a, b, sizeof(b));
+  });
+  stage_t load([&] {
+    std::memset(a, 0, sizeof(a));
+    std::memcpy(a, key.data(), 16);
+  });
+  stage_t data0([&] {
+    elephant::get_ith_data_block<slen>(data.data(), dlen, nonce.data(), 0, a);
+  });
+  stage_t datai([&] {
+    elephant::get_ith_data_block<slen>(
+      data.data(), dlen, nonce.data(), ad_i, a);
+  });
+  stage_t cipher([&] {
+    elephant::get_ith_cipher_block<slen>(enc.data(), ctlen, 0, a);
+  });
+  stage_t xor_blk([&] {
+    for (size_t j = 0; j < sbytes; j++) {
+      a[j] ^= b[j];
+    }
+  });
+
+  std::vector<double> perm_s, mask_s, copy_s, xor_s;
+
+  for (size_t r = 0; r < 9; r++) {
+    const double total = whole.cycles();
+
+    const double t_perm = perm.cycles() * perms;
+    const double t_mask = mask1.cycles() * ks_blks +
+                          mask0.cycles() * (ad_blks - 1) +
+                          mask2.cycles() * ct_blks;
+    const double t_copy = load.cycles() * (4 + ks_blks) + data0.cycles() +
+                          datai.cycles() * (ad_blks - 1) +
+                          cipher.cycles() * ct_blks;
+    const double t_xor =
+      xor_blk.cycles() * (3 * ks_blks + 3 * (ad_blks - 1) + 3 * ct_blks + 2);
+
+    perm_s.push_back(t_perm / total);
+    mask_s.push_back(t_mask / total);
+    copy_s.push_back(t_copy / total);
+    xor_s.push_back(t_xor / total);
+  }
+
+  const double p_perm = median(perm_s);
+  const double p_mask = median(mask_s);
+  const double p_copy = median(copy_s);
+  const double p_xor = median(xor_s);
+
+  state.counters["cycles/op"] =
+    static_cast<double>(c1 - c0) / static_cast<double>(state.iterations());
+  state.counters["perm_share"] = p_perm;
+  state.counters["mask_share"] = p_mask;
+  state.counters["copy_share"] = p_copy;
+  state.counters["xor_share"] = p_xor;
+  state.counters["other_share"] = 1. - (p_perm + p_mask + p_copy + p_xor);
+  if (p_perm < 1.) {
+    state.counters["perm_speedup_bound"] = 1. / (1. - p_perm);
+  }
+
+  state.SetBytesProcessed(
+    static_cast<int64_t>(state.iterations() * (dlen + ctlen)));
+}
+
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include "aead.hpp"
+#include "bench_perf.hpp"
+#include "bench_tsc.hpp"
+#include "utils.hpp"
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <string>
+#include <vector>
+
+// Size-sweep benchmarks of Elephant AEAD, reporting cycles/ byte
+namespace bench_elephant {
+
+// Associated data & text lengths, which size-sweeps go over | <= 16 MiB
+inline std::vector<int64_t>
+sweep_lengths(const int64_t max_len)
+{
+  std::vector<int64_t> lens{ 0, 1, 16 };
+  for (int64_t len = 64; len <= (int64_t{ 1 } << 24); len <<= 2) {
+    lens.push_back(len);
+  }
+
+  std::erase_if(lens, [&](const int64_t len) { return len > max_len; });
+  return lens;
+}
+
+// Benchmarks Dumbo/ Jumbo/ Delirium encryption ( or verified decryption ) of
+// message with range(0) -bytes associated data & range(1) -bytes text,
+// reporting time stamp counter cycles per byte ( of associated data & text )
+// & per message
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+static void
+aead_sweep(benchmark::State& state)
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t dlen = static_cast<size_t>(state.range(0));
+  const size_t ctlen = static_cast<size_t>(state.range(1));
+
+  std::vector<uint8_t> key(16), nonce(12), tag(tbytes);
+  std::vector<uint8_t> data(dlen), txt(ctlen), enc(ctlen), dec(ctlen);
+
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  elephant::encrypt<slen, rounds, tlen>(key.data(),
+                                        nonce.data(),
+                                        data.data(),
+                                        dlen,
+                                        txt.data(),
+                                        enc.data(),
+                                        ctlen,
+                                        tag.data());
+
+  bool flag = true;
+
+  perf_scope_t perf(state);
+  const uint64_t c0 = rdtsc();
+  for (auto _ : state) {
+    if constexpr (decrypting) {
+      flag &= elephant::decrypt<slen, rounds, tlen>(key.data(),
+                                                    nonce.data(),
+                                                    tag.data(),
+                                                    data.data(),
+                                                    dlen,
+                                                    enc.data(),
+                                                    dec.data(),
+                                                    ctlen);
+
+      benchmark::DoNotOptimize(flag);
+      benchmark::DoNotOptimize(dec.data());
+    } else {
+      elephant::encrypt<slen, rounds, tlen>(key.data(),
+                                            nonce.data(),
+                                            data.data(),
+                                            dlen,
+                                            txt.data(),
+                                            enc.data(),
+                                            ctlen,
+                                            tag.data());
+
+      benchmark::DoNotOptimize(enc.data());
+      benchmark::DoNotOptimize(tag.data());
+    }
+    benchmark::ClobberMemory();
+  }
+  const uint64_t c1 = rdtsc();
+  perf.report(static_cast<double>(dlen + ctlen),
+              aead_perm_calls<slen>(dlen, ctlen));
+
+  assert(flag);
+  if constexpr (decrypting) {
+    assert(dec == txt);
+  }
+  (void)flag;
+
+  const double itrs = static_cast<double>(state.iterations());
+  const double cycles = static_cast<double>(c1 - c0) / itrs;
+  const size_t per_itr = dlen + ctlen;
+
+  state.counters["cycles/op"] = cycles;
+  if (per_itr > 0) {
+    state.counters["cycles/byte"] = cycles / static_cast<double>(per_itr);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * per_itr));
+}
+
+// Registers associated data only, text only & mixed ( equal lengths )
+// size-sweeps of encryption & decryption, for one Elephant variant, named
+// `{name}/{encrypt, decrypt}/{ad_only, msg_only, mixed}`, with lengths up to
+// `max_len` -bytes
+template<const size_t slen, const size_t rounds, const size_t tlen>
+void
+register_sweeps(const std::string& name, const int64_t max_len)
+{
+  const std::vector<int64_t> lens = sweep_lengths(max_len);
+
+  auto add = [&](const char* const op, auto fn) {
+    const std::string prefix = name + "/" + op;
+
+    const std::string ad_name = prefix + "/ad_only";
+    const std::string msg_name = prefix + "/msg_only";
+    const std::string mixed_name = prefix + "/mixed";
+
+    auto* ad_only = benchmark::RegisterBenchmark(ad_name.c_str(), fn);
+    auto* msg_only = benchmark::RegisterBenchmark(msg_name.c_str(), fn);
+    auto* mixed = benchmark::RegisterBenchmark(mixed_name.c_str(), fn);
+
+    for (const int64_t len : lens) {
+      if (len > 0) {
+        ad_only->Args({ len, 0 });
+        msg_only->Args({ 0, len });
+      }
+      mixed->Args({ len, len });
+    }
+
+    for (auto* b : { ad_only, msg_only, mixed }) {
+      b->ArgNames({ "ad", "msg" })->Unit(benchmark::kMicrosecond);
+    }
+  };
+
+  add("encrypt", aead_sweep<slen, rounds, tlen, false>);
+  add("decrypt", aead_sweep<slen, rounds, tlen, true>);
+}
+
+}
@@ -0,0 +1,86 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// Time stamp counter based cycle measurement, for benchmarks reporting
+// cycles/ byte
+namespace bench_elephant {
+
+// Reads time stamp counter; on targets without one, steady clock nanoseconds
+// are returned, so that `tsc_hz` calibrates to ~1 GHz
+inline uint64_t
+rdtsc()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return static_cast<uint64_t>(
+    std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch())
+      .count());
+#endif
+}
+
+// Reads time stamp counter at start of timed region, after all earlier
+// instructions have completed ( lfence; rdtsc ), so that they don't leak into
+// it
+inline uint64_t
+tsc_begin()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_lfence();
+  const uint64_t t = __rdtsc();
+  _mm_lfence();
+  return t;
+#else
+  return rdtsc();
+#endif
+}
+
+// Reads time stamp counter at end of timed region, once all instructions of it
+// have completed ( rdtscp ), keeping later ones from starting early ( lfence )
+inline uint64_t
+tsc_end()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  uint32_t aux = 0;
+  const uint64_t t = __rdtscp(&aux);
+  _mm_lfence();
+  return t;
+#else
+  return rdtsc();
+#endif
+}
+
+// Frequency of time stamp counter ( in Hz ), calibrated once against steady
+// clock, over ~50 ms
+//
+// Note, on modern x86 CPUs TSC ticks at constant ( nominal ) rate, no matter
+// what frequency cores are actually running at, so cycles reported using it
+// are reference cycles; disable frequency scaling & turbo boost, for them to
+// match core clock cycles.
+inline double
+tsc_hz()
+{
+  static const double hz = [] {
+    using clock = std::chrono::steady_clock;
+
+    const auto t0 = clock::now();
+    const uint64_t c0 = rdtsc();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const uint64_t c1 = rdtsc();
+    const auto t1 = clock::now();
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    return static_cast<double>(c1 - c0) / secs;
+  }();
+
+  return hz;
+}
+
+}
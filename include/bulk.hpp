@@ -0,0 +1,80 @@
+#pragma once
+#include "lanes.hpp"
+
+// Bulk permutation API, running ( full or reduced round ) Spongent-π[{160,
+// 176}] & Keccak-f[200] on large arrays of independent states, say for trail
+// search or statistical testing of permutation outputs
+namespace elephant {
+
+// Maximum # -of rounds of permutation underlying Elephant variant with
+// `slen` -bit state i.e. 80 for Spongent-π[160], 90 for Spongent-π[176] & 18
+// for Keccak-f[200]
+template<const size_t slen>
+constexpr inline static size_t
+max_rounds() requires(spongent::check_state_bit_len(slen))
+{
+  if constexpr (slen == 160) {
+    return 80;
+  } else if constexpr (slen == 176) {
+    return 90;
+  } else {
+    return keccak::ROUNDS;
+  }
+}
+
+// Applies `rounds` -many rounds of permutation, starting from round `first`
+// ( i.e. rounds first, first + 1, ..., first + rounds - 1, using respective
+// round constants ), on each of `cnt` -many (slen >> 3) -bytes states, stored
+// back to back in `states`, in-place | cnt >= 0
+//
+// With first = 0 & rounds = max_rounds<slen>(), it's same as full permutation,
+// while applying k rounds starting from round r on output of r rounds is same
+// as applying r + k rounds in one go. States are permuted `lanes` -many at a
+// time, using multi-state permutation, & groups of them are spread across
+// `nthreads` -many threads.
+//
+// Returns false, without touching any state, if first + rounds exceeds
+// max_rounds<slen>().
+template<const size_t slen, const size_t lanes = LANES>
+static bool
+permute_bulk(uint8_t* const states,    // `cnt` -many permutation states
+             const size_t cnt,         // # -of states | >= 0
+             const size_t first,       // index of first round to apply
+             const size_t rounds,      // # -of rounds to apply
+             const size_t nthreads = 1 // # -of threads to use | > 0
+             ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t rmax = max_rounds<slen>();
+
+  if ((first > rmax) || (rounds > rmax - first)) {
+    return false;
+  }
+  if (rounds == 0) {
+    return true;
+  }
+
+  for_each_lane_group<lanes>(
+    cnt, nthreads, [&](const size_t s, const size_t n) {
+      uint8_t state[sbytes * lanes]{};
+      uint8_t* const group = states + s * sbytes;
+
+      for (size_t l = 0; l < n; l++) {
+        to_lane<slen, lanes>(group + l * sbytes, state, l);
+      }
+
+      if constexpr ((slen == 160) || (slen == 176)) {
+        spongent::permute_lanes<slen, lanes>(state, first, rounds);
+      } else {
+        keccak::permute_lanes<lanes>(state, first, rounds);
+      }
+
+      for (size_t l = 0; l < n; l++) {
+        from_lane<slen, lanes>(state, group + l * sbytes, l);
+      }
+    });
+
+  return true;
+}
+
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "aead.hpp"
+
+// Reusable key context for Elephant Authenticated Encryption with Associated
+// Data, which avoids expanding same secret key on every {en, de}cryption
+namespace elephant {
+
+// Zeroes `len` -bytes of sensitive memory, in a way that compiler can't elide
+inline static void
+secure_zero(void* const mem, const size_t len)
+{
+  volatile uint8_t* ptr = static_cast<volatile uint8_t*>(mem);
+
+  for (size_t i = 0; i < len; i++) {
+    ptr[i] = 0;
+  }
+}
+
+// Key context holding (slen >> 3) -bytes expanded masking key ( i.e. zero
+// padded 16 -bytes secret key, after applying underlying permutation ), which
+// is what every `mask(K, a, b)` computation starts from
+//
+// Expanding key costs one full permutation & reference `encrypt`/ `decrypt`
+// routines do that four times per call; key context does it once per key.
+// Expanded key is zeroed when context goes out of scope ( or is wiped ).
+template<const size_t slen, const size_t rounds>
+struct key_ctx_t
+{
+  static constexpr size_t sbytes = slen >> 3;
+
+  uint8_t ekey[sbytes]{};
+
+  key_ctx_t() = default;
+
+  explicit key_ctx_t(const uint8_t* const key) { init(key); }
+
+  ~key_ctx_t() { wipe(); }
+
+  // (Re)initializes key context with given 128 -bit secret key
+  inline void init(const uint8_t* const key)
+  {
+    expand_key<slen, rounds>(key, ekey);
+  }
+
+  // Zeroes expanded key, so context must be (re)initialized before next use
+  inline void wipe() { secure_zero(ekey, sizeof(ekey)); }
+};
+
+// Given key context, 12 -bytes public message nonce, N -bytes associated data &
+// M -bytes plain text, this routine computes M -bytes encrypted text & (tlen >>
+// 3) -bytes authentication tag, using Dumbo/ Jumbo/ Delirium AEAD scheme | M, N
+// >= 0
+//
+// Produces same output as `elephant::encrypt`, given key context was
+// initialized using same secret key.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+encrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // N -bytes associated data
+        const size_t dlen,                     // len(data) = N | >= 0
+        const uint8_t* const __restrict txt,   // M -bytes plain text
+        uint8_t* const __restrict enc,         // M -bytes encrypted text
+        const size_t ctlen,                    // len(txt) = len(enc) = M | >= 0
+        uint8_t* const __restrict tag          // `tlen` -bit authentication tag
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen))
+{
+  uint8_t acc[slen >> 3];
+
+  xor_keystream<slen, rounds>(ctx.ekey, nonce, txt, enc, ctlen);
+  absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, acc);
+  absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+}
+
+// Given key context, 12 -bytes public message nonce, (tlen >> 3) -bytes
+// authentication tag, N -bytes associated data & M -bytes encrypted text, this
+// routine computes M -bytes plain text & boolean verification flag, using
+// Dumbo/ Jumbo/ Delirium AEAD scheme | M, N >= 0
+//
+// Note, authentication tag is verified before decrypting, so unverified plain
+// text is never released; on failure plain text is zeroed.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // `tlen` -bit authentication tag
+        const uint8_t* const __restrict data,  // N -bytes associated data
+        const size_t dlen,                     // len(data) = N | >= 0
+        const uint8_t* const __restrict enc,   // M -bytes encrypted text
+        uint8_t* const __restrict txt,         // M -bytes plain text
+        const size_t ctlen                     // len(enc) = len(txt) = M | >= 0
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen))
+{
+  uint8_t acc[slen >> 3];
+  uint8_t tag_[tlen >> 3];
+
+  absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, acc);
+  absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag_);
+
+  const bool flg = verify_tag<tlen>(tag, tag_);
+
+  if (flg) {
+    xor_keystream<slen, rounds>(ctx.ekey, nonce, enc, txt, ctlen);
+  } else {
+    std::memset(txt, 0, ctlen);
+  }
+
+  return flg;
+}
+
+}
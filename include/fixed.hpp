@@ -0,0 +1,314 @@
+#pragma once
+#include "context.hpp"
+#include <utility>
+
+// Fixed-length ( compile-time message size ) Elephant Authenticated Encryption
+// with Associated Data, for latency sensitive small messages
+namespace elephant {
+
+// Upper bound on associated data/ plain text length ( in bytes ), accepted by
+// fixed-length routines, because all block loops get fully unrolled
+constexpr size_t FIXED_MAX_LEN = 1024;
+
+// Ensure that fixed-length routines are used only for small messages, in
+// compile-time
+constexpr inline static bool
+check_fixed_len(const size_t dlen, const size_t ctlen)
+{
+  return (dlen <= FIXED_MAX_LEN) && (ctlen <= FIXED_MAX_LEN);
+}
+
+// Invokes `f` with std::integral_constant<size_t, i>, for i ∈ [0, N), so that
+// index i ( and everything derived from it ) is a compile-time constant
+template<typename F, size_t... I>
+inline static void
+unroll(F&& f, std::index_sequence<I...>)
+{
+  (f(std::integral_constant<size_t, I>{}), ...);
+}
+
+template<const size_t N, typename F>
+inline static void
+unroll(F&& f)
+{
+  unroll(std::forward<F>(f), std::make_index_sequence<N>{});
+}
+
+// Compile-time block counts of keystream, padded associated data & padded
+// cipher text, along with # -of φ_1^i(K) masks required, for i ∈ [0, cnt)
+template<const size_t slen, const size_t dlen, const size_t ctlen>
+struct fixed_layout_t
+{
+  static constexpr size_t sbytes = slen >> 3;
+
+  static constexpr size_t ks_blk_cnt = (ctlen + sbytes - 1) / sbytes;
+  static constexpr size_t ad_blk_cnt = (12 + dlen + 1 + sbytes - 1) / sbytes;
+  static constexpr size_t ct_blk_cnt = (ctlen + 1 + sbytes - 1) / sbytes;
+
+  // keystream block i uses φ_1^{i+1}(K) ⊕ φ_1^i(K), associated data block i
+  // uses φ_1^i(K) & cipher text block i uses φ_1^{i+2}(K) ⊕ φ_1^i(K)
+  static constexpr size_t mask_cnt =
+    std::max(std::max(ks_blk_cnt + 1, ad_blk_cnt), ct_blk_cnt + 2);
+};
+
+// Computes masks φ_1^i(K), for i ∈ [0, cnt), all at once, because they are
+// shared by keystream, associated data & cipher text blocks
+template<const size_t slen, const size_t cnt>
+inline static void
+fixed_masks(const uint8_t* const __restrict ekey, // expanded masking key
+            uint8_t (*const __restrict lm)[slen >> 3] // cnt x (slen >> 3) masks
+)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  std::memcpy(lm[0], ekey, sbytes);
+
+  unroll<cnt - 1>([&](auto i) {
+    std::memcpy(lm[i + 1], lm[i], sbytes);
+    lfsr<slen>(lm[i + 1]);
+  });
+}
+
+// XORs two masks, producing mask used for some keystream/ cipher text block
+template<const size_t slen>
+inline static void
+fixed_mask_xor(const uint8_t* const __restrict a,
+               const uint8_t* const __restrict b,
+               uint8_t* const __restrict c)
+{
+  for (size_t i = 0; i < (slen >> 3); i++) {
+    c[i] = a[i] ^ b[i];
+  }
+}
+
+// XORs keystream with `ctlen` -bytes input, where every block boundary & tail
+// length is known in compile-time
+template<const size_t slen, const size_t rounds, const size_t ctlen>
+inline static void
+fixed_xor_keystream(const uint8_t (*const __restrict lm)[slen >> 3],
+                    const uint8_t* const __restrict nonce,
+                    const uint8_t* const __restrict in,
+                    uint8_t* const __restrict out)
+{
+  using layout = fixed_layout_t<slen, 0, ctlen>;
+  constexpr size_t sbytes = layout::sbytes;
+
+  uint8_t fmask[sbytes];
+  uint8_t ks[sbytes];
+
+  unroll<layout::ks_blk_cnt>([&](auto i) {
+    constexpr size_t off = i * sbytes;
+    constexpr size_t elen = std::min(sbytes, ctlen - off);
+
+    fixed_mask_xor<slen>(lm[i + 1], lm[i], fmask);
+    keystream_block<slen, rounds>(nonce, fmask, ks);
+
+    for (size_t j = 0; j < elen; j++) {
+      out[off + j] = in[off + j] ^ ks[j];
+    }
+  });
+}
+
+// Authenticates 12 -bytes nonce prepended & padded `dlen` -bytes associated
+// data, initializing tag accumulator, where position of every nonce/ data/
+// padding byte is known in compile-time
+template<const size_t slen, const size_t rounds, const size_t dlen>
+inline static void
+fixed_absorb_data(const uint8_t (*const __restrict lm)[slen >> 3],
+                  const uint8_t* const __restrict nonce,
+                  const uint8_t* const __restrict data,
+                  uint8_t* const __restrict acc)
+{
+  using layout = fixed_layout_t<slen, dlen, 0>;
+  constexpr size_t sbytes = layout::sbytes;
+
+  uint8_t blk[sbytes];
+
+  unroll<layout::ad_blk_cnt>([&](auto i) {
+    // bytes [beg, end) of nonce || data || 0x01 || 0* fall in i-th block
+    constexpr size_t beg = i * sbytes;
+    constexpr size_t end = beg + sbytes;
+
+    constexpr size_t dbeg = std::clamp(beg, 12ul, 12 + dlen) - 12;
+    constexpr size_t dend = std::clamp(end, 12ul, 12 + dlen) - 12;
+    constexpr size_t doff = dbeg + 12 - beg;
+    constexpr size_t poff = 12 + dlen - beg;
+
+    uint8_t* const dst = (i == 0) ? acc : blk;
+
+    std::memset(dst, 0, sbytes);
+    if constexpr (i == 0) {
+      std::memcpy(dst, nonce, 12);
+    }
+    std::memcpy(dst + doff, data + dbeg, dend - dbeg);
+    if constexpr ((12 + dlen >= beg) && (12 + dlen < end)) {
+      dst[poff] = 0x01;
+    }
+
+    if constexpr (i > 0) {
+      absorb_block<slen, rounds>(blk, lm[i], acc);
+    }
+  });
+}
+
+// Authenticates padded `ctlen` -bytes cipher text, XOR-ing result into tag
+// accumulator, where position of every cipher text/ padding byte is known in
+// compile-time
+template<const size_t slen, const size_t rounds, const size_t ctlen>
+inline static void
+fixed_absorb_cipher(const uint8_t (*const __restrict lm)[slen >> 3],
+                    const uint8_t* const __restrict enc,
+                    uint8_t* const __restrict acc)
+{
+  using layout = fixed_layout_t<slen, 0, ctlen>;
+  constexpr size_t sbytes = layout::sbytes;
+
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  unroll<layout::ct_blk_cnt>([&](auto i) {
+    constexpr size_t off = i * sbytes;
+    constexpr size_t clen = std::min(sbytes, ctlen - std::min(off, ctlen));
+
+    std::memset(blk, 0, sbytes);
+    std::memcpy(blk, enc + off, clen);
+    if constexpr (clen < sbytes) {
+      blk[clen] = 0x01;
+    }
+
+    fixed_mask_xor<slen>(lm[i + 2], lm[i], fmask);
+    absorb_block<slen, rounds>(blk, fmask, acc);
+  });
+}
+
+// Given key context, 12 -bytes public message nonce, `dlen` -bytes associated
+// data & `ctlen` -bytes plain text, this routine computes `ctlen` -bytes
+// encrypted text & (tlen >> 3) -bytes authentication tag, using Dumbo/ Jumbo/
+// Delirium AEAD scheme | dlen, ctlen <= FIXED_MAX_LEN
+//
+// Produces same output as `elephant::encrypt`, but because message lengths are
+// template parameters, block counts, padding positions & loop trip counts are
+// all resolved in compile-time, flattening whole AEAD into straight-line code.
+// Masks are computed once & shared by keystream, associated data & cipher text.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t ctlen>
+static void
+encrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict txt,   // `ctlen` -bytes plain text
+        uint8_t* const __restrict enc,         // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict tag          // `tlen` -bit authentication tag
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen) && check_fixed_len(dlen, ctlen))
+{
+  using layout = fixed_layout_t<slen, dlen, ctlen>;
+  constexpr size_t sbytes = layout::sbytes;
+
+  uint8_t lm[layout::mask_cnt][sbytes];
+  uint8_t acc[sbytes];
+
+  fixed_masks<slen, layout::mask_cnt>(ctx.ekey, lm);
+
+  fixed_xor_keystream<slen, rounds, ctlen>(lm, nonce, txt, enc);
+  fixed_absorb_data<slen, rounds, dlen>(lm, nonce, data, acc);
+  fixed_absorb_cipher<slen, rounds, ctlen>(lm, enc, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+
+  secure_zero(lm, sizeof(lm));
+}
+
+// Given key context, 12 -bytes public message nonce, (tlen >> 3) -bytes
+// authentication tag, `dlen` -bytes associated data & `ctlen` -bytes encrypted
+// text, this routine computes `ctlen` -bytes plain text & boolean verification
+// flag, using Dumbo/ Jumbo/ Delirium AEAD scheme | dlen, ctlen <= FIXED_MAX_LEN
+//
+// Note, authentication tag is verified before decrypting, so unverified plain
+// text is never released; on failure plain text is zeroed.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t ctlen>
+static bool
+decrypt(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // `tlen` -bit authentication tag
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict enc,   // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict txt          // `ctlen` -bytes plain text
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen) && check_fixed_len(dlen, ctlen))
+{
+  using layout = fixed_layout_t<slen, dlen, ctlen>;
+  constexpr size_t sbytes = layout::sbytes;
+
+  uint8_t lm[layout::mask_cnt][sbytes];
+  uint8_t acc[sbytes];
+  uint8_t tag_[tlen >> 3];
+
+  fixed_masks<slen, layout::mask_cnt>(ctx.ekey, lm);
+
+  fixed_absorb_data<slen, rounds, dlen>(lm, nonce, data, acc);
+  fixed_absorb_cipher<slen, rounds, ctlen>(lm, enc, acc);
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag_);
+
+  const bool flg = verify_tag<tlen>(tag, tag_);
+
+  if (flg) {
+    fixed_xor_keystream<slen, rounds, ctlen>(lm, nonce, enc, txt);
+  } else {
+    std::memset(txt, 0, ctlen);
+  }
+
+  secure_zero(lm, sizeof(lm));
+  return flg;
+}
+
+// Same as fixed-length `elephant::encrypt` with key context, except secret key
+// is expanded ( only once ) on the fly
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t ctlen>
+static void
+encrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict txt,   // `ctlen` -bytes plain text
+        uint8_t* const __restrict enc,         // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict tag          // `tlen` -bit authentication tag
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen) && check_fixed_len(dlen, ctlen))
+{
+  const key_ctx_t<slen, rounds> ctx{ key };
+  encrypt<slen, rounds, tlen, dlen, ctlen>(ctx, nonce, data, txt, enc, tag);
+}
+
+// Same as fixed-length `elephant::decrypt` with key context, except secret key
+// is expanded ( only once ) on the fly
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t ctlen>
+static bool
+decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // `tlen` -bit authentication tag
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict enc,   // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict txt          // `ctlen` -bytes plain text
+        ) requires(spongent::check_state_bit_len(slen) &&
+                   check_tag_bit_len(tlen) && check_fixed_len(dlen, ctlen))
+{
+  const key_ctx_t<slen, rounds> ctx{ key };
+  return decrypt<slen, rounds, tlen, dlen, ctlen>(
+    ctx, nonce, tag, data, enc, txt);
+}
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+#include "multi.hpp"
+#include "split.hpp"
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+// Long-lived AEAD context, which is what opaque context handles of C-ABI (
+// & language bindings built on top of it ) point to, so that repeated {en,
+// de}cryptions under same key skip all key derivation work
+namespace elephant {
+
+// AEAD context holding expanded key &, optionally, mask table ( see
+// `mb_table_t` ) prebuilt for messages of up to `max_len` -bytes associated
+// data/ text, both zeroed when context is destroyed
+//
+// Table covers at most `max_table_len` -bytes, longer `max_len` is clamped,
+// so that sizing it can neither overflow nor ask for absurd amounts of
+// memory; bindings reject such `max_len` up front.
+//
+// Messages needing at least `mb_min_units` -many permutation calls ( which
+// fit in the table ) are pushed through multi-state permutation lanes, as
+// their keystream, associated data & ( when decrypting ) cipher text blocks
+// are all independent of each other, while shorter ones take scalar path,
+// which doesn't leave lanes mostly empty. Table is scratch space, so it's
+// guarded by a mutex; a thread finding it busy takes scalar path, making
+// context safe to share among threads.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class aead_ctx_t
+{
+public:
+  static constexpr size_t sbytes = slen >> 3;
+  static constexpr size_t mb_min_units = LANES / 2;
+  static constexpr size_t max_table_len = 1ul << 24;
+
+  key_ctx_t<slen, rounds> ctx;
+
+  // Expands secret key & builds mask table, when `max_len` > 0
+  aead_ctx_t(const uint8_t* const key, // 128 -bit secret key
+             const size_t max_len      // longest message to cover | >= 0
+             )
+    : ctx(key)
+  {
+    if (max_len > 0) {
+      const size_t len = std::min(max_len, max_table_len);
+
+      max_blks = (12 + len + 1 + sbytes - 1) / sbytes;
+      // table never grows past `max_len`, so keep it whole between calls
+      tab = std::make_unique<mb_table_t<slen, rounds>>(ctx, ~0ul);
+      tab->reserve(max_blks + 2);
+    }
+  }
+
+  aead_ctx_t(const aead_ctx_t&) = delete;
+  aead_ctx_t& operator=(const aead_ctx_t&) = delete;
+
+  // Encrypts one message, producing same output as `elephant::encrypt`
+  void encrypt(const uint8_t* const __restrict nonce, // 96 -bit nonce
+               const uint8_t* const __restrict data,  // N -bytes assoc. data
+               const size_t dlen,                     // len(data) = N | >= 0
+               const uint8_t* const __restrict txt,   // M -bytes plain text
+               uint8_t* const __restrict enc,         // M -bytes cipher text
+               const size_t ctlen,                    // len(txt) = M | >= 0
+               uint8_t* const __restrict tag          // authentication tag
+  )
+  {
+    if (!run_lanes<false>(nonce, data, dlen, txt, enc, ctlen, tag)) {
+      elephant::encrypt<slen, rounds, tlen>(
+        ctx, nonce, data, dlen, txt, enc, ctlen, tag);
+    }
+  }
+
+  // Verifies & decrypts one message, producing same output as
+  // `elephant::decrypt`
+  bool decrypt(const uint8_t* const __restrict nonce, // 96 -bit nonce
+               const uint8_t* const __restrict tag,   // authentication tag
+               const uint8_t* const __restrict data,  // N -bytes assoc. data
+               const size_t dlen,                     // len(data) = N | >= 0
+               const uint8_t* const __restrict enc,   // M -bytes cipher text
+               uint8_t* const __restrict txt,         // M -bytes plain text
+               const size_t ctlen                     // len(enc) = M | >= 0
+  )
+  {
+    uint8_t* const tag_ = const_cast<uint8_t*>(tag);
+
+    bool flag = false;
+    if (run_lanes<true>(nonce, data, dlen, enc, txt, ctlen, tag_, &flag)) {
+      return flag;
+    }
+    return elephant::decrypt<slen, rounds, tlen>(
+      ctx, nonce, tag, data, dlen, enc, txt, ctlen);
+  }
+
+  // Whether mask table was built
+  inline bool has_table() const { return tab != nullptr; }
+
+  // Occupancy of lanes, over messages which went through them
+  mb_stats_t stats()
+  {
+    std::lock_guard<std::mutex> lock(tab_mtx);
+    return lane_stats;
+  }
+
+  // Visits context's own memory, which every {en, de}cryption touches, as
+  // `visit(ptr, len, writes)`, so that benchmarks can tell which cache lines
+  // threads sharing context fight over; expanded key & table fields are only
+  // read, while table's mutex & lane statistics, updated under it, are
+  // written ( as one ) by any thread trying to use table
+  template<typename F>
+  void footprint(F&& visit) const
+  {
+    visit(&ctx, sizeof(ctx), false);
+    visit(&tab, sizeof(tab), false);
+    visit(&max_blks, sizeof(max_blks), false);
+
+    if (tab != nullptr) {
+      const auto* const beg = reinterpret_cast<const uint8_t*>(&tab_mtx);
+      const auto* const end = reinterpret_cast<const uint8_t*>(&lane_stats + 1);
+
+      visit(beg, static_cast<size_t>(end - beg), true);
+    }
+  }
+
+private:
+  // read by every call, before trying to take table
+  std::unique_ptr<mb_table_t<slen, rounds>> tab;
+  size_t max_blks = 0;
+
+  // written by every thread trying to take table, so it's kept off cache
+  // line(s) of fields above & of expanded key
+  alignas(64) std::mutex tab_mtx;
+  mb_stats_t lane_stats;
+
+  // {En, De}crypts message through lanes, if it's long enough, fits in mask
+  // table & table isn't in use, returning whether it did
+  template<const bool decrypting>
+  bool run_lanes(const uint8_t* const nonce,
+                 const uint8_t* const data,
+                 const size_t dlen,
+                 const uint8_t* const in,
+                 uint8_t* const out,
+                 const size_t ctlen,
+                 uint8_t* const tag,
+                 bool* const flag = nullptr)
+  {
+    if (tab == nullptr) {
+      return false;
+    }
+
+    const split_plan_t<slen> plan(dlen, ctlen);
+    if ((plan.units() < mb_min_units) || (plan.ad_blks + 1 > max_blks) ||
+        (plan.ct_blks > max_blks)) {
+      return false;
+    }
+
+    std::unique_lock<std::mutex> lock(tab_mtx, std::try_to_lock);
+    if (!lock.owns_lock()) {
+      return false;
+    }
+
+    mb_msg_t msg{ nonce, data, dlen, in, out, ctlen, tag };
+    if constexpr (decrypting) {
+      *flag = decrypt_multi<slen, rounds, tlen>(*tab, &msg, 1, lane_stats);
+    } else {
+      encrypt_multi<slen, rounds, tlen>(*tab, &msg, 1, lane_stats);
+    }
+    return true;
+  }
+};
+
+}
@@ -0,0 +1,1036 @@
+#pragma once
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "segment.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>) && __has_include(<sys/eventfd.h>)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) &&            \
+  defined(__NR_io_uring_register)
+#define ELEPHANT_HAS_IO_URING
+#endif
+#endif
+
+// Asynchronous ( io_uring driven ) file {en, de}cryption pipeline for Elephant
+// Authenticated Encryption with Associated Data, which overlaps reads,
+// {en, de}cryption & writes, producing/ consuming segmented stream format
+namespace elephant {
+
+// Tuning knobs of I/O pipeline
+struct io_pipeline_opts_t
+{
+  size_t queue_depth = 8;   // # -of buffers ( i.e. segments ) in flight
+  size_t buf_size = 1 << 20; // # -of plain text bytes per buffer ( segment )
+  bool use_uring = true;    // falls back to blocking I/O, when false/ missing
+};
+
+// Byte range to be read from input & written to output, for i-th segment
+struct io_job_t
+{
+  uint64_t in_off = 0;
+  size_t in_len = 0;
+  uint64_t out_off = 0;
+  size_t out_len = 0;
+};
+
+#if defined(ELEPHANT_HAS_IO_URING)
+
+// Minimal io_uring binding over raw system calls ( i.e. without liburing ),
+// covering only what's needed by I/O pipeline
+class uring_t
+{
+private:
+  int ring_fd = -1;
+
+  void* sq_ptr = MAP_FAILED;
+  void* cq_ptr = MAP_FAILED;
+  size_t sq_sz = 0;
+  size_t cq_sz = 0;
+
+  io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+  size_t sqes_sz = 0;
+
+  unsigned* sq_head = nullptr;
+  unsigned* sq_tail = nullptr;
+  unsigned* sq_mask = nullptr;
+  unsigned* sq_array = nullptr;
+  unsigned sq_entries = 0;
+
+  unsigned* cq_head = nullptr;
+  unsigned* cq_tail = nullptr;
+  unsigned* cq_mask = nullptr;
+  io_uring_cqe* cqes = nullptr;
+
+  unsigned to_submit = 0;
+
+public:
+  uring_t() = default;
+  uring_t(const uring_t&) = delete;
+  uring_t& operator=(const uring_t&) = delete;
+
+  ~uring_t()
+  {
+    if (sqes != MAP_FAILED) {
+      munmap(sqes, sqes_sz);
+    }
+    if ((cq_ptr != MAP_FAILED) && (cq_ptr != sq_ptr)) {
+      munmap(cq_ptr, cq_sz);
+    }
+    if (sq_ptr != MAP_FAILED) {
+      munmap(sq_ptr, sq_sz);
+    }
+    if (ring_fd >= 0) {
+      close(ring_fd);
+    }
+  }
+
+  // Sets up submission & completion queues of ( at least ) `entries` -many
+  // slots, returning false, if io_uring is unavailable ( say, old kernel or
+  // disallowed by seccomp policy )
+  bool init(const unsigned entries)
+  {
+    io_uring_params p{};
+
+    ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &p));
+    if (ring_fd < 0) {
+      return false;
+    }
+
+    sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+
+    const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+      sq_sz = cq_sz = std::max(sq_sz, cq_sz);
+    }
+
+    sq_ptr = mmap(nullptr,
+                  sq_sz,
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED | MAP_POPULATE,
+                  ring_fd,
+                  IORING_OFF_SQ_RING);
+    if (sq_ptr == MAP_FAILED) {
+      return false;
+    }
+
+    if (single) {
+      cq_ptr = sq_ptr;
+    } else {
+      cq_ptr = mmap(nullptr,
+                    cq_sz,
+                    PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE,
+                    ring_fd,
+                    IORING_OFF_CQ_RING);
+      if (cq_ptr == MAP_FAILED) {
+        return false;
+      }
+    }
+
+    sqes_sz = p.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe*>(mmap(nullptr,
+                                           sqes_sz,
+                                           PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE,
+                                           ring_fd,
+                                           IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+      return false;
+    }
+
+    uint8_t* const sq = static_cast<uint8_t*>(sq_ptr);
+    uint8_t* const cq = static_cast<uint8_t*>(cq_ptr);
+
+    sq_head = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+    sq_tail = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+    sq_mask = reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+    sq_entries = p.sq_entries;
+
+    cq_head = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+    cq_mask = reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+
+    return true;
+  }
+
+  // Registers buffers with kernel, so that fixed reads/ writes skip pinning
+  // ( and unpinning ) user pages on every request
+  bool register_buffers(const iovec* const iovs, const unsigned cnt)
+  {
+    const long r = syscall(
+      __NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iovs, cnt);
+    return r == 0;
+  }
+
+  // Whether running kernel supports given request opcode; kernels older than
+  // 5.6 can't be probed, so they report false
+  bool supports(const unsigned op)
+  {
+    constexpr unsigned nops = 256;
+
+    std::vector<uint8_t> buf(sizeof(io_uring_probe) +
+                             nops * sizeof(io_uring_probe_op));
+    io_uring_probe* const probe = reinterpret_cast<io_uring_probe*>(buf.data());
+
+    const long r = syscall(
+      __NR_io_uring_register, ring_fd, IORING_REGISTER_PROBE, probe, nops);
+    if ((r != 0) || (op >= probe->ops_len)) {
+      return false;
+    }
+
+    return (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+  }
+
+  // Returns next free submission queue entry ( zeroed ), or null pointer, if
+  // submission queue is full
+  io_uring_sqe* get_sqe()
+  {
+    const unsigned head = __atomic_load_n(sq_head, __ATOMIC_ACQUIRE);
+    const unsigned tail = *sq_tail;
+
+    if (tail - head >= sq_entries) {
+      return nullptr;
+    }
+
+    const unsigned idx = tail & *sq_mask;
+    io_uring_sqe* const sqe = &sqes[idx];
+
+    std::memset(sqe, 0, sizeof(*sqe));
+    sq_array[idx] = idx;
+
+    __atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+    to_submit++;
+
+    return sqe;
+  }
+
+  // Submits queued entries & waits for at least `wait_nr` -many completions
+  int submit_and_wait(const unsigned wait_nr)
+  {
+    const unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+
+    while (true) {
+      const long r = syscall(
+        __NR_io_uring_enter, ring_fd, to_submit, wait_nr, flags, nullptr, 0);
+
+      if (r >= 0) {
+        to_submit -= std::min<unsigned>(to_submit, static_cast<unsigned>(r));
+        return 0;
+      }
+      if (errno != EINTR) {
+        return -errno;
+      }
+    }
+  }
+
+  // Pops next completion, if any
+  bool pop_cqe(io_uring_cqe& cqe)
+  {
+    const unsigned head = *cq_head;
+    const unsigned tail = __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE);
+
+    if (head == tail) {
+      return false;
+    }
+
+    cqe = cqes[head & *cq_mask];
+    __atomic_store_n(cq_head, head + 1, __ATOMIC_RELEASE);
+
+    return true;
+  }
+};
+
+#endif
+
+// Pipeline of `queue_depth` -many buffers ( slots ), each carrying one segment
+// through read -> {en, de}crypt -> write stages
+//
+// With io_uring, reads & writes of all slots are issued asynchronously, using
+// registered ( fixed ) buffers, while {en, de}cryption runs on thread pool;
+// worker threads signal completion through an eventfd, which is itself read
+// via io_uring, so a single event loop waits on both I/O & compute. So disk
+// keeps reading ahead ( and writing behind ) while cores {en, de}crypt.
+//
+// Without io_uring, batches of `queue_depth` -many segments are read, {en,
+// de}crypted in parallel & written, using blocking I/O.
+class io_pipeline_t
+{
+private:
+  enum class stage_t
+  {
+    idle,
+    reading,
+    computing,
+    writing
+  };
+
+  struct slot_t
+  {
+    uint8_t* in = nullptr;
+    uint8_t* out = nullptr;
+    uint64_t job = 0;
+    io_job_t io;
+    size_t done = 0;
+    bool ok = true;
+    stage_t stage = stage_t::idle;
+  };
+
+  const size_t qd;
+  const size_t in_cap;
+  const size_t out_cap;
+  std::vector<slot_t> slots;
+  bool uring_on = false;
+
+#if defined(ELEPHANT_HAS_IO_URING)
+  uring_t ring;
+  int evfd = -1;
+  uint64_t evbuf = 0;
+  bool ev_armed = false; // read of eventfd in flight
+  size_t inflight = 0;   // # -of queued requests, not yet completed
+  bool abandoned = false; // requests may still touch buffers, don't free them
+  std::atomic<size_t> computing{ 0 }; // # -of compute tasks in flight
+
+  std::mutex done_mtx;
+  std::vector<size_t> done_slots; // slots whose compute finished
+#endif
+
+  static constexpr uint64_t EV_TAG = ~0ul;
+
+  static inline uint8_t* alloc_buffer(const size_t len)
+  {
+    const size_t alen = (std::max<size_t>(len, 1) + 4095) & ~4095ul;
+    return static_cast<uint8_t*>(std::aligned_alloc(4096, alen));
+  }
+
+  // Reads/ writes exactly `len` -bytes at given offset, using blocking I/O
+  static inline bool pread_full(int fd, uint8_t* buf, size_t len, uint64_t off)
+  {
+    while (len > 0) {
+      const ssize_t r = pread(fd, buf, len, static_cast<off_t>(off));
+      if (r < 0 && errno == EINTR) {
+        continue;
+      }
+      if (r <= 0) {
+        return false;
+      }
+
+      buf += r;
+      len -= r;
+      off += r;
+    }
+    return true;
+  }
+
+  static inline bool pwrite_full(int fd,
+                                 const uint8_t* buf,
+                                 size_t len,
+                                 uint64_t off)
+  {
+    while (len > 0) {
+      const ssize_t r = pwrite(fd, buf, len, static_cast<off_t>(off));
+      if (r < 0 && errno == EINTR) {
+        continue;
+      }
+      if (r <= 0) {
+        return false;
+      }
+
+      buf += r;
+      len -= r;
+      off += r;
+    }
+    return true;
+  }
+
+  template<typename JobF, typename ComputeF>
+  bool run_blocking(const int in_fd,
+                    const int out_fd,
+                    const uint64_t cnt,
+                    JobF& job,
+                    ComputeF& compute,
+                    thread_pool_t& pool)
+  {
+    std::vector<std::future<void>> futs;
+    futs.reserve(qd);
+
+    for (uint64_t beg = 0; beg < cnt; beg += qd) {
+      const size_t n = std::min<uint64_t>(qd, cnt - beg);
+
+      for (size_t j = 0; j < n; j++) {
+        slot_t& s = slots[j];
+        s.job = beg + j;
+        s.io = job(s.job);
+
+        if (!pread_full(in_fd, s.in, s.io.in_len, s.io.in_off)) {
+          return false;
+        }
+      }
+
+      futs.clear();
+      for (size_t j = 0; j < n; j++) {
+        slot_t* const s = &slots[j];
+        futs.emplace_back(pool.submit(
+          [s, &compute]() { s->ok = compute(s->job, s->in, s->out); }));
+      }
+      for (auto& f : futs) {
+        f.wait();
+      }
+
+      for (size_t j = 0; j < n; j++) {
+        slot_t& s = slots[j];
+
+        if (!s.ok || !pwrite_full(out_fd, s.out, s.io.out_len, s.io.out_off)) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+#if defined(ELEPHANT_HAS_IO_URING)
+
+  // Queues read ( or write ) of remaining bytes of slot's current stage
+  //
+  // Ring has room for twice the # -of requests which can ever be in flight (
+  // one per slot + eventfd read ), so it never runs out of entries.
+  inline void queue_io(const size_t idx, const int fd)
+  {
+    io_uring_sqe* const sqe = ring.get_sqe();
+
+    slot_t& s = slots[idx];
+    const bool rd = s.stage == stage_t::reading;
+
+    sqe->opcode = rd ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>((rd ? s.in : s.out) + s.done);
+    const size_t len = rd ? s.io.in_len : s.io.out_len;
+
+    sqe->len = static_cast<uint32_t>(len - s.done);
+    sqe->off = (rd ? s.io.in_off : s.io.out_off) + s.done;
+    sqe->buf_index = static_cast<uint16_t>(2 * idx + !rd);
+    sqe->user_data = idx;
+
+    inflight++;
+  }
+
+  // Queues read of eventfd, which completes once some compute task finishes
+  inline void queue_event_read()
+  {
+    if (ev_armed) {
+      return;
+    }
+
+    io_uring_sqe* const sqe = ring.get_sqe();
+    ev_armed = true;
+
+    sqe->opcode = IORING_OP_READ;
+    sqe->fd = evfd;
+    sqe->addr = reinterpret_cast<uint64_t>(&evbuf);
+    sqe->len = sizeof(evbuf);
+    sqe->off = 0;
+    sqe->user_data = EV_TAG;
+
+    inflight++;
+  }
+
+  template<typename ComputeF>
+  inline void dispatch_compute(const size_t idx,
+                               ComputeF& compute,
+                               thread_pool_t& pool)
+  {
+    slot_t* const s = &slots[idx];
+    s->stage = stage_t::computing;
+    computing.fetch_add(1, std::memory_order_relaxed);
+
+    pool.submit([this, s, idx, &compute]() {
+      s->ok = compute(s->job, s->in, s->out);
+
+      {
+        std::lock_guard<std::mutex> lock(done_mtx);
+        done_slots.push_back(idx);
+      }
+
+      const uint64_t one = 1;
+      [[maybe_unused]] const ssize_t r = write(evfd, &one, sizeof(one));
+
+      computing.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // Waits for every queued request to complete, as they may still be reading
+  // into/ writing from slot buffers, after event loop gave up; returns false,
+  // if ring itself keeps failing, in which case buffers must never be freed
+  inline bool drain()
+  {
+    // no compute task may signal anymore, so complete eventfd read ourselves
+    while (computing.load(std::memory_order_acquire) > 0) {
+      std::this_thread::yield();
+    }
+
+    const uint64_t one = 1;
+    [[maybe_unused]] const ssize_t r = write(evfd, &one, sizeof(one));
+
+    while (true) {
+      io_uring_cqe cqe;
+      while (ring.pop_cqe(cqe)) {
+        inflight--;
+      }
+
+      if (inflight == 0) {
+        ev_armed = false;
+        return true;
+      }
+      if (ring.submit_and_wait(1) != 0) {
+        return false;
+      }
+    }
+  }
+
+  template<typename JobF, typename ComputeF>
+  bool run_uring(const int in_fd,
+                 const int out_fd,
+                 const uint64_t cnt,
+                 JobF& job,
+                 ComputeF& compute,
+                 thread_pool_t& pool)
+  {
+    uint64_t next = 0;
+    uint64_t finished = 0;
+    size_t busy = 0; // # -of slots in some stage
+    bool failed = false;
+
+    // moves idle slot to reading stage, with next job
+    auto start = [&](const size_t idx) {
+      slot_t& s = slots[idx];
+
+      s.job = next++;
+      s.io = job(s.job);
+      s.done = 0;
+      s.ok = true;
+      s.stage = stage_t::reading;
+      busy++;
+
+      if (s.io.in_len == 0) {
+        dispatch_compute(idx, compute, pool);
+      } else {
+        queue_io(idx, in_fd);
+      }
+    };
+
+    for (size_t i = 0; (i < qd) && (next < cnt); i++) {
+      start(i);
+    }
+    queue_event_read();
+
+    while (busy > 0) {
+      if (ring.submit_and_wait(1) != 0) {
+        // can't make progress; wait for requests & compute tasks touching
+        // buffers ( retrying once completions are reaped, say on -EBUSY )
+        abandoned = !drain();
+        return false;
+      }
+
+      io_uring_cqe cqe;
+      while (ring.pop_cqe(cqe)) {
+        inflight--;
+
+        if (cqe.user_data == EV_TAG) {
+          ev_armed = false;
+          std::vector<size_t> ready;
+          {
+            std::lock_guard<std::mutex> lock(done_mtx);
+            ready.swap(done_slots);
+          }
+
+          for (const size_t idx : ready) {
+            slot_t& s = slots[idx];
+
+            if (!s.ok || failed) {
+              failed = true;
+              s.stage = stage_t::idle;
+              busy--;
+              continue;
+            }
+
+            s.stage = stage_t::writing;
+            s.done = 0;
+
+            if (s.io.out_len == 0) {
+              s.stage = stage_t::idle;
+              busy--;
+              finished++;
+
+              if (next < cnt) {
+                start(idx);
+              }
+            } else {
+              queue_io(idx, out_fd);
+            }
+          }
+
+          queue_event_read();
+          continue;
+        }
+
+        const size_t idx = cqe.user_data;
+        slot_t& s = slots[idx];
+
+        const bool rd = s.stage == stage_t::reading;
+        const size_t len = rd ? s.io.in_len : s.io.out_len;
+
+        if ((cqe.res == -EAGAIN) || (cqe.res == -EINTR)) {
+          queue_io(idx, rd ? in_fd : out_fd);
+          continue;
+        }
+        if ((cqe.res <= 0) || failed) {
+          failed = true;
+          s.stage = stage_t::idle;
+          busy--;
+          continue;
+        }
+
+        s.done += static_cast<size_t>(cqe.res);
+        if (s.done < len) {
+          queue_io(idx, rd ? in_fd : out_fd);
+          continue;
+        }
+
+        if (rd) {
+          dispatch_compute(idx, compute, pool);
+        } else {
+          s.stage = stage_t::idle;
+          busy--;
+          finished++;
+
+          if (next < cnt) {
+            start(idx);
+          }
+        }
+      }
+    }
+
+    // last compute tasks may still be signalling eventfd
+    while (computing.load(std::memory_order_acquire) > 0) {
+      std::this_thread::yield();
+    }
+
+    return !failed && (finished == cnt);
+  }
+
+  // Sets up ring, registers slot buffers & eventfd, returning false, if any of
+  // them fails, in which case blocking I/O is used
+  //
+  // Eventfd is read using IORING_OP_READ, which kernels older than 5.6 reject
+  // on every attempt, so event loop would spin, re-arming it; such kernels get
+  // blocking I/O too.
+  inline bool setup_uring()
+  {
+    if (!ring.init(static_cast<unsigned>(2 * qd + 2))) {
+      return false;
+    }
+    if (!ring.supports(IORING_OP_READ)) {
+      return false;
+    }
+
+    std::vector<iovec> iovs(2 * qd);
+    for (size_t i = 0; i < qd; i++) {
+      iovs[2 * i] = iovec{ slots[i].in, in_cap };
+      iovs[2 * i + 1] = iovec{ slots[i].out, out_cap };
+    }
+
+    const unsigned cnt = static_cast<unsigned>(iovs.size());
+    if (!ring.register_buffers(iovs.data(), cnt)) {
+      return false;
+    }
+
+    evfd = eventfd(0, EFD_CLOEXEC);
+    return evfd >= 0;
+  }
+
+#endif
+
+public:
+  // Pipeline of `queue_depth` -many slots, each holding `in_cap` -bytes input
+  // & `out_cap` -bytes output buffer; io_uring is used, when requested &
+  // available
+  io_pipeline_t(const size_t queue_depth,
+                const size_t in_cap_,
+                const size_t out_cap_,
+                const bool use_uring)
+    : qd(std::max<size_t>(queue_depth, 1))
+    , in_cap(in_cap_)
+    , out_cap(out_cap_)
+    , slots(qd)
+  {
+    for (auto& s : slots) {
+      s.in = alloc_buffer(in_cap);
+      s.out = alloc_buffer(out_cap);
+    }
+
+#if defined(ELEPHANT_HAS_IO_URING)
+    uring_on = use_uring && setup_uring();
+#else
+    (void)use_uring;
+#endif
+  }
+
+  io_pipeline_t(const io_pipeline_t&) = delete;
+  io_pipeline_t& operator=(const io_pipeline_t&) = delete;
+
+  ~io_pipeline_t()
+  {
+#if defined(ELEPHANT_HAS_IO_URING)
+    // eventfd read stays armed between runs, targeting `evbuf`
+    if (uring_on && (inflight > 0)) {
+      abandoned = !drain();
+    }
+    if (evfd >= 0) {
+      close(evfd);
+    }
+
+    // kernel may still access buffers of requests which never completed, so
+    // leaking them is the only safe option
+    if (abandoned) {
+      return;
+    }
+#endif
+
+    for (auto& s : slots) {
+      secure_zero(s.in, in_cap);
+      secure_zero(s.out, out_cap);
+      std::free(s.in);
+      std::free(s.out);
+    }
+  }
+
+  // Whether io_uring is being used, instead of blocking I/O
+  bool uring_active() const { return uring_on; }
+
+  // Runs `cnt` -many jobs through pipeline, where `job(i)` returns byte ranges
+  // of i-th job & `compute(i, in, out)` turns `in_len` -bytes input into
+  // `out_len` -bytes output, returning false on failure; returns false, if any
+  // I/O or compute step fails
+  //
+  // Note, on failure, some outputs might already be written.
+  template<typename JobF, typename ComputeF>
+  bool run(const int in_fd,
+           const int out_fd,
+           const uint64_t cnt,
+           JobF&& job,
+           ComputeF&& compute,
+           thread_pool_t& pool)
+  {
+#if defined(ELEPHANT_HAS_IO_URING)
+    if (uring_on) {
+      return run_uring(in_fd, out_fd, cnt, job, compute, pool);
+    }
+#endif
+    return run_blocking(in_fd, out_fd, cnt, job, compute, pool);
+  }
+};
+
+// Sets length of output file to exactly `len` -bytes, so that nothing left over
+// from its previous ( longer ) content survives past end of output; outputs
+// which aren't regular files ( say, block devices ) are left as they are
+static inline bool
+truncate_output(const int fd, const uint64_t len)
+{
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    return false;
+  }
+  if (!S_ISREG(st.st_mode)) {
+    return true;
+  }
+
+  return ftruncate(fd, static_cast<off_t>(len)) == 0;
+}
+
+// Encrypts whole input file into output file ( from offset 0, truncating it to
+// length of segmented stream ), in segmented stream format, with segment length
+// = `opts.buf_size`, overlapping I/O with encryption on thread pool | returns
+// false on I/O failure
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+pipeline_encrypt(const key_ctx_t<slen, rounds>& ctx, // expanded key context
+                 const uint8_t* const nonce,         // 96 -bit base nonce
+                 const int in_fd,                    // input file
+                 const int out_fd,                   // output file
+                 thread_pool_t& pool,                // compute workers
+                 const io_pipeline_opts_t& opts = {} // tuning knobs
+                 ) requires(spongent::check_state_bit_len(slen) &&
+                            check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  struct stat st;
+  if (fstat(in_fd, &st) != 0) {
+    return false;
+  }
+
+  const uint64_t in_len = static_cast<uint64_t>(st.st_size);
+  const uint32_t seg_len = static_cast<uint32_t>(
+    std::clamp<size_t>(opts.buf_size, 1, SEGMENT_MAX_LEN));
+  const uint64_t cnt = std::max<uint64_t>(1, (in_len + seg_len - 1) / seg_len);
+
+  segment_header_t h;
+  h.sbytes = slen >> 3;
+  h.tbytes = tbytes;
+  h.seg_len = seg_len;
+  std::memcpy(h.nonce, nonce, 12);
+
+  uint8_t hdr[SEGMENT_HEADER_LEN];
+  h.encode(hdr);
+
+  if (!truncate_output(out_fd, SEGMENT_HEADER_LEN + in_len + cnt * tbytes)) {
+    return false;
+  }
+
+  const ssize_t r = pwrite(out_fd, hdr, sizeof(hdr), 0);
+  if (r != static_cast<ssize_t>(sizeof(hdr))) {
+    return false;
+  }
+
+  auto job = [&](const uint64_t i) {
+    io_job_t j;
+    j.in_off = i * seg_len;
+    j.in_len = std::min<uint64_t>(seg_len, in_len - j.in_off);
+    j.out_off = segment_offset<tlen>(seg_len, i);
+    j.out_len = j.in_len + tbytes;
+    return j;
+  };
+
+  auto compute = [&](const uint64_t i, const uint8_t* in, uint8_t* out) {
+    const size_t len = std::min<uint64_t>(seg_len, in_len - i * seg_len);
+    seal_segment<slen, rounds, tlen>(ctx, hdr, i, i + 1 == cnt, in, len, out);
+    return true;
+  };
+
+  const size_t qd = opts.queue_depth;
+  io_pipeline_t pipe(qd, seg_len, seg_len + tbytes, opts.use_uring);
+  return pipe.run(in_fd, out_fd, cnt, job, compute, pool);
+}
+
+// Verifies & decrypts segmented stream in input file into output file ( from
+// offset 0, truncating it to plain text length ), overlapping I/O with
+// decryption on thread pool | returns false, if stream is malformed, any
+// segment fails verification or I/O fails
+//
+// Note, plain text of segments already verified may have been written, when
+// this fails, so caller should discard output file in that case.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+pipeline_decrypt(const key_ctx_t<slen, rounds>& ctx, // expanded key context
+                 const int in_fd,                    // input file
+                 const int out_fd,                   // output file
+                 thread_pool_t& pool,                // compute workers
+                 const io_pipeline_opts_t& opts = {} // tuning knobs
+                 ) requires(spongent::check_state_bit_len(slen) &&
+                            check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  struct stat st;
+  if (fstat(in_fd, &st) != 0) {
+    return false;
+  }
+
+  auto src = [in_fd](uint64_t off, uint8_t* buf, size_t len) -> size_t {
+    const ssize_t r = pread(in_fd, buf, len, static_cast<off_t>(off));
+    return r < 0 ? 0 : static_cast<size_t>(r);
+  };
+
+  const segment_reader_t<slen, rounds, tlen> rd(ctx, src, st.st_size);
+  if (!rd.valid()) {
+    return false;
+  }
+
+  uint8_t hdr[SEGMENT_HEADER_LEN];
+  if (src(0, hdr, sizeof(hdr)) != sizeof(hdr)) {
+    return false;
+  }
+
+  if (!truncate_output(out_fd, rd.plain_len())) {
+    return false;
+  }
+
+  const uint32_t seg_len = rd.segment_len();
+  const uint64_t cnt = rd.segment_count();
+
+  auto job = [&](const uint64_t i) {
+    io_job_t j;
+    j.in_off = segment_offset<tlen>(seg_len, i);
+    j.in_len = rd.segment_plain_len(i) + tbytes;
+    j.out_off = i * seg_len;
+    j.out_len = rd.segment_plain_len(i);
+    return j;
+  };
+
+  auto compute = [&](const uint64_t i, const uint8_t* in, uint8_t* out) {
+    const size_t len = rd.segment_plain_len(i);
+    return open_segment<slen, rounds, tlen>(
+      ctx, hdr, i, i + 1 == cnt, in, len, out);
+  };
+
+  const size_t qd = opts.queue_depth;
+  io_pipeline_t pipe(qd, seg_len + tbytes, seg_len, opts.use_uring);
+  return pipe.run(in_fd, out_fd, cnt, job, compute, pool);
+}
+
+}
+
+// Dumbo, Jumbo & Delirium flavours of file pipeline, kept out of variant
+// headers, as it's Linux only & pulls in io_uring
+namespace dumbo {
+
+// Encrypts whole input file into output file, in segmented stream format (
+// segment length = `opts.buf_size` ), using Dumbo AEAD, overlapping I/O (
+// io_uring, when available ) with encryption on thread pool
+inline static bool
+pipeline_encrypt(const key_ctx_t& ctx,                      // key context
+                 const uint8_t* const nonce,                // 96 -bit nonce
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_encrypt<a, b, c>(
+    ctx, nonce, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+// Verifies & decrypts segmented stream in input file into output file, using
+// Dumbo AEAD, overlapping I/O ( io_uring, when available ) with decryption
+// on thread pool | on failure, output file should be discarded
+inline static bool
+pipeline_decrypt(const key_ctx_t& ctx,                      // key context
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_decrypt<a, b, c>(ctx, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+}
+
+namespace jumbo {
+
+// Encrypts whole input file into output file, in segmented stream format (
+// segment length = `opts.buf_size` ), using Jumbo AEAD, overlapping I/O (
+// io_uring, when available ) with encryption on thread pool
+inline static bool
+pipeline_encrypt(const key_ctx_t& ctx,                      // key context
+                 const uint8_t* const nonce,                // 96 -bit nonce
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_encrypt<a, b, c>(
+    ctx, nonce, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+// Verifies & decrypts segmented stream in input file into output file, using
+// Jumbo AEAD, overlapping I/O ( io_uring, when available ) with decryption
+// on thread pool | on failure, output file should be discarded
+inline static bool
+pipeline_decrypt(const key_ctx_t& ctx,                      // key context
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_decrypt<a, b, c>(ctx, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+}
+
+namespace delirium {
+
+// Encrypts whole input file into output file, in segmented stream format (
+// segment length = `opts.buf_size` ), using Delirium AEAD, overlapping I/O (
+// io_uring, when available ) with encryption on thread pool
+inline static bool
+pipeline_encrypt(const key_ctx_t& ctx,                      // key context
+                 const uint8_t* const nonce,                // 96 -bit nonce
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_encrypt<a, b, c>(
+    ctx, nonce, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+// Verifies & decrypts segmented stream in input file into output file, using
+// Delirium AEAD, overlapping I/O ( io_uring, when available ) with decryption
+// on thread pool | on failure, output file should be discarded
+inline static bool
+pipeline_decrypt(const key_ctx_t& ctx,                      // key context
+                 const int in_fd,                           // input file
+                 const int out_fd,                          // output file
+                 elephant::thread_pool_t& pool,             // compute workers
+                 const elephant::io_pipeline_opts_t& opts = {} // tuning knobs
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::pipeline_decrypt<a, b, c>(ctx, in_fd, out_fd, pool, opts);
+  return f;
+}
+
+}
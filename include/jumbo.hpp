@@ -1,5 +1,18 @@
 #pragma once
+#include "ad_digest.hpp"
 #include "aead.hpp"
+#include "append.hpp"
+#include "bulk.hpp"
+#include "fixed.hpp"
+#include "handle.hpp"
+#include "key_cache.hpp"
+#include "keystream_pool.hpp"
+#include "mac.hpp"
+#include "nonce.hpp"
+#include "range.hpp"
+#include "scatter_gather.hpp"
+#include "sector.hpp"
+#include "segment.hpp"
 
 // Jumbo Authenticated Encryption with Associated Data
 namespace jumbo {
@@ -23,7 +36,7 @@ constexpr size_t TLEN = 64;
 //
 // See algorithm 1 of Elephant specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
-static void
+inline static void
 encrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
         const uint8_t* const __restrict nonce, // 96 -bit nonce
         const uint8_t* const __restrict data,  // N -bytes associated data
@@ -52,7 +65,7 @@ encrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
 //
 // See algorithm 2 of Elephant specification
 // https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
-static bool
+inline static bool
 decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
         const uint8_t* const __restrict nonce, // 96 -bit nonce
         const uint8_t* const __restrict tag,   // 64 -bit authentication tag
@@ -72,4 +85,564 @@ decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
   return f;
 }
 
+// Given 16 -bytes secret key, 12 -bytes public message nonce, N -bytes
+// associated data & M -bytes plain text, this routine computes M -bytes
+// encrypted text & 8 -bytes authentication tag, using Jumbo AEAD scheme
+// | M, N >= 0
+//
+// Same as `jumbo::encrypt`, except associated data, plain text & encrypted
+// text are supplied as arrays of ( pointer, length ) memory fragments.
+inline static void
+encryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 96 -bit nonce
+         const elephant::iovec_t* const __restrict data, // associated data
+         const size_t dcnt, // # -of associated data fragments
+         const elephant::iovec_t* const __restrict txt, // plain text
+         const size_t tcnt, // # -of plain text fragments
+         const elephant::iovec_mut_t* const __restrict enc, // encrypted text
+         const size_t ecnt,            // # -of encrypted text fragments
+         uint8_t* const __restrict tag // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encryptv<a, b, c>(
+    key, nonce, data, dcnt, txt, tcnt, enc, ecnt, tag);
+}
+
+// Given 16 -bytes secret key, 12 -bytes public message nonce, 8 -bytes
+// authentication tag, N -bytes associated data & M -bytes encrypted text, this
+// routine computes M -bytes plain text & boolean verification flag, using
+// Jumbo AEAD scheme | M, N >= 0
+//
+// Same as `jumbo::decrypt`, except associated data, encrypted text & plain
+// text are supplied as arrays of ( pointer, length ) memory fragments.
+inline static bool
+decryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 96 -bit nonce
+         const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+         const elephant::iovec_t* const __restrict data, // associated data
+         const size_t dcnt, // # -of associated data fragments
+         const elephant::iovec_t* const __restrict enc, // encrypted text
+         const size_t ecnt, // # -of encrypted text fragments
+         const elephant::iovec_mut_t* const __restrict txt, // plain text
+         const size_t tcnt // # -of plain text fragments
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decryptv<a, b, c>(
+    key, nonce, tag, data, dcnt, enc, ecnt, txt, tcnt);
+  return f;
+}
+
+// Key context holding expanded secret key, for Jumbo AEAD scheme, which can
+// be reused across many {en, de}cryptions under same key
+using key_ctx_t = elephant::key_ctx_t<SLEN, ROUNDS>;
+
+// Precomputed digest of static associated data, for Jumbo AEAD scheme
+using ad_digest_t = elephant::ad_digest_t<SLEN>;
+
+// Given key context, 12 -bytes public message nonce, N -bytes associated data &
+// M -bytes plain text, this routine computes M -bytes encrypted text & 8
+// -bytes authentication tag, using Jumbo AEAD scheme | M, N >= 0
+//
+// Same as `jumbo::encrypt`, except secret key is not expanded again.
+inline static void
+encrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // N -bytes associated data
+        const size_t dlen,                     // len(data) = N | >= 0
+        const uint8_t* const __restrict txt,   // M -bytes plain text
+        uint8_t* const __restrict enc,         // M -bytes encrypted text
+        const size_t ctlen,                    // len(txt) = len(enc) = M | >= 0
+        uint8_t* const __restrict tag          // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt<a, b, c>(ctx, nonce, data, dlen, txt, enc, ctlen, tag);
+}
+
+// Given key context, 12 -bytes public message nonce, 8 -bytes
+// authentication tag, N -bytes associated data & M -bytes encrypted text, this
+// routine computes M -bytes plain text & boolean verification flag, using
+// Jumbo AEAD scheme | M, N >= 0
+//
+// Same as `jumbo::decrypt`, except secret key is not expanded again.
+inline static bool
+decrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+        const uint8_t* const __restrict data,  // N -bytes associated data
+        const size_t dlen,                     // len(data) = N | >= 0
+        const uint8_t* const __restrict enc,   // M -bytes encrypted text
+        uint8_t* const __restrict txt,         // M -bytes plain text
+        const size_t ctlen                     // len(enc) = len(txt) = M | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt<a, b, c>(ctx, nonce, tag, data, dlen, enc, txt, ctlen);
+  return f;
+}
+
+// Precomputes digest of N -bytes static associated data, under given key
+// context, so that it can be reused across many Jumbo {en, de}cryptions
+inline static void
+compute_ad_digest(const key_ctx_t& ctx, // expanded key context
+                  const uint8_t* const __restrict data, // N -bytes assoc. data
+                  const size_t dlen, // len(data) = N | >= 0
+                  ad_digest_t& digest // associated data digest
+)
+{
+  elephant::compute_ad_digest<SLEN, ROUNDS>(ctx, data, dlen, digest);
+}
+
+// Given key context, 12 -bytes public message nonce, precomputed associated
+// data digest & M -bytes plain text, this routine computes M -bytes encrypted
+// text & 8 -bytes authentication tag, using Jumbo AEAD scheme | M >= 0
+inline static void
+encrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const ad_digest_t& digest,             // associated data digest
+        const uint8_t* const __restrict txt,   // M -bytes plain text
+        uint8_t* const __restrict enc,         // M -bytes encrypted text
+        const size_t ctlen,                    // len(txt) = len(enc) = M | >= 0
+        uint8_t* const __restrict tag          // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt<a, b, c>(ctx, nonce, digest, txt, enc, ctlen, tag);
+}
+
+// Given key context, 12 -bytes public message nonce, 8 -bytes
+// authentication tag, precomputed associated data digest & M -bytes encrypted
+// text, this routine computes M -bytes plain text & boolean verification flag,
+// using Jumbo AEAD scheme | M >= 0
+inline static bool
+decrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+        const ad_digest_t& digest,             // associated data digest
+        const uint8_t* const __restrict enc,   // M -bytes encrypted text
+        uint8_t* const __restrict txt,         // M -bytes plain text
+        const size_t ctlen                     // len(enc) = len(txt) = M | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt<a, b, c>(ctx, nonce, tag, digest, enc, txt, ctlen);
+  return f;
+}
+
+// State of an append-only record, encrypted using Jumbo AEAD scheme
+using append_state_t = elephant::append_state_t<SLEN>;
+
+// Begins an append-only record, under given key context & 12 -bytes public
+// message nonce, authenticating N -bytes associated data, using Jumbo AEAD
+// scheme | N >= 0
+inline static void
+append_init(const key_ctx_t& ctx,                  // expanded key context
+            const uint8_t* const __restrict nonce, // 96 -bit nonce
+            const uint8_t* const __restrict data,  // N -bytes associated data
+            const size_t dlen,                     // len(data) = N | >= 0
+            append_state_t& st                     // append state
+)
+{
+  elephant::append_init<SLEN, ROUNDS>(ctx, nonce, data, dlen, st);
+}
+
+// Encrypts M -bytes plain text, to be appended to record, producing M -bytes
+// encrypted text & 8 -bytes authentication tag, covering whole record, using
+// Jumbo AEAD scheme | M >= 0
+//
+// Cost of this routine scales with M, not with total record length.
+inline static void
+append(const key_ctx_t& ctx,                  // expanded key context
+       const uint8_t* const __restrict nonce, // 96 -bit nonce
+       append_state_t& st,                    // append state
+       const uint8_t* const __restrict txt,   // M -bytes plain text
+       uint8_t* const __restrict enc,         // M -bytes encrypted text
+       const size_t len,                      // len(txt) = len(enc) = M | >= 0
+       uint8_t* const __restrict tag          // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::append<a, b, c>(ctx, nonce, st, txt, enc, len, tag);
+}
+
+// Reconstructs append state of an already stored Jumbo record, from its N
+// -bytes associated data & M -bytes cipher text | M, N >= 0
+inline static void
+append_resume(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              append_state_t& st                     // append state
+)
+{
+  elephant::append_resume<SLEN, ROUNDS>(ctx, nonce, data, dlen, enc, ctlen, st);
+}
+
+// Authentication-only pass of Jumbo AEAD scheme, which verifies 8 -bytes
+// authentication tag over N -bytes associated data & M -bytes cipher text,
+// without decrypting, using `nthreads` -many threads | M, N >= 0
+inline static bool
+verify(const key_ctx_t& ctx,                  // expanded key context
+       const uint8_t* const __restrict nonce, // 96 -bit nonce
+       const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+       const uint8_t* const __restrict data,  // N -bytes associated data
+       const size_t dlen,                     // len(data) = N | >= 0
+       const uint8_t* const __restrict enc,   // M -bytes encrypted text
+       const size_t ctlen,                    // len(enc) = M | >= 0
+       const size_t nthreads = 1              // # -of threads to use | > 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::verify<a, b, c>(
+    ctx, nonce, tag, data, dlen, enc, ctlen, nthreads);
+  return f;
+}
+
+// Decrypts byte range [off, off + len) of Jumbo cipher text, without verifying
+// authentication tag; `enc` points to cipher text bytes of that range
+//
+// Note, decrypted bytes must not be released, unless `verify` passes.
+inline static void
+decrypt_range_unverified(
+  const key_ctx_t& ctx,                  // expanded key context
+  const uint8_t* const __restrict nonce, // 96 -bit nonce
+  const uint8_t* const __restrict enc,   // `len` -bytes cipher text of range
+  const size_t off,                      // byte offset of range
+  const size_t len,                      // byte length of range
+  uint8_t* const __restrict txt          // `len` -bytes plain text of range
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+
+  elephant::decrypt_range_unverified<a, b>(ctx, nonce, enc, off, len, txt);
+}
+
+// Verifies 8 -bytes authentication tag over N -bytes associated data & whole
+// M -bytes cipher text, then decrypts only byte range [off, off + len) of it,
+// using Jumbo AEAD scheme | returns false, if range isn't within M -bytes
+inline static bool
+decrypt_range(const key_ctx_t& ctx,                  // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // 64 -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              const size_t off,                      // byte offset of range
+              const size_t len,                      // byte length of range
+              uint8_t* const __restrict txt,         // `len` -bytes plain text
+              const size_t nthreads = 1              // # -of threads | > 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt_range<a, b, c>(
+    ctx, nonce, tag, data, dlen, enc, ctlen, off, len, txt, nthreads);
+  return f;
+}
+
+// Keystream pregeneration pool for Jumbo AEAD scheme, used with counter nonces
+using keystream_pool_t = elephant::keystream_pool_t<SLEN, ROUNDS, TLEN>;
+
+// Fixed-length variant of `jumbo::encrypt`, where associated data &
+// plain text lengths are template parameters, so that whole Jumbo AEAD
+// flattens into straight-line code | dlen, ctlen <= elephant::FIXED_MAX_LEN
+template<const size_t dlen, const size_t ctlen>
+inline static void
+encrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict txt,   // `ctlen` -bytes plain text
+        uint8_t* const __restrict enc,         // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict tag          // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt<a, b, c, dlen, ctlen>(key, nonce, data, txt, enc, tag);
+}
+
+// Fixed-length variant of `jumbo::decrypt`, where associated data &
+// encrypted text lengths are template parameters | dlen, ctlen <=
+// elephant::FIXED_MAX_LEN
+template<const size_t dlen, const size_t ctlen>
+inline static bool
+decrypt(const uint8_t* const __restrict key,   // 128 -bit secret key
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict enc,   // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict txt          // `ctlen` -bytes plain text
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt<a, b, c, dlen, ctlen>(key, nonce, tag, data, enc, txt);
+  return f;
+}
+
+// Fixed-length variant of `jumbo::encrypt`, using key context
+template<const size_t dlen, const size_t ctlen>
+inline static void
+encrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict txt,   // `ctlen` -bytes plain text
+        uint8_t* const __restrict enc,         // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict tag          // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt<a, b, c, dlen, ctlen>(ctx, nonce, data, txt, enc, tag);
+}
+
+// Fixed-length variant of `jumbo::decrypt`, using key context
+template<const size_t dlen, const size_t ctlen>
+inline static bool
+decrypt(const key_ctx_t& ctx,                  // expanded key context
+        const uint8_t* const __restrict nonce, // 96 -bit nonce
+        const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+        const uint8_t* const __restrict data,  // `dlen` -bytes assoc. data
+        const uint8_t* const __restrict enc,   // `ctlen` -bytes encrypted text
+        uint8_t* const __restrict txt          // `ctlen` -bytes plain text
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt<a, b, c, dlen, ctlen>(ctx, nonce, tag, data, enc, txt);
+  return f;
+}
+
+// Computes 8 -bytes message authentication code over N -bytes message,
+// using Jumbo AEAD scheme in authentication-only mode, with `nthreads`
+// -many threads | N >= 0
+//
+// Produces same tag as `jumbo::encrypt`, with N -bytes associated data &
+// empty plain text, while skipping all encryption machinery.
+inline static void
+mac(const key_ctx_t& ctx,                  // expanded key context
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict data,  // N -bytes message
+    const size_t dlen,                     // len(data) = N | >= 0
+    uint8_t* const __restrict tag,         // 64 -bit authentication tag
+    const size_t nthreads = 1              // # -of threads to use | > 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::mac<a, b, c>(ctx, nonce, data, dlen, tag, nthreads);
+}
+
+// Verifies 8 -bytes message authentication code over N -bytes message,
+// using Jumbo AEAD scheme in authentication-only mode, with `nthreads`
+// -many threads | N >= 0
+inline static bool
+mac_verify(const key_ctx_t& ctx,                  // expanded key context
+           const uint8_t* const __restrict nonce, // 96 -bit nonce
+           const uint8_t* const __restrict tag,   // 64 -bit tag
+           const uint8_t* const __restrict data,  // N -bytes message
+           const size_t dlen,                     // len(data) = N | >= 0
+           const size_t nthreads = 1              // # -of threads to use | > 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::mac_verify<a, b, c>(ctx, nonce, tag, data, dlen, nthreads);
+  return f;
+}
+
+// Concurrent cache of Jumbo key contexts, keyed by 64 -bit key identifier
+using key_cache_t = elephant::key_cache_t<SLEN, ROUNDS>;
+
+// Streaming writer & reader of segmented stream format, using Jumbo AEAD
+using segment_writer_t = elephant::segment_writer_t<SLEN, ROUNDS, TLEN>;
+using segment_reader_t = elephant::segment_reader_t<SLEN, ROUNDS, TLEN>;
+
+// Mask table for fixed length sectors, sharing a Jumbo key context
+using sector_table_t = elephant::sector_table_t<SLEN, ROUNDS>;
+
+// Encrypts `cnt` -many consecutive sectors, starting at sector number `first`,
+// using Jumbo AEAD, writing 8 -bytes tag of each sector into out-of-band
+// tag array | cnt >= 0
+inline static void
+encrypt_sectors(const sector_table_t& tab,             // mask table
+                const uint64_t first,                  // first sector number
+                const uint32_t* const __restrict gens, // `cnt` generations
+                const uint8_t* const __restrict txt,   // `cnt` plain sectors
+                uint8_t* const __restrict enc,         // `cnt` cipher sectors
+                const size_t cnt,                      // # -of sectors
+                uint8_t* const __restrict tags,        // `cnt` -many tags
+                const size_t nthreads = 1              // # -of threads | > 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt_sectors<a, b, c>(
+    tab, first, gens, txt, enc, cnt, tags, nthreads);
+}
+
+// Verifies & decrypts `cnt` -many consecutive sectors, starting at sector
+// number `first`, using Jumbo AEAD & 8 -bytes tags from out-of-band tag
+// array, returning true only when every sector verifies | cnt >= 0
+inline static bool
+decrypt_sectors(const sector_table_t& tab,             // mask table
+                const uint64_t first,                  // first sector number
+                const uint32_t* const __restrict gens, // `cnt` generations
+                const uint8_t* const __restrict tags,  // `cnt` -many tags
+                const uint8_t* const enc,              // `cnt` cipher sectors
+                uint8_t* const txt,                    // `cnt` plain sectors
+                const size_t cnt,                      // # -of sectors
+                const size_t nthreads = 1,             // # -of threads | > 0
+                bool* const __restrict ok = nullptr    // `cnt` -many flags
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt_sectors<a, b, c>(
+    tab, first, gens, tags, enc, txt, cnt, nthreads, ok);
+  return f;
+}
+
+// Key context carrying its own nonce generator, for Jumbo AEAD scheme
+using nonce_ctx_t = elephant::nonce_ctx_t<SLEN, ROUNDS>;
+
+// Encrypts M -bytes plain text & authenticates N -bytes associated data, using
+// Jumbo AEAD, under fresh nonce drawn from key context's generator, which is
+// written to `nonce` | returns false, if nonces are exhausted
+inline static bool
+seal(nonce_ctx_t& ctx,                     // key context with nonces
+     const uint8_t* const __restrict data, // N -bytes associated data
+     const size_t dlen,                    // len(data) = N | >= 0
+     const uint8_t* const __restrict txt,  // M -bytes plain text
+     uint8_t* const __restrict enc,        // M -bytes encrypted text
+     const size_t ctlen,                   // len(txt) = len(enc) = M | >= 0
+     uint8_t* const __restrict nonce,      // 96 -bit nonce, used
+     uint8_t* const __restrict tag         // 64 -bit authentication tag
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::seal<a, b, c>(ctx, data, dlen, txt, enc, ctlen, nonce, tag);
+  return f;
+}
+
+// Applies `rounds` -many rounds of permutation underlying Jumbo AEAD,
+// starting from round `first`, on each of `cnt` -many states, stored back to
+// back in `states`, in-place, using `nthreads` -many threads | returns false,
+// if first + rounds exceeds ROUNDS
+inline static bool
+permute_bulk(uint8_t* const states,    // `cnt` -many permutation states
+             const size_t cnt,         // # -of states | >= 0
+             const size_t first,       // index of first round to apply
+             const size_t rounds,      // # -of rounds to apply
+             const size_t nthreads = 1 // # -of threads to use | > 0
+)
+{
+  bool f = false;
+  f = elephant::permute_bulk<SLEN>(states, cnt, first, rounds, nthreads);
+  return f;
+}
+
+// Mask table & scratch space for multi-buffer Jumbo {en, de}cryption
+using mb_table_t = elephant::mb_table_t<SLEN, ROUNDS>;
+
+// Encrypts `cnt` -many independent messages, using Jumbo AEAD, through
+// multi-state permutation lanes, see `elephant::encrypt_multi`
+inline static void
+encrypt_multi(mb_table_t& tab,                // mask table & scratch space
+              elephant::mb_msg_t* const msgs, // `cnt` -many messages
+              const size_t cnt,               // # -of messages | >= 0
+              elephant::mb_stats_t& stats     // lane occupancy
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt_multi<a, b, c>(tab, msgs, cnt, stats);
+}
+
+// Verifies & decrypts `cnt` -many independent messages, using Jumbo AEAD,
+// through multi-state permutation lanes, returning true only when all of them
+// verify, see `elephant::decrypt_multi`
+inline static bool
+decrypt_multi(mb_table_t& tab,                // mask table & scratch space
+              elephant::mb_msg_t* const msgs, // `cnt` -many messages
+              const size_t cnt,               // # -of messages | >= 0
+              elephant::mb_stats_t& stats     // lane occupancy
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  bool f = false;
+  f = elephant::decrypt_multi<a, b, c>(tab, msgs, cnt, stats);
+  return f;
+}
+
+// Long-lived Jumbo AEAD context ( expanded key & optional mask table ),
+// behind opaque context handles of C-ABI, see `elephant::aead_ctx_t`
+using aead_ctx_t = elephant::aead_ctx_t<SLEN, ROUNDS, TLEN>;
+
 }
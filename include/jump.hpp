@@ -0,0 +1,125 @@
+#pragma once
+#include "aead.hpp"
+#include <limits>
+
+// Jump-ahead for Elephant's mask generating linear feedback shift register
+namespace elephant {
+
+// Masks used for i-th block are derived from φ_1^i(K) & advancing LFSR i times,
+// one step at a time, makes random access to block i an O(i) operation.
+//
+// φ_1 is linear over GF(2), so φ_1^(2^k) can be written as a (slen x slen) bit
+// matrix, stored here as images of each unit vector e_j ( i.e. matrix columns
+// ). Applying φ_1^n then takes XOR of columns selected by set bits of state,
+// for each set bit of n. Low `LO_BITS` bits of n are still handled by
+// stepping LFSR, which is cheaper than a matrix-vector product for small n.
+//
+// Table covers every jump expressible as `size_t` & it's built lazily, on
+// first use.
+template<const size_t slen>
+struct lfsr_jump_table_t
+{
+  static constexpr size_t sbytes = slen >> 3;
+  static constexpr size_t swords = (sbytes + 7) >> 3;
+  static constexpr size_t LO_BITS = 10;
+  static constexpr size_t STEP_BITS = std::numeric_limits<size_t>::digits;
+  static constexpr size_t HI_BITS = STEP_BITS - LO_BITS;
+
+  // cols[k][j] = φ_1^(2^(LO_BITS + k))(e_j), zero padded to 64 -bit words
+  uint64_t cols[HI_BITS][slen][swords];
+
+  lfsr_jump_table_t()
+  {
+    uint8_t tmp[swords << 3]{};
+
+    for (size_t j = 0; j < slen; j++) {
+      std::memset(tmp, 0, sizeof(tmp));
+      tmp[j >> 3] = static_cast<uint8_t>(1u << (j & 7));
+
+      for (size_t i = 0; i < (1ul << LO_BITS); i++) {
+        lfsr<slen>(tmp);
+      }
+
+      std::memcpy(cols[0][j], tmp, sizeof(tmp));
+    }
+
+    for (size_t k = 1; k < HI_BITS; k++) {
+      for (size_t j = 0; j < slen; j++) {
+        std::memcpy(tmp, cols[k - 1][j], sizeof(tmp));
+        apply(k - 1, tmp, tmp);
+        std::memcpy(cols[k][j], tmp, sizeof(tmp));
+      }
+    }
+  }
+
+  // Computes φ_1^(2^(LO_BITS + k))(in), without branching on ( secret ) bits
+  // of input | both `in` & `out` are (slen >> 3) -bytes wide, they may alias
+  inline void apply(const size_t k,
+                    const uint8_t* const in,
+                    uint8_t* const out) const
+  {
+    uint64_t res[swords]{};
+
+    for (size_t j = 0; j < slen; j++) {
+      const uint64_t bit = (in[j >> 3] >> (j & 7)) & 0b1;
+      const uint64_t msk = -bit;
+
+      for (size_t w = 0; w < swords; w++) {
+        res[w] ^= cols[k][j][w] & msk;
+      }
+    }
+
+    std::memcpy(out, res, sbytes);
+  }
+};
+
+// Returns lazily built ( thread-safe ) jump table for given LFSR width
+template<const size_t slen>
+inline static const lfsr_jump_table_t<slen>&
+lfsr_jump_table() requires(spongent::check_state_bit_len(slen))
+{
+  static const lfsr_jump_table_t<slen> tbl{};
+  return tbl;
+}
+
+// Advances Elephant's mask generating LFSR state by `steps` -many steps, in
+// place i.e. x = φ_1^steps(x) | steps >= 0
+template<const size_t slen>
+inline static void
+lfsr_jump(uint8_t* const x,
+          const size_t steps) requires(spongent::check_state_bit_len(slen))
+{
+  using tbl_t = lfsr_jump_table_t<slen>;
+  constexpr size_t lo_mask = (1ul << tbl_t::LO_BITS) - 1;
+
+  const size_t hi = steps >> tbl_t::LO_BITS;
+
+  if (hi > 0) {
+    const tbl_t& tbl = lfsr_jump_table<slen>();
+
+    for (size_t k = 0; k < tbl_t::HI_BITS; k++) {
+      if ((hi >> k) & 0b1) {
+        tbl.apply(k, x, x);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < (steps & lo_mask); i++) {
+    lfsr<slen>(x);
+  }
+}
+
+// Computes φ_1^i(K), from expanded masking key K, which is what masks of i-th
+// {keystream, associated data, cipher text} block are derived from
+template<const size_t slen>
+inline static void
+mask_at(const uint8_t* const __restrict ekey, // expanded masking key
+        const size_t i,                       // block index
+        uint8_t* const __restrict lmask       // φ_1^i(K)
+        ) requires(spongent::check_state_bit_len(slen))
+{
+  std::memcpy(lmask, ekey, slen >> 3);
+  lfsr_jump<slen>(lmask, i);
+}
+
+}
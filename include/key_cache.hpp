@@ -0,0 +1,660 @@
+#pragma once
+#include "context.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Concurrent cache of expanded key contexts for Elephant Authenticated
+// Encryption with Associated Data, when many ( tenant ) keys are in use
+namespace elephant {
+
+// Hit/ miss/ eviction counters of key context cache
+struct key_cache_stats_t
+{
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+};
+
+// Epoch based reclamation, letting readers of concurrent structures ( say
+// `key_cache_t` ) go without taking locks or touching shared reference counts
+//
+// Every thread owns a cache line sized record, holding value of global epoch
+// counter at which it entered its ( outermost ) read side critical section, or
+// 0 while it's outside of one. Writers first unlink an object, then retire it,
+// tagging it with current epoch, which they bump right after. Any thread
+// entering later on can't reach that object anymore, so it can be reused once
+// no thread is inside a critical section entered at or before its tag.
+//
+// Records are never freed, a record of an exited thread is reused by some
+// thread started later on.
+struct epoch_t
+{
+  struct alignas(64) record_t
+  {
+    std::atomic<uint64_t> local{ 0 }; // epoch at entry, 0 if outside
+    std::atomic<bool> in_use{ false };
+    record_t* next = nullptr;
+    size_t idx = 0;   // # -of records registered before this one
+    size_t depth = 0; // nesting depth of critical sections, owner only
+  };
+
+  static inline std::atomic<uint64_t> epoch{ 1 };
+  static inline std::atomic<record_t*> head{ nullptr };
+  static inline std::atomic<size_t> count{ 0 };
+
+  // Gives record back, when owning thread exits
+  struct owner_t
+  {
+    record_t* rec = nullptr;
+
+    ~owner_t()
+    {
+      if (rec != nullptr) {
+        rec->local.store(0, std::memory_order_release);
+        rec->in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+  // Record of calling thread, registered ( or reused ) on first call
+  static inline record_t& self()
+  {
+    thread_local owner_t owner;
+
+    if (owner.rec != nullptr) {
+      return *owner.rec;
+    }
+
+    for (auto r = head.load(std::memory_order_acquire); r; r = r->next) {
+      bool expected = false;
+
+      if (!r->in_use.load(std::memory_order_relaxed) &&
+          r->in_use.compare_exchange_strong(expected, true)) {
+        owner.rec = r;
+        return *r;
+      }
+    }
+
+    auto r = new record_t;
+    r->in_use.store(true, std::memory_order_relaxed);
+    r->idx = count.fetch_add(1, std::memory_order_relaxed);
+    r->next = head.load(std::memory_order_relaxed);
+    while (!head.compare_exchange_weak(r->next, r)) {
+    }
+
+    owner.rec = r;
+    return *r;
+  }
+
+  // Enters read side critical section, on calling thread
+  static inline void enter()
+  {
+    record_t& r = self();
+
+    if (r.depth++ == 0) {
+      r.local.store(epoch.load(std::memory_order_acquire),
+                    std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+  }
+
+  // Leaves read side critical section, on calling thread
+  static inline void exit()
+  {
+    record_t& r = self();
+
+    if (--r.depth == 0) {
+      r.local.store(0, std::memory_order_release);
+    }
+  }
+
+  // Returns tag of an object, which was just unlinked
+  static inline uint64_t retire()
+  {
+    return epoch.fetch_add(1, std::memory_order_seq_cst);
+  }
+
+  // Objects tagged with epoch below returned value can be reused
+  static inline uint64_t safe_below()
+  {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    uint64_t safe = std::numeric_limits<uint64_t>::max();
+    for (auto r = head.load(std::memory_order_acquire); r; r = r->next) {
+      const uint64_t l = r->local.load(std::memory_order_acquire);
+      safe = l != 0 ? std::min(safe, l) : safe;
+    }
+
+    return safe;
+  }
+};
+
+// Cache of expanded key contexts, keyed by 64 -bit key identifier, so that hot
+// keys pay key expansion ( one full permutation ) only once
+//
+// Cache is split into power of 2 -many shards ( by hash of key identifier ).
+// Each shard indexes its entries using an open addressing hash table of
+// atomic pointers, which lookups probe without taking any lock, while
+// insertions, evictions & erasures are serialized by shard's mutex. Entries
+// are carved out of per shard pools & recycled using CLOCK ( i.e. second chance
+// approximation of LRU ) eviction; lookups only set reference bit of an entry,
+// when it's not already set.
+//
+// Contexts are handed out as pinned references, which keep calling thread in
+// an epoch based read side critical section ( see `epoch_t` ), so an evicted (
+// or erased ) context isn't reused, until every reference which could have
+// reached it is dropped; its expanded key is zeroed before reuse. So a hit
+// writes nothing, other than calling thread's own epoch record & a per thread
+// hit counter.
+//
+// Note, pinned references must be dropped on thread which obtained them, they
+// must not outlive the cache & as long as one is held, no retired entry of any
+// cache can be reused, so keep them short lived.
+template<const size_t slen, const size_t rounds>
+class key_cache_t
+{
+public:
+  using ctx_t = key_ctx_t<slen, rounds>;
+
+private:
+  struct entry_t
+  {
+    ctx_t ctx;
+    uint64_t id = 0;
+    std::atomic<bool> ref{ false }; // CLOCK reference bit
+  };
+
+  using bucket_t = std::atomic<entry_t*>;
+
+  // # -of hash table buckets per entry, in each of two bucket arrays
+  static constexpr size_t BUCKETS_PER_ENTRY = 2;
+
+public:
+  // Exact # -of bytes accounted per cached key i.e. pooled entry ( context, key
+  // identifier & reference bit ) & its buckets in both ( double buffered ) hash
+  // table arrays; entries which are retired but not yet reused, are on top
+  static constexpr size_t ENTRY_BYTES =
+    sizeof(entry_t) + 2 * BUCKETS_PER_ENTRY * sizeof(bucket_t);
+
+  // Reference to cached key context, pinning it ( i.e. keeping it from being
+  // reused ) until dropped
+  class pinned_ctx_t
+  {
+  private:
+    const ctx_t* ctx = nullptr;
+
+  public:
+    pinned_ctx_t() = default;
+
+    // Takes over an already entered critical section
+    explicit pinned_ctx_t(const ctx_t* const ctx_)
+      : ctx(ctx_)
+    {
+    }
+
+    pinned_ctx_t(pinned_ctx_t&& o) noexcept
+      : ctx(std::exchange(o.ctx, nullptr))
+    {
+    }
+
+    pinned_ctx_t& operator=(pinned_ctx_t&& o) noexcept
+    {
+      if (this != &o) {
+        reset();
+        ctx = std::exchange(o.ctx, nullptr);
+      }
+      return *this;
+    }
+
+    pinned_ctx_t(const pinned_ctx_t&) = delete;
+    pinned_ctx_t& operator=(const pinned_ctx_t&) = delete;
+
+    ~pinned_ctx_t() { reset(); }
+
+    // Drops reference, if holding one
+    void reset()
+    {
+      if (ctx != nullptr) {
+        ctx = nullptr;
+        epoch_t::exit();
+      }
+    }
+
+    const ctx_t* get() const { return ctx; }
+    const ctx_t& operator*() const { return *ctx; }
+    const ctx_t* operator->() const { return ctx; }
+    explicit operator bool() const { return ctx != nullptr; }
+  };
+
+private:
+  struct shard_t
+  {
+    // read by every lookup, written only when bucket array is rebuilt
+    alignas(64) std::atomic<bucket_t*> table{ nullptr };
+    size_t nbuckets = 0;
+
+    // everything below is guarded by `mtx`
+    alignas(64) std::mutex mtx;
+    std::unique_ptr<bucket_t[]> arrays[2]; // current & spare bucket arrays
+    size_t cur = 0;                        // index of current bucket array
+    uint64_t spare_tag = 0;                // epoch spare array was retired at
+
+    std::vector<std::unique_ptr<entry_t[]>> chunks; // entry pool
+    std::vector<entry_t*> free_entries;
+    std::vector<std::pair<uint64_t, entry_t*>> retired; // ( tag, entry )
+
+    entry_t tomb;     // marks bucket of removed entry
+    size_t cap = 0;   // maximum # -of live entries
+    size_t live = 0;  // # -of live entries
+    size_t tombs = 0; // # -of buckets marked removed
+    size_t hand = 0;  // CLOCK hand, over buckets of current array
+
+    std::atomic<uint64_t> misses{ 0 };
+    std::atomic<uint64_t> evictions{ 0 };
+  };
+
+  // Hit counter, one per slot; threads pick slot by index of their epoch
+  // record, so that hits of up to `HIT_SLOTS` -many threads don't contend
+  struct alignas(64) hit_ctr_t
+  {
+    std::atomic<uint64_t> n{ 0 };
+  };
+
+  static constexpr size_t HIT_SLOTS = 64;
+
+  std::vector<shard_t> shards;
+  size_t shard_mask;
+  std::unique_ptr<hit_ctr_t[]> hits;
+
+  // Mixes bits of key identifier, so that sequential identifiers spread across
+  // shards ( and hash buckets )
+  static inline uint64_t mix(uint64_t x)
+  {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdul;
+    x ^= x >> 33;
+    return x;
+  }
+
+  inline shard_t& shard_of(const uint64_t id)
+  {
+    return shards[mix(id) & shard_mask];
+  }
+
+  // Home bucket of key identifier, in shard's bucket arrays
+  static inline size_t home_of(const shard_t& sh, const uint64_t id)
+  {
+    return (mix(id) >> 16) % sh.nbuckets;
+  }
+
+  // Probes bucket array for key identifier, returning its bucket index ( and
+  // entry, through `found` ) or `nbuckets`, when not found
+  static inline size_t probe(const shard_t& sh,
+                             const bucket_t* const tab,
+                             const uint64_t id,
+                             entry_t*& found)
+  {
+    size_t i = home_of(sh, id);
+
+    for (size_t n = 0; n < sh.nbuckets; n++) {
+      entry_t* const e = tab[i].load(std::memory_order_acquire);
+
+      if (e == nullptr) {
+        break;
+      }
+      if ((e != &sh.tomb) && (e->id == id)) {
+        found = e;
+        return i;
+      }
+
+      i = (i + 1 == sh.nbuckets) ? 0 : i + 1;
+    }
+
+    return sh.nbuckets;
+  }
+
+  // Places entry into first free ( empty or removed ) bucket, on its probe
+  // sequence | requires lock on shard
+  static inline void place(shard_t& sh, bucket_t* const tab, entry_t* const e)
+  {
+    size_t i = home_of(sh, e->id);
+
+    while (true) {
+      entry_t* const b = tab[i].load(std::memory_order_relaxed);
+
+      if ((b == nullptr) || (b == &sh.tomb)) {
+        sh.tombs -= b == &sh.tomb;
+        tab[i].store(e, std::memory_order_release);
+        return;
+      }
+
+      i = (i + 1 == sh.nbuckets) ? 0 : i + 1;
+    }
+  }
+
+  // Moves retired entries, which no reader can reach anymore, to free list,
+  // zeroing their expanded keys | requires lock on shard
+  static inline void reclaim(shard_t& sh)
+  {
+    const uint64_t safe = epoch_t::safe_below();
+
+    auto it = std::remove_if(
+      sh.retired.begin(), sh.retired.end(), [&](const auto& r) {
+        if (r.first < safe) {
+          secure_zero(r.second->ctx.ekey, sizeof(r.second->ctx.ekey));
+          sh.free_entries.push_back(r.second);
+          return true;
+        }
+        return false;
+      });
+    sh.retired.erase(it, sh.retired.end());
+  }
+
+  // Takes an entry out of shard's pool, growing pool when every retired entry
+  // is still reachable by some reader | requires lock on shard
+  static inline entry_t* alloc_entry(shard_t& sh)
+  {
+    if (sh.free_entries.empty()) {
+      reclaim(sh);
+    }
+
+    if (sh.free_entries.empty()) {
+      const size_t n = std::max(sh.cap / 8, 1ul);
+
+      sh.chunks.push_back(std::make_unique<entry_t[]>(n));
+      for (size_t i = n; i > 0; i--) {
+        sh.free_entries.push_back(&sh.chunks.back()[i - 1]);
+      }
+    }
+
+    entry_t* const e = sh.free_entries.back();
+    sh.free_entries.pop_back();
+    return e;
+  }
+
+  // Unlinks entry living in bucket `i` of current array & retires it |
+  // requires lock on shard
+  static inline void unlink(shard_t& sh, const size_t i)
+  {
+    bucket_t* const tab = sh.arrays[sh.cur].get();
+    entry_t* const e = tab[i].load(std::memory_order_relaxed);
+
+    tab[i].store(&sh.tomb, std::memory_order_release);
+    sh.live--;
+    sh.tombs++;
+
+    sh.retired.emplace_back(epoch_t::retire(), e);
+  }
+
+  // Evicts some unreferenced entry, using CLOCK | requires lock on shard
+  inline void evict(shard_t& sh)
+  {
+    bucket_t* const tab = sh.arrays[sh.cur].get();
+
+    while (true) {
+      const size_t i = sh.hand;
+      entry_t* const e = tab[i].load(std::memory_order_relaxed);
+
+      sh.hand = (sh.hand + 1 == sh.nbuckets) ? 0 : sh.hand + 1;
+
+      if ((e == nullptr) || (e == &sh.tomb)) {
+        continue;
+      }
+
+      if (!e->ref.exchange(false, std::memory_order_relaxed)) {
+        unlink(sh, i);
+        sh.evictions.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+  }
+
+  // Rebuilds bucket array without removed markers, once they pile up, if no
+  // reader can still be probing spare array | requires lock on shard
+  static inline void maybe_rebuild(shard_t& sh)
+  {
+    if ((sh.tombs < sh.nbuckets / 4) ||
+        (sh.spare_tag >= epoch_t::safe_below())) {
+      return;
+    }
+
+    bucket_t* const old = sh.arrays[sh.cur].get();
+    bucket_t* const tab = sh.arrays[sh.cur ^ 1].get();
+
+    for (size_t i = 0; i < sh.nbuckets; i++) {
+      tab[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    sh.tombs = 0;
+    for (size_t i = 0; i < sh.nbuckets; i++) {
+      entry_t* const e = old[i].load(std::memory_order_relaxed);
+
+      if ((e != nullptr) && (e != &sh.tomb)) {
+        place(sh, tab, e);
+      }
+    }
+
+    sh.table.store(tab, std::memory_order_release);
+    sh.cur ^= 1;
+    sh.hand = 0;
+    sh.spare_tag = epoch_t::retire();
+  }
+
+public:
+  // Cache holding at most `budget` -bytes worth of key contexts ( at least one
+  // per shard ), spread across `nshards` -many shards | nshards = 2^k
+  explicit key_cache_t(const size_t budget, const size_t nshards = 16)
+    : shards(std::bit_ceil(std::max(nshards, 1ul)))
+    , shard_mask(shards.size() - 1)
+    , hits(std::make_unique<hit_ctr_t[]>(HIT_SLOTS))
+  {
+    const size_t cap = budget / ENTRY_BYTES;
+    const size_t per_shard = std::max(cap / shards.size(), 1ul);
+
+    for (auto& sh : shards) {
+      sh.cap = per_shard;
+      sh.nbuckets = per_shard * BUCKETS_PER_ENTRY;
+
+      for (auto& arr : sh.arrays) {
+        arr = std::make_unique<bucket_t[]>(sh.nbuckets);
+        for (size_t i = 0; i < sh.nbuckets; i++) {
+          arr[i].store(nullptr, std::memory_order_relaxed);
+        }
+      }
+      sh.table.store(sh.arrays[0].get(), std::memory_order_release);
+
+      sh.chunks.push_back(std::make_unique<entry_t[]>(per_shard));
+      sh.free_entries.reserve(per_shard);
+      for (size_t i = per_shard; i > 0; i--) {
+        sh.free_entries.push_back(&sh.chunks.back()[i - 1]);
+      }
+    }
+  }
+
+  key_cache_t(const key_cache_t&) = delete;
+  key_cache_t& operator=(const key_cache_t&) = delete;
+
+  // Looks up cached context of given key identifier, returning empty reference
+  // if it's not cached | counts as hit/ miss
+  pinned_ctx_t find(const uint64_t id)
+  {
+    shard_t& sh = shard_of(id);
+
+    epoch_t::enter();
+
+    const bucket_t* const tab = sh.table.load(std::memory_order_acquire);
+
+    entry_t* e = nullptr;
+    if (probe(sh, tab, id, e) == sh.nbuckets) {
+      epoch_t::exit();
+      sh.misses.fetch_add(1, std::memory_order_relaxed);
+      return {};
+    }
+
+    if (!e->ref.load(std::memory_order_relaxed)) {
+      e->ref.store(true, std::memory_order_relaxed);
+    }
+
+    const size_t slot = epoch_t::self().idx % HIT_SLOTS;
+    hits[slot].n.fetch_add(1, std::memory_order_relaxed);
+
+    return pinned_ctx_t{ &e->ctx };
+  }
+
+  // Returns cached context of given key identifier; on miss, 16 -bytes secret
+  // key is obtained by calling `fetch(key)` ( which returns false, if key
+  // identifier is unknown ), expanded outside of any lock & inserted into
+  // cache, possibly evicting some other key's context
+  //
+  // Returns empty reference, only when `fetch` fails.
+  template<typename F>
+  pinned_ctx_t get(const uint64_t id, F&& fetch) requires(
+    std::is_invocable_r_v<bool, F, uint8_t*>)
+  {
+    if (auto ctx = find(id); ctx) {
+      return ctx;
+    }
+
+    uint8_t key[16];
+    if (!fetch(key)) {
+      return {};
+    }
+
+    const ctx_t expanded{ key };
+    secure_zero(key, sizeof(key));
+
+    shard_t& sh = shard_of(id);
+    std::lock_guard<std::mutex> lock(sh.mtx);
+
+    bucket_t* const tab = sh.arrays[sh.cur].get();
+
+    // some other thread might have inserted it meanwhile
+    entry_t* e = nullptr;
+    if (probe(sh, tab, id, e) == sh.nbuckets) {
+      if (sh.live == sh.cap) {
+        evict(sh);
+      }
+
+      e = alloc_entry(sh);
+      e->id = id;
+      e->ref.store(true, std::memory_order_relaxed);
+      std::memcpy(e->ctx.ekey, expanded.ekey, sizeof(expanded.ekey));
+
+      place(sh, tab, e);
+      sh.live++;
+
+      maybe_rebuild(sh);
+    }
+
+    // entry can't be reclaimed, while lock on shard is held
+    epoch_t::enter();
+    return pinned_ctx_t{ &e->ctx };
+  }
+
+  // Same as above, when 16 -bytes secret key is already at hand
+  pinned_ctx_t get(const uint64_t id, const uint8_t* const key)
+  {
+    return get(id, [key](uint8_t* const out) {
+      std::memcpy(out, key, 16);
+      return true;
+    });
+  }
+
+  // Drops cached context of given key identifier ( say, after key rotation )
+  void erase(const uint64_t id)
+  {
+    shard_t& sh = shard_of(id);
+    std::lock_guard<std::mutex> lock(sh.mtx);
+
+    entry_t* e = nullptr;
+    const size_t i = probe(sh, sh.arrays[sh.cur].get(), id, e);
+    if (i == sh.nbuckets) {
+      return;
+    }
+
+    unlink(sh, i);
+    maybe_rebuild(sh);
+  }
+
+  // # -of key contexts, currently cached
+  size_t size()
+  {
+    size_t n = 0;
+
+    for (auto& sh : shards) {
+      std::lock_guard<std::mutex> lock(sh.mtx);
+      n += sh.live;
+    }
+
+    return n;
+  }
+
+  // Maximum # -of key contexts, which can be cached
+  size_t capacity() const { return shards.size() * shards[0].cap; }
+
+  // Visits memory, which a hit on given key identifier, by calling thread,
+  // touches, as `visit(ptr, len, writes)`, so that benchmarks can tell which
+  // cache lines threads share: calling thread's epoch record & hit counter
+  // slot are written, shard's bucket array pointer, probed buckets & entry
+  // are read, while shard's mutex is visited as written, as misses take it
+  //
+  // Nothing is visited, when key identifier isn't cached.
+  template<typename F>
+  void footprint(const uint64_t id, F&& visit)
+  {
+    shard_t& sh = shard_of(id);
+    std::lock_guard<std::mutex> lock(sh.mtx);
+
+    const bucket_t* const tab = sh.arrays[sh.cur].get();
+
+    entry_t* e = nullptr;
+    const size_t i = probe(sh, tab, id, e);
+    if (i == sh.nbuckets) {
+      return;
+    }
+
+    const epoch_t::record_t& rec = epoch_t::self();
+
+    visit(&rec, sizeof(rec), true);
+    visit(&hits[rec.idx % HIT_SLOTS], sizeof(hit_ctr_t), true);
+    visit(&sh.table, sizeof(sh.table), false);
+    visit(&sh.nbuckets, sizeof(sh.nbuckets), false);
+    visit(&sh.mtx, sizeof(sh.mtx), true);
+
+    // buckets from home one up to where entry was found, wrapping around
+    for (size_t j = home_of(sh, id);; j = (j + 1 == sh.nbuckets) ? 0 : j + 1) {
+      visit(&tab[j], sizeof(bucket_t), false);
+      if (j == i) {
+        break;
+      }
+    }
+
+    visit(e, sizeof(entry_t), false);
+  }
+
+  // Snapshot of hit/ miss/ eviction counters, summed across shards
+  key_cache_stats_t stats() const
+  {
+    key_cache_stats_t st;
+
+    for (size_t i = 0; i < HIT_SLOTS; i++) {
+      st.hits += hits[i].n.load(std::memory_order_relaxed);
+    }
+
+    for (const auto& sh : shards) {
+      st.misses += sh.misses.load(std::memory_order_relaxed);
+      st.evictions += sh.evictions.load(std::memory_order_relaxed);
+    }
+
+    return st;
+  }
+};
+
+}
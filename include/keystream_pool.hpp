@@ -0,0 +1,335 @@
+#pragma once
+#include "range.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Keystream pregeneration for Elephant Authenticated Encryption with Associated
+// Data, when upcoming nonces are known before their payloads arrive
+namespace elephant {
+
+// Increments 12 -bytes nonce, interpreted as 96 -bit big-endian counter
+inline static void
+increment_nonce(uint8_t* const nonce)
+{
+  for (size_t i = 12; i > 0; i--) {
+    if (++nonce[i - 1] != 0) {
+      break;
+    }
+  }
+}
+
+// Elephant keystream depends only on key, nonce & block index, so for counter
+// nonces, keystream of next few messages can be computed ahead of time ( when
+// CPU is idle or on a background thread ) & encryption then boils down to
+// XOR-ing pregenerated keystream with plain text, followed by authentication.
+//
+// This pool pregenerates `ks_len` -bytes keystream for each upcoming nonce
+// ( starting from `first_nonce`, incremented as 96 -bit big-endian counter ),
+// keeping at most `budget` -bytes of keystream buffered. Messages longer than
+// `ks_len` -bytes take pooled keystream for their prefix & compute rest on
+// demand. Nonces which are not found in pool ( say, skipped ones ) fall back to
+// computing whole keystream on demand, while pool moves past them.
+//
+// Note, buffered keystream is secret material, it's zeroed once consumed.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class keystream_pool_t
+{
+private:
+  struct entry_t
+  {
+    uint8_t nonce[12];
+    std::vector<uint8_t> ks;
+  };
+
+  const key_ctx_t<slen, rounds>& ctx;
+  const size_t ks_len;
+  const size_t max_entries;
+
+  std::mutex mtx;             // guards everything below
+  std::condition_variable cv; // wakes up background generator
+  std::deque<entry_t> pool;   // pregenerated keystream, in nonce order
+
+  std::vector<std::vector<uint8_t>> spare; // recycled keystream buffers
+  uint8_t next_nonce[12];                  // next nonce to pregenerate for
+
+  uint8_t last_taken[12]{}; // largest nonce requested so far
+  bool taken_any = false;   // whether `last_taken` holds some nonce
+  size_t in_flight = 0;     // # -of entries being generated, outside lock
+
+  std::mutex gen_mtx; // serializes keystream generators
+  std::thread worker;
+  bool stopping = false;
+
+  // Takes out pregenerated keystream for given nonce, if present, dropping
+  // entries of nonces preceding it
+  inline bool take(const uint8_t* const nonce, std::vector<uint8_t>& ks)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!taken_any || (std::memcmp(last_taken, nonce, 12) < 0)) {
+      std::memcpy(last_taken, nonce, 12);
+      taken_any = true;
+    }
+
+    while (!pool.empty() && (std::memcmp(pool.front().nonce, nonce, 12) < 0)) {
+      recycle(pool.front().ks);
+      pool.pop_front();
+    }
+
+    const bool hit =
+      !pool.empty() && (std::memcmp(pool.front().nonce, nonce, 12) == 0);
+
+    if (hit) {
+      ks.swap(pool.front().ks);
+      pool.pop_front();
+    } else if (std::memcmp(next_nonce, nonce, 12) <= 0) {
+      // pool is behind, so skip ahead
+      std::memcpy(next_nonce, nonce, 12);
+      increment_nonce(next_nonce);
+    }
+
+    cv.notify_one();
+    return hit;
+  }
+
+  // Computes `ks_len` -bytes keystream, for given nonce
+  inline void keystream(const uint8_t* const __restrict nonce,
+                        uint8_t* const __restrict ks) const
+  {
+    constexpr size_t sbytes = slen >> 3;
+
+    uint8_t key[sbytes];
+    uint8_t hmask[sbytes];
+    uint8_t fmask[sbytes];
+    uint8_t blk[sbytes];
+
+    std::memcpy(key, ctx.ekey, sbytes);
+
+    for (size_t off = 0; off < ks_len; off += sbytes) {
+      next_mask<slen, 1>(key, hmask, fmask);
+      std::memcpy(key, hmask, sbytes);
+
+      keystream_block<slen, rounds>(nonce, fmask, blk);
+      std::memcpy(ks + off, blk, std::min(sbytes, ks_len - off));
+    }
+
+    secure_zero(blk, sizeof(blk));
+  }
+
+  // Zeroes consumed keystream & keeps buffer for reuse | requires lock
+  inline void recycle(std::vector<uint8_t>& ks)
+  {
+    secure_zero(ks.data(), ks.size());
+    spare.emplace_back(std::move(ks));
+  }
+
+  inline void give_back(std::vector<uint8_t>& ks)
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    recycle(ks);
+  }
+
+  // XORs keystream with M -bytes input, using pooled keystream if available
+  inline void apply_keystream(const uint8_t* const __restrict nonce,
+                              const uint8_t* const __restrict in,
+                              uint8_t* const __restrict out,
+                              const size_t len)
+  {
+    std::vector<uint8_t> ks;
+
+    if (take(nonce, ks)) {
+      const size_t plen = std::min(len, ks_len);
+
+      for (size_t i = 0; i < plen; i++) {
+        out[i] = in[i] ^ ks[i];
+      }
+
+      xor_keystream_at<slen, rounds>(
+        ctx.ekey, nonce, plen, in + plen, out + plen, len - plen);
+
+      give_back(ks);
+    } else {
+      xor_keystream<slen, rounds>(ctx.ekey, nonce, in, out, len);
+    }
+  }
+
+  inline void background()
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+
+    while (!stopping) {
+      if (pool.size() + in_flight < max_entries) {
+        lock.unlock();
+        refill(1);
+        lock.lock();
+      } else {
+        cv.wait(lock);
+      }
+    }
+  }
+
+public:
+  // Pool pregenerates `ks_len` -bytes keystream per nonce, starting from
+  // `first_nonce`, while buffering at most `budget` -bytes of keystream
+  //
+  // Note, key context must outlive the pool.
+  keystream_pool_t(const key_ctx_t<slen, rounds>& ctx_,
+                   const uint8_t* const first_nonce,
+                   const size_t ks_len_,
+                   const size_t budget)
+    : ctx(ctx_)
+    , ks_len(std::max(ks_len_, 1ul))
+    , max_entries(budget / std::max(ks_len_, 1ul))
+  {
+    std::memcpy(next_nonce, first_nonce, 12);
+  }
+
+  keystream_pool_t(const keystream_pool_t&) = delete;
+  keystream_pool_t& operator=(const keystream_pool_t&) = delete;
+
+  ~keystream_pool_t()
+  {
+    stop();
+
+    for (auto& e : pool) {
+      secure_zero(e.ks.data(), e.ks.size());
+    }
+  }
+
+  // Pregenerates keystream for at most `max_cnt` -many upcoming nonces, while
+  // staying within byte budget; returns # -of nonces processed. Call it during
+  // idle cycles, when not using background generator.
+  size_t refill(const size_t max_cnt = SIZE_MAX)
+  {
+    std::lock_guard<std::mutex> gen_lock(gen_mtx);
+
+    size_t cnt = 0;
+    while (cnt < max_cnt) {
+      entry_t e;
+
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        if (pool.size() >= max_entries) {
+          break;
+        }
+
+        std::memcpy(e.nonce, next_nonce, 12);
+        increment_nonce(next_nonce);
+
+        if (!spare.empty()) {
+          e.ks.swap(spare.back());
+          spare.pop_back();
+        }
+        in_flight++;
+      }
+
+      e.ks.resize(ks_len);
+      keystream(e.nonce, e.ks.data());
+
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+
+        in_flight--;
+
+        // nonce might have already been requested, while it was being computed
+        const bool stale =
+          taken_any && (std::memcmp(e.nonce, last_taken, 12) <= 0);
+        if (stale) {
+          recycle(e.ks);
+        } else {
+          pool.emplace_back(std::move(e));
+        }
+      }
+
+      cnt++;
+    }
+
+    return cnt;
+  }
+
+  // Starts background thread, which keeps pool filled up to its byte budget
+  void start()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    if (!worker.joinable()) {
+      stopping = false;
+      worker = std::thread([this]() { background(); });
+    }
+  }
+
+  // Stops background thread, if running
+  void stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+      cv.notify_all();
+    }
+
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+
+  // # -of nonces, for which keystream is pregenerated
+  size_t size()
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    return pool.size();
+  }
+
+  // Same as `elephant::encrypt` with key context, except keystream is taken
+  // from pool, when pregenerated for this nonce
+  void encrypt(const uint8_t* const __restrict nonce, // 96 -bit nonce
+               const uint8_t* const __restrict data,  // N -bytes assoc. data
+               const size_t dlen,                     // len(data) = N | >= 0
+               const uint8_t* const __restrict txt,   // M -bytes plain text
+               uint8_t* const __restrict enc,         // M -bytes cipher text
+               const size_t ctlen,                    // len(txt) = len(enc)
+               uint8_t* const __restrict tag          // `tlen` -bit tag
+  )
+  {
+    uint8_t acc[slen >> 3];
+
+    apply_keystream(nonce, txt, enc, ctlen);
+    absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, acc);
+    absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+    finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+  }
+
+  // Same as `elephant::decrypt` with key context, except keystream is taken
+  // from pool, when pregenerated for this nonce
+  bool decrypt(const uint8_t* const __restrict nonce, // 96 -bit nonce
+               const uint8_t* const __restrict tag,   // `tlen` -bit tag
+               const uint8_t* const __restrict data,  // N -bytes assoc. data
+               const size_t dlen,                     // len(data) = N | >= 0
+               const uint8_t* const __restrict enc,   // M -bytes cipher text
+               uint8_t* const __restrict txt,         // M -bytes plain text
+               const size_t ctlen                     // len(enc) = len(txt)
+  )
+  {
+    uint8_t acc[slen >> 3];
+    uint8_t tag_[tlen >> 3];
+
+    absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, acc);
+    absorb_cipher<slen, rounds>(ctx.ekey, enc, ctlen, acc);
+    finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag_);
+
+    const bool flg = verify_tag<tlen>(tag, tag_);
+
+    if (flg) {
+      apply_keystream(nonce, enc, txt, ctlen);
+    } else {
+      std::memset(txt, 0, ctlen);
+    }
+
+    return flg;
+  }
+};
+
+}
@@ -0,0 +1,315 @@
+#pragma once
+#include "aead.hpp"
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+// Multi-state ( lane sliced ) Spongent-π[{160, 176}] & Keccak-f[200]
+// permutations, applying same permutation on many independent states at once
+//
+// States are kept in lane sliced layout i.e. byte `i` of lane ( state ) `l`
+// lives at index `i * lanes + l`, so every step of round function becomes an
+// identical byte-wise operation over `lanes` -many consecutive bytes, which
+// compiler turns into SIMD instructions.
+namespace spongent {
+
+// Applies 8 -bit substitution box on every byte of all lanes of lane sliced
+// Spongent-π-W permutation state | W = slen = {160, 176}
+//
+// 8 -bit substitution box is two parallel copies of 4 -bit S-box
+// S = {e, d, b, 0, 2, 1, 4, f, 7, a, 8, 5, 9, c, 3, 6}, which is evaluated here
+// using its algebraic normal form ( on both nibbles at once ), instead of table
+// lookup, so that it's vectorizable
+//
+// y0 = x0 ^ x1 ^ x1x2 ^ x3
+// y1 = 1 ^ x0 ^ x1x2 ^ x0x3 ^ x1x3 ^ x2x3 ^ x1x2x3
+// y2 = 1 ^ x1 ^ x2 ^ x0x3 ^ x1x2x3
+// y3 = 1 ^ x0x1 ^ x2 ^ x3 ^ x0x3 ^ x1x3 ^ x0x1x3 ^ x0x2x3
+//
+// See section 2.3.1 of Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t lanes>
+inline static void
+apply_sbox_lanes(uint8_t* const state) requires(check_state_bit_len(slen))
+{
+  constexpr size_t n = (slen >> 3) * lanes;
+  constexpr uint8_t m = 0x11;
+
+  for (size_t i = 0; i < n; i++) {
+    const uint8_t v = state[i];
+
+    const uint8_t x0 = v & m;
+    const uint8_t x1 = (v >> 1) & m;
+    const uint8_t x2 = (v >> 2) & m;
+    const uint8_t x3 = (v >> 3) & m;
+
+    const uint8_t x12 = x1 & x2;
+    const uint8_t x03 = x0 & x3;
+    const uint8_t x13 = x1 & x3;
+
+    const uint8_t y0 = x0 ^ x1 ^ x12 ^ x3;
+    const uint8_t y1 = m ^ x0 ^ x12 ^ x03 ^ x13 ^ (x2 & x3) ^ (x12 & x3);
+    const uint8_t y2 = m ^ x1 ^ x2 ^ x03 ^ (x12 & x3);
+    const uint8_t y3 = m ^ (x0 & x1) ^ x2 ^ x3 ^ x03 ^ x13 ^ (x0 & x13) ^
+                       (x03 & x2);
+
+    state[i] = y0 ^ (y1 << 1) ^ (y2 << 2) ^ (y3 << 3);
+  }
+}
+
+// Applies bit permutation on all lanes of lane sliced Spongent-π-W
+// permutation state | W = slen = {160, 176}
+//
+// See formula defined in section 2.{3, 4}.1 of Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t lanes>
+inline static void
+apply_permutation_lanes(uint8_t* const state) requires(
+  check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t tmp[sbytes * lanes]{};
+
+  for (size_t i = 0; i < slen; i++) {
+    const size_t permi = pi<slen>(i);
+
+    const uint8_t* const src = state + (i >> 3) * lanes;
+    uint8_t* const dst = tmp + (permi >> 3) * lanes;
+
+    const size_t boff = i & 7;
+    const size_t boff_ = permi & 7;
+
+    for (size_t l = 0; l < lanes; l++) {
+      dst[l] |= ((src[l] >> boff) & 0b1) << boff_;
+    }
+  }
+
+  std::memcpy(state, tmp, sizeof(tmp));
+}
+
+// Applies `cnt` -many rounds of Spongent-π-W permutation, starting from round
+// `first`, on all lanes of lane sliced permutation state | W = slen = {160,
+// 176} & first + cnt <= {80, 90}
+template<const size_t slen, const size_t lanes>
+inline static void
+permute_lanes(uint8_t* const state,
+              const size_t first,
+              const size_t cnt) requires(check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  for (size_t r = first; r < first + cnt; r++) {
+    uint8_t rc0, rc1;
+
+    if constexpr (slen == 160) {
+      rc0 = LCounter160[r];
+      rc1 = RevLCounter160[r];
+    } else {
+      rc0 = LCounter176[r];
+      rc1 = RevLCounter176[r];
+    }
+
+    for (size_t l = 0; l < lanes; l++) {
+      state[l] ^= rc0;
+      state[(sbytes - 1) * lanes + l] ^= rc1;
+    }
+
+    apply_sbox_lanes<slen, lanes>(state);
+    apply_permutation_lanes<slen, lanes>(state);
+  }
+}
+
+}
+
+namespace keccak {
+
+// Applies `cnt` -many rounds of Keccak-f[200] permutation, starting from round
+// `first`, on all lanes of lane sliced permutation state | first + cnt <= 18
+//
+// See section 3.3 of https://dx.doi.org/10.6028/NIST.FIPS.202
+template<const size_t lanes>
+inline static void
+permute_lanes(uint8_t* const state, const size_t first, const size_t cnt)
+{
+  for (size_t r = first; r < first + cnt; r++) {
+    uint8_t c[5 * lanes];
+    uint8_t d[5 * lanes];
+    uint8_t tmp[25 * lanes];
+
+    // theta
+    for (size_t i = 0; i < 5; i++) {
+      for (size_t l = 0; l < lanes; l++) {
+        c[i * lanes + l] = state[i * lanes + l] ^ state[(i + 5) * lanes + l] ^
+                           state[(i + 10) * lanes + l] ^
+                           state[(i + 15) * lanes + l] ^
+                           state[(i + 20) * lanes + l];
+      }
+    }
+
+    for (size_t i = 0; i < 5; i++) {
+      const uint8_t* const c0 = c + ((i + 4) % 5) * lanes;
+      const uint8_t* const c1 = c + ((i + 1) % 5) * lanes;
+
+      for (size_t l = 0; l < lanes; l++) {
+        d[i * lanes + l] = c0[l] ^ static_cast<uint8_t>((c1[l] << 1) |
+                                                        (c1[l] >> 7));
+      }
+    }
+
+    for (size_t i = 0; i < 25; i++) {
+      for (size_t l = 0; l < lanes; l++) {
+        state[i * lanes + l] ^= d[(i % 5) * lanes + l];
+      }
+    }
+
+    // rho & pi
+    for (size_t i = 0; i < 5; i++) {
+      for (size_t j = 0; j < 5; j++) {
+        const size_t src = 5 * j + (3 * i + j) % 5;
+        const size_t rot = ROT[src];
+
+        for (size_t l = 0; l < lanes; l++) {
+          const uint8_t v = state[src * lanes + l];
+          tmp[(5 * i + j) * lanes + l] =
+            static_cast<uint8_t>((v << rot) | (v >> ((8 - rot) & 7)));
+        }
+      }
+    }
+
+    // chi
+    for (size_t i = 0; i < 5; i++) {
+      for (size_t j = 0; j < 5; j++) {
+        const uint8_t* const t0 = tmp + (5 * i + j) * lanes;
+        const uint8_t* const t1 = tmp + (5 * i + (j + 1) % 5) * lanes;
+        const uint8_t* const t2 = tmp + (5 * i + (j + 2) % 5) * lanes;
+
+        for (size_t l = 0; l < lanes; l++) {
+          state[(5 * i + j) * lanes + l] = t0[l] ^ (~t1[l] & t2[l]);
+        }
+      }
+    }
+
+    // iota
+    for (size_t l = 0; l < lanes; l++) {
+      state[l] ^= RC[r];
+    }
+  }
+}
+
+}
+
+namespace elephant {
+
+// Default # -of lanes, processed together by multi-state permutations ( one
+// 256 -bit vector register worth of bytes )
+constexpr size_t LANES = 32;
+
+// Applies `rounds` -many rounds of underlying permutation on every lane of lane
+// sliced state, holding `lanes` -many (slen >> 3) -bytes states
+template<const size_t slen, const size_t rounds, const size_t lanes>
+inline static void
+permute_lanes(uint8_t* const state) requires(
+  spongent::check_state_bit_len(slen))
+{
+  if constexpr ((slen == 160) || (slen == 176)) {
+    spongent::permute_lanes<slen, lanes>(state, 0, rounds);
+  } else if constexpr (slen == 200) {
+    keccak::permute_lanes<lanes>(state, 0, rounds);
+  }
+}
+
+// Copies (slen >> 3) -bytes state into lane `l` of lane sliced state
+template<const size_t slen, const size_t lanes>
+inline static void
+to_lane(const uint8_t* const __restrict in,
+        uint8_t* const __restrict state,
+        const size_t l) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  for (size_t i = 0; i < sbytes; i++) {
+    state[i * lanes + l] = in[i];
+  }
+}
+
+// Copies lane `l` of lane sliced state out, as (slen >> 3) -bytes state
+template<const size_t slen, const size_t lanes>
+inline static void
+from_lane(const uint8_t* const __restrict state,
+          uint8_t* const __restrict out,
+          const size_t l) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  for (size_t i = 0; i < sbytes; i++) {
+    out[i] = state[i * lanes + l];
+  }
+}
+
+// Splits `cnt` -many independent items ( states, sectors ... ) into groups of
+// `lanes` -many & spreads groups across `nthreads` -many threads, calling
+// `f(first, n)` for each group | n <= lanes
+//
+// Groups are split into `nthreads` -many contiguous parts, which are claimed
+// by calling thread & by helper tasks, posted to `default_thread_pool()`, so
+// that no thread is spawned per call. Calling thread keeps claiming parts until
+// none is left, so this is safe to call from a task running on that pool.
+template<const size_t lanes, typename F>
+static void
+for_each_lane_group(const size_t cnt, const size_t nthreads, F&& f)
+{
+  // claimed & finished part counters, shared with helpers, which may only
+  // start running once all parts are done
+  struct progress_t
+  {
+    std::atomic<size_t> claimed{ 0 };
+    std::atomic<size_t> finished{ 0 };
+  };
+
+  const size_t groups = (cnt + lanes - 1) / lanes;
+  const size_t nparts = std::max(1ul, std::min(nthreads, groups));
+  const size_t per_part = groups / nparts;
+  const size_t rm_groups = groups % nparts;
+
+  auto work = [&f, cnt, nparts, per_part, rm_groups](progress_t& p) {
+    size_t t;
+    while ((t = p.claimed.fetch_add(1, std::memory_order_relaxed)) < nparts) {
+      const size_t beg = t * per_part + std::min(t, rm_groups);
+      const size_t n = per_part + (t < rm_groups);
+
+      for (size_t g = beg; g < beg + n; g++) {
+        const size_t first = g * lanes;
+        f(first, std::min(lanes, cnt - first));
+      }
+
+      p.finished.fetch_add(1, std::memory_order_acq_rel);
+      p.finished.notify_all();
+    }
+  };
+
+  if (nparts == 1) {
+    progress_t p;
+    work(p);
+    return;
+  }
+
+  auto prog = std::make_shared<progress_t>();
+
+  thread_pool_t& pool = default_thread_pool();
+  const size_t nhelpers = std::min(nparts - 1, pool.size());
+
+  for (size_t i = 0; i < nhelpers; i++) {
+    pool.submit([work, prog]() { work(*prog); });
+  }
+
+  work(*prog);
+
+  size_t done;
+  while ((done = prog->finished.load(std::memory_order_acquire)) < nparts) {
+    prog->finished.wait(done, std::memory_order_acquire);
+  }
+}
+
+}
@@ -0,0 +1,152 @@
+#pragma once
+#include "lanes.hpp"
+#include "range.hpp"
+#include <cassert>
+
+// Authentication-only ( MAC ) mode of Elephant Authenticated Encryption with
+// Associated Data, for large messages which stay in the clear
+namespace elephant {
+
+// Authenticates `cnt` -many blocks of 12 -bytes nonce prepended & padded N
+// -bytes associated data, starting from block index `first`, XOR-ing result
+// into tag accumulator | first >= 1
+//
+// Very first block ( which holds nonce ) is never masked/ permuted, so it's
+// not handled here; every other block i contributes P(A_i ⊕ mask(K, i, 0)) ⊕
+// mask(K, i, 0), where mask(K, i, 0) = φ_1^i(K), which can be jumped to.
+//
+// Those permutation calls are all independent of each other, so blocks are
+// permuted `LANES` -many at a time, using multi-state permutation; only a
+// trailing group of less than `LANES / 2` -many blocks is permuted one by one.
+template<const size_t slen, const size_t rounds>
+static void
+absorb_data_at(const uint8_t* const __restrict ekey, // expanded masking key
+               const uint8_t* const __restrict data, // N -bytes assoc. data
+               const size_t dlen,                    // len(data) = N | >= 0
+               const size_t first,                   // first block index
+               const size_t cnt,                     // # -of blocks
+               uint8_t* const __restrict acc         // tag accumulator
+               ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t lanes = LANES;
+  constexpr uint8_t zeros[12]{};
+
+  assert(first >= 1);
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[lanes][sbytes];
+  uint8_t blk[sbytes];
+  uint8_t state[sbytes * lanes]{};
+
+  mask_at<slen>(ekey, first - 1, key);
+
+  for (size_t base = first; base < first + cnt; base += lanes) {
+    const size_t n = std::min(lanes, first + cnt - base);
+
+    if (n < lanes / 2) {
+      for (size_t i = base; i < base + n; i++) {
+        get_ith_data_block<slen>(data, dlen, zeros, i, blk);
+
+        next_mask<slen, 0>(key, hmask, fmask[0]);
+        std::memcpy(key, hmask, sbytes);
+
+        absorb_block<slen, rounds>(blk, fmask[0], acc);
+      }
+      break;
+    }
+
+    for (size_t l = 0; l < n; l++) {
+      get_ith_data_block<slen>(data, dlen, zeros, base + l, blk);
+
+      next_mask<slen, 0>(key, hmask, fmask[l]);
+      std::memcpy(key, hmask, sbytes);
+
+      for (size_t i = 0; i < sbytes; i++) {
+        blk[i] ^= fmask[l][i];
+      }
+      to_lane<slen, lanes>(blk, state, l);
+    }
+
+    permute_lanes<slen, rounds, lanes>(state);
+
+    for (size_t l = 0; l < n; l++) {
+      from_lane<slen, lanes>(state, blk, l);
+
+      for (size_t i = 0; i < sbytes; i++) {
+        acc[i] ^= blk[i] ^ fmask[l][i];
+      }
+    }
+  }
+}
+
+// Computes (tlen >> 3) -bytes message authentication code over N -bytes message
+// ( passed as associated data ), under given key context & 12 -bytes public
+// message nonce | N >= 0
+//
+// Produces same tag as `elephant::encrypt` does, with N -bytes associated data
+// & empty plain text, but skips keystream generation altogether & as cipher
+// text is empty, its only ( padding ) block is authenticated directly. Blocks
+// of associated data are all independent of each other, so they are split into
+// `nthreads` -many contiguous ranges, authenticated in parallel ( using
+// jump-ahead masks ) & partial accumulators are XOR-merged.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+mac(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict data,  // N -bytes message
+    const size_t dlen,                     // len(data) = N | >= 0
+    uint8_t* const __restrict tag,         // `tlen` -bit authentication tag
+    const size_t nthreads = 1              // # -of threads to use | > 0
+    ) requires(spongent::check_state_bit_len(slen) && check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t tot_blk_cnt = (12 + dlen + 1 + sbytes - 1) / sbytes;
+
+  uint8_t acc[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes]{};
+
+  get_ith_data_block<slen>(data, dlen, nonce, 0, acc);
+
+  absorb_parallel<slen>(
+    1,
+    tot_blk_cnt - 1,
+    nthreads,
+    [&](const size_t first, const size_t cnt, uint8_t* const pacc) {
+      absorb_data_at<slen, rounds>(ctx.ekey, data, dlen, first, cnt, pacc);
+    },
+    acc);
+
+  // padding block of empty cipher text
+  blk[0] = 0x01;
+  next_mask<slen, 2>(ctx.ekey, hmask, fmask);
+  absorb_block<slen, rounds>(blk, fmask, acc);
+
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag);
+}
+
+// Recomputes message authentication code over N -bytes message ( using
+// `nthreads` -many threads ) & compares it against expected (tlen >> 3) -bytes
+// tag, returning truth value only when they're equal | N >= 0
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+mac_verify(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+           const uint8_t* const __restrict nonce, // 96 -bit nonce
+           const uint8_t* const __restrict tag,   // `tlen` -bit tag
+           const uint8_t* const __restrict data,  // N -bytes message
+           const size_t dlen,                     // len(data) = N | >= 0
+           const size_t nthreads = 1              // # -of threads to use | > 0
+           ) requires(spongent::check_state_bit_len(slen) &&
+                      check_tag_bit_len(tlen))
+{
+  uint8_t tag_[tlen >> 3];
+
+  mac<slen, rounds, tlen>(ctx, nonce, data, dlen, tag_, nthreads);
+  return verify_tag<tlen>(tag, tag_);
+}
+
+}
@@ -0,0 +1,418 @@
+#pragma once
+#include "context.hpp"
+#include "lanes.hpp"
+#include <vector>
+
+// Multi-buffer {en, de}cryption of many independent ( variable length )
+// messages under same key, pushing all their permutation calls through
+// multi-state permutation lanes
+namespace elephant {
+
+// Single message of multi-buffer {en, de}cryption
+//
+// When encrypting, `in` is plain text, `out` receives cipher text & `tag`
+// receives authentication tag, while when decrypting, `in` is cipher text,
+// `out` receives plain text ( zeroed, if verification fails ), `tag` holds
+// expected authentication tag & `ok` receives verification flag. Input &
+// output text must not overlap.
+struct mb_msg_t
+{
+  const uint8_t* nonce = nullptr; // 96 -bit nonce
+  const uint8_t* data = nullptr;  // N -bytes associated data
+  size_t dlen = 0;                // len(data) = N | >= 0
+  const uint8_t* in = nullptr;    // M -bytes input text
+  uint8_t* out = nullptr;         // M -bytes output text
+  size_t len = 0;                 // len(in) = len(out) = M | >= 0
+  uint8_t* tag = nullptr;         // authentication tag
+  bool ok = false;                // verification flag, when decrypting
+};
+
+// Occupancy of multi-state permutation lanes, accumulated over calls
+struct mb_stats_t
+{
+  uint64_t calls = 0; // # -of multi-state permutation calls
+  uint64_t used = 0;  // # -of lanes carrying some state, over all calls
+
+  // Fraction of lanes doing useful work | [0, 1]
+  template<const size_t lanes = LANES>
+  double fill_ratio() const
+  {
+    return calls == 0 ? 0. : static_cast<double>(used) / (calls * lanes);
+  }
+};
+
+// Mask table & scratch space for multi-buffer {en, de}cryption under a key
+// context, which must outlive it; not thread-safe, use one per thread
+//
+// Every mask Elephant uses is XOR of LFSR states L_i = φ_1^i(K) i.e.
+//
+// - associated data block i ( >= 1 ) : L_i
+// - keystream block i : L_i ⊕ L_{i + 1}
+// - cipher text block i : L_i ⊕ L_{i + 2} ( as φ_1 is linear )
+//
+// so table keeps L_0, L_1, ..., growing on demand up to longest message seen,
+// & shares it among all messages. After each run, table & scratch space are
+// trimmed back to `keep_bytes`, so that a single long message doesn't pin its
+// memory for the table's lifetime. Table is zeroed when it goes out of scope.
+template<const size_t slen, const size_t rounds>
+class mb_table_t
+{
+public:
+  static constexpr size_t sbytes = slen >> 3;
+
+  // Kind of permutation input
+  enum class kind_t : uint8_t
+  {
+    keystream,
+    data,
+    cipher,
+    tag
+  };
+
+  // Permutation input, identified by message & block index
+  struct item_t
+  {
+    uint32_t msg;
+    kind_t kind;
+    size_t blk;
+  };
+
+  // Default # -of bytes, each of table & scratch buffers keeps between runs
+  static constexpr size_t KEEP_BYTES = 1ul << 16;
+
+  const key_ctx_t<slen, rounds>& ctx;
+  const size_t keep_bytes;
+
+  std::vector<uint8_t> lfsr_states; // L_0, L_1, ...
+  std::vector<uint8_t> accs;        // tag accumulator of each message
+  std::vector<item_t> items;        // permutation inputs of current pass
+
+  explicit mb_table_t(const key_ctx_t<slen, rounds>& ctx_,
+                      const size_t keep_bytes_ = KEEP_BYTES)
+    : ctx(ctx_)
+    , keep_bytes(keep_bytes_)
+    , lfsr_states(ctx_.ekey, ctx_.ekey + sbytes)
+  {
+  }
+
+  mb_table_t(const mb_table_t&) = delete;
+  mb_table_t& operator=(const mb_table_t&) = delete;
+
+  ~mb_table_t()
+  {
+    secure_zero(lfsr_states.data(), lfsr_states.size());
+    secure_zero(accs.data(), accs.size());
+  }
+
+  // Extends table to hold at least L_0, ..., L_{n - 1}
+  void reserve(const size_t n)
+  {
+    size_t have = lfsr_states.size() / sbytes;
+    if (have >= n) {
+      return;
+    }
+
+    lfsr_states.resize(n * sbytes);
+    for (; have < n; have++) {
+      uint8_t* const dst = lfsr_states.data() + have * sbytes;
+
+      std::memcpy(dst, dst - sbytes, sbytes);
+      lfsr<slen>(dst);
+    }
+  }
+
+  // Shrinks table back to at most `keep_bytes` -bytes ( keeping at least L_0
+  // ) & releases scratch buffers grown beyond that, zeroing all memory handed
+  // back to allocator
+  void trim()
+  {
+    if (lfsr_states.size() > keep_bytes) {
+      const size_t n = std::max<size_t>(keep_bytes / sbytes, 1) * sbytes;
+      std::vector<uint8_t> kept(lfsr_states.begin(), lfsr_states.begin() + n);
+
+      secure_zero(lfsr_states.data(), lfsr_states.size());
+      lfsr_states.swap(kept);
+    }
+
+    if (accs.capacity() > keep_bytes) {
+      accs.resize(accs.capacity());
+      secure_zero(accs.data(), accs.size());
+      std::vector<uint8_t>().swap(accs);
+    }
+
+    if (items.capacity() * sizeof(item_t) > keep_bytes) {
+      std::vector<item_t>().swap(items);
+    }
+  }
+
+  // L_i | i < # -of reserved states
+  inline const uint8_t* at(const size_t i) const
+  {
+    return lfsr_states.data() + i * sbytes;
+  }
+};
+
+// Runs `n` -many independent permutation inputs through `lanes` -many lanes
+// at a time, where `load(k, st)` writes k-th input & `store(k, st)` consumes
+// k-th output ( both (slen >> 3) -bytes ), in order of k
+template<const size_t slen,
+         const size_t rounds,
+         const size_t lanes,
+         typename Load,
+         typename Store>
+static void
+mb_stream(const size_t n, Load&& load, Store&& store, mb_stats_t& stats)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t state[sbytes * lanes]{};
+  uint8_t buf[sbytes];
+
+  for (size_t base = 0; base < n; base += lanes) {
+    const size_t cnt = std::min(lanes, n - base);
+
+    for (size_t l = 0; l < cnt; l++) {
+      load(base + l, buf);
+      to_lane<slen, lanes>(buf, state, l);
+    }
+
+    permute_lanes<slen, rounds, lanes>(state);
+
+    for (size_t l = 0; l < cnt; l++) {
+      from_lane<slen, lanes>(state, buf, l);
+      store(base + l, buf);
+    }
+
+    stats.calls++;
+    stats.used += cnt;
+  }
+}
+
+// {En, De}crypts `cnt` -many independent messages, under key context of mask
+// table, producing same output as `elephant::{en, de}crypt` on each of them,
+// returning true only when every message verifies ( when decrypting )
+//
+// Work is done in ( at most ) three passes over lanes
+//
+// 1) keystream & associated data blocks of all messages ( also cipher text
+// blocks, when decrypting )
+// 2) cipher text blocks of all messages, when encrypting
+// 3) tag finalization of all messages
+//
+// so that lanes stay full, as long as there are enough blocks in a pass,
+// irrespective of how short individual messages are.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting,
+         const size_t lanes = LANES>
+static bool
+mb_run(mb_table_t<slen, rounds>& tab, // mask table & scratch space
+       mb_msg_t* const msgs,          // `cnt` -many messages
+       const size_t cnt,              // # -of messages | >= 0
+       mb_stats_t& stats              // lane occupancy
+       ) requires(spongent::check_state_bit_len(slen) &&
+                  check_tag_bit_len(tlen))
+{
+  using table_t = mb_table_t<slen, rounds>;
+  using kind_t = typename table_t::kind_t;
+
+  constexpr size_t sbytes = slen >> 3;
+
+  auto& items = tab.items;
+  auto& accs = tab.accs;
+
+  size_t max_blks = 0;
+  for (size_t m = 0; m < cnt; m++) {
+    const size_t ad_blks = (12 + msgs[m].dlen + 1 + sbytes - 1) / sbytes;
+    const size_t ct_blks = (msgs[m].len + 1 + sbytes - 1) / sbytes;
+
+    max_blks = std::max({ max_blks, ad_blks, ct_blks });
+  }
+
+  tab.reserve(max_blks + 2);
+  accs.resize(cnt * sbytes);
+
+  for (size_t m = 0; m < cnt; m++) {
+    const mb_msg_t& msg = msgs[m];
+    get_ith_data_block<slen>(
+      msg.data, msg.dlen, msg.nonce, 0, accs.data() + m * sbytes);
+  }
+
+  // computes mask of a permutation input
+  auto mask = [&](const typename table_t::item_t& it, uint8_t* const fmask) {
+    const size_t i = it.blk;
+
+    switch (it.kind) {
+      case kind_t::keystream:
+        for (size_t j = 0; j < sbytes; j++) {
+          fmask[j] = tab.at(i)[j] ^ tab.at(i + 1)[j];
+        }
+        break;
+      case kind_t::data:
+        std::memcpy(fmask, tab.at(i), sbytes);
+        break;
+      case kind_t::cipher:
+        for (size_t j = 0; j < sbytes; j++) {
+          fmask[j] = tab.at(i)[j] ^ tab.at(i + 2)[j];
+        }
+        break;
+      case kind_t::tag:
+        std::memcpy(fmask, tab.ctx.ekey, sbytes);
+        break;
+    }
+  };
+
+  // writes masked ( padded ) input block of a permutation input
+  auto load = [&](const size_t k, uint8_t* const st) {
+    const auto& it = items[k];
+    const mb_msg_t& msg = msgs[it.msg];
+    const size_t i = it.blk;
+
+    switch (it.kind) {
+      case kind_t::keystream:
+        std::memcpy(st, msg.nonce, 12);
+        std::memset(st + 12, 0, sbytes - 12);
+        break;
+      case kind_t::data:
+        get_ith_data_block<slen>(msg.data, msg.dlen, msg.nonce, i, st);
+        break;
+      case kind_t::cipher:
+        get_ith_cipher_block<slen>(
+          decrypting ? msg.in : msg.out, msg.len, i, st);
+        break;
+      case kind_t::tag:
+        std::memcpy(st, accs.data() + it.msg * sbytes, sbytes);
+        break;
+    }
+
+    uint8_t fmask[sbytes];
+    mask(it, fmask);
+
+    for (size_t j = 0; j < sbytes; j++) {
+      st[j] ^= fmask[j];
+    }
+  };
+
+  bool flag = true;
+
+  auto store = [&](const size_t k, uint8_t* const st) {
+    const auto& it = items[k];
+    mb_msg_t& msg = msgs[it.msg];
+
+    uint8_t fmask[sbytes];
+    mask(it, fmask);
+
+    for (size_t j = 0; j < sbytes; j++) {
+      st[j] ^= fmask[j];
+    }
+
+    if (it.kind == kind_t::keystream) {
+      const size_t off = it.blk * sbytes;
+      const size_t elen = std::min(sbytes, msg.len - off);
+
+      for (size_t j = 0; j < elen; j++) {
+        msg.out[off + j] = msg.in[off + j] ^ st[j];
+      }
+    } else if (it.kind == kind_t::tag) {
+      if constexpr (decrypting) {
+        msg.ok = verify_tag<tlen>(msg.tag, st);
+        flag &= msg.ok;
+
+        if (!msg.ok && (msg.len > 0)) {
+          std::memset(msg.out, 0, msg.len);
+        }
+      } else {
+        std::memcpy(msg.tag, st, tlen >> 3);
+      }
+    } else {
+      uint8_t* const acc = accs.data() + it.msg * sbytes;
+      for (size_t j = 0; j < sbytes; j++) {
+        acc[j] ^= st[j];
+      }
+    }
+  };
+
+  // pass 1
+  items.clear();
+  for (size_t m = 0; m < cnt; m++) {
+    const uint32_t mi = static_cast<uint32_t>(m);
+    const size_t ks_blks = (msgs[m].len + sbytes - 1) / sbytes;
+    const size_t ad_blks = (12 + msgs[m].dlen + 1 + sbytes - 1) / sbytes;
+    const size_t ct_blks = (msgs[m].len + 1 + sbytes - 1) / sbytes;
+
+    for (size_t i = 0; i < ks_blks; i++) {
+      items.push_back({ mi, kind_t::keystream, i });
+    }
+    for (size_t i = 1; i < ad_blks; i++) {
+      items.push_back({ mi, kind_t::data, i });
+    }
+    if constexpr (decrypting) {
+      for (size_t i = 0; i < ct_blks; i++) {
+        items.push_back({ mi, kind_t::cipher, i });
+      }
+    }
+  }
+  mb_stream<slen, rounds, lanes>(items.size(), load, store, stats);
+
+  // pass 2
+  if constexpr (!decrypting) {
+    items.clear();
+    for (size_t m = 0; m < cnt; m++) {
+      const uint32_t mi = static_cast<uint32_t>(m);
+      const size_t ct_blks = (msgs[m].len + 1 + sbytes - 1) / sbytes;
+
+      for (size_t i = 0; i < ct_blks; i++) {
+        items.push_back({ mi, kind_t::cipher, i });
+      }
+    }
+    mb_stream<slen, rounds, lanes>(items.size(), load, store, stats);
+  }
+
+  // pass 3
+  items.clear();
+  for (size_t m = 0; m < cnt; m++) {
+    items.push_back({ static_cast<uint32_t>(m), kind_t::tag, 0 });
+  }
+  mb_stream<slen, rounds, lanes>(items.size(), load, store, stats);
+
+  tab.trim();
+  return flag;
+}
+
+// Encrypts `cnt` -many independent messages through multi-state permutation
+// lanes, see `mb_run` | cnt >= 0
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes = LANES>
+static void
+encrypt_multi(mb_table_t<slen, rounds>& tab, // mask table & scratch space
+              mb_msg_t* const msgs,          // `cnt` -many messages
+              const size_t cnt,              // # -of messages | >= 0
+              mb_stats_t& stats              // lane occupancy
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  mb_run<slen, rounds, tlen, false, lanes>(tab, msgs, cnt, stats);
+}
+
+// Verifies & decrypts `cnt` -many independent messages through multi-state
+// permutation lanes, returning true only when every message verifies; each
+// message's own verification flag is written to its `ok` field | cnt >= 0
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes = LANES>
+static bool
+decrypt_multi(mb_table_t<slen, rounds>& tab, // mask table & scratch space
+              mb_msg_t* const msgs,          // `cnt` -many messages
+              const size_t cnt,              // # -of messages | >= 0
+              mb_stats_t& stats              // lane occupancy
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  return mb_run<slen, rounds, tlen, true, lanes>(tab, msgs, cnt, stats);
+}
+
+}
@@ -0,0 +1,226 @@
+#pragma once
+#include "context.hpp"
+#include <atomic>
+#include <random>
+
+// Nonce management for Elephant Authenticated Encryption with Associated Data,
+// handing out unique 96 -bit nonces under a key, from many threads, without
+// locks
+namespace elephant {
+
+// How 12 -bytes nonces are laid out
+//
+// - counter : 4 -bytes fixed field ( say, device/ process identifier, chosen
+// by caller ) || 8 -bytes big endian counter
+// - random_prefix : 8 -bytes random prefix ( drawn once per generator ) || 4
+// -bytes big endian counter, so that independent processes sharing a key
+// don't collide, without coordinating; at most 2^32 nonces per generator
+enum class nonce_mode_t
+{
+  counter,
+  random_prefix
+};
+
+// Generator of unique nonces, drawing from a shared atomic counter
+//
+// Threads reserve disjoint ranges ( leases ) of `lease_len` -many counter
+// values at a time, using a single compare-and-swap, & hand out nonces from
+// their lease with no synchronization at all. Counter values left unused in a
+// lease are simply skipped, so nonces are unique but not dense. Once counter
+// space ( or caller imposed limit ) is used up, generator refuses to hand out
+// any more nonces, so that key can be rotated instead of nonces repeating.
+class nonce_gen_t
+{
+private:
+  alignas(64) std::atomic<uint64_t> ctr{ 0 };
+
+  alignas(64) uint8_t prefix[8]{};
+  size_t prefix_len = 4;
+  uint64_t limit = 0;
+  uint64_t lease_len = 0;
+  uint64_t id = 0;
+
+  // Unique identifier of generator instance, used for tagging thread local
+  // leases, so that a lease never outlives ( or gets mixed up with ) its
+  // generator, even if another generator reuses same address
+  static inline uint64_t next_id()
+  {
+    static std::atomic<uint64_t> ids{ 1 };
+    return ids.fetch_add(1, std::memory_order_relaxed);
+  }
+
+public:
+  // Range [next, end) of counter values, reserved by a single thread
+  struct lease_t
+  {
+    uint64_t next = 0;
+    uint64_t end = 0;
+  };
+
+  // Generator handing out nonces in given mode, reserving `lease_len` -many
+  // counter values at a time, refusing to hand out more than `max_nonces`
+  // -many ( clamped to counter space of mode ) | lease_len > 0
+  //
+  // `field` is 4 -bytes fixed field in counter mode & ignored otherwise.
+  explicit nonce_gen_t(const nonce_mode_t mode = nonce_mode_t::random_prefix,
+                       const uint32_t field = 0,
+                       const uint64_t lease_len_ = 1024,
+                       const uint64_t max_nonces = ~0ul)
+    : lease_len(std::max<uint64_t>(lease_len_, 1))
+    , id(next_id())
+  {
+    if (mode == nonce_mode_t::counter) {
+      prefix_len = 4;
+      for (size_t i = 0; i < 4; i++) {
+        prefix[i] = static_cast<uint8_t>(field >> ((3 - i) << 3));
+      }
+
+      limit = max_nonces;
+    } else {
+      prefix_len = 8;
+
+      std::random_device rd;
+      for (size_t i = 0; i < 8; i += 4) {
+        const uint32_t r = rd();
+        std::memcpy(prefix + i, &r, 4);
+      }
+
+      limit = std::min<uint64_t>(max_nonces, 1ul << 32);
+    }
+  }
+
+  nonce_gen_t(const nonce_gen_t&) = delete;
+  nonce_gen_t& operator=(const nonce_gen_t&) = delete;
+
+  // Reserves next range of counter values, returning false, if generator is
+  // exhausted
+  bool reserve(lease_t& l)
+  {
+    uint64_t cur = ctr.load(std::memory_order_relaxed);
+
+    while (true) {
+      if (cur >= limit) {
+        return false;
+      }
+
+      const uint64_t n = std::min(lease_len, limit - cur);
+      if (ctr.compare_exchange_weak(
+            cur, cur + n, std::memory_order_relaxed)) {
+        l.next = cur;
+        l.end = cur + n;
+        return true;
+      }
+    }
+  }
+
+  // Writes 12 -bytes nonce of given counter value
+  inline void encode(const uint64_t c, uint8_t* const nonce) const
+  {
+    std::memcpy(nonce, prefix, 8);
+
+    if (prefix_len == 4) {
+      for (size_t i = 0; i < 8; i++) {
+        nonce[4 + i] = static_cast<uint8_t>(c >> ((7 - i) << 3));
+      }
+    } else {
+      for (size_t i = 0; i < 4; i++) {
+        nonce[8 + i] = static_cast<uint8_t>(c >> ((3 - i) << 3));
+      }
+    }
+  }
+
+  // Hands out next nonce from caller owned lease, refilling it from shared
+  // counter, when empty | returns false, if generator is exhausted
+  inline bool next(lease_t& l, uint8_t* const nonce)
+  {
+    if ((l.next == l.end) && !reserve(l)) {
+      return false;
+    }
+
+    encode(l.next++, nonce);
+    return true;
+  }
+
+  // Hands out next nonce from calling thread's lease, returning false, if
+  // generator is exhausted
+  //
+  // Each thread caches lease of one generator; using many generators from
+  // same thread in turn works, but throws away rest of lease on every switch.
+  bool next(uint8_t* const nonce)
+  {
+    struct tls_lease_t
+    {
+      uint64_t owner = 0;
+      lease_t lease;
+    };
+    thread_local tls_lease_t tls;
+
+    if (tls.owner != id) {
+      tls.owner = id;
+      tls.lease = lease_t{};
+    }
+
+    return next(tls.lease, nonce);
+  }
+
+  // Whether every counter value has been reserved
+  bool exhausted() const
+  {
+    return ctr.load(std::memory_order_relaxed) >= limit;
+  }
+
+  // # -of counter values not yet reserved by any thread
+  uint64_t remaining() const
+  {
+    const uint64_t cur = ctr.load(std::memory_order_relaxed);
+    return cur >= limit ? 0 : limit - cur;
+  }
+};
+
+// Key context, carrying its own nonce generator, so that callers never have to
+// come up with nonces themselves
+template<const size_t slen, const size_t rounds>
+struct nonce_ctx_t : public key_ctx_t<slen, rounds>
+{
+  nonce_gen_t nonces;
+
+  // Expands 128 -bit secret key & sets up nonce generator, see `nonce_gen_t`
+  explicit nonce_ctx_t(const uint8_t* const key,
+                       const nonce_mode_t mode = nonce_mode_t::random_prefix,
+                       const uint32_t field = 0,
+                       const uint64_t lease_len = 1024,
+                       const uint64_t max_nonces = ~0ul)
+    : key_ctx_t<slen, rounds>(key)
+    , nonces(mode, field, lease_len, max_nonces)
+  {
+  }
+};
+
+// Encrypts M -bytes plain text & authenticates N -bytes associated data under
+// a fresh nonce, drawn from key context's generator, which is written to
+// `nonce` ( it must be sent along with cipher text ) | M, N >= 0
+//
+// Returns false, without touching any output, if nonces are exhausted, in
+// which case key must be rotated.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+seal(nonce_ctx_t<slen, rounds>& ctx,      // key context with nonce generator
+     const uint8_t* const __restrict data, // N -bytes associated data
+     const size_t dlen,                    // len(data) = N | >= 0
+     const uint8_t* const __restrict txt,  // M -bytes plain text
+     uint8_t* const __restrict enc,        // M -bytes encrypted text
+     const size_t ctlen,                   // len(txt) = len(enc) = M | >= 0
+     uint8_t* const __restrict nonce,      // 96 -bit nonce, used
+     uint8_t* const __restrict tag         // `tlen` -bit authentication tag
+     ) requires(spongent::check_state_bit_len(slen) &&
+                check_tag_bit_len(tlen))
+{
+  if (!ctx.nonces.next(nonce)) {
+    return false;
+  }
+
+  encrypt<slen, rounds, tlen>(ctx, nonce, data, dlen, txt, enc, ctlen, tag);
+  return true;
+}
+
+}
@@ -0,0 +1,284 @@
+#pragma once
+#include "context.hpp"
+#include "jump.hpp"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Seekable ( byte range ) decryption for Elephant Authenticated Encryption with
+// Associated Data, along with authentication-only verification pass
+namespace elephant {
+
+// XORs keystream bytes [off, off + len), generated using 12 -bytes nonce &
+// expanded masking key, with `len` -bytes input, producing `len` -bytes output
+//
+// Only keystream blocks covering requested byte range are computed, after
+// jumping mask generating LFSR ahead to very first of them.
+template<const size_t slen, const size_t rounds>
+static void
+xor_keystream_at(const uint8_t* const __restrict ekey,  // expanded masking key
+                 const uint8_t* const __restrict nonce, // 96 -bit nonce
+                 const size_t off, // byte offset of input, in whole text
+                 const uint8_t* const __restrict in, // `len` -bytes input
+                 uint8_t* const __restrict out,      // `len` -bytes output
+                 const size_t len                    // len(in) = len(out)
+                 ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t ks[sbytes];
+
+  mask_at<slen>(ekey, off / sbytes, key);
+
+  size_t skip = off % sbytes;
+  size_t done = 0;
+
+  while (done < len) {
+    const size_t elen = std::min(sbytes - skip, len - done);
+
+    next_mask<slen, 1>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    keystream_block<slen, rounds>(nonce, fmask, ks);
+
+    for (size_t i = 0; i < elen; i++) {
+      out[done + i] = in[done + i] ^ ks[skip + i];
+    }
+
+    done += elen;
+    skip = 0;
+  }
+}
+
+// Authenticates `cnt` -many padded cipher text blocks, starting from block
+// index `first`, XOR-ing result into tag accumulator | M -bytes cipher text
+//
+// Partial accumulators of disjoint block ranges can be XOR-ed together, which
+// gives same result as authenticating all of them, in order.
+template<const size_t slen, const size_t rounds>
+static void
+absorb_cipher_at(const uint8_t* const __restrict ekey, // expanded masking key
+                 const uint8_t* const __restrict enc,  // M -bytes cipher text
+                 const size_t ctlen,                   // len(enc) = M | >= 0
+                 const size_t first,                   // first block index
+                 const size_t cnt,                     // # -of blocks
+                 uint8_t* const __restrict acc         // tag accumulator
+                 ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  mask_at<slen>(ekey, first, key);
+
+  for (size_t i = first; i < first + cnt; i++) {
+    get_ith_cipher_block<slen>(enc, ctlen, i, blk);
+
+    next_mask<slen, 2>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    absorb_block<slen, rounds>(blk, fmask, acc);
+  }
+}
+
+// Callable doing nothing, default for optional callbacks
+struct no_op_t
+{
+  inline void operator()() const {}
+};
+
+// Splits block index range [first, first + cnt) into `nthreads` -many
+// contiguous parts, invoking `f(first, cnt, acc)` on each of them ( in parallel
+// ), with zero initialized partial tag accumulators, which are finally XOR-ed
+// into `acc`
+//
+// Masks of any block can be computed using jump-ahead, so that each part can
+// be authenticated independently of others.
+//
+// Parts are claimed by calling thread & by helper tasks, posted to
+// `default_thread_pool()`. Calling thread keeps claiming parts until none is
+// left, so it never waits for a helper which didn't start yet, which makes
+// this safe to call from a task running on that same pool.
+//
+// Calling thread runs `own()` right after posting helpers & before claiming
+// any part, so that some other serial work ( say associated data absorption,
+// writing into `acc` ) overlaps with parts being authenticated by helpers.
+template<const size_t slen, typename F, typename G = no_op_t>
+static void
+absorb_parallel(const size_t first,            // first block index
+                const size_t cnt,              // # -of blocks
+                const size_t nthreads,         // # -of threads to use | > 0
+                F&& f,                         // authenticates a block range
+                uint8_t* const __restrict acc, // tag accumulator
+                G&& own = G{}                  // serial work of caller
+)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  // claimed & finished part counters, shared with helpers, which may only
+  // start running once all parts are done
+  struct progress_t
+  {
+    std::atomic<size_t> claimed{ 0 };
+    std::atomic<size_t> finished{ 0 };
+  };
+
+  const size_t nparts = std::max(1ul, std::min(nthreads, cnt));
+  const size_t per_part = cnt / nparts;
+  const size_t rm_blks = cnt % nparts;
+
+  std::vector<uint8_t> accs(nparts * sbytes, 0);
+  auto prog = std::make_shared<progress_t>();
+
+  auto work = [&f, &accs, first, nparts, per_part, rm_blks](progress_t& p) {
+    size_t t;
+    while ((t = p.claimed.fetch_add(1, std::memory_order_relaxed)) < nparts) {
+      const size_t beg = first + t * per_part + std::min(t, rm_blks);
+      const size_t n = per_part + (t < rm_blks);
+
+      f(beg, n, accs.data() + t * sbytes);
+
+      p.finished.fetch_add(1, std::memory_order_acq_rel);
+      p.finished.notify_all();
+    }
+  };
+
+  if (nparts > 1) {
+    thread_pool_t& pool = default_thread_pool();
+    const size_t nhelpers = std::min(nparts - 1, pool.size());
+
+    for (size_t i = 0; i < nhelpers; i++) {
+      pool.submit([work, prog]() { work(*prog); });
+    }
+  }
+
+  own();
+  work(*prog);
+
+  size_t done;
+  while ((done = prog->finished.load(std::memory_order_acquire)) < nparts) {
+    prog->finished.wait(done, std::memory_order_acquire);
+  }
+
+  for (size_t t = 0; t < nparts; t++) {
+    for (size_t i = 0; i < sbytes; i++) {
+      acc[i] ^= accs[t * sbytes + i];
+    }
+  }
+}
+
+// Authentication-only pass, which recomputes tag over N -bytes associated data
+// & M -bytes cipher text ( without decrypting anything ) & compares it against
+// expected (tlen >> 3) -bytes tag | M, N >= 0
+//
+// Cipher text blocks are split into `nthreads` -many contiguous ranges, which
+// are authenticated in parallel ( using jump-ahead masks ) & their partial
+// accumulators are XOR-merged. Associated data is absorbed by calling thread,
+// while other threads authenticate cipher text.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+verify(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+       const uint8_t* const __restrict nonce, // 96 -bit nonce
+       const uint8_t* const __restrict tag,   // `tlen` -bit authentication tag
+       const uint8_t* const __restrict data,  // N -bytes associated data
+       const size_t dlen,                     // len(data) = N | >= 0
+       const uint8_t* const __restrict enc,   // M -bytes encrypted text
+       const size_t ctlen,                    // len(enc) = M | >= 0
+       const size_t nthreads = 1              // # -of threads to use | > 0
+       ) requires(spongent::check_state_bit_len(slen) &&
+                  check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t tot_blk_cnt = (ctlen + 1 + sbytes - 1) / sbytes;
+
+  uint8_t acc[sbytes];
+
+  absorb_parallel<slen>(
+    0,
+    tot_blk_cnt,
+    nthreads,
+    [&](const size_t first, const size_t cnt, uint8_t* const pacc) {
+      absorb_cipher_at<slen, rounds>(ctx.ekey, enc, ctlen, first, cnt, pacc);
+    },
+    acc,
+    [&]() { absorb_data<slen, rounds>(ctx.ekey, nonce, data, dlen, acc); });
+
+  uint8_t tag_[tlen >> 3];
+  finalize_tag<slen, rounds, tlen>(ctx.ekey, acc, tag_);
+
+  return verify_tag<tlen>(tag, tag_);
+}
+
+// Decrypts byte range [off, off + len) of M -bytes cipher text, without
+// verifying authentication tag | off + len <= M
+//
+// Cost of this routine is O(len), independent of M. `enc` points to cipher text
+// bytes of requested range ( not to beginning of whole cipher text ) & `txt`
+// receives `len` -bytes of plain text.
+//
+// Note, plain text produced by this routine is unverified. Caller must
+// ( possibly later ) run `verify` on whole cipher text & must not release
+// decrypted bytes, unless that passes.
+template<const size_t slen, const size_t rounds>
+static void
+decrypt_range_unverified(
+  const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+  const uint8_t* const __restrict nonce, // 96 -bit nonce
+  const uint8_t* const __restrict enc,   // `len` -bytes cipher text of range
+  const size_t off,                      // byte offset of range
+  const size_t len,                      // byte length of range
+  uint8_t* const __restrict txt          // `len` -bytes plain text of range
+  ) requires(spongent::check_state_bit_len(slen))
+{
+  xor_keystream_at<slen, rounds>(ctx.ekey, nonce, off, enc, txt, len);
+}
+
+// Verifies authentication tag over N -bytes associated data & whole M -bytes
+// cipher text ( using `nthreads` -many threads ), then decrypts only byte range
+// [off, off + len) of cipher text, returning boolean verification flag
+//
+// Note, `enc` points to beginning of whole cipher text, while `txt` receives
+// `len` -bytes plain text of requested range, which is zeroed if verification
+// fails. A range not lying within cipher text is rejected, returning false
+// without touching `txt`.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decrypt_range(const key_ctx_t<slen, rounds>& ctx,    // expanded key context
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict tag,   // `tlen` -bit tag
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const __restrict enc,   // M -bytes cipher text
+              const size_t ctlen,                    // len(enc) = M | >= 0
+              const size_t off,                      // byte offset of range
+              const size_t len,                      // byte length of range
+              uint8_t* const __restrict txt,         // `len` -bytes plain text
+              const size_t nthreads = 1              // # -of threads | > 0
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  if ((off > ctlen) || (len > ctlen - off)) {
+    return false;
+  }
+
+  const bool flg = verify<slen, rounds, tlen>(
+    ctx, nonce, tag, data, dlen, enc, ctlen, nthreads);
+
+  if (flg) {
+    xor_keystream_at<slen, rounds>(ctx.ekey, nonce, off, enc + off, txt, len);
+  } else {
+    std::memset(txt, 0, len);
+  }
+
+  return flg;
+}
+
+}
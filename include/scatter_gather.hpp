@@ -0,0 +1,399 @@
+#pragma once
+#include "aead.hpp"
+
+// Scatter-gather ( i.e. iovec style ) Elephant Authenticated Encryption with
+// Associated Data, where associated data, input & output texts are allowed to
+// live in multiple non-contiguous memory fragments
+namespace elephant {
+
+// Read-only memory fragment, much like POSIX `struct iovec`
+struct iovec_t
+{
+  const uint8_t* base; // starting address of fragment
+  size_t len;          // byte length of fragment | >= 0
+};
+
+// Writable memory fragment, much like POSIX `struct iovec`
+struct iovec_mut_t
+{
+  uint8_t* base; // starting address of fragment
+  size_t len;    // byte length of fragment | >= 0
+};
+
+// Total byte length of `cnt` -many memory fragments
+template<typename iov_t>
+inline static size_t
+iov_len(const iov_t* const iov, const size_t cnt)
+{
+  size_t len = 0;
+  for (size_t i = 0; i < cnt; i++) {
+    len += iov[i].len;
+  }
+  return len;
+}
+
+// Sequential cursor over an array of memory fragments, which hands out direct
+// pointers when requested bytes live in a single fragment, otherwise it
+// stitches/ splits them across fragment boundaries, using caller's scratch
+template<typename iov_t>
+struct iov_cursor
+{
+  using ptr_t = decltype(iov_t::base);
+
+  const iov_t* iov; // array of memory fragments
+  size_t cnt;       // # -of memory fragments
+  size_t idx = 0;   // index of current fragment
+  size_t off = 0;   // byte offset inside current fragment
+
+  iov_cursor(const iov_t* const iov_, const size_t cnt_)
+    : iov(iov_)
+    , cnt(cnt_)
+  {
+    skip_empty();
+  }
+
+  // Moves past fully consumed/ empty fragments
+  inline void skip_empty()
+  {
+    while ((idx < cnt) && (off == iov[idx].len)) {
+      idx++;
+      off = 0;
+    }
+  }
+
+  // If next `n` -bytes live in current fragment, returns pointer to them,
+  // while moving cursor forward; otherwise returns nullptr & doesn't move
+  inline ptr_t contiguous(const size_t n)
+  {
+    if ((idx < cnt) && (iov[idx].len - off >= n)) {
+      ptr_t ptr = iov[idx].base + off;
+      off += n;
+      skip_empty();
+      return ptr;
+    }
+    return nullptr;
+  }
+
+  // Gathers next `n` -bytes ( possibly spanning multiple fragments ) into
+  // `dst`, while moving cursor forward
+  inline void read(uint8_t* const __restrict dst, const size_t n)
+  {
+    size_t done = 0;
+    while (done < n) {
+      const size_t take = std::min(n - done, iov[idx].len - off);
+      std::memcpy(dst + done, iov[idx].base + off, take);
+
+      done += take;
+      off += take;
+      skip_empty();
+    }
+  }
+
+  // Scatters `n` -bytes from `src` over next fragments, while moving cursor
+  // forward
+  inline void write(const uint8_t* const __restrict src, const size_t n)
+  {
+    size_t done = 0;
+    while (done < n) {
+      const size_t take = std::min(n - done, iov[idx].len - off);
+      std::memcpy(iov[idx].base + off, src + done, take);
+
+      done += take;
+      off += take;
+      skip_empty();
+    }
+  }
+};
+
+// Reads next `n` ( <= slen >> 3 ) -bytes from cursor, appends padding byte 0x01
+// ( if space permits ) followed by zero bytes, while masking with `fmask`, so
+// that resulting block is ready to be permuted
+//
+// Note, when those `n` -bytes live in a single fragment, they are read directly
+// from there, otherwise they're first stitched together in scratch space.
+template<const size_t slen, typename iov_t>
+inline static void
+masked_padded_block(iov_cursor<iov_t>& cur,
+                    const size_t n,
+                    const uint8_t* const __restrict fmask,
+                    uint8_t* const __restrict blk)
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t tmp[sbytes];
+
+  const uint8_t* src = cur.contiguous(n);
+  if (src == nullptr) {
+    cur.read(tmp, n);
+    src = tmp;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    blk[i] = src[i] ^ fmask[i];
+  }
+  for (size_t i = n; i < sbytes; i++) {
+    blk[i] = fmask[i] ^ static_cast<uint8_t>(i == n);
+  }
+}
+
+// Authenticates 12 -bytes nonce prepended & padded associated data, living in
+// `dcnt` -many memory fragments, XOR-ing result into tag accumulator
+//
+// See step {5, 9} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+static void
+absorb_data_iov(const uint8_t* const __restrict ekey, // expanded masking key
+                const uint8_t* const __restrict nonce, // 96 -bit nonce
+                const iovec_t* const __restrict data,  // associated data
+                const size_t dcnt, // # -of associated data fragments
+                uint8_t* const __restrict acc // tag accumulator
+                ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr uint8_t zeros[sbytes]{};
+
+  const size_t dlen = iov_len(data, dcnt);
+  const size_t tot_blk_cnt = (12 + dlen + 1 + sbytes - 1) / sbytes;
+
+  iov_cursor<iovec_t> cur{ data, dcnt };
+
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  // very first block carries nonce & it's never masked/ permuted
+  const size_t n0 = std::min(sbytes - 12, dlen);
+
+  masked_padded_block<slen>(cur, n0, zeros, blk);
+  std::memcpy(acc, nonce, 12);
+  std::memcpy(acc + 12, blk, sbytes - 12);
+
+  uint8_t key[sbytes];
+  std::memcpy(key, ekey, sbytes);
+
+  for (size_t i = 1; i < tot_blk_cnt; i++) {
+    const size_t n = std::min(sbytes, dlen - (i * sbytes - 12));
+
+    next_mask<slen, 0>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    masked_padded_block<slen>(cur, n, fmask, blk);
+    permute<slen, rounds>(blk);
+
+    for (size_t j = 0; j < sbytes; j++) {
+      acc[j] ^= blk[j] ^ fmask[j];
+    }
+  }
+}
+
+// Authenticates padded cipher text, living in `ccnt` -many memory fragments,
+// XOR-ing result into tag accumulator
+//
+// See step {6, 10} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds, typename iov_t>
+static void
+absorb_cipher_iov(const uint8_t* const __restrict ekey, // expanded masking key
+                  const iov_t* const __restrict enc,    // cipher text
+                  const size_t ccnt, // # -of cipher text fragments
+                  uint8_t* const __restrict acc // tag accumulator
+                  ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t ctlen = iov_len(enc, ccnt);
+  const size_t tot_blk_cnt = (ctlen + 1 + sbytes - 1) / sbytes;
+
+  iov_cursor<iov_t> cur{ enc, ccnt };
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t blk[sbytes];
+
+  std::memcpy(key, ekey, sbytes);
+
+  for (size_t i = 0; i < tot_blk_cnt; i++) {
+    const size_t n = std::min(sbytes, ctlen - i * sbytes);
+
+    next_mask<slen, 2>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    masked_padded_block<slen>(cur, n, fmask, blk);
+    permute<slen, rounds>(blk);
+
+    for (size_t j = 0; j < sbytes; j++) {
+      acc[j] ^= blk[j] ^ fmask[j];
+    }
+  }
+}
+
+// XORs keystream, generated using 12 -bytes nonce, with input text living in
+// `icnt` -many memory fragments, writing result into `ocnt` -many output memory
+// fragments | total byte length of input fragments = total byte length of
+// output fragments, which must be ensured by caller
+//
+// Note, input & output fragment boundaries don't need to be aligned with each
+// other. Blocks fully living inside one fragment are {read from, written to}
+// directly, only blocks straddling fragment boundaries are stitched together.
+//
+// See step {4, 7} of algorithm 1 & 2, in Elephant specification
+// https://csrc.nist.gov/CSRC/media/Projects/lightweight-cryptography/documents/finalist-round/updated-spec-doc/elephant-spec-final.pdf
+template<const size_t slen, const size_t rounds>
+static void
+xor_keystream_iov(const uint8_t* const __restrict ekey, // expanded masking key
+                  const uint8_t* const __restrict nonce, // 96 -bit nonce
+                  const iovec_t* const __restrict in,    // input text
+                  const size_t icnt, // # -of input text fragments
+                  const iovec_mut_t* const __restrict out, // output text
+                  const size_t ocnt // # -of output text fragments
+                  ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t ctlen = iov_len(in, icnt);
+
+  iov_cursor<iovec_t> icur{ in, icnt };
+  iov_cursor<iovec_mut_t> ocur{ out, ocnt };
+
+  uint8_t key[sbytes];
+  uint8_t hmask[sbytes];
+  uint8_t fmask[sbytes];
+  uint8_t ks[sbytes];
+  uint8_t itmp[sbytes];
+  uint8_t otmp[sbytes];
+
+  std::memcpy(key, ekey, sbytes);
+
+  size_t off = 0;
+  while (off < ctlen) {
+    const size_t elen = std::min(sbytes, ctlen - off);
+
+    next_mask<slen, 1>(key, hmask, fmask);
+    std::memcpy(key, hmask, sbytes);
+
+    keystream_block<slen, rounds>(nonce, fmask, ks);
+
+    const uint8_t* src = icur.contiguous(elen);
+    if (src == nullptr) {
+      icur.read(itmp, elen);
+      src = itmp;
+    }
+
+    uint8_t* dst = ocur.contiguous(elen);
+    const bool stitched = dst == nullptr;
+    dst = stitched ? otmp : dst;
+
+    for (size_t i = 0; i < elen; i++) {
+      dst[i] = src[i] ^ ks[i];
+    }
+
+    if (stitched) {
+      ocur.write(otmp, elen);
+    }
+
+    off += elen;
+  }
+}
+
+// Given 16 -bytes secret key, 12 -bytes public message nonce, N -bytes
+// associated data & M -bytes plain text, this routine computes M -bytes
+// encrypted text & (tlen >> 3) -bytes authentication tag, using Dumbo/ Jumbo/
+// Delirium AEAD scheme | M, N >= 0
+//
+// Same as `elephant::encrypt`, except associated data, plain text & encrypted
+// text are supplied as arrays of memory fragments, which need not be
+// coalesced by caller. Total byte length of plain text fragments must be equal
+// to total byte length of encrypted text fragments, otherwise nothing is
+// written to encrypted text fragments & authentication tag is zeroed.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+encryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 96 -bit nonce
+         const iovec_t* const __restrict data,  // N -bytes associated data
+         const size_t dcnt,                  // # -of associated data fragments
+         const iovec_t* const __restrict txt, // M -bytes plain text
+         const size_t tcnt,                   // # -of plain text fragments
+         const iovec_mut_t* const __restrict enc, // M -bytes encrypted text
+         const size_t ecnt,            // # -of encrypted text fragments
+         uint8_t* const __restrict tag // `tlen` -bit authentication tag
+         ) requires(spongent::check_state_bit_len(slen) &&
+                    check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  if (iov_len(txt, tcnt) != iov_len(enc, ecnt)) {
+    std::memset(tag, 0, tbytes);
+    return;
+  }
+
+  uint8_t ekey[sbytes];
+  uint8_t acc[sbytes];
+
+  expand_key<slen, rounds>(key, ekey);
+
+  xor_keystream_iov<slen, rounds>(ekey, nonce, txt, tcnt, enc, ecnt);
+  absorb_data_iov<slen, rounds>(ekey, nonce, data, dcnt, acc);
+  absorb_cipher_iov<slen, rounds>(ekey, enc, ecnt, acc);
+  finalize_tag<slen, rounds, tlen>(ekey, acc, tag);
+}
+
+// Given 16 -bytes secret key, 12 -bytes public message nonce, (tlen >> 3)
+// -bytes authentication tag, N -bytes associated data & M -bytes encrypted
+// text, this routine computes M -bytes plain text & boolean verification flag,
+// using Dumbo/ Jumbo/ Delirium AEAD scheme | M, N >= 0
+//
+// Same as `elephant::decrypt`, except associated data, encrypted text & plain
+// text are supplied as arrays of memory fragments, which need not be coalesced
+// by caller. Total byte length of encrypted text fragments must be equal to
+// total byte length of plain text fragments, otherwise verification fails.
+//
+// Note, authentication tag is verified before decrypting, so unverified plain
+// text never reaches output fragments; on failure they are zeroed.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decryptv(const uint8_t* const __restrict key,   // 128 -bit secret key
+         const uint8_t* const __restrict nonce, // 96 -bit nonce
+         const uint8_t* const __restrict tag,   // authentication tag
+         const iovec_t* const __restrict data,  // N -bytes associated data
+         const size_t dcnt,                  // # -of associated data fragments
+         const iovec_t* const __restrict enc, // M -bytes encrypted text
+         const size_t ecnt,                   // # -of encrypted text fragments
+         const iovec_mut_t* const __restrict txt, // M -bytes plain text
+         const size_t tcnt // # -of plain text fragments
+         ) requires(spongent::check_state_bit_len(slen) &&
+                    check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  uint8_t ekey[sbytes];
+  uint8_t acc[sbytes];
+  uint8_t tag_[tbytes];
+
+  bool flg = iov_len(enc, ecnt) == iov_len(txt, tcnt);
+
+  if (flg) {
+    expand_key<slen, rounds>(key, ekey);
+
+    absorb_data_iov<slen, rounds>(ekey, nonce, data, dcnt, acc);
+    absorb_cipher_iov<slen, rounds>(ekey, enc, ecnt, acc);
+    finalize_tag<slen, rounds, tlen>(ekey, acc, tag_);
+
+    flg = verify_tag<tlen>(tag, tag_);
+  }
+
+  if (flg) {
+    xor_keystream_iov<slen, rounds>(ekey, nonce, enc, ecnt, txt, tcnt);
+  } else {
+    for (size_t i = 0; i < tcnt; i++) {
+      std::memset(txt[i].base, 0, txt[i].len);
+    }
+  }
+
+  return flg;
+}
+
+}
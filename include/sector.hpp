@@ -0,0 +1,355 @@
+#pragma once
+#include "context.hpp"
+#include "lanes.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Sector oriented ( block storage ) API of Elephant Authenticated Encryption
+// with Associated Data, {en, de}crypting runs of consecutive fixed length
+// sectors, with authentication tags kept out-of-band
+namespace elephant {
+
+// Derives 12 -bytes nonce of a sector, as 64 -bit sector number ( little
+// endian ) followed by 32 -bit generation counter ( little endian ), which
+// must be bumped every time sector is rewritten
+inline static void
+sector_nonce(const uint64_t sector,  // sector number
+             const uint32_t gen,     // generation of sector
+             uint8_t* const nonce    // 96 -bit nonce
+)
+{
+  for (size_t i = 0; i < 8; i++) {
+    nonce[i] = static_cast<uint8_t>(sector >> (i << 3));
+  }
+  for (size_t i = 0; i < 4; i++) {
+    nonce[8 + i] = static_cast<uint8_t>(gen >> (i << 3));
+  }
+}
+
+// Mask table for sectors of fixed length, built from shared key context
+//
+// Sectors carry no associated data ( other than nonce, which fits in very
+// first, never masked, associated data block ), so every `mask(K, i, b)`
+// needed for a sector depends only on key & block index, never on sector.
+// Table holds exactly one sector worth of them i.e. mask(K, i, 1) for each
+// keystream block & mask(K, i, 2) for each padded cipher text block, so that
+// no mask is ever recomputed. Table is zeroed when it goes out of scope.
+template<const size_t slen, const size_t rounds>
+class sector_table_t
+{
+public:
+  static constexpr size_t sbytes = slen >> 3;
+
+  const key_ctx_t<slen, rounds>& ctx;
+  const size_t sector_len;
+  const size_t ks_blks; // # -of keystream blocks per sector
+  const size_t ct_blks; // # -of padded cipher text blocks per sector
+
+  std::vector<uint8_t> ks_masks; // `ks_blks` -many mask(K, i, 1)
+  std::vector<uint8_t> ct_masks; // `ct_blks` -many mask(K, i, 2)
+
+  // Builds mask table for sectors of `sector_len` -bytes, using key context,
+  // which must outlive table | sector_len > 0
+  sector_table_t(const key_ctx_t<slen, rounds>& ctx_, const size_t sector_len_)
+    : ctx(ctx_)
+    , sector_len(sector_len_)
+    , ks_blks((sector_len_ + sbytes - 1) / sbytes)
+    , ct_blks((sector_len_ + 1 + sbytes - 1) / sbytes)
+    , ks_masks(ks_blks * sbytes)
+    , ct_masks(ct_blks * sbytes)
+  {
+    uint8_t key[sbytes];
+    uint8_t hmask[sbytes];
+
+    std::memcpy(key, ctx.ekey, sbytes);
+    for (size_t i = 0; i < ks_blks; i++) {
+      next_mask<slen, 1>(key, hmask, ks_masks.data() + i * sbytes);
+      std::memcpy(key, hmask, sbytes);
+    }
+
+    std::memcpy(key, ctx.ekey, sbytes);
+    for (size_t i = 0; i < ct_blks; i++) {
+      next_mask<slen, 2>(key, hmask, ct_masks.data() + i * sbytes);
+      std::memcpy(key, hmask, sbytes);
+    }
+
+    secure_zero(key, sizeof(key));
+    secure_zero(hmask, sizeof(hmask));
+  }
+
+  sector_table_t(const sector_table_t&) = delete;
+  sector_table_t& operator=(const sector_table_t&) = delete;
+
+  ~sector_table_t()
+  {
+    secure_zero(ks_masks.data(), ks_masks.size());
+    secure_zero(ct_masks.data(), ct_masks.size());
+  }
+};
+
+// XORs keystream of `cnt` -many consecutive sectors ( cnt <= lanes ), with
+// sector `i` in lane `i` of multi-state permutation, into output sectors;
+// when `keep` is non-null, only sectors `i` with `keep[i]` set are written
+//
+// Note, input & output sectors may be same ( i.e. in-place ), but must not
+// partially overlap.
+template<const size_t slen, const size_t rounds, const size_t lanes>
+static void
+sector_keystream(const sector_table_t<slen, rounds>& tab, // mask table
+                 const uint8_t* const __restrict nonces,  // lane sliced nonces
+                 const uint8_t* const in,                 // input sectors
+                 uint8_t* const out,                      // output sectors
+                 const size_t cnt,                        // # -of sectors
+                 const bool* const keep = nullptr // `cnt` -many flags
+                 ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  const size_t seclen = tab.sector_len;
+
+  uint8_t state[sbytes * lanes];
+
+  for (size_t j = 0; j < tab.ks_blks; j++) {
+    const uint8_t* const fmask = tab.ks_masks.data() + j * sbytes;
+
+    for (size_t i = 0; i < sbytes; i++) {
+      for (size_t l = 0; l < lanes; l++) {
+        state[i * lanes + l] = fmask[i];
+      }
+    }
+    for (size_t i = 0; i < 12 * lanes; i++) {
+      state[i] ^= nonces[i];
+    }
+
+    permute_lanes<slen, rounds, lanes>(state);
+
+    const size_t off = j * sbytes;
+    const size_t elen = std::min(sbytes, seclen - off);
+
+    for (size_t l = 0; l < cnt; l++) {
+      if ((keep != nullptr) && !keep[l]) {
+        continue;
+      }
+
+      const uint8_t* const src = in + l * seclen + off;
+      uint8_t* const dst = out + l * seclen + off;
+
+      for (size_t i = 0; i < elen; i++) {
+        dst[i] = src[i] ^ state[i * lanes + l] ^ fmask[i];
+      }
+    }
+  }
+}
+
+// Computes authentication tags of `cnt` -many consecutive encrypted sectors (
+// cnt <= lanes ), with sector `i` in lane `i` of multi-state permutation
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes>
+static void
+sector_tags(const sector_table_t<slen, rounds>& tab, // mask table
+            const uint8_t* const __restrict nonces,  // lane sliced nonces
+            const uint8_t* const __restrict enc,     // encrypted sectors
+            uint8_t* const __restrict tags,          // `cnt` -many tags
+            const size_t cnt                         // # -of sectors
+            ) requires(spongent::check_state_bit_len(slen) &&
+                       check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t seclen = tab.sector_len;
+
+  uint8_t acc[sbytes * lanes]{};
+  uint8_t state[sbytes * lanes];
+  uint8_t blk[sbytes];
+
+  // first associated data block = nonce || 0x01 || 0*
+  std::memcpy(acc, nonces, 12 * lanes);
+  for (size_t l = 0; l < lanes; l++) {
+    acc[12 * lanes + l] = 0x01;
+  }
+
+  for (size_t j = 0; j < tab.ct_blks; j++) {
+    const uint8_t* const fmask = tab.ct_masks.data() + j * sbytes;
+
+    for (size_t l = 0; l < lanes; l++) {
+      if (l < cnt) {
+        get_ith_cipher_block<slen>(enc + l * seclen, seclen, j, blk);
+      } else {
+        std::memset(blk, 0, sbytes);
+      }
+
+      for (size_t i = 0; i < sbytes; i++) {
+        state[i * lanes + l] = blk[i] ^ fmask[i];
+      }
+    }
+
+    permute_lanes<slen, rounds, lanes>(state);
+
+    for (size_t i = 0; i < sbytes; i++) {
+      for (size_t l = 0; l < lanes; l++) {
+        acc[i * lanes + l] ^= state[i * lanes + l] ^ fmask[i];
+      }
+    }
+  }
+
+  const uint8_t* const ekey = tab.ctx.ekey;
+
+  for (size_t i = 0; i < sbytes; i++) {
+    for (size_t l = 0; l < lanes; l++) {
+      state[i * lanes + l] = acc[i * lanes + l] ^ ekey[i];
+    }
+  }
+
+  permute_lanes<slen, rounds, lanes>(state);
+
+  for (size_t l = 0; l < cnt; l++) {
+    for (size_t i = 0; i < tbytes; i++) {
+      tags[l * tbytes + i] = state[i * lanes + l] ^ ekey[i];
+    }
+  }
+}
+
+// Lane sliced nonces of `cnt` -many consecutive sectors, starting at sector
+// number `first` | cnt <= lanes
+template<const size_t lanes>
+inline static void
+sector_nonces(const uint64_t first,
+              const uint32_t* const __restrict gens,
+              const size_t cnt,
+              uint8_t* const __restrict nonces)
+{
+  uint8_t nonce[12];
+
+  std::memset(nonces, 0, 12 * lanes);
+
+  for (size_t l = 0; l < cnt; l++) {
+    sector_nonce(first + l, gens[l], nonce);
+
+    for (size_t i = 0; i < 12; i++) {
+      nonces[i * lanes + l] = nonce[i];
+    }
+  }
+}
+
+// Encrypts `cnt` -many consecutive sectors, starting at sector number `first`,
+// writing (tlen >> 3) -bytes tag of each sector into out-of-band tag array |
+// cnt >= 0
+//
+// Sector i is sealed under nonce `sector_nonce(first + i, gens[i])` with empty
+// associated data, producing same cipher text & tag as `elephant::encrypt`
+// would. Up to `lanes` -many sectors go through multi-state permutation
+// together & such groups are spread across `nthreads` -many threads.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes = LANES>
+static void
+encrypt_sectors(const sector_table_t<slen, rounds>& tab, // mask table
+                const uint64_t first,                  // first sector number
+                const uint32_t* const __restrict gens, // `cnt` generations
+                const uint8_t* const __restrict txt,   // `cnt` plain sectors
+                uint8_t* const __restrict enc,         // `cnt` cipher sectors
+                const size_t cnt,                      // # -of sectors
+                uint8_t* const __restrict tags,        // `cnt` -many tags
+                const size_t nthreads = 1              // # -of threads | > 0
+                ) requires(spongent::check_state_bit_len(slen) &&
+                           check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t seclen = tab.sector_len;
+
+  for_each_lane_group<lanes>(
+    cnt, nthreads, [&](const size_t s, const size_t n) {
+      uint8_t nonces[12 * lanes];
+      sector_nonces<lanes>(first + s, gens + s, n, nonces);
+
+      const uint8_t* const in = txt + s * seclen;
+      uint8_t* const out = enc + s * seclen;
+
+      sector_keystream<slen, rounds, lanes>(tab, nonces, in, out, n);
+      sector_tags<slen, rounds, tlen, lanes>(
+        tab, nonces, out, tags + s * tbytes, n);
+    });
+}
+
+// Verifies & decrypts `cnt` -many consecutive sectors, starting at sector
+// number `first`, using (tlen >> 3) -bytes tags from out-of-band tag array,
+// returning true only when every sector verifies | cnt >= 0
+//
+// Tags of whole group of up to `lanes` -many sectors are verified first & only
+// sectors which pass are decrypted, so unauthenticated plain text is never
+// written out; plain text of sectors failing verification is zeroed instead.
+// When `ok` is non-null, it receives `cnt` -many per sector verification
+// flags.
+//
+// Note, decryption may happen in-place i.e. `enc` = `txt`, in which case
+// sectors failing verification lose their cipher text too.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes = LANES>
+static bool
+decrypt_sectors(const sector_table_t<slen, rounds>& tab, // mask table
+                const uint64_t first,                  // first sector number
+                const uint32_t* const __restrict gens, // `cnt` generations
+                const uint8_t* const __restrict tags,  // `cnt` -many tags
+                const uint8_t* const enc,              // `cnt` cipher sectors
+                uint8_t* const txt,                    // `cnt` plain sectors
+                const size_t cnt,                      // # -of sectors
+                const size_t nthreads = 1,             // # -of threads | > 0
+                bool* const __restrict ok = nullptr    // `cnt` -many flags
+                ) requires(spongent::check_state_bit_len(slen) &&
+                           check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  const size_t seclen = tab.sector_len;
+
+  std::atomic<bool> all{ true };
+
+  for_each_lane_group<lanes>(
+    cnt, nthreads, [&](const size_t s, const size_t n) {
+      uint8_t nonces[12 * lanes];
+      uint8_t tags_[tbytes * lanes];
+      bool keep[lanes];
+
+      sector_nonces<lanes>(first + s, gens + s, n, nonces);
+
+      const uint8_t* const in = enc + s * seclen;
+      uint8_t* const out = txt + s * seclen;
+
+      sector_tags<slen, rounds, tlen, lanes>(tab, nonces, in, tags_, n);
+
+      bool any = false;
+      for (size_t l = 0; l < n; l++) {
+        const uint8_t* const tag = tags + (s + l) * tbytes;
+
+        keep[l] = verify_tag<tlen>(tag, tags_ + l * tbytes);
+        any |= keep[l];
+
+        if (ok != nullptr) {
+          ok[s + l] = keep[l];
+        }
+      }
+
+      if (any) {
+        sector_keystream<slen, rounds, lanes>(tab, nonces, in, out, n, keep);
+      }
+
+      for (size_t l = 0; l < n; l++) {
+        if (!keep[l]) {
+          std::memset(out + l * seclen, 0, seclen);
+          all.store(false, std::memory_order_relaxed);
+        }
+      }
+    });
+
+  return all.load(std::memory_order_relaxed);
+}
+
+}
@@ -0,0 +1,540 @@
+#pragma once
+#include "context.hpp"
+#include "thread_pool.hpp"
+#include <functional>
+
+// Segmented ( chunked ) stream format on top of Elephant Authenticated
+// Encryption with Associated Data, for messages which don't fit in memory
+namespace elephant {
+
+// Stream is laid out as
+//
+// header || segment_0 || segment_1 || ... || segment_(n-1)
+//
+// where header ( 24 -bytes ) is
+//
+// magic "ELPH" (4) || version (1) || slen >> 3 (1) || tlen >> 3 (1) ||
+// reserved = 0 (1) || segment length L, little-endian (4) || base nonce (12)
+//
+// & segment i holds L -bytes ( last one holds <= L -bytes ) cipher text,
+// followed by (tlen >> 3) -bytes authentication tag. Segment i is encrypted
+// under nonce N_i = base nonce ⊕ (0^32 || big-endian i), with associated data
+// header || final flag, where final flag is 1 only for last segment.
+//
+// Because each segment is independently authenticated, segments can be {en,
+// de}crypted in parallel & any segment can be decrypted on its own, given its
+// offset. Binding final flag to last segment detects truncation ( at segment
+// boundary ), while binding header to every segment detects parameter
+// tampering. Empty stream consists of header & single empty final segment.
+constexpr size_t SEGMENT_HEADER_LEN = 24;
+constexpr uint8_t SEGMENT_MAGIC[4]{ 'E', 'L', 'P', 'H' };
+constexpr uint8_t SEGMENT_VERSION = 1;
+
+// Default upper bound on segment length ( 64 MiB ), both produced & accepted.
+// Header isn't authenticated until first segment is opened, so segment length
+// read from it must be bounded, before it's used for sizing any buffer.
+constexpr uint32_t SEGMENT_MAX_LEN = 1u << 26;
+
+// Parameters of segmented stream, carried in its header
+struct segment_header_t
+{
+  uint8_t sbytes = 0;   // slen >> 3, of AEAD scheme in use
+  uint8_t tbytes = 0;   // tlen >> 3, of AEAD scheme in use
+  uint32_t seg_len = 0; // # -of plain text bytes per segment
+  uint8_t nonce[12]{};  // base nonce
+
+  // Serializes header into 24 -bytes
+  inline void encode(uint8_t* const out) const
+  {
+    std::memcpy(out, SEGMENT_MAGIC, 4);
+    out[4] = SEGMENT_VERSION;
+    out[5] = sbytes;
+    out[6] = tbytes;
+    out[7] = 0;
+
+    for (size_t i = 0; i < 4; i++) {
+      out[8 + i] = static_cast<uint8_t>(seg_len >> (i << 3));
+    }
+
+    std::memcpy(out + 12, nonce, 12);
+  }
+
+  // Deserializes 24 -bytes header, returning false, if it's malformed or its
+  // segment length is not in [1, max_len]
+  inline bool decode(const uint8_t* const in,
+                     const uint32_t max_len = SEGMENT_MAX_LEN)
+  {
+    if (std::memcmp(in, SEGMENT_MAGIC, 4) != 0) {
+      return false;
+    }
+    if ((in[4] != SEGMENT_VERSION) || (in[7] != 0)) {
+      return false;
+    }
+
+    sbytes = in[5];
+    tbytes = in[6];
+
+    seg_len = 0;
+    for (size_t i = 0; i < 4; i++) {
+      seg_len |= static_cast<uint32_t>(in[8 + i]) << (i << 3);
+    }
+
+    std::memcpy(nonce, in + 12, 12);
+    return (seg_len > 0) && (seg_len <= max_len);
+  }
+};
+
+// Derives nonce of i-th segment, by XOR-ing big-endian segment index into last
+// 8 -bytes of base nonce
+inline static void
+segment_nonce(const uint8_t* const __restrict base, // 96 -bit base nonce
+              const uint64_t idx,                   // segment index
+              uint8_t* const __restrict nonce       // 96 -bit segment nonce
+)
+{
+  std::memcpy(nonce, base, 12);
+
+  for (size_t i = 0; i < 8; i++) {
+    nonce[11 - i] ^= static_cast<uint8_t>(idx >> (i << 3));
+  }
+}
+
+// Byte offset of i-th segment, in segmented stream
+template<const size_t tlen>
+inline static uint64_t
+segment_offset(const uint32_t seg_len, const uint64_t idx)
+{
+  const uint64_t stride = static_cast<uint64_t>(seg_len) + (tlen >> 3);
+  return SEGMENT_HEADER_LEN + idx * stride;
+}
+
+// Encrypts M -bytes plain text of i-th segment, producing M -bytes cipher text,
+// followed by (tlen >> 3) -bytes authentication tag | M <= segment length
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+seal_segment(const key_ctx_t<slen, rounds>& ctx,  // expanded key context
+             const uint8_t* const __restrict hdr, // 24 -bytes stream header
+             const uint64_t idx,                  // segment index
+             const bool final,                    // is it last segment ?
+             const uint8_t* const __restrict txt, // M -bytes plain text
+             const size_t len,                    // len(txt) = M
+             uint8_t* const __restrict out // M + (tlen >> 3) -bytes output
+             ) requires(spongent::check_state_bit_len(slen) &&
+                        check_tag_bit_len(tlen))
+{
+  const uint8_t* const base = hdr + 12;
+
+  uint8_t nonce[12];
+  uint8_t data[SEGMENT_HEADER_LEN + 1];
+
+  segment_nonce(base, idx, nonce);
+  std::memcpy(data, hdr, SEGMENT_HEADER_LEN);
+  data[SEGMENT_HEADER_LEN] = final;
+
+  encrypt<slen, rounds, tlen>(
+    ctx, nonce, data, sizeof(data), txt, out, len, out + len);
+}
+
+// Verifies & decrypts i-th segment, holding M -bytes cipher text, followed by
+// (tlen >> 3) -bytes authentication tag, producing M -bytes plain text; returns
+// false ( zeroing plain text ), if verification fails
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+open_segment(const key_ctx_t<slen, rounds>& ctx,  // expanded key context
+             const uint8_t* const __restrict hdr, // 24 -bytes stream header
+             const uint64_t idx,                  // segment index
+             const bool final,                    // is it last segment ?
+             const uint8_t* const __restrict in, // M + (tlen >> 3) -bytes input
+             const size_t len,                   // M
+             uint8_t* const __restrict txt       // M -bytes plain text
+             ) requires(spongent::check_state_bit_len(slen) &&
+                        check_tag_bit_len(tlen))
+{
+  const uint8_t* const base = hdr + 12;
+
+  uint8_t nonce[12];
+  uint8_t data[SEGMENT_HEADER_LEN + 1];
+
+  segment_nonce(base, idx, nonce);
+  std::memcpy(data, hdr, SEGMENT_HEADER_LEN);
+  data[SEGMENT_HEADER_LEN] = final;
+
+  return decrypt<slen, rounds, tlen>(
+    ctx, nonce, in + len, data, sizeof(data), in, txt, len);
+}
+
+// Consumer of produced bytes, returning false on failure
+using segment_sink_t = std::function<bool(const uint8_t*, size_t)>;
+
+// Positional reader of stored bytes, which reads requested # -of bytes from
+// given offset, returning # -of bytes actually read
+using segment_source_t = std::function<size_t(uint64_t, uint8_t*, size_t)>;
+
+// Streaming writer of segmented stream, which accepts plain text in arbitrary
+// sized pieces & emits header, followed by sealed segments, in order, to sink
+//
+// Full segments are sealed on thread pool ( when given ), while at most `depth`
+// -many of them are in flight, so memory usage stays bounded by ( depth + 1 )
+// segments, irrespective of stream length. A full segment is sealed only once
+// some more plain text arrives, because until then it may turn out to be last.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class segment_writer_t
+{
+private:
+  static constexpr size_t tbytes = tlen >> 3;
+
+  struct job_t
+  {
+    std::vector<uint8_t> txt;
+    std::vector<uint8_t> out;
+    std::future<void> done;
+  };
+
+  const key_ctx_t<slen, rounds>& ctx;
+  const uint32_t seg_len;
+  segment_sink_t sink;
+  thread_pool_t* const pool;
+  const size_t depth;
+
+  uint8_t hdr[SEGMENT_HEADER_LEN];
+  bool hdr_written = false;
+  bool failed = false;
+  bool finished = false;
+
+  std::vector<uint8_t> cur; // plain text of segment being filled
+  uint64_t seg_idx = 0;     // index of segment being filled
+  std::deque<job_t> jobs;   // segments being sealed, in order
+  std::vector<std::vector<uint8_t>> spare; // recycled buffers
+
+  inline std::vector<uint8_t> take_buffer()
+  {
+    if (spare.empty()) {
+      return {};
+    }
+
+    auto buf = std::move(spare.back());
+    spare.pop_back();
+    buf.clear();
+    return buf;
+  }
+
+  inline bool emit(const uint8_t* const buf, const size_t len)
+  {
+    if (!failed && !sink(buf, len)) {
+      failed = true;
+    }
+    return !failed;
+  }
+
+  // Waits for oldest in flight segment & writes it to sink
+  inline bool drain_one()
+  {
+    job_t& j = jobs.front();
+    j.done.wait();
+
+    emit(j.out.data(), j.out.size());
+
+    secure_zero(j.txt.data(), j.txt.size());
+    spare.emplace_back(std::move(j.txt));
+    spare.emplace_back(std::move(j.out));
+    jobs.pop_front();
+
+    return !failed;
+  }
+
+  // Hands over segment being filled, for sealing
+  inline bool dispatch(const bool final)
+  {
+    job_t j;
+    j.txt = std::move(cur);
+    j.out = take_buffer();
+    j.out.resize(j.txt.size() + tbytes);
+
+    const uint64_t idx = seg_idx++;
+    auto task = [this, idx, final, txt = j.txt.data(), len = j.txt.size(),
+                 out = j.out.data()]() {
+      seal_segment<slen, rounds, tlen>(ctx, hdr, idx, final, txt, len, out);
+    };
+
+    if (pool != nullptr) {
+      j.done = pool->submit(std::move(task));
+    } else {
+      std::promise<void> p;
+      task();
+      p.set_value();
+      j.done = p.get_future();
+    }
+
+    jobs.emplace_back(std::move(j));
+
+    cur = take_buffer();
+    cur.reserve(seg_len);
+
+    while (jobs.size() > depth) {
+      if (!drain_one()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+public:
+  // Writer of segmented stream, under given key context, base nonce & segment
+  // length ( clamped to [1, SEGMENT_MAX_LEN] ), emitting bytes to `sink`, while
+  // sealing at most `depth` -many segments concurrently on `pool` ( or inline,
+  // if no pool is given ); `depth = 0` picks twice the pool size
+  //
+  // Note, key context & thread pool must outlive the writer & base nonce must
+  // never be reused under same key.
+  segment_writer_t(const key_ctx_t<slen, rounds>& ctx_,
+                   const uint8_t* const nonce,
+                   const uint32_t seg_len_,
+                   segment_sink_t sink_,
+                   thread_pool_t* const pool_ = nullptr,
+                   const size_t depth_ = 0)
+    : ctx(ctx_)
+    , seg_len(std::clamp(seg_len_, 1u, SEGMENT_MAX_LEN))
+    , sink(std::move(sink_))
+    , pool(pool_)
+    , depth(depth_ != 0 ? depth_ : (pool_ != nullptr ? pool_->size() * 2 : 1))
+  {
+    segment_header_t h;
+    h.sbytes = slen >> 3;
+    h.tbytes = tbytes;
+    h.seg_len = seg_len;
+    std::memcpy(h.nonce, nonce, 12);
+    h.encode(hdr);
+
+    cur.reserve(seg_len);
+  }
+
+  segment_writer_t(const segment_writer_t&) = delete;
+  segment_writer_t& operator=(const segment_writer_t&) = delete;
+
+  ~segment_writer_t()
+  {
+    while (!jobs.empty()) {
+      jobs.front().done.wait();
+      secure_zero(jobs.front().txt.data(), jobs.front().txt.size());
+      jobs.pop_front();
+    }
+    secure_zero(cur.data(), cur.size());
+  }
+
+  // Appends M -bytes plain text to stream, returning false, if sink failed
+  bool write(const uint8_t* const txt, const size_t len)
+  {
+    if (!hdr_written) {
+      hdr_written = true;
+      emit(hdr, sizeof(hdr));
+    }
+
+    size_t off = 0;
+    while (!failed && !finished && (off < len)) {
+      if (cur.size() == seg_len) {
+        if (!dispatch(false)) {
+          break;
+        }
+      }
+
+      const size_t take = std::min(seg_len - cur.size(), len - off);
+      cur.insert(cur.end(), txt + off, txt + off + take);
+      off += take;
+    }
+
+    return !failed && !finished;
+  }
+
+  // Seals last segment ( marking it final ) & flushes everything to sink,
+  // returning false, if sink failed | must be called exactly once
+  bool finish()
+  {
+    if (finished) {
+      return false;
+    }
+    if (!hdr_written) {
+      hdr_written = true;
+      emit(hdr, sizeof(hdr));
+    }
+
+    dispatch(true);
+    finished = true;
+
+    while (!jobs.empty()) {
+      drain_one();
+    }
+
+    return !failed;
+  }
+};
+
+// Reader of segmented stream, stored in some positional ( random access )
+// source of known length, which can either decrypt any single segment, or
+// stream whole plain text to sink, decrypting at most `depth` -many segments
+// concurrently on thread pool ( when given )
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class segment_reader_t
+{
+private:
+  static constexpr size_t tbytes = tlen >> 3;
+
+  const key_ctx_t<slen, rounds>& ctx;
+  segment_source_t src;
+
+  uint8_t hdr[SEGMENT_HEADER_LEN]{};
+  segment_header_t h;
+  uint64_t seg_cnt = 0;
+  uint64_t last_len = 0; // plain text length of last segment
+  bool ok = false;
+
+public:
+  // Parses header of `total` -bytes long segmented stream, which is read using
+  // `src`; check `valid()` before using the reader
+  //
+  // Streams declaring segment length > `max_seg_len` are rejected, so that a
+  // forged header can't make reader allocate arbitrarily large buffers.
+  //
+  // Note, key context must outlive the reader.
+  segment_reader_t(const key_ctx_t<slen, rounds>& ctx_,
+                   segment_source_t src_,
+                   const uint64_t total,
+                   const uint32_t max_seg_len = SEGMENT_MAX_LEN)
+    : ctx(ctx_)
+    , src(std::move(src_))
+  {
+    if (total < SEGMENT_HEADER_LEN + tbytes) {
+      return;
+    }
+    if (src(0, hdr, sizeof(hdr)) != sizeof(hdr)) {
+      return;
+    }
+    if (!h.decode(hdr, max_seg_len)) {
+      return;
+    }
+    if ((h.sbytes != (slen >> 3)) || (h.tbytes != tbytes)) {
+      return;
+    }
+
+    const uint64_t body = total - SEGMENT_HEADER_LEN;
+    const uint64_t stride = static_cast<uint64_t>(h.seg_len) + tbytes;
+
+    seg_cnt = (body + stride - 1) / stride;
+    last_len = body - (seg_cnt - 1) * stride;
+
+    if (last_len < tbytes) {
+      return;
+    }
+
+    last_len -= tbytes;
+    ok = true;
+  }
+
+  // Whether stream header is well-formed & matches this AEAD scheme
+  bool valid() const { return ok; }
+
+  // # -of plain text bytes per segment
+  uint32_t segment_len() const { return h.seg_len; }
+
+  // # -of segments in stream
+  uint64_t segment_count() const { return seg_cnt; }
+
+  // Total # -of plain text bytes in stream
+  uint64_t plain_len() const
+  {
+    return ok ? (seg_cnt - 1) * h.seg_len + last_len : 0;
+  }
+
+  // Plain text length of i-th segment | i < segment_count()
+  size_t segment_plain_len(const uint64_t idx) const
+  {
+    return (idx + 1 == seg_cnt) ? last_len : h.seg_len;
+  }
+
+  // Reads, verifies & decrypts i-th segment into `segment_plain_len(i)` -bytes
+  // plain text, returning false, if it's missing or fails verification
+  //
+  // `buf` is scratch space of at least `segment_len() + (tlen >> 3)` -bytes.
+  bool read_segment(const uint64_t idx,
+                    uint8_t* const __restrict buf,
+                    uint8_t* const __restrict txt) const
+  {
+    if (!ok || (idx >= seg_cnt)) {
+      return false;
+    }
+
+    const size_t len = segment_plain_len(idx);
+    const uint64_t off = segment_offset<tlen>(h.seg_len, idx);
+
+    if (src(off, buf, len + tbytes) != len + tbytes) {
+      return false;
+    }
+
+    const bool final = (idx + 1) == seg_cnt;
+    return open_segment<slen, rounds, tlen>(
+      ctx, hdr, idx, final, buf, len, txt);
+  }
+
+  // Decrypts whole stream, emitting plain text to sink, in order; stops at
+  // first segment failing verification ( or sink failure ) & returns false
+  //
+  // At most `depth` -many segments are read & decrypted at a time ( on `pool`,
+  // when given ), bounding memory usage; `depth = 0` picks twice the pool size.
+  //
+  // Note, plain text of segments preceding a failing one is already emitted,
+  // so whole stream must be considered authentic only when this returns true.
+  // Also note, source is read from worker threads, when pool is given, so it
+  // must be safe to call concurrently ( say, `pread` on a file descriptor ).
+  bool read_all(const segment_sink_t& sink,
+                thread_pool_t* const pool = nullptr,
+                const size_t depth = 0) const
+  {
+    if (!ok) {
+      return false;
+    }
+
+    const size_t batch =
+      depth != 0 ? depth : (pool != nullptr ? pool->size() * 2 : 1);
+    const size_t stride = static_cast<size_t>(h.seg_len) + tbytes;
+
+    std::vector<uint8_t> bufs(batch * stride);
+    std::vector<uint8_t> txts(batch * h.seg_len);
+    std::vector<uint8_t> flgs(batch);
+    std::vector<std::future<void>> futs;
+    futs.reserve(batch);
+
+    bool res = true;
+
+    for (uint64_t beg = 0; res && (beg < seg_cnt); beg += batch) {
+      const size_t n = std::min<uint64_t>(batch, seg_cnt - beg);
+
+      futs.clear();
+      for (size_t j = 0; j < n; j++) {
+        auto task = [this, &bufs, &txts, &flgs, stride, beg, j]() {
+          flgs[j] = read_segment(
+            beg + j, bufs.data() + j * stride, txts.data() + j * h.seg_len);
+        };
+
+        if (pool != nullptr) {
+          futs.emplace_back(pool->submit(std::move(task)));
+        } else {
+          task();
+        }
+      }
+
+      for (auto& f : futs) {
+        f.wait();
+      }
+
+      for (size_t j = 0; res && (j < n); j++) {
+        res = flgs[j] && sink(txts.data() + j * h.seg_len,
+                              segment_plain_len(beg + j));
+      }
+    }
+
+    secure_zero(txts.data(), txts.size());
+    return res;
+  }
+};
+
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "mac.hpp"
+#include <algorithm>
+
+// Splitting {en, de}cryption of a single message into independent block
+// ranges, so that parts of one large message can be processed concurrently
+namespace elephant {
+
+// Work units of a message, with N -bytes associated data & M -bytes text
+//
+// Blocks of associated data ( but very first one, which holds nonce & is
+// never permuted ) count as one unit each, while text blocks, costing two
+// permutation calls ( keystream & tag ), count as two units each. Given masks
+// computed using jump-ahead, any contiguous range of units can be processed
+// independently of others, producing a partial tag accumulator.
+template<const size_t slen>
+struct split_plan_t
+{
+  static constexpr size_t sbytes = slen >> 3;
+
+  size_t ad_blks = 0;
+  size_t ct_blks = 0;
+
+  split_plan_t() = default;
+  split_plan_t(const size_t dlen, const size_t ctlen)
+    : ad_blks((12 + dlen + 1 + sbytes - 1) / sbytes - 1)
+    , ct_blks((ctlen + 1 + sbytes - 1) / sbytes)
+  {
+  }
+
+  // Total # -of work units
+  inline size_t units() const { return ad_blks + 2 * ct_blks; }
+
+  // First work unit of part `p`, when split into `nparts` -many roughly equal
+  // parts | p <= nparts
+  inline size_t bound(const size_t p, const size_t nparts) const
+  {
+    return (units() * p) / nparts;
+  }
+};
+
+// Processes work units [u0, u1) of a message ( see `split_plan_t` ), writing
+// respective bytes of output text & overwriting `acc` with partial tag
+// accumulator of those units
+//
+// XOR of partial accumulators of all parts, along with very first associated
+// data block, is same as tag accumulator of whole message.
+template<const size_t slen, const size_t rounds, const bool decrypting>
+static void
+process_units(const uint8_t* const __restrict ekey,  // expanded masking key
+              const uint8_t* const __restrict nonce, // 96 -bit nonce
+              const uint8_t* const __restrict data,  // N -bytes assoc. data
+              const size_t dlen,                     // len(data) = N | >= 0
+              const uint8_t* const in,               // M -bytes input text
+              uint8_t* const out,                    // M -bytes output text
+              const size_t ctlen,                    // len(in) = M | >= 0
+              const split_plan_t<slen>& plan,        // work units of message
+              const size_t u0,                       // first unit
+              const size_t u1,                       // one past last unit
+              uint8_t* const __restrict acc          // partial accumulator
+              ) requires(spongent::check_state_bit_len(slen))
+{
+  constexpr size_t sbytes = slen >> 3;
+  std::memset(acc, 0, sbytes);
+
+  const size_t ad_blks = plan.ad_blks;
+  const size_t a0 = std::min(u0, ad_blks);
+  const size_t a1 = std::min(u1, ad_blks);
+
+  if (a1 > a0) {
+    absorb_data_at<slen, rounds>(ekey, data, dlen, 1 + a0, a1 - a0, acc);
+  }
+
+  const size_t c0 = (std::max(u0, ad_blks) - ad_blks + 1) >> 1;
+  const size_t c1 = (std::max(u1, ad_blks) - ad_blks + 1) >> 1;
+
+  if (c1 > c0) {
+    const size_t off = std::min(c0 * sbytes, ctlen);
+    const size_t len = std::min(c1 * sbytes, ctlen) - off;
+
+    if constexpr (decrypting) {
+      absorb_cipher_at<slen, rounds>(ekey, in, ctlen, c0, c1 - c0, acc);
+      xor_keystream_at<slen, rounds>(
+        ekey, nonce, off, in + off, out + off, len);
+    } else {
+      xor_keystream_at<slen, rounds>(
+        ekey, nonce, off, in + off, out + off, len);
+      absorb_cipher_at<slen, rounds>(ekey, out, ctlen, c0, c1 - c0, acc);
+    }
+  }
+}
+
+// Merges `nparts` -many partial tag accumulators ( stored back to back ) of a
+// message, with its very first associated data block & finalizes tag into
+// `otag`, when encrypting, or verifies it against `itag`, when decrypting, in
+// which case output text is zeroed, if verification fails
+//
+// Returns boolean verification flag, which is always truth value when
+// encrypting.
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const bool decrypting>
+static bool
+finish_units(const uint8_t* const __restrict ekey,  // expanded masking key
+             const uint8_t* const __restrict nonce, // 96 -bit nonce
+             const uint8_t* const __restrict data,  // N -bytes assoc. data
+             const size_t dlen,                     // len(data) = N | >= 0
+             uint8_t* const __restrict out,         // M -bytes output text
+             const size_t ctlen,                    // len(out) = M | >= 0
+             const uint8_t* const __restrict accs,  // partial accumulators
+             const size_t nparts,                   // # -of parts | >= 0
+             const uint8_t* const __restrict itag,  // tag, when decrypting
+             uint8_t* const __restrict otag         // tag, when encrypting
+             ) requires(spongent::check_state_bit_len(slen) &&
+                        check_tag_bit_len(tlen))
+{
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t acc[sbytes];
+  get_ith_data_block<slen>(data, dlen, nonce, 0, acc);
+
+  for (size_t p = 0; p < nparts; p++) {
+    for (size_t i = 0; i < sbytes; i++) {
+      acc[i] ^= accs[p * sbytes + i];
+    }
+  }
+
+  if constexpr (decrypting) {
+    uint8_t tag_[tlen >> 3];
+    finalize_tag<slen, rounds, tlen>(ekey, acc, tag_);
+
+    const bool flag = verify_tag<tlen>(itag, tag_);
+    if (!flag && (ctlen > 0)) {
+      std::memset(out, 0, ctlen);
+    }
+    return flag;
+  } else {
+    finalize_tag<slen, rounds, tlen>(ekey, acc, otag);
+    return true;
+  }
+}
+
+}
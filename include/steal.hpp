@@ -0,0 +1,995 @@
+#pragma once
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "multi.hpp"
+#include "split.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Work-stealing executor of large batch jobs ( say, re-encrypting a table
+// with hundreds of millions of records ), whose records vary wildly in size,
+// using Elephant Authenticated Encryption with Associated Data
+namespace elephant {
+
+// Single record of work-stealing batch job, {en, de}crypted under its own key
+//
+// Key is identified by `key_id`, which workers use for grouping records &
+// indexing their cache of expanded key contexts, so records of a job with same
+// identifier must carry same key; cached contexts are only reused when key
+// bytes match too, so stale identifiers from earlier jobs are harmless. When
+// encrypting, `in` is plain text, `out` receives cipher text & `tag` receives
+// authentication tag, while when decrypting, `in` is cipher text, `out`
+// receives plain text ( zeroed, if verification fails ), `tag` holds expected
+// authentication tag & `ok` receives verification flag. Input & output text
+// must not overlap.
+struct ws_record_t
+{
+  uint64_t key_id = 0;            // identifier of secret key
+  const uint8_t* key = nullptr;   // 128 -bit secret key
+  const uint8_t* nonce = nullptr; // 96 -bit nonce
+  const uint8_t* data = nullptr;  // N -bytes associated data
+  size_t dlen = 0;                // len(data) = N | >= 0
+  const uint8_t* in = nullptr;    // M -bytes input text
+  uint8_t* out = nullptr;         // M -bytes output text
+  size_t len = 0;                 // len(in) = len(out) = M | >= 0
+  uint8_t* tag = nullptr;         // authentication tag
+  bool ok = false;                // verification flag, when decrypting
+};
+
+// Knobs of `ws_executor_t`
+//
+// - small_len : records with at most these many bytes ( associated data &
+// text, together ) are grouped, at most `group` -many under same key, into
+// tasks running through multi-state permutation lanes
+// - part_len : records with more than twice these many bytes are split into
+// block range subtasks of roughly these many bytes, rest are single tasks
+// - cache_slots : # -of expanded key contexts each worker caches ( at least 1 )
+// - pin : whether workers are pinned to cores ( only on Linux )
+struct ws_opts_t
+{
+  size_t small_len = 1ul << 10;
+  size_t group = 4 * LANES;
+  size_t part_len = 1ul << 16;
+  size_t cache_slots = 64;
+  bool pin = true;
+};
+
+// Counters of `ws_executor_t`, accumulated over all jobs
+struct ws_stats_t
+{
+  uint64_t tasks = 0;        // # -of tasks executed
+  uint64_t steals = 0;       // # -of tasks stolen from other workers
+  uint64_t parts = 0;        // # -of block range subtasks executed
+  uint64_t cache_hits = 0;   // # -of key context lookups served from cache
+  uint64_t cache_misses = 0; // # -of key expansions
+  mb_stats_t lanes;          // occupancy of multi-state permutation lanes
+};
+
+// Work-stealing deque of task indices ( Chase-Lev deque, without growth ),
+// filled before a job starts & only shrinking while it runs; owner takes
+// tasks from bottom, while thieves steal from top
+class ws_deque_t
+{
+private:
+  alignas(64) std::atomic<int64_t> top{ 0 };
+  alignas(64) std::atomic<int64_t> bottom{ 0 };
+  std::vector<uint32_t> buf;
+
+public:
+  // Refills deque, must not race with `take` or `steal`
+  void reset(std::vector<uint32_t>& tasks)
+  {
+    buf.swap(tasks);
+    top.store(0, std::memory_order_relaxed);
+    bottom.store(static_cast<int64_t>(buf.size()), std::memory_order_relaxed);
+  }
+
+  // Takes most recently added task, only called by owner
+  bool take(uint32_t& task)
+  {
+    const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    int64_t t = top.load(std::memory_order_relaxed);
+    if (t > b) {
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+
+    task = buf[b];
+    if (t < b) {
+      return true;
+    }
+
+    // last task, race against thieves
+    const bool won = top.compare_exchange_strong(
+      t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // Steals least recently added task, called by any other worker
+  bool steal(uint32_t& task)
+  {
+    int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t b = bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+      return false;
+    }
+
+    const uint32_t v = buf[t];
+    if (!top.compare_exchange_strong(
+          t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return false;
+    }
+
+    task = v;
+    return true;
+  }
+};
+
+// Work-stealing executor of Elephant batch jobs, with one ( optionally pinned
+// ) worker per core
+//
+// A job is planned into tasks of roughly comparable cost
+//
+// - small records, under same key, are grouped & run through multi-state
+// permutation lanes, see `encrypt_multi`
+// - large records are split into block ranges, see `split_plan_t`, using
+// jump-ahead masks; subtask finishing last XOR-merges partial tag
+// accumulators & finalizes ( or verifies ) tag
+// - rest are {en, de}crypted as single tasks
+//
+// which are dealt round-robin to per worker deques, block range subtasks
+// first, so that they end up on top. Workers drain their own deque from
+// bottom & once empty, steal from top of others' deques, so that few huge
+// records don't leave cores idle. Once no task is left to take, workers go
+// back to sleeping on a condition variable, instead of waiting for the rest.
+// Each worker keeps its own direct-mapped cache of expanded key contexts ( &
+// mask tables ), so key lookups never contend. Jobs submitted from many
+// threads run one after another.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+class ws_executor_t
+{
+private:
+  static constexpr size_t sbytes = slen >> 3;
+
+  using ctx_t = key_ctx_t<slen, rounds>;
+  using tab_t = mb_table_t<slen, rounds>;
+
+  // Kind of task
+  enum class kind_t : uint8_t
+  {
+    group,  // `cnt` -many small records, starting at `order[idx]`
+    single, // record `idx`
+    part    // `cnt` -th block range of split record `idx`
+  };
+
+  struct task_t
+  {
+    kind_t kind;
+    uint32_t idx;
+    uint32_t cnt;
+  };
+
+  // Large record, split into `nparts` -many block ranges
+  struct split_t
+  {
+    uint32_t rec = 0;
+    uint32_t nparts = 0;
+    size_t acc_off = 0; // offset of partial accumulators in `accs`
+    split_plan_t<slen> plan;
+    std::atomic<uint32_t> pending{ 0 };
+  };
+
+  // Cached key context, with its lazily built mask table
+  struct slot_t
+  {
+    uint64_t id = 0;
+    bool valid = false;
+    uint8_t key[16]{};
+    ctx_t ctx;
+    std::optional<tab_t> tab;
+
+    ~slot_t() { secure_zero(key, sizeof(key)); }
+  };
+
+  struct alignas(64) worker_t
+  {
+    ws_deque_t dq;
+    std::unique_ptr<slot_t[]> cache;
+    std::vector<mb_msg_t> msgs;
+    ws_stats_t stats;
+    uint64_t rng = 0;
+  };
+
+  const ws_opts_t opts;
+  const size_t nworkers;
+  const size_t nslots; // # -of cache slots per worker | >= 1
+
+  std::unique_ptr<worker_t[]> states;
+  std::vector<std::thread> workers;
+
+  // Job being run
+  ws_record_t* recs = nullptr;
+  bool decrypting = false;
+  std::vector<task_t> tasks;
+  std::vector<uint32_t> order;
+  std::vector<split_t> splits;
+  std::vector<uint8_t> accs;
+  std::atomic<size_t> unclaimed{ 0 }; // # -of tasks not yet taken by anyone
+  std::atomic<bool> all_ok{ true };
+
+  std::mutex job_mtx;
+  std::mutex mtx;
+  std::condition_variable cv_start;
+  std::condition_variable cv_done;
+  uint64_t generation = 0;
+  size_t finished = 0;
+  bool stopping = false;
+
+  // Pins calling worker to `i` -th core, it's allowed to run on
+  static void pin_to_core(const size_t i)
+  {
+#if defined(__linux__)
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) {
+      return;
+    }
+
+    const size_t ncpus = static_cast<size_t>(CPU_COUNT(&allowed));
+    if (ncpus == 0) {
+      return;
+    }
+
+    size_t k = i % ncpus;
+    for (size_t c = 0; c < CPU_SETSIZE; c++) {
+      if (CPU_ISSET(c, &allowed) && (k-- == 0)) {
+        cpu_set_t one;
+        CPU_ZERO(&one);
+        CPU_SET(c, &one);
+
+        // best effort, worker simply stays unpinned on failure
+        pthread_setaffinity_np(pthread_self(), sizeof(one), &one);
+        return;
+      }
+    }
+#else
+    (void)i;
+#endif
+  }
+
+  // Expanded key context of record, from worker's cache, which only counts as
+  // hit when both identifier & key bytes match
+  slot_t& lookup(worker_t& w, const ws_record_t& r)
+  {
+    uint64_t h = r.key_id;
+    h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdul;
+    h ^= h >> 33;
+
+    slot_t& s = w.cache[h % nslots];
+    if (s.valid && (s.id == r.key_id) &&
+        (std::memcmp(s.key, r.key, sizeof(s.key)) == 0)) {
+      w.stats.cache_hits++;
+      return s;
+    }
+
+    w.stats.cache_misses++;
+
+    s.tab.reset();
+    s.ctx.init(r.key);
+    std::memcpy(s.key, r.key, sizeof(s.key));
+    s.id = r.key_id;
+    s.valid = true;
+    return s;
+  }
+
+  void run_group(worker_t& w, const task_t& t)
+  {
+    const ws_record_t& first = recs[order[t.idx]];
+    slot_t& s = lookup(w, first);
+    if (!s.tab) {
+      s.tab.emplace(s.ctx);
+    }
+
+    w.msgs.resize(t.cnt);
+    for (size_t i = 0; i < t.cnt; i++) {
+      const ws_record_t& r = recs[order[t.idx + i]];
+      w.msgs[i] = mb_msg_t{
+        r.nonce, r.data, r.dlen, r.in, r.out, r.len, r.tag, false
+      };
+    }
+
+    if (decrypting) {
+      decrypt_multi<slen, rounds, tlen>(
+        *s.tab, w.msgs.data(), t.cnt, w.stats.lanes);
+
+      for (size_t i = 0; i < t.cnt; i++) {
+        recs[order[t.idx + i]].ok = w.msgs[i].ok;
+        if (!w.msgs[i].ok) {
+          all_ok.store(false, std::memory_order_relaxed);
+        }
+      }
+    } else {
+      encrypt_multi<slen, rounds, tlen>(
+        *s.tab, w.msgs.data(), t.cnt, w.stats.lanes);
+    }
+  }
+
+  void run_single(worker_t& w, const task_t& t)
+  {
+    ws_record_t& r = recs[t.idx];
+    const slot_t& s = lookup(w, r);
+
+    if (decrypting) {
+      r.ok = elephant::decrypt<slen, rounds, tlen>(
+        s.ctx, r.nonce, r.tag, r.data, r.dlen, r.in, r.out, r.len);
+      if (!r.ok) {
+        all_ok.store(false, std::memory_order_relaxed);
+      }
+    } else {
+      elephant::encrypt<slen, rounds, tlen>(
+        s.ctx, r.nonce, r.data, r.dlen, r.in, r.out, r.len, r.tag);
+    }
+  }
+
+  template<const bool dec>
+  void run_part(worker_t& w, split_t& sp, const size_t p)
+  {
+    ws_record_t& r = recs[sp.rec];
+    const slot_t& s = lookup(w, r);
+    uint8_t* const pacc = accs.data() + sp.acc_off;
+
+    process_units<slen, rounds, dec>(s.ctx.ekey,
+                                     r.nonce,
+                                     r.data,
+                                     r.dlen,
+                                     r.in,
+                                     r.out,
+                                     r.len,
+                                     sp.plan,
+                                     sp.plan.bound(p, sp.nparts),
+                                     sp.plan.bound(p + 1, sp.nparts),
+                                     pacc + p * sbytes);
+
+    if (sp.pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+      return;
+    }
+
+    const uint8_t* const itag = dec ? r.tag : nullptr;
+    uint8_t* const otag = dec ? nullptr : r.tag;
+
+    const bool flag = finish_units<slen, rounds, tlen, dec>(
+      s.ctx.ekey,
+      r.nonce,
+      r.data,
+      r.dlen,
+      r.out,
+      r.len,
+      pacc,
+      sp.nparts,
+      itag,
+      otag);
+    if constexpr (dec) {
+      r.ok = flag;
+      if (!flag) {
+        all_ok.store(false, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void execute(worker_t& w, const uint32_t ti)
+  {
+    const task_t& t = tasks[ti];
+    w.stats.tasks++;
+
+    switch (t.kind) {
+      case kind_t::group:
+        run_group(w, t);
+        break;
+      case kind_t::single:
+        run_single(w, t);
+        break;
+      case kind_t::part:
+        w.stats.parts++;
+        if (decrypting) {
+          run_part<true>(w, splits[t.idx], t.cnt);
+        } else {
+          run_part<false>(w, splits[t.idx], t.cnt);
+        }
+        break;
+    }
+  }
+
+  // Tries stealing a task from other workers, starting at a random victim
+  bool steal_any(worker_t& w, const size_t self, uint32_t& ti)
+  {
+    w.rng ^= w.rng << 13;
+    w.rng ^= w.rng >> 7;
+    w.rng ^= w.rng << 17;
+
+    const size_t start = w.rng % nworkers;
+    for (size_t k = 0; k < nworkers; k++) {
+      const size_t v = (start + k) % nworkers;
+      if ((v != self) && states[v].dq.steal(ti)) {
+        w.stats.steals++;
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Drains own deque & steals from others, until every task of job is taken
+  // by some worker; job is done once all workers return from here, so idle
+  // ones go back to sleep, instead of waiting on those still running a task
+  void work(const size_t self)
+  {
+    worker_t& w = states[self];
+    uint32_t ti = 0;
+
+    while (unclaimed.load(std::memory_order_acquire) > 0) {
+      if (w.dq.take(ti) || steal_any(w, self, ti)) {
+        unclaimed.fetch_sub(1, std::memory_order_acq_rel);
+        execute(w, ti);
+      } else {
+        // some task is still counted, while another worker is taking it
+        std::this_thread::yield();
+      }
+    }
+  }
+
+  void worker_loop(const size_t self)
+  {
+    if (opts.pin) {
+      pin_to_core(self);
+    }
+
+    uint64_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv_start.wait(lock, [&]() { return stopping || generation != seen; });
+        if (stopping) {
+          return;
+        }
+        seen = generation;
+      }
+
+      work(self);
+
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        if (++finished == nworkers) {
+          cv_done.notify_one();
+        }
+      }
+    }
+  }
+
+  // Splits job into tasks & deals them to workers
+  void plan(const size_t cnt)
+  {
+    tasks.clear();
+    order.clear();
+    splits.clear();
+
+    const size_t part_len = std::max<size_t>(opts.part_len, 1);
+    const size_t group = std::max<size_t>(opts.group, 1);
+
+    auto kind_of = [&](const size_t i) {
+      const size_t bytes = recs[i].dlen + recs[i].len;
+      if (bytes <= opts.small_len) {
+        return kind_t::group;
+      }
+      return bytes > 2 * part_len ? kind_t::part : kind_t::single;
+    };
+
+    size_t nsplits = 0;
+    for (size_t i = 0; i < cnt; i++) {
+      const kind_t k = kind_of(i);
+      if (k == kind_t::group) {
+        order.push_back(static_cast<uint32_t>(i));
+      } else if (k == kind_t::part) {
+        nsplits++;
+      }
+    }
+
+    splits = std::vector<split_t>(nsplits);
+    size_t nacc = 0;
+    size_t s = 0;
+
+    for (size_t i = 0; i < cnt; i++) {
+      if (kind_of(i) != kind_t::part) {
+        continue;
+      }
+
+      const size_t bytes = recs[i].dlen + recs[i].len;
+
+      split_t& sp = splits[s];
+      sp.rec = static_cast<uint32_t>(i);
+      sp.plan = split_plan_t<slen>(recs[i].dlen, recs[i].len);
+      sp.nparts = static_cast<uint32_t>(
+        std::min((bytes + part_len - 1) / part_len, sp.plan.units()));
+      sp.acc_off = nacc;
+      sp.pending.store(sp.nparts, std::memory_order_relaxed);
+
+      for (uint32_t p = 0; p < sp.nparts; p++) {
+        tasks.push_back(task_t{ kind_t::part, static_cast<uint32_t>(s), p });
+      }
+
+      nacc += sp.nparts * sbytes;
+      s++;
+    }
+    accs.assign(nacc, 0);
+
+    for (size_t i = 0; i < cnt; i++) {
+      if (kind_of(i) == kind_t::single) {
+        tasks.push_back(task_t{ kind_t::single, static_cast<uint32_t>(i), 0 });
+      }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+      return recs[a].key_id < recs[b].key_id;
+    });
+
+    for (size_t i = 0; i < order.size();) {
+      const uint64_t id = recs[order[i]].key_id;
+
+      size_t n = 1;
+      while ((i + n < order.size()) && (n < group) &&
+             (recs[order[i + n]].key_id == id)) {
+        n++;
+      }
+
+      tasks.push_back(task_t{ kind_t::group,
+                              static_cast<uint32_t>(i),
+                              static_cast<uint32_t>(n) });
+      i += n;
+    }
+
+    std::vector<std::vector<uint32_t>> dealt(nworkers);
+    for (size_t t = 0; t < tasks.size(); t++) {
+      dealt[t % nworkers].push_back(static_cast<uint32_t>(t));
+    }
+    for (size_t i = 0; i < nworkers; i++) {
+      states[i].dq.reset(dealt[i]);
+    }
+  }
+
+  bool run(ws_record_t* const recs_, const size_t cnt, const bool dec)
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx);
+
+    recs = recs_;
+    decrypting = dec;
+    all_ok.store(true, std::memory_order_relaxed);
+
+    plan(cnt);
+    if (tasks.empty()) {
+      return true;
+    }
+
+    unclaimed.store(tasks.size(), std::memory_order_relaxed);
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      finished = 0;
+      generation++;
+    }
+    cv_start.notify_all();
+
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv_done.wait(lock, [&]() { return finished == nworkers; });
+    }
+
+    secure_zero(accs.data(), accs.size());
+    return all_ok.load(std::memory_order_relaxed);
+  }
+
+public:
+  // Executor with `n` -many workers | n > 0
+  explicit ws_executor_t(
+    const size_t n = std::max(std::thread::hardware_concurrency(), 1u),
+    const ws_opts_t opts_ = {})
+    : opts(opts_)
+    , nworkers(std::max<size_t>(n, 1))
+    , nslots(std::max<size_t>(opts.cache_slots, 1))
+    , states(new worker_t[nworkers])
+  {
+    for (size_t i = 0; i < nworkers; i++) {
+      states[i].cache.reset(new slot_t[nslots]);
+      states[i].rng = 0x9e3779b97f4a7c15ul * (i + 1);
+    }
+
+    workers.reserve(nworkers);
+    for (size_t i = 0; i < nworkers; i++) {
+      workers.emplace_back([this, i]() { worker_loop(i); });
+    }
+  }
+
+  ws_executor_t(const ws_executor_t&) = delete;
+  ws_executor_t& operator=(const ws_executor_t&) = delete;
+
+  ~ws_executor_t()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cv_start.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of workers
+  size_t size() const { return nworkers; }
+
+  // Encrypts `cnt` -many records, returning once all of them are done, with
+  // same cipher texts & tags as `elephant::encrypt` | cnt >= 0
+  void encrypt(ws_record_t* const recs_, const size_t cnt)
+  {
+    run(recs_, cnt, false);
+  }
+
+  // Verifies & decrypts `cnt` -many records, returning true only when every
+  // record verifies; each record's own verification flag is written to its
+  // `ok` field | cnt >= 0
+  bool decrypt(ws_record_t* const recs_, const size_t cnt)
+  {
+    return run(recs_, cnt, true);
+  }
+
+  // Counters, accumulated over all jobs so far
+  ws_stats_t stats()
+  {
+    std::lock_guard<std::mutex> job_lock(job_mtx);
+
+    ws_stats_t s;
+    for (size_t i = 0; i < nworkers; i++) {
+      const ws_stats_t& w = states[i].stats;
+
+      s.tasks += w.tasks;
+      s.steals += w.steals;
+      s.parts += w.parts;
+      s.cache_hits += w.cache_hits;
+      s.cache_misses += w.cache_misses;
+      s.lanes.calls += w.lanes.calls;
+      s.lanes.used += w.lanes.used;
+    }
+    return s;
+  }
+};
+
+// Process wide work-stealing executor of given Elephant variant, used by
+// `{en, de}crypt_batch`, with one ( unpinned, as it lives inside host
+// application ) worker per hardware thread; records run on it must get their
+// key identifiers from `assign_key_ids`
+template<const size_t slen, const size_t rounds, const size_t tlen>
+inline ws_executor_t<slen, rounds, tlen>&
+default_ws_executor()
+{
+  static ws_executor_t<slen, rounds, tlen> ex{
+    std::max(std::thread::hardware_concurrency(), 1u), ws_opts_t{ .pin = false }
+  };
+  return ex;
+}
+
+// Assigns key identifiers to `cnt` -many records, such that records carrying
+// same 128 -bit secret key ( compared byte-wise ) get same identifier, so that
+// each key is expanded once per worker & its records share permutation lanes
+//
+// Identifiers are drawn from a process wide counter, so they never repeat
+// across calls, as workers keep caching key contexts from one job to next.
+static void
+assign_key_ids(ws_record_t* const recs, const size_t cnt)
+{
+  static std::atomic<uint64_t> next_id{ 0 };
+
+  std::unordered_map<std::string_view, uint64_t> ids;
+  ids.reserve(std::min<size_t>(cnt, 1024));
+
+  const uint8_t* prev = nullptr;
+  uint64_t prev_id = 0;
+
+  for (size_t i = 0; i < cnt; i++) {
+    // fast path, for batches sharing one key buffer
+    if (recs[i].key == prev) {
+      recs[i].key_id = prev_id;
+      continue;
+    }
+
+    const std::string_view k(reinterpret_cast<const char*>(recs[i].key), 16);
+    const auto it = ids.try_emplace(k, ids.size()).first;
+
+    recs[i].key_id = it->second;
+    prev = recs[i].key;
+    prev_id = it->second;
+  }
+
+  const uint64_t base =
+    next_id.fetch_add(ids.size(), std::memory_order_relaxed);
+  for (size_t i = 0; i < cnt; i++) {
+    recs[i].key_id += base;
+  }
+}
+
+// Encrypts `cnt` -many equal length records, stored back to back ( i-th
+// record's key at keys + 16 * i, nonce at nonces + 12 * i, associated data at
+// data + N * i, text at txt + M * i & tag at tags + (tlen >> 3) * i ), each
+// under its own key, on process wide work-stealing executor | M, N, cnt >= 0
+//
+// Produces same cipher texts & tags as calling `elephant::encrypt` on each
+// record.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+encrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict txt,    // M -bytes plain texts
+              uint8_t* const __restrict enc,          // M -bytes cipher texts
+              const size_t ctlen,                     // per record M | >= 0
+              uint8_t* const __restrict tags,         // `tlen` -bit tags
+              const size_t cnt                        // # -of records | >= 0
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<ws_record_t> recs(cnt);
+  for (size_t i = 0; i < cnt; i++) {
+    recs[i].key = keys + i * 16;
+    recs[i].nonce = nonces + i * 12;
+    recs[i].data = data + i * dlen;
+    recs[i].dlen = dlen;
+    recs[i].in = txt + i * ctlen;
+    recs[i].out = enc + i * ctlen;
+    recs[i].len = ctlen;
+    recs[i].tag = tags + i * tbytes;
+  }
+
+  assign_key_ids(recs.data(), cnt);
+
+  auto& ex = default_ws_executor<slen, rounds, tlen>();
+  ex.encrypt(recs.data(), cnt);
+}
+
+// Verifies & decrypts `cnt` -many equal length records, laid out just like
+// `encrypt_batch` does, writing each record's verification flag to `flags` &
+// returning true only when all of them verify | M, N, cnt >= 0
+//
+// Produces same plain texts ( zeroed, if verification fails ) as calling
+// `elephant::decrypt` on each record.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static bool
+decrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict tags,   // `tlen` -bit tags
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict enc,    // M -bytes cipher texts
+              uint8_t* const __restrict txt,          // M -bytes plain texts
+              const size_t ctlen,                     // per record M | >= 0
+              bool* const __restrict flags,           // verification flags
+              const size_t cnt                        // # -of records | >= 0
+              ) requires(spongent::check_state_bit_len(slen) &&
+                         check_tag_bit_len(tlen))
+{
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<ws_record_t> recs(cnt);
+  for (size_t i = 0; i < cnt; i++) {
+    recs[i].key = keys + i * 16;
+    recs[i].nonce = nonces + i * 12;
+    recs[i].data = data + i * dlen;
+    recs[i].dlen = dlen;
+    recs[i].in = enc + i * ctlen;
+    recs[i].out = txt + i * ctlen;
+    recs[i].len = ctlen;
+    recs[i].tag = const_cast<uint8_t*>(tags + i * tbytes);
+  }
+
+  assign_key_ids(recs.data(), cnt);
+
+  auto& ex = default_ws_executor<slen, rounds, tlen>();
+  const bool f = ex.decrypt(recs.data(), cnt);
+
+  for (size_t i = 0; i < cnt; i++) {
+    flags[i] = recs[i].ok;
+  }
+  return f;
+}
+
+}
+
+// Dumbo, Jumbo & Delirium flavours of work-stealing batch API, kept out of
+// variant headers, as executor pins worker threads of its own
+namespace dumbo {
+
+// Work-stealing executor of large batch jobs, {en, de}crypting records (
+// each under its own key ) using Dumbo AEAD, see `elephant::ws_executor_t`
+using ws_executor_t = elephant::ws_executor_t<SLEN, ROUNDS, TLEN>;
+
+// Encrypts `cnt` -many equal length records, stored back to back, each under
+// its own key, using Dumbo AEAD, on process wide work-stealing executor, see
+// `elephant::encrypt_batch`
+inline static void
+encrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict txt,    // M -bytes plain texts
+              uint8_t* const __restrict enc,          // M -bytes cipher texts
+              const size_t ctlen,                     // per record M | >= 0
+              uint8_t* const __restrict tags,         // 8 -bytes tags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt_batch<a, b, c>(
+    keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+}
+
+// Verifies & decrypts `cnt` -many equal length records, stored back to back,
+// each under its own key, using Dumbo AEAD, on process wide work-stealing
+// executor, returning true only when all of them verify, see
+// `elephant::decrypt_batch`
+inline static bool
+decrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict tags,   // 8 -bytes tags
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict enc,    // M -bytes cipher texts
+              uint8_t* const __restrict txt,          // M -bytes plain texts
+              const size_t ctlen,                     // per record M | >= 0
+              bool* const __restrict flags,           // verification flags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::decrypt_batch<a, b, c>(
+    keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+}
+
+}
+
+namespace jumbo {
+
+// Work-stealing executor of large batch jobs, {en, de}crypting records (
+// each under its own key ) using Jumbo AEAD, see `elephant::ws_executor_t`
+using ws_executor_t = elephant::ws_executor_t<SLEN, ROUNDS, TLEN>;
+
+// Encrypts `cnt` -many equal length records, stored back to back, each under
+// its own key, using Jumbo AEAD, on process wide work-stealing executor, see
+// `elephant::encrypt_batch`
+inline static void
+encrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict txt,    // M -bytes plain texts
+              uint8_t* const __restrict enc,          // M -bytes cipher texts
+              const size_t ctlen,                     // per record M | >= 0
+              uint8_t* const __restrict tags,         // 8 -bytes tags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt_batch<a, b, c>(
+    keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+}
+
+// Verifies & decrypts `cnt` -many equal length records, stored back to back,
+// each under its own key, using Jumbo AEAD, on process wide work-stealing
+// executor, returning true only when all of them verify, see
+// `elephant::decrypt_batch`
+inline static bool
+decrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict tags,   // 8 -bytes tags
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict enc,    // M -bytes cipher texts
+              uint8_t* const __restrict txt,          // M -bytes plain texts
+              const size_t ctlen,                     // per record M | >= 0
+              bool* const __restrict flags,           // verification flags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::decrypt_batch<a, b, c>(
+    keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+}
+
+}
+
+namespace delirium {
+
+// Work-stealing executor of large batch jobs, {en, de}crypting records (
+// each under its own key ) using Delirium AEAD, see `elephant::ws_executor_t`
+using ws_executor_t = elephant::ws_executor_t<SLEN, ROUNDS, TLEN>;
+
+// Encrypts `cnt` -many equal length records, stored back to back, each under
+// its own key, using Delirium AEAD, on process wide work-stealing executor, see
+// `elephant::encrypt_batch`
+inline static void
+encrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict txt,    // M -bytes plain texts
+              uint8_t* const __restrict enc,          // M -bytes cipher texts
+              const size_t ctlen,                     // per record M | >= 0
+              uint8_t* const __restrict tags,         // 16 -bytes tags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  elephant::encrypt_batch<a, b, c>(
+    keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+}
+
+// Verifies & decrypts `cnt` -many equal length records, stored back to back,
+// each under its own key, using Delirium AEAD, on process wide work-stealing
+// executor, returning true only when all of them verify, see
+// `elephant::decrypt_batch`
+inline static bool
+decrypt_batch(const uint8_t* const __restrict keys,   // 16 -bytes keys
+              const uint8_t* const __restrict nonces, // 12 -bytes nonces
+              const uint8_t* const __restrict tags,   // 16 -bytes tags
+              const uint8_t* const __restrict data,   // N -bytes assoc. data
+              const size_t dlen,                      // per record N | >= 0
+              const uint8_t* const __restrict enc,    // M -bytes cipher texts
+              uint8_t* const __restrict txt,          // M -bytes plain texts
+              const size_t ctlen,                     // per record M | >= 0
+              bool* const __restrict flags,           // verification flags
+              const size_t cnt                        // # -of records | >= 0
+)
+{
+  constexpr size_t a = SLEN;
+  constexpr size_t b = ROUNDS;
+  constexpr size_t c = TLEN;
+
+  return elephant::decrypt_batch<a, b, c>(
+    keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+}
+
+}
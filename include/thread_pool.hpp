@@ -0,0 +1,106 @@
+#pragma once
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Thread pool, used for processing independent Elephant messages ( or parts
+// of a message ) concurrently
+namespace elephant {
+
+// Fixed size pool of worker threads, executing submitted tasks in FIFO order
+class thread_pool_t
+{
+private:
+  std::vector<std::thread> workers;
+  std::deque<std::function<void()>> tasks;
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool stopping = false;
+
+  inline void run()
+  {
+    while (true) {
+      std::function<void()> task;
+
+      {
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [this]() { return stopping || !tasks.empty(); });
+
+        if (tasks.empty()) {
+          return;
+        }
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+
+      task();
+    }
+  }
+
+public:
+  // Spawns `n` -many worker threads | n > 0
+  explicit thread_pool_t(
+    const size_t n = std::max(std::thread::hardware_concurrency(), 1u))
+  {
+    workers.reserve(n);
+
+    for (size_t i = 0; i < n; i++) {
+      workers.emplace_back([this]() { run(); });
+    }
+  }
+
+  thread_pool_t(const thread_pool_t&) = delete;
+  thread_pool_t& operator=(const thread_pool_t&) = delete;
+
+  // Waits for all submitted tasks to finish & joins worker threads
+  ~thread_pool_t()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      stopping = true;
+    }
+    cv.notify_all();
+
+    for (auto& w : workers) {
+      w.join();
+    }
+  }
+
+  // # -of worker threads
+  size_t size() const { return workers.size(); }
+
+  // Enqueues a task, returning future which becomes ready once it's executed
+  template<typename F>
+  std::future<void> submit(F&& f)
+  {
+    using task_t = std::packaged_task<void()>;
+
+    auto task = std::make_shared<task_t>(std::forward<F>(f));
+    auto fut = task->get_future();
+
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      tasks.emplace_back([task]() { (*task)(); });
+    }
+    cv.notify_one();
+
+    return fut;
+  }
+};
+
+// Process wide worker pool, used by multi-threaded authentication passes ( say
+// `verify`, `mac` ), so that they don't spawn threads on every call
+inline thread_pool_t&
+default_thread_pool()
+{
+  static thread_pool_t pool;
+  return pool;
+}
+
+}
@@ -1,9 +1,13 @@
 #pragma once
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
 #include <iomanip>
 #include <random>
 #include <sstream>
+#include <string>
+#include <unistd.h>
 
 // Given a bytearray of length N, it converts that to human readable hex string
 // of length N << 1
@@ -32,3 +36,33 @@ random_data(uint8_t* const data, const size_t len)
     data[i] = dis(gen);
   }
 }
+
+// Creates anonymous ( already unlinked ) temporary file in $TMPDIR ( or /tmp ),
+// holding N -many random bytes, returning its file descriptor | N >= 0
+static inline int
+random_file(const size_t len)
+{
+  const char* dir = std::getenv("TMPDIR");
+  std::string path = std::string(dir != nullptr ? dir : "/tmp");
+  path += "/elephXXXXXX";
+
+  const int fd = mkstemp(path.data());
+  if (fd < 0) {
+    return fd;
+  }
+  unlink(path.c_str());
+
+  uint8_t buf[4096];
+  for (size_t off = 0; off < len; off += sizeof(buf)) {
+    const size_t n = std::min(sizeof(buf), len - off);
+
+    random_data(buf, n);
+    const ssize_t r = pwrite(fd, buf, n, static_cast<off_t>(off));
+    if (r != static_cast<ssize_t>(n)) {
+      close(fd);
+      return -1;
+    }
+  }
+
+  return fd;
+}
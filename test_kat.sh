@@ -4,6 +4,7 @@
 # Elephant ( i.e. Dumbo, Jumbo & Delirium ) implementation
 
 make lib
+make pyext
 
 # ---
 
@@ -0,0 +1,101 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that appending randomly sized chunks to a record, either keeping
+// append state around or resuming it from stored cipher text after every
+// chunk, produces same cipher text & authentication tag reference ( KAT
+// verified ) `encrypt` computes on whole record, which `decrypt` accepts
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_append()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::mt19937 gen(slen);
+
+  for (size_t trial = 0; trial < 32; trial++) {
+    const size_t dlen = gen() % 50;
+
+    std::vector<uint8_t> key(16), nonce(12), data(dlen);
+    std::vector<uint8_t> rec, enc, enc_;
+
+    random_data(key.data(), key.size());
+    random_data(nonce.data(), nonce.size());
+    random_data(data.data(), dlen);
+
+    const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+    append_state_t<slen> st;
+    append_init<slen, rounds>(ctx, nonce.data(), data.data(), dlen, st);
+
+    for (size_t step = 0; step < 8; step++) {
+      // chunks shorter than, equal to & longer than a block, including empty
+      const size_t len = gen() % (3 * (slen >> 3));
+
+      std::vector<uint8_t> txt(len), chunk(len), chunk_(len);
+      uint8_t tag[tbytes], tag_[tbytes], tag__[tbytes];
+
+      random_data(txt.data(), len);
+
+      append<slen, rounds, tlen>(
+        ctx, nonce.data(), st, txt.data(), chunk.data(), len, tag);
+
+      append_state_t<slen> st_;
+      append_resume<slen, rounds>(
+        ctx, nonce.data(), data.data(), dlen, enc.data(), enc.size(), st_);
+      append<slen, rounds, tlen>(
+        ctx, nonce.data(), st_, txt.data(), chunk_.data(), len, tag_);
+
+      rec.insert(rec.end(), txt.begin(), txt.end());
+      enc.insert(enc.end(), chunk.begin(), chunk.end());
+      enc_.insert(enc_.end(), chunk_.begin(), chunk_.end());
+
+      std::vector<uint8_t> ref(rec.size()), dec(rec.size());
+      encrypt<slen, rounds, tlen>(key.data(),
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  rec.data(),
+                                  ref.data(),
+                                  rec.size(),
+                                  tag__);
+
+      EXPECT_EQ(ref, enc);
+      EXPECT_EQ(ref, enc_);
+      EXPECT_EQ(std::memcmp(tag, tag__, tbytes), 0);
+      EXPECT_EQ(std::memcmp(tag_, tag__, tbytes), 0);
+
+      const bool flg = decrypt<slen, rounds, tlen>(key.data(),
+                                                   nonce.data(),
+                                                   tag,
+                                                   data.data(),
+                                                   dlen,
+                                                   enc.data(),
+                                                   dec.data(),
+                                                   enc.size());
+
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(rec, dec);
+    }
+  }
+}
+
+TEST(Append, DumboMatchesEncrypt)
+{
+  test_append<160, 80, 64>();
+}
+
+TEST(Append, JumboMatchesEncrypt)
+{
+  test_append<176, 90, 64>();
+}
+
+TEST(Append, DeliriumMatchesEncrypt)
+{
+  test_append<200, 18, 128>();
+}
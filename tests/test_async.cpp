@@ -0,0 +1,203 @@
+#include "async.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// Encrypts & then decrypts ( original & tampered cipher text ) message from
+// within a coroutine, using `co_await`, returning verification flags
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static elephant::task_t<std::pair<bool, bool>>
+seal_open(const elephant::key_ctx_t<slen, rounds>& ctx,
+          const uint8_t* const nonce,
+          const std::vector<uint8_t>& data,
+          const std::vector<uint8_t>& txt,
+          std::vector<uint8_t>& enc,
+          std::vector<uint8_t>& tag,
+          std::vector<uint8_t>& dec,
+          elephant::async_pool_t& pool,
+          const elephant::async_opts_t opts)
+{
+  using namespace elephant;
+
+  co_await async_encrypt<slen, rounds, tlen>(ctx,
+                                             nonce,
+                                             data.data(),
+                                             data.size(),
+                                             txt.data(),
+                                             enc.data(),
+                                             txt.size(),
+                                             tag.data(),
+                                             pool,
+                                             opts);
+
+  const bool f0 = co_await async_decrypt<slen, rounds, tlen>(ctx,
+                                                             nonce,
+                                                             tag.data(),
+                                                             data.data(),
+                                                             data.size(),
+                                                             enc.data(),
+                                                             dec.data(),
+                                                             enc.size(),
+                                                             pool,
+                                                             opts);
+  if (!f0) {
+    co_return std::make_pair(false, false);
+  }
+
+  std::vector<uint8_t> enc_ = enc, dec_(dec.size());
+  if (!enc_.empty()) {
+    enc_[enc_.size() / 2] ^= 1;
+  } else {
+    tag[0] ^= 1;
+  }
+
+  const bool f1 = co_await async_decrypt<slen, rounds, tlen>(ctx,
+                                                             nonce,
+                                                             tag.data(),
+                                                             data.data(),
+                                                             data.size(),
+                                                             enc_.data(),
+                                                             dec_.data(),
+                                                             enc_.size(),
+                                                             pool,
+                                                             opts);
+  if (enc_.empty()) {
+    tag[0] ^= 1;
+  }
+
+  co_return std::make_pair(f0, f1);
+}
+
+// Checks that awaiting `async_{en, de}crypt`, both when it completes inline &
+// when it's split across worker pool, gives same cipher text & tag reference (
+// KAT verified ) `encrypt` computes, decrypts it back & rejects tampering
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_async()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  async_pool_t pool(3);
+
+  std::vector<uint8_t> key(16), nonce(12);
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  // inline only, default knobs & always offloaded, in many small parts
+  const async_opts_t inlined{ ~0ul, 1ul << 16 };
+  const async_opts_t dflt{};
+  const async_opts_t offloaded{ 0, 64 };
+
+  for (const size_t dlen : { 0ul, 1ul, 33ul, 300ul }) {
+    for (const size_t ctlen : { 0ul, 1ul, 100ul, 5000ul }) {
+      std::vector<uint8_t> data(dlen), txt(ctlen);
+      std::vector<uint8_t> enc(ctlen), tag(tbytes);
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      encrypt<slen, rounds, tlen>(ctx,
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc.data(),
+                                  ctlen,
+                                  tag.data());
+
+      for (const auto& opts : { inlined, dflt, offloaded }) {
+        std::vector<uint8_t> enc_(ctlen), tag_(tbytes), dec(ctlen);
+
+        auto t = seal_open<slen, rounds, tlen>(
+          ctx, nonce.data(), data, txt, enc_, tag_, dec, pool, opts);
+        const auto [f0, f1] = t.sync_wait();
+
+        EXPECT_EQ(enc_, enc);
+        EXPECT_EQ(tag_, tag);
+        EXPECT_TRUE(f0);
+        EXPECT_EQ(dec, txt);
+        EXPECT_FALSE(f1);
+      }
+    }
+  }
+}
+
+TEST(Async, DumboMatchesEncrypt)
+{
+  test_async<160, 80, 64>();
+}
+
+TEST(Async, JumboMatchesEncrypt)
+{
+  test_async<176, 90, 64>();
+}
+
+TEST(Async, DeliriumMatchesEncrypt)
+{
+  test_async<200, 18, 128>();
+}
+
+// Checks that a frame freed on another thread goes back to free list of
+// thread which allocated it
+TEST(Async, FrameReturnsToOwner)
+{
+  using frame_pool_t = elephant::frame_pool_t;
+
+  constexpr size_t n = 200;
+  constexpr size_t hdr = sizeof(frame_pool_t::header_t);
+  constexpr size_t c = frame_pool_t::size_class(n + hdr);
+
+  void* const blk = frame_pool_t::alloc(n);
+  frame_pool_t::owner_t* const o = frame_pool_t::self();
+  ASSERT_NE(o, nullptr);
+
+  // empty this size class, so that next allocation must drain return list
+  std::vector<void*> held;
+  while (o->heads[c] != nullptr) {
+    held.emplace_back(frame_pool_t::alloc(n));
+  }
+
+  std::thread([blk]() { frame_pool_t::dealloc(blk, n); }).join();
+
+  void* const again = frame_pool_t::alloc(n);
+  EXPECT_EQ(again, blk);
+
+  frame_pool_t::dealloc(again, n);
+  for (void* const p : held) {
+    frame_pool_t::dealloc(p, n);
+  }
+}
+
+// Checks that frames outliving thread which allocated them can still be freed,
+// on other threads, after it's gone
+TEST(Async, FrameOutlivesOwner)
+{
+  using frame_pool_t = elephant::frame_pool_t;
+
+  std::vector<void*> blks;
+  std::thread([&blks]() {
+    for (size_t i = 0; i < 100; i++) {
+      blks.emplace_back(frame_pool_t::alloc(64 + i * 8));
+    }
+    frame_pool_t::dealloc(blks.back(), 64 + 99 * 8);
+    blks.pop_back();
+  }).join();
+
+  std::vector<std::thread> freers;
+  for (size_t t = 0; t < 3; t++) {
+    freers.emplace_back([&blks, t]() {
+      for (size_t i = t; i < blks.size(); i += 3) {
+        frame_pool_t::dealloc(blks[i], 64 + i * 8);
+      }
+    });
+  }
+  for (auto& f : freers) {
+    f.join();
+  }
+}
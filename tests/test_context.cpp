@@ -0,0 +1,230 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that {en, de}cryption using key context & precomputed associated data
+// digest agrees with reference ( KAT verified ) `encrypt`/ `decrypt`, which
+// expand secret key & absorb associated data on every call
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_context()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  for (size_t dlen : { 0, 1, 7, 8, 9, 13, 20, 21, 40, 77, 300 }) {
+    for (size_t ctlen : { 0, 1, 19, 20, 21, 22, 25, 64 }) {
+      std::vector<uint8_t> key(16), nonce(12), data(dlen), txt(ctlen);
+      std::vector<uint8_t> enc(ctlen), enc_(ctlen), dec(ctlen);
+      uint8_t tag[tbytes], tag_[tbytes];
+
+      random_data(key.data(), key.size());
+      random_data(nonce.data(), nonce.size());
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      encrypt<slen, rounds, tlen>(key.data(),
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc.data(),
+                                  ctlen,
+                                  tag);
+
+      const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+      encrypt<slen, rounds, tlen>(ctx,
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc_.data(),
+                                  ctlen,
+                                  tag_);
+
+      EXPECT_EQ(enc, enc_);
+      EXPECT_EQ(std::memcmp(tag, tag_, tbytes), 0);
+
+      ad_digest_t<slen> digest;
+      compute_ad_digest<slen, rounds>(ctx, data.data(), dlen, digest);
+
+      std::fill(enc_.begin(), enc_.end(), 0);
+      encrypt<slen, rounds, tlen>(
+        ctx, nonce.data(), digest, txt.data(), enc_.data(), ctlen, tag_);
+
+      EXPECT_EQ(enc, enc_);
+      EXPECT_EQ(std::memcmp(tag, tag_, tbytes), 0);
+
+      bool flg = decrypt<slen, rounds, tlen>(ctx,
+                                             nonce.data(),
+                                             tag,
+                                             data.data(),
+                                             dlen,
+                                             enc.data(),
+                                             dec.data(),
+                                             ctlen);
+
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(txt, dec);
+
+      std::fill(dec.begin(), dec.end(), 0);
+      flg = decrypt<slen, rounds, tlen>(
+        ctx, nonce.data(), tag, digest, enc.data(), dec.data(), ctlen);
+
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(txt, dec);
+
+      // same digest must be reusable with a different nonce
+      nonce[0] ^= 1;
+      encrypt<slen, rounds, tlen>(key.data(),
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc.data(),
+                                  ctlen,
+                                  tag);
+      encrypt<slen, rounds, tlen>(
+        ctx, nonce.data(), digest, txt.data(), enc_.data(), ctlen, tag_);
+
+      EXPECT_EQ(enc, enc_);
+      EXPECT_EQ(std::memcmp(tag, tag_, tbytes), 0);
+
+      tag[tbytes - 1] ^= 0x80;
+      flg = decrypt<slen, rounds, tlen>(
+        ctx, nonce.data(), tag, digest, enc.data(), dec.data(), ctlen);
+
+      EXPECT_FALSE(flg);
+      EXPECT_EQ(dec, std::vector<uint8_t>(ctlen, 0));
+    }
+  }
+}
+
+TEST(KeyContext, DumboMatchesEncrypt)
+{
+  test_context<160, 80, 64>();
+}
+
+TEST(KeyContext, JumboMatchesEncrypt)
+{
+  test_context<176, 90, 64>();
+}
+
+TEST(KeyContext, DeliriumMatchesEncrypt)
+{
+  test_context<200, 18, 128>();
+}
+
+// Checks that expanded key material is zeroed by `wipe`, which destructor also
+// calls, & that re-initializing context brings same key material back
+TEST(KeyContext, ZeroedOnWipe)
+{
+  using ctx_t = dumbo::key_ctx_t;
+  constexpr size_t n = ctx_t::sbytes;
+
+  uint8_t key[16];
+  random_data(key, sizeof(key));
+
+  ctx_t ctx{ key };
+  const std::vector<uint8_t> ekey(ctx.ekey, ctx.ekey + n);
+
+  EXPECT_NE(ekey, std::vector<uint8_t>(n, 0));
+
+  ctx.wipe();
+  EXPECT_EQ(std::vector<uint8_t>(ctx.ekey, ctx.ekey + n),
+            std::vector<uint8_t>(n, 0));
+
+  ctx.init(key);
+  EXPECT_EQ(std::vector<uint8_t>(ctx.ekey, ctx.ekey + n), ekey);
+}
+
+// Checks that long-lived AEAD context, with & without mask table ( including
+// one asked to cover absurdly long messages, which must be clamped ), gives
+// same cipher text & tag reference `encrypt` computes, decrypts it back &
+// rejects tampering, zeroing plain text
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_aead_context()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> key(16);
+  random_data(key.data(), key.size());
+
+  for (const size_t max_len : { 0ul, 4096ul, ~0ul }) {
+    aead_ctx_t<slen, rounds, tlen> actx(key.data(), max_len);
+    EXPECT_EQ(actx.has_table(), max_len > 0);
+
+    for (const size_t dlen : { 0ul, 7ul, 64ul, 300ul }) {
+      for (const size_t ctlen : { 0ul, 1ul, 1000ul, 5000ul }) {
+        std::vector<uint8_t> nonce(12), data(dlen), txt(ctlen);
+        std::vector<uint8_t> enc(ctlen), enc_(ctlen), dec(ctlen);
+        std::vector<uint8_t> tag(tbytes), tag_(tbytes);
+
+        random_data(nonce.data(), nonce.size());
+        random_data(data.data(), dlen);
+        random_data(txt.data(), ctlen);
+
+        encrypt<slen, rounds, tlen>(key.data(),
+                                    nonce.data(),
+                                    data.data(),
+                                    dlen,
+                                    txt.data(),
+                                    enc.data(),
+                                    ctlen,
+                                    tag.data());
+        actx.encrypt(nonce.data(),
+                     data.data(),
+                     dlen,
+                     txt.data(),
+                     enc_.data(),
+                     ctlen,
+                     tag_.data());
+
+        EXPECT_EQ(enc_, enc);
+        EXPECT_EQ(tag_, tag);
+
+        bool flg = actx.decrypt(nonce.data(),
+                                tag.data(),
+                                data.data(),
+                                dlen,
+                                enc.data(),
+                                dec.data(),
+                                ctlen);
+        EXPECT_TRUE(flg);
+        EXPECT_EQ(dec, txt);
+
+        tag[0] ^= 1;
+        flg = actx.decrypt(nonce.data(),
+                           tag.data(),
+                           data.data(),
+                           dlen,
+                           enc.data(),
+                           dec.data(),
+                           ctlen);
+        EXPECT_FALSE(flg);
+        EXPECT_EQ(dec, std::vector<uint8_t>(ctlen, 0));
+      }
+    }
+  }
+}
+
+TEST(AeadContext, DumboMatchesEncrypt)
+{
+  test_aead_context<160, 80, 64>();
+}
+
+TEST(AeadContext, JumboMatchesEncrypt)
+{
+  test_aead_context<176, 90, 64>();
+}
+
+TEST(AeadContext, DeliriumMatchesEncrypt)
+{
+  test_aead_context<200, 18, 128>();
+}
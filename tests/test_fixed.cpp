@@ -0,0 +1,141 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+// Checks that fixed-length `encrypt`, both with raw secret key & key context,
+// produces same cipher text & tag reference ( KAT verified ) `encrypt` does,
+// for `dlen` -bytes associated data & `ctlen` -bytes plain text, that
+// fixed-length `decrypt` gives plain text back & that a tampered tag is
+// rejected, zeroing plain text
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t ctlen>
+static void
+test_fixed_len()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  // one byte longer than needed, so that no buffer is ever empty
+  std::vector<uint8_t> key(16), nonce(12), data(dlen + 1), txt(ctlen + 1);
+  std::vector<uint8_t> enc(ctlen + 1), enc_(ctlen + 1), enc__(ctlen + 1);
+  std::vector<uint8_t> dec(ctlen + 1), dec_(ctlen + 1);
+  std::vector<uint8_t> tag(tbytes), tag_(tbytes), tag__(tbytes);
+
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+  random_data(data.data(), dlen);
+  random_data(txt.data(), ctlen);
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  encrypt<slen, rounds, tlen>(key.data(),
+                              nonce.data(),
+                              data.data(),
+                              dlen,
+                              txt.data(),
+                              enc.data(),
+                              ctlen,
+                              tag.data());
+
+  encrypt<slen, rounds, tlen, dlen, ctlen>(key.data(),
+                                           nonce.data(),
+                                           data.data(),
+                                           txt.data(),
+                                           enc_.data(),
+                                           tag_.data());
+  encrypt<slen, rounds, tlen, dlen, ctlen>(
+    ctx, nonce.data(), data.data(), txt.data(), enc__.data(), tag__.data());
+
+  EXPECT_EQ(enc_, enc);
+  EXPECT_EQ(tag_, tag);
+  EXPECT_EQ(enc__, enc);
+  EXPECT_EQ(tag__, tag);
+
+  bool flg = decrypt<slen, rounds, tlen, dlen, ctlen>(key.data(),
+                                                      nonce.data(),
+                                                      tag.data(),
+                                                      data.data(),
+                                                      enc.data(),
+                                                      dec.data());
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(dec, txt);
+
+  flg = decrypt<slen, rounds, tlen, dlen, ctlen>(
+    ctx, nonce.data(), tag.data(), data.data(), enc.data(), dec_.data());
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(dec_, txt);
+
+  tag[0] ^= 1;
+
+  flg = decrypt<slen, rounds, tlen, dlen, ctlen>(key.data(),
+                                                 nonce.data(),
+                                                 tag.data(),
+                                                 data.data(),
+                                                 enc.data(),
+                                                 dec.data());
+  EXPECT_FALSE(flg);
+  EXPECT_EQ(dec, std::vector<uint8_t>(ctlen + 1, 0));
+
+  flg = decrypt<slen, rounds, tlen, dlen, ctlen>(
+    ctx, nonce.data(), tag.data(), data.data(), enc.data(), dec_.data());
+  EXPECT_FALSE(flg);
+  EXPECT_EQ(dec_, std::vector<uint8_t>(ctlen + 1, 0));
+}
+
+// Runs fixed-length test for `dlen` -bytes associated data, over each of given
+// plain text lengths
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t dlen,
+         const size_t... ctlen>
+static void
+test_fixed_row(std::index_sequence<ctlen...>)
+{
+  (test_fixed_len<slen, rounds, tlen, dlen, ctlen>(), ...);
+}
+
+// Checks fixed-length routines over a compile-time grid of lengths, where plain
+// text lengths are empty, one short of, exactly & one past permutation state
+// size along with a few power of 2 payloads, while associated data lengths
+// make 12 -bytes nonce prepended & padded data just fit in, exactly fill or
+// spill over first block ( & also second one )
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_fixed()
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t first = sbytes - 12; // data bytes fitting in first block
+
+  using ctlens =
+    std::index_sequence<0, sbytes - 1, sbytes, sbytes + 1, 16, 32, 64, 128>;
+
+  test_fixed_row<slen, rounds, tlen, 0>(ctlens{});
+  test_fixed_row<slen, rounds, tlen, 1>(ctlens{});
+  test_fixed_row<slen, rounds, tlen, first - 1>(ctlens{});
+  test_fixed_row<slen, rounds, tlen, first>(ctlens{});
+  test_fixed_row<slen, rounds, tlen, first + 1>(ctlens{});
+  test_fixed_row<slen, rounds, tlen, first + sbytes>(ctlens{});
+}
+
+TEST(Fixed, DumboMatchesEncrypt)
+{
+  test_fixed<160, 80, 64>();
+}
+
+TEST(Fixed, JumboMatchesEncrypt)
+{
+  test_fixed<176, 90, 64>();
+}
+
+TEST(Fixed, DeliriumMatchesEncrypt)
+{
+  test_fixed<200, 18, 128>();
+}
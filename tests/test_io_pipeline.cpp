@@ -0,0 +1,144 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "io_pipeline.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Writes given bytes into a fresh temporary file
+static FILE*
+temp_file(const std::vector<uint8_t>& bytes)
+{
+  FILE* const f = std::tmpfile();
+  std::fwrite(bytes.data(), 1, bytes.size(), f);
+  std::fflush(f);
+  return f;
+}
+
+// Reads whole content of file, from offset 0
+static std::vector<uint8_t>
+read_file(FILE* const f)
+{
+  std::vector<uint8_t> bytes;
+  uint8_t buf[4096];
+
+  for (off_t off = 0;;) {
+    const ssize_t n = pread(fileno(f), buf, sizeof(buf), off);
+    if (n <= 0) {
+      break;
+    }
+    bytes.insert(bytes.end(), buf, buf + n);
+    off += n;
+  }
+
+  return bytes;
+}
+
+// Checks that file {en, de}cryption pipeline, both over io_uring ( when
+// available ) & its blocking I/O fallback, produces same segmented stream
+// `segment_writer_t` does, that decrypting it gives back plain text & that a
+// flipped bit makes decryption fail, for empty, sub-segment, segment aligned &
+// multi-segment inputs, under queue depths both smaller & larger than # -of
+// segments, while outputs overwrite longer stale files
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_io_pipeline(const bool use_uring)
+{
+  using namespace elephant;
+
+  {
+    io_pipeline_t pipe(4, 64, 64, use_uring);
+    if (!use_uring) {
+      EXPECT_FALSE(pipe.uring_active());
+    }
+  }
+
+  constexpr size_t seg_len = 1024;
+  thread_pool_t pool(3);
+
+  std::vector<uint8_t> key(16), nonce(12);
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  for (const size_t len : { 0ul, 1ul, seg_len, 5 * seg_len + 7 }) {
+    for (const size_t qd : { 1ul, 3ul, 16ul }) {
+      std::vector<uint8_t> txt(len), ref, stale(2 * len + 4096);
+      random_data(txt.data(), len);
+      random_data(stale.data(), stale.size());
+
+      segment_writer_t<slen, rounds, tlen> wr(
+        ctx, nonce.data(), seg_len, [&](const uint8_t* buf, size_t n) {
+          ref.insert(ref.end(), buf, buf + n);
+          return true;
+        });
+      wr.write(txt.data(), len);
+      wr.finish();
+
+      const io_pipeline_opts_t opts{ qd, seg_len, use_uring };
+
+      FILE* const in = temp_file(txt);
+      FILE* const enc = temp_file(stale);
+      FILE* const dec = temp_file(stale);
+      FILE* const bad = std::tmpfile();
+
+      bool flg = pipeline_encrypt<slen, rounds, tlen>(
+        ctx, nonce.data(), fileno(in), fileno(enc), pool, opts);
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(read_file(enc), ref);
+
+      flg = pipeline_decrypt<slen, rounds, tlen>(
+        ctx, fileno(enc), fileno(dec), pool, opts);
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(read_file(dec), txt);
+
+      uint8_t b = 0;
+      const off_t pos = SEGMENT_HEADER_LEN + len / 2;
+      ASSERT_EQ(pread(fileno(enc), &b, 1, pos), 1);
+      b ^= 1;
+      ASSERT_EQ(pwrite(fileno(enc), &b, 1, pos), 1);
+
+      flg = pipeline_decrypt<slen, rounds, tlen>(
+        ctx, fileno(enc), fileno(bad), pool, opts);
+      EXPECT_FALSE(flg);
+
+      std::fclose(in);
+      std::fclose(enc);
+      std::fclose(dec);
+      std::fclose(bad);
+    }
+  }
+}
+
+TEST(IOPipeline, DumboUring)
+{
+  test_io_pipeline<160, 80, 64>(true);
+}
+
+TEST(IOPipeline, DumboBlocking)
+{
+  test_io_pipeline<160, 80, 64>(false);
+}
+
+TEST(IOPipeline, JumboUring)
+{
+  test_io_pipeline<176, 90, 64>(true);
+}
+
+TEST(IOPipeline, JumboBlocking)
+{
+  test_io_pipeline<176, 90, 64>(false);
+}
+
+TEST(IOPipeline, DeliriumUring)
+{
+  test_io_pipeline<200, 18, 128>(true);
+}
+
+TEST(IOPipeline, DeliriumBlocking)
+{
+  test_io_pipeline<200, 18, 128>(false);
+}
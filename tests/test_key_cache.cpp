@@ -0,0 +1,262 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Deterministic 16 -bytes secret key of given key identifier
+static void
+key_of(const uint64_t id, uint8_t* const key)
+{
+  std::mt19937_64 gen(id);
+
+  for (size_t i = 0; i < 16; i += 8) {
+    const uint64_t w = gen();
+    std::memcpy(key + i, &w, 8);
+  }
+}
+
+// Checks that cached context holds same expanded key, which key context built
+// from secret key of that identifier holds
+template<typename ctx_t>
+static bool
+matches(const uint64_t id, const ctx_t& ctx)
+{
+  uint8_t key[16];
+  key_of(id, key);
+
+  const ctx_t ref{ key };
+  return std::memcmp(ref.ekey, ctx.ekey, sizeof(ref.ekey)) == 0;
+}
+
+// Checks that cache never holds more contexts than its capacity, evicts
+// unreferenced ones first & serves contexts matching their key identifiers
+TEST(KeyCache, Eviction)
+{
+  dumbo::key_cache_t cache{ 8 * dumbo::key_cache_t::ENTRY_BYTES, 1 };
+
+  EXPECT_EQ(cache.capacity(), 8ul);
+
+  auto fetch = [](const uint64_t id) {
+    return [id](uint8_t* const key) {
+      key_of(id, key);
+      return true;
+    };
+  };
+
+  for (uint64_t id = 0; id < 8; id++) {
+    const auto ctx = cache.get(id, fetch(id));
+
+    ASSERT_TRUE(ctx);
+    EXPECT_TRUE(matches(id, *ctx));
+  }
+
+  EXPECT_EQ(cache.size(), 8ul);
+  EXPECT_EQ(cache.stats().evictions, 0ul);
+
+  // first insertion beyond capacity sweeps CLOCK hand over all ( referenced )
+  // entries, clearing their reference bits & evicts first one it revisits
+  EXPECT_TRUE(cache.get(100, fetch(100)));
+  EXPECT_EQ(cache.stats().evictions, 1ul);
+  EXPECT_EQ(cache.size(), 8ul);
+
+  // give second chance to 3 of 7 remaining ones
+  std::vector<uint64_t> hot, cold;
+  for (uint64_t id = 0; id < 8; id++) {
+    if (hot.size() < 3) {
+      if (cache.find(id)) {
+        hot.push_back(id);
+      }
+    } else {
+      cold.push_back(id);
+    }
+  }
+
+  // so that next insertions evict only unreferenced ones
+  for (uint64_t id = 101; id < 105; id++) {
+    EXPECT_TRUE(cache.get(id, fetch(id)));
+  }
+
+  EXPECT_EQ(cache.stats().evictions, 5ul);
+  EXPECT_EQ(cache.size(), 8ul);
+
+  for (const auto id : hot) {
+    EXPECT_TRUE(cache.find(id));
+  }
+  for (const auto id : cold) {
+    EXPECT_FALSE(cache.find(id));
+  }
+  for (uint64_t id = 100; id < 105; id++) {
+    EXPECT_TRUE(cache.find(id));
+  }
+
+  for (uint64_t id = 200; id < 300; id++) {
+    const auto ctx = cache.get(id, fetch(id));
+
+    ASSERT_TRUE(ctx);
+    EXPECT_TRUE(matches(id, *ctx));
+    EXPECT_LE(cache.size(), 8ul);
+  }
+
+  EXPECT_EQ(cache.stats().evictions, 105ul);
+
+  // erased key is gone, others are untouched
+  EXPECT_TRUE(cache.find(299));
+  cache.erase(299);
+  EXPECT_FALSE(cache.find(299));
+  EXPECT_EQ(cache.size(), 7ul);
+
+  // unknown key identifier isn't cached
+  EXPECT_FALSE(cache.get(12345, [](uint8_t*) { return false; }));
+  EXPECT_FALSE(cache.find(12345));
+}
+
+// Checks that context stays usable while pinned, even after being evicted,
+// & that same context is handed out to every lookup, while cached
+TEST(KeyCache, PinnedOutlivesEviction)
+{
+  delirium::key_cache_t cache{ 2 * delirium::key_cache_t::ENTRY_BYTES, 1 };
+
+  uint8_t key[16];
+  key_of(1, key);
+
+  const auto pinned = cache.get(1, key);
+  const auto again = cache.find(1);
+
+  ASSERT_TRUE(pinned);
+  EXPECT_EQ(pinned.get(), again.get());
+
+  for (uint64_t id = 2; id < 64; id++) {
+    key_of(id, key);
+    EXPECT_TRUE(cache.get(id, key));
+  }
+
+  EXPECT_FALSE(cache.find(1));
+  EXPECT_TRUE(matches(1, *pinned));
+}
+
+// Checks that concurrent lookups, insertions, evictions & erasures always hand
+// out contexts matching requested key identifiers, which {en, de}crypt same
+// as reference ( KAT verified ) routines
+TEST(KeyCache, ConcurrentLookup)
+{
+  constexpr size_t nthreads = 4;
+  constexpr uint64_t nkeys = 512;
+
+  dumbo::key_cache_t cache{ 64 * dumbo::key_cache_t::ENTRY_BYTES, 4 };
+  std::atomic<size_t> bad{ 0 };
+
+  auto work = [&](const size_t t) {
+    std::mt19937_64 gen(t);
+
+    uint8_t key[16], nonce[12]{}, txt[24], enc[24], enc_[24], tag[8], tag_[8];
+    const uint8_t data[1]{}; // empty associated data
+    random_data(txt, sizeof(txt));
+
+    for (size_t i = 0; i < 20000; i++) {
+      // mostly a small hot set, sometimes a cold key
+      const uint64_t id = (i % 4 == 0) ? gen() % nkeys : gen() % 32;
+
+      const auto ctx = cache.get(id, [id](uint8_t* const k) {
+        key_of(id, k);
+        return true;
+      });
+
+      if (!ctx || !matches(id, *ctx)) {
+        bad++;
+        continue;
+      }
+
+      if (i % 64 == 0) {
+        key_of(id, key);
+
+        dumbo::encrypt(*ctx, nonce, data, 0, txt, enc, sizeof(txt), tag);
+        dumbo::encrypt(key, nonce, data, 0, txt, enc_, sizeof(txt), tag_);
+
+        bad += std::memcmp(enc, enc_, sizeof(enc)) != 0;
+        bad += std::memcmp(tag, tag_, sizeof(tag)) != 0;
+      }
+
+      if (i % 1000 == 999) {
+        cache.erase(id);
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < nthreads; t++) {
+    workers.emplace_back(work, t);
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  const auto st = cache.stats();
+
+  EXPECT_EQ(bad.load(), 0ul);
+  EXPECT_LE(cache.size(), cache.capacity());
+  EXPECT_EQ(st.hits + st.misses, nthreads * 20000);
+  EXPECT_GT(st.hits, 0ul);
+  EXPECT_GT(st.evictions, 0ul);
+}
+
+// Checks that, on a hit, bytes one thread writes ( its epoch record & hit
+// counter, shard's mutex ) never share a cache line with other bytes another
+// thread touches, & that nothing is visited for uncached key identifier
+TEST(KeyCache, HitPathLinesApart)
+{
+  struct access_t
+  {
+    size_t t;
+    uintptr_t beg;
+    uintptr_t end;
+    bool writes;
+  };
+
+  dumbo::key_cache_t cache(1ul << 16);
+  std::vector<access_t> accs;
+
+  size_t n = 0;
+  cache.footprint(7, [&](const void*, const size_t, const bool) { n++; });
+  EXPECT_EQ(n, 0ul);
+
+  uint8_t key[16];
+  key_of(7, key);
+  cache.get(7, key).reset();
+
+  std::vector<std::thread> workers;
+  std::mutex mtx;
+  std::latch visited(2); // so that threads get epoch records of their own
+
+  for (size_t t = 0; t < 2; t++) {
+    workers.emplace_back([&, t]() {
+      cache.get(7, key).reset();
+      cache.footprint(
+        7, [&](const void* const ptr, const size_t len, const bool writes) {
+          const uintptr_t beg = reinterpret_cast<uintptr_t>(ptr);
+
+          std::lock_guard<std::mutex> lock(mtx);
+          accs.push_back({ t, beg, beg + len, writes });
+        });
+      visited.arrive_and_wait();
+    });
+  }
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  ASSERT_FALSE(accs.empty());
+
+  for (const auto& w : accs) {
+    for (const auto& a : accs) {
+      const bool same_line = (w.beg / 64 <= (a.end - 1) / 64) &&
+                             (a.beg / 64 <= (w.end - 1) / 64);
+      const bool disjoint = (w.end <= a.beg) || (a.end <= w.beg);
+
+      EXPECT_FALSE(w.writes && (w.t != a.t) && same_line && disjoint);
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that {en, de}cryption through keystream pool agrees with reference
+// ( KAT verified ) `encrypt`, for counter nonces, whether keystream is taken
+// from pool ( fully or only prefix of it ) or computed on demand, for skipped
+// & repeated nonces, with & without background generator
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_keystream_pool(const bool background)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+  constexpr size_t ks_len = 64;
+
+  std::mt19937 gen(slen);
+
+  std::vector<uint8_t> key(16);
+  uint8_t nonce[12];
+
+  random_data(key.data(), key.size());
+  random_data(nonce, sizeof(nonce));
+  nonce[11] = 0xf0; // so that counter carries into higher bytes
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+  keystream_pool_t<slen, rounds, tlen> pool{ ctx, nonce, ks_len, 8 * ks_len };
+
+  if (background) {
+    pool.start();
+  }
+
+  for (size_t i = 0; i < 64; i++) {
+    if (!background) {
+      pool.refill(gen() % 4);
+    }
+
+    // skip a few nonces, now & then
+    for (size_t j = gen() % 8; j > 4; j--) {
+      increment_nonce(nonce);
+    }
+
+    const size_t dlen = gen() % 32;
+    const size_t ctlen = gen() % (3 * ks_len);
+
+    std::vector<uint8_t> data(dlen), txt(ctlen);
+    std::vector<uint8_t> enc(ctlen), enc_(ctlen), dec(ctlen);
+    uint8_t tag[tbytes], tag_[tbytes];
+
+    random_data(data.data(), dlen);
+    random_data(txt.data(), ctlen);
+
+    encrypt<slen, rounds, tlen>(key.data(),
+                                nonce,
+                                data.data(),
+                                dlen,
+                                txt.data(),
+                                enc.data(),
+                                ctlen,
+                                tag);
+    pool.encrypt(
+      nonce, data.data(), dlen, txt.data(), enc_.data(), ctlen, tag_);
+
+    EXPECT_EQ(enc, enc_);
+    EXPECT_EQ(std::memcmp(tag, tag_, tbytes), 0);
+
+    // same nonce again, which must not be served from pool anymore
+    const bool flg = pool.decrypt(
+      nonce, tag, data.data(), dlen, enc.data(), dec.data(), ctlen);
+
+    EXPECT_TRUE(flg);
+    EXPECT_EQ(txt, dec);
+
+    increment_nonce(nonce);
+  }
+
+  if (background) {
+    pool.stop();
+  }
+}
+
+TEST(KeystreamPool, DumboMatchesEncrypt)
+{
+  test_keystream_pool<160, 80, 64>(false);
+}
+
+TEST(KeystreamPool, JumboMatchesEncrypt)
+{
+  test_keystream_pool<176, 90, 64>(false);
+}
+
+TEST(KeystreamPool, DeliriumMatchesEncrypt)
+{
+  test_keystream_pool<200, 18, 128>(false);
+}
+
+TEST(KeystreamPool, BackgroundMatchesEncrypt)
+{
+  test_keystream_pool<160, 80, 64>(true);
+  test_keystream_pool<200, 18, 128>(true);
+}
+
+// Checks that pool fills up to its byte budget & hands out pregenerated
+// keystream, in nonce order
+TEST(KeystreamPool, RefillWithinBudget)
+{
+  uint8_t key[16], nonce[12]{}, tag[8], tag_[8];
+  uint8_t txt[48], enc[48], enc_[48], dec[48];
+
+  random_data(key, sizeof(key));
+  random_data(txt, sizeof(txt));
+
+  const dumbo::key_ctx_t ctx{ key };
+  dumbo::keystream_pool_t pool{ ctx, nonce, 32, 4 * 32 };
+
+  EXPECT_EQ(pool.refill(), 4ul);
+  EXPECT_EQ(pool.size(), 4ul);
+  EXPECT_EQ(pool.refill(), 0ul);
+
+  nonce[11] = 1;
+  dumbo::encrypt(key, nonce, nullptr, 0, txt, enc, sizeof(txt), tag);
+  pool.encrypt(nonce, nullptr, 0, txt, enc_, sizeof(txt), tag_);
+
+  // entry of skipped nonce 0 is dropped, along with consumed one
+  EXPECT_EQ(pool.size(), 2ul);
+  EXPECT_EQ(std::memcmp(enc, enc_, sizeof(enc)), 0);
+  EXPECT_EQ(std::memcmp(tag, tag_, sizeof(tag)), 0);
+
+  tag[0] ^= 1;
+  nonce[11] = 2;
+  EXPECT_FALSE(pool.decrypt(nonce, tag, nullptr, 0, enc, dec, sizeof(enc)));
+  EXPECT_EQ(std::vector<uint8_t>(dec, dec + sizeof(dec)),
+            std::vector<uint8_t>(sizeof(dec), 0));
+}
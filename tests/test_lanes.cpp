@@ -0,0 +1,86 @@
+#include "lanes.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that algebraic normal form of Spongent 8 -bit S-box, as evaluated on
+// lane sliced states, agrees with its lookup table, on every byte value
+template<const size_t slen>
+static void
+test_sbox_lanes()
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t lanes = 256 / sbytes + 1;
+
+  std::vector<uint8_t> state(sbytes * lanes);
+  for (size_t i = 0; i < state.size(); i++) {
+    state[i] = static_cast<uint8_t>(i);
+  }
+
+  spongent::apply_sbox_lanes<slen, lanes>(state.data());
+
+  for (size_t i = 0; i < state.size(); i++) {
+    EXPECT_EQ(state[i], spongent::SBox[i & 0xff]);
+  }
+}
+
+// Checks that applying multi-state permutation on `lanes` -many random states
+// is same as applying scalar ( reference ) permutation on each of them
+template<const size_t slen, const size_t rounds, const size_t lanes>
+static void
+test_permute_lanes()
+{
+  using namespace elephant;
+  constexpr size_t sbytes = slen >> 3;
+
+  std::vector<uint8_t> states(sbytes * lanes), sliced(sbytes * lanes);
+  random_data(states.data(), states.size());
+
+  for (size_t l = 0; l < lanes; l++) {
+    to_lane<slen, lanes>(states.data() + l * sbytes, sliced.data(), l);
+  }
+
+  permute_lanes<slen, rounds, lanes>(sliced.data());
+
+  for (size_t l = 0; l < lanes; l++) {
+    uint8_t* const st = states.data() + l * sbytes;
+    uint8_t out[sbytes];
+
+    if constexpr (slen == 200) {
+      keccak::permute<rounds>(st);
+    } else {
+      spongent::permute<slen, rounds>(st);
+    }
+
+    from_lane<slen, lanes>(sliced.data(), out, l);
+    EXPECT_EQ(std::memcmp(out, st, sbytes), 0);
+  }
+}
+
+TEST(Lanes, SpongentSBox)
+{
+  test_sbox_lanes<160>();
+  test_sbox_lanes<176>();
+}
+
+TEST(Lanes, DumboPermutation)
+{
+  test_permute_lanes<160, 80, 1>();
+  test_permute_lanes<160, 80, 7>();
+  test_permute_lanes<160, 80, 32>();
+}
+
+TEST(Lanes, JumboPermutation)
+{
+  test_permute_lanes<176, 90, 1>();
+  test_permute_lanes<176, 90, 7>();
+  test_permute_lanes<176, 90, 32>();
+}
+
+TEST(Lanes, DeliriumPermutation)
+{
+  test_permute_lanes<200, 18, 1>();
+  test_permute_lanes<200, 18, 7>();
+  test_permute_lanes<200, 18, 32>();
+}
@@ -0,0 +1,80 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that authentication-only mode produces same tag as reference ( KAT
+// verified ) `encrypt` does with empty plain text, for message lengths which
+// end up in partially filled & full lane groups, on many # -of threads
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_mac()
+{
+  using namespace elephant;
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> key(16), nonce(12);
+
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  for (size_t blks : { 0, 1, 2, 15, 16, 17, 32, 33, 47, 48, 64, 100, 200 }) {
+    for (size_t extra : { 0ul, 1ul, sbytes - 1 }) {
+      const size_t dlen = blks * sbytes + extra;
+
+      std::vector<uint8_t> data(dlen);
+      uint8_t tag[tbytes], tag_[tbytes];
+
+      random_data(data.data(), dlen);
+
+      encrypt<slen, rounds, tlen>(key.data(),
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  nullptr,
+                                  nullptr,
+                                  0,
+                                  tag);
+
+      for (size_t nthreads : { 1, 2, 3, 8 }) {
+        mac<slen, rounds, tlen>(
+          ctx, nonce.data(), data.data(), dlen, tag_, nthreads);
+
+        EXPECT_EQ(std::memcmp(tag, tag_, tbytes), 0);
+
+        bool flg = mac_verify<slen, rounds, tlen>(
+          ctx, nonce.data(), tag, data.data(), dlen, nthreads);
+        EXPECT_TRUE(flg);
+
+        if (dlen > 0) {
+          data[dlen - 1] ^= 1;
+          flg = mac_verify<slen, rounds, tlen>(
+            ctx, nonce.data(), tag, data.data(), dlen, nthreads);
+          data[dlen - 1] ^= 1;
+
+          EXPECT_FALSE(flg);
+        }
+      }
+    }
+  }
+}
+
+TEST(Mac, DumboMatchesEncrypt)
+{
+  test_mac<160, 80, 64>();
+}
+
+TEST(Mac, JumboMatchesEncrypt)
+{
+  test_mac<176, 90, 64>();
+}
+
+TEST(Mac, DeliriumMatchesEncrypt)
+{
+  test_mac<200, 18, 128>();
+}
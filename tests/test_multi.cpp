@@ -0,0 +1,281 @@
+#include "batch.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// Random message, along with its reference ( KAT verified ) cipher text & tag
+struct ref_msg_t
+{
+  std::vector<uint8_t> nonce, data, txt, enc, tag;
+};
+
+// Copy of bytes held by ( possibly empty ) slab buffer
+static std::vector<uint8_t>
+bytes(const elephant::slab_buf_t& buf)
+{
+  return std::vector<uint8_t>(buf.data(), buf.data() + buf.size());
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static ref_msg_t
+ref_msg(const elephant::key_ctx_t<slen, rounds>& ctx,
+        const size_t dlen,
+        const size_t ctlen)
+{
+  ref_msg_t m{ std::vector<uint8_t>(12),
+               std::vector<uint8_t>(dlen),
+               std::vector<uint8_t>(ctlen),
+               std::vector<uint8_t>(ctlen),
+               std::vector<uint8_t>(tlen >> 3) };
+
+  random_data(m.nonce.data(), m.nonce.size());
+  random_data(m.data.data(), dlen);
+  random_data(m.txt.data(), ctlen);
+
+  elephant::encrypt<slen, rounds, tlen>(ctx,
+                                        m.nonce.data(),
+                                        m.data.data(),
+                                        dlen,
+                                        m.txt.data(),
+                                        m.enc.data(),
+                                        ctlen,
+                                        m.tag.data());
+  return m;
+}
+
+// Checks that multi-buffer {en, de}cryption of `cnt` -many variable length
+// messages gives same cipher texts & tags reference `encrypt` computes,
+// decrypts them back & zeroes ( & flags ) only tampered one, while table,
+// kept at `keep` -bytes, is trimmed back after long messages
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes>
+static void
+test_multi(const size_t cnt, const size_t max_len, const size_t keep)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> key(16);
+  random_data(key.data(), key.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+  mb_table_t<slen, rounds> tab(ctx, keep);
+
+  std::vector<ref_msg_t> refs;
+  std::vector<std::vector<uint8_t>> enc(cnt), dec(cnt), tags(cnt);
+  std::vector<mb_msg_t> msgs(cnt);
+
+  for (size_t i = 0; i < cnt; i++) {
+    refs.emplace_back(ref_msg<slen, rounds, tlen>(
+      ctx, (i * 7) % (max_len / 4 + 1), (i * 131) % (max_len + 1)));
+
+    const ref_msg_t& r = refs.back();
+    enc[i].resize(r.txt.size());
+    dec[i].resize(r.txt.size());
+    tags[i].resize(tbytes);
+
+    msgs[i] = mb_msg_t{ r.nonce.data(), r.data.data(), r.data.size(),
+                        r.txt.data(),   enc[i].data(), r.txt.size(),
+                        tags[i].data() };
+  }
+
+  mb_stats_t stats;
+  encrypt_multi<slen, rounds, tlen, lanes>(tab, msgs.data(), cnt, stats);
+
+  for (size_t i = 0; i < cnt; i++) {
+    EXPECT_EQ(enc[i], refs[i].enc);
+    EXPECT_EQ(tags[i], refs[i].tag);
+
+    msgs[i].in = enc[i].data();
+    msgs[i].out = dec[i].data();
+  }
+
+  bool flg = decrypt_multi<slen, rounds, tlen, lanes>(
+    tab, msgs.data(), cnt, stats);
+  EXPECT_TRUE(flg);
+
+  for (size_t i = 0; i < cnt; i++) {
+    EXPECT_TRUE(msgs[i].ok);
+    EXPECT_EQ(dec[i], refs[i].txt);
+  }
+
+  EXPECT_LE(tab.lfsr_states.size(), std::max(keep, tab.sbytes));
+  EXPECT_LE(tab.accs.capacity(), std::max(keep, cnt * tab.sbytes));
+
+  if (cnt < 2) {
+    return;
+  }
+
+  tags[1][0] ^= 1;
+  flg = decrypt_multi<slen, rounds, tlen, lanes>(tab, msgs.data(), cnt, stats);
+  EXPECT_FALSE(flg);
+
+  for (size_t i = 0; i < cnt; i++) {
+    EXPECT_EQ(msgs[i].ok, i != 1);
+
+    const auto exp = (i == 1) ? std::vector<uint8_t>(dec[i].size(), 0)
+                              : refs[i].txt;
+    EXPECT_EQ(dec[i], exp);
+  }
+}
+
+TEST(Multi, DumboMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 5ul, 40ul }) {
+    test_multi<160, 80, 64, 16>(cnt, 300, 1ul << 16);
+    test_multi<160, 80, 64, 32>(cnt, 3000, 64);
+  }
+}
+
+TEST(Multi, JumboMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 5ul, 40ul }) {
+    test_multi<176, 90, 64, 8>(cnt, 300, 1ul << 16);
+    test_multi<176, 90, 64, 32>(cnt, 3000, 0);
+  }
+}
+
+TEST(Multi, DeliriumMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 5ul, 40ul }) {
+    test_multi<200, 18, 128, 32>(cnt, 300, 1ul << 16);
+    test_multi<200, 18, 128, 7>(cnt, 3000, 100);
+  }
+}
+
+// Checks that submissions, from many threads, to batching scheduler give same
+// cipher texts & tags reference `encrypt` computes, decrypt back, zero out
+// tampered ones & that output buffers outlive scheduler
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_batch(const elephant::batch_opts_t opts)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> key(16);
+  random_data(key.data(), key.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+  const auto last = ref_msg<slen, rounds, tlen>(ctx, 10, 1000);
+  batch_result_t kept;
+
+  {
+    batch_scheduler_t<slen, rounds, tlen> sched(ctx, opts);
+    std::vector<std::thread> workers;
+
+    for (size_t t = 0; t < 3; t++) {
+      workers.emplace_back([&, t]() {
+        for (size_t i = 0; i < 30; i++) {
+          const size_t dlen = (t * 13 + i) % 40;
+          const size_t ctlen = (t * 71 + i * 29) % 300;
+          const auto m = ref_msg<slen, rounds, tlen>(ctx, dlen, ctlen);
+
+          auto e = sched
+                     .encrypt(m.nonce.data(),
+                              m.data.data(),
+                              dlen,
+                              m.txt.data(),
+                              ctlen)
+                     .get();
+          EXPECT_EQ(bytes(e.out), m.enc);
+          EXPECT_EQ(std::memcmp(e.tag, m.tag.data(), tbytes), 0);
+
+          e.tag[0] ^= static_cast<uint8_t>(i & 1);
+
+          auto d = sched
+                     .decrypt(m.nonce.data(),
+                              e.tag,
+                              m.data.data(),
+                              dlen,
+                              e.out.data(),
+                              ctlen)
+                     .get();
+          EXPECT_EQ(d.ok, (i & 1) == 0);
+
+          const auto exp = d.ok ? m.txt : std::vector<uint8_t>(ctlen, 0);
+          EXPECT_EQ(bytes(d.out), exp);
+        }
+      });
+    }
+
+    for (auto& w : workers) {
+      w.join();
+    }
+
+    kept = sched
+             .encrypt(last.nonce.data(),
+                      last.data.data(),
+                      last.data.size(),
+                      last.txt.data(),
+                      last.txt.size())
+             .get();
+
+    const auto m = sched.metrics();
+    EXPECT_EQ(m.requests, 3ul * 30 * 2 + 1);
+    EXPECT_LE(m.fill_ratio(), 1.);
+  }
+
+  EXPECT_EQ(bytes(kept.out), last.enc);
+  EXPECT_EQ(std::memcmp(kept.tag, last.tag.data(), tbytes), 0);
+}
+
+TEST(Batch, DumboMatchesEncrypt)
+{
+  test_batch<160, 80, 64>({});
+  test_batch<160, 80, 64>({ std::chrono::microseconds(200), 4 });
+}
+
+TEST(Batch, JumboMatchesEncrypt)
+{
+  test_batch<176, 90, 64>({});
+  test_batch<176, 90, 64>({ std::chrono::microseconds(200), 4 });
+}
+
+TEST(Batch, DeliriumMatchesEncrypt)
+{
+  test_batch<200, 18, 128>({});
+  test_batch<200, 18, 128>({ std::chrono::microseconds(200), 4 });
+}
+
+// Checks that callback based submissions are all completed, including ones
+// still queued when scheduler goes away
+TEST(Batch, DrainedOnDestruction)
+{
+  using namespace elephant;
+
+  std::vector<uint8_t> key(16), txt(64);
+  random_data(key.data(), key.size());
+  random_data(txt.data(), txt.size());
+
+  const dumbo::key_ctx_t ctx{ key.data() };
+  std::vector<batch_req_t> reqs(100);
+  std::atomic<size_t> left{ reqs.size() };
+
+  {
+    dumbo::batch_scheduler_t sched(ctx, { std::chrono::seconds(10), 1024 });
+
+    for (auto& r : reqs) {
+      r.in = txt.data();
+      r.len = txt.size();
+      r.done = [](batch_req_t* const, void* const arg) {
+        static_cast<std::atomic<size_t>*>(arg)->fetch_sub(1);
+      };
+      r.arg = &left;
+
+      sched.submit(&r);
+    }
+  }
+
+  EXPECT_EQ(left.load(), 0ul);
+  for (const auto& r : reqs) {
+    EXPECT_EQ(r.out.size(), txt.size());
+  }
+}
@@ -0,0 +1,132 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "utils.hpp"
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <set>
+#include <thread>
+#include <vector>
+
+using nonce_t = std::array<uint8_t, 12>;
+
+// Draws nonces from generator on `nthreads` -many threads, alternating between
+// caller owned & thread local leases, until either each thread has drawn
+// `per_thread` -many or generator is exhausted, returning all of them
+//
+// A thread falls back to its other lease, when one runs dry, so that it stops
+// only once both are used up.
+static std::vector<nonce_t>
+draw_nonces(elephant::nonce_gen_t& gen,
+            const size_t nthreads,
+            const size_t per_thread)
+{
+  std::vector<std::vector<nonce_t>> outs(nthreads);
+  std::vector<std::thread> workers;
+
+  for (size_t t = 0; t < nthreads; t++) {
+    workers.emplace_back([&, t]() {
+      elephant::nonce_gen_t::lease_t lease;
+      nonce_t n;
+      uint8_t* const p = n.data();
+
+      for (size_t i = 0; i < per_thread; i++) {
+        const bool f = (i & 1) ? (gen.next(lease, p) || gen.next(p))
+                               : (gen.next(p) || gen.next(lease, p));
+        if (!f) {
+          break;
+        }
+        outs[t].emplace_back(n);
+      }
+    });
+  }
+
+  for (auto& w : workers) {
+    w.join();
+  }
+
+  std::vector<nonce_t> all;
+  for (const auto& o : outs) {
+    all.insert(all.end(), o.begin(), o.end());
+  }
+  return all;
+}
+
+// Checks that nonces drawn concurrently, under various lease lengths, never
+// repeat & carry caller's fixed field, in counter mode
+TEST(Nonce, UniqueAcrossThreads)
+{
+  using namespace elephant;
+
+  for (const uint64_t lease_len : { 1ul, 7ul, 1024ul }) {
+    nonce_gen_t gen(nonce_mode_t::counter, 0xdeadbeef, lease_len);
+
+    const auto all = draw_nonces(gen, 8, 5000);
+    const std::set<nonce_t> uniq(all.begin(), all.end());
+
+    EXPECT_EQ(all.size(), 8ul * 5000);
+    EXPECT_EQ(uniq.size(), all.size());
+
+    for (const auto& n : all) {
+      EXPECT_EQ(n[0], 0xde);
+      EXPECT_EQ(n[3], 0xef);
+    }
+  }
+}
+
+// Checks that generator hands out exactly `max_nonces` -many distinct nonces,
+// even when threads race for last lease, & refuses to hand out any more
+TEST(Nonce, ExhaustedAtLimit)
+{
+  using namespace elephant;
+
+  for (const uint64_t limit : { 1ul, 100ul, 1000ul }) {
+    nonce_gen_t gen(nonce_mode_t::random_prefix, 0, 16, limit);
+
+    const auto all = draw_nonces(gen, 4, 1000);
+    const std::set<nonce_t> uniq(all.begin(), all.end());
+
+    EXPECT_EQ(all.size(), limit);
+    EXPECT_EQ(uniq.size(), all.size());
+    EXPECT_TRUE(gen.exhausted());
+    EXPECT_EQ(gen.remaining(), 0ul);
+
+    nonce_t n;
+    nonce_gen_t::lease_t lease;
+    EXPECT_FALSE(gen.next(n.data()));
+    EXPECT_FALSE(gen.next(lease, n.data()));
+  }
+
+  // random prefix mode has only 32 -bit counter space
+  nonce_gen_t gen;
+  EXPECT_EQ(gen.remaining(), 1ul << 32);
+}
+
+// Checks that `seal` encrypts under drawn nonce, as `decrypt` accepts, & stops
+// once generator is exhausted, leaving outputs untouched
+TEST(Nonce, SealUntilExhausted)
+{
+  using namespace elephant;
+
+  std::vector<uint8_t> key(16), data(5), txt(100), enc(100), dec(100);
+  random_data(key.data(), key.size());
+  random_data(data.data(), data.size());
+  random_data(txt.data(), txt.size());
+
+  dumbo::nonce_ctx_t ctx(key.data(), nonce_mode_t::counter, 7, 4, 2);
+
+  uint8_t nonce[12], tag[8];
+
+  for (size_t i = 0; i < 2; i++) {
+    ASSERT_TRUE(dumbo::seal(
+      ctx, data.data(), 5, txt.data(), enc.data(), 100, nonce, tag));
+    ASSERT_TRUE(dumbo::decrypt(
+      ctx, nonce, tag, data.data(), 5, enc.data(), dec.data(), 100));
+    EXPECT_EQ(dec, txt);
+  }
+
+  std::fill(enc.begin(), enc.end(), 0xa5);
+  EXPECT_FALSE(dumbo::seal(
+    ctx, data.data(), 5, txt.data(), enc.data(), 100, nonce, tag));
+  EXPECT_EQ(enc, std::vector<uint8_t>(100, 0xa5));
+}
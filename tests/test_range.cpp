@@ -0,0 +1,171 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that jumping LFSR ahead agrees with stepping it one by one, for short
+// jumps, & that jumps compose, for jumps using any bit of `size_t`
+template<const size_t slen>
+static void
+test_jump()
+{
+  using namespace elephant;
+  constexpr size_t sbytes = slen >> 3;
+
+  uint8_t x[sbytes], y[sbytes];
+  random_data(x, sbytes);
+
+  std::memcpy(y, x, sbytes);
+  for (size_t i = 0; i < 3000; i++) {
+    lfsr_jump<slen>(x, 1);
+  }
+  lfsr_jump<slen>(y, 3000);
+
+  EXPECT_EQ(std::memcmp(x, y, sbytes), 0);
+
+  for (size_t k : { 40, 47, 48, 55, 60 }) {
+    const size_t steps = (1ul << k) + 12345;
+
+    std::memcpy(y, x, sbytes);
+    for (size_t i = 0; i < 8; i++) {
+      lfsr_jump<slen>(x, steps);
+    }
+    lfsr_jump<slen>(y, steps << 3);
+
+    EXPECT_EQ(std::memcmp(x, y, sbytes), 0);
+  }
+
+  std::memcpy(y, x, sbytes);
+  lfsr_jump<slen>(x, ~0ul);
+  lfsr_jump<slen>(x, 1);
+  lfsr_jump<slen>(y, 1ul << 63);
+  lfsr_jump<slen>(y, 1ul << 63);
+
+  EXPECT_EQ(std::memcmp(x, y, sbytes), 0);
+}
+
+TEST(Range, JumpDumbo)
+{
+  test_jump<160>();
+}
+
+TEST(Range, JumpJumbo)
+{
+  test_jump<176>();
+}
+
+TEST(Range, JumpDelirium)
+{
+  test_jump<200>();
+}
+
+// Checks that multi-threaded verification & byte range decryption agree with
+// reference ( KAT verified ) `encrypt`, for many # -of threads, & that ranges
+// not lying within cipher text are rejected
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_range()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::mt19937 gen(slen);
+
+  for (size_t ctlen : { 0, 1, 24, 25, 200, 4096 }) {
+    const size_t dlen = gen() % 64;
+
+    std::vector<uint8_t> key(16), nonce(12), data(dlen), txt(ctlen);
+    std::vector<uint8_t> enc(ctlen);
+    uint8_t tag[tbytes];
+
+    random_data(key.data(), key.size());
+    random_data(nonce.data(), nonce.size());
+    random_data(data.data(), dlen);
+    random_data(txt.data(), ctlen);
+
+    encrypt<slen, rounds, tlen>(key.data(),
+                                nonce.data(),
+                                data.data(),
+                                dlen,
+                                txt.data(),
+                                enc.data(),
+                                ctlen,
+                                tag);
+
+    const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+    for (size_t nthreads : { 1, 2, 3, 8 }) {
+      const size_t off = ctlen > 0 ? gen() % ctlen : 0;
+      const size_t len = ctlen > 0 ? gen() % (ctlen - off + 1) : 0;
+
+      std::vector<uint8_t> dec(len);
+
+      bool flg = decrypt_range<slen, rounds, tlen>(ctx,
+                                                   nonce.data(),
+                                                   tag,
+                                                   data.data(),
+                                                   dlen,
+                                                   enc.data(),
+                                                   ctlen,
+                                                   off,
+                                                   len,
+                                                   dec.data(),
+                                                   nthreads);
+
+      EXPECT_TRUE(flg);
+      EXPECT_TRUE(std::equal(dec.begin(), dec.end(), txt.begin() + off));
+
+      tag[0] ^= 1;
+      flg = verify<slen, rounds, tlen>(ctx,
+                                       nonce.data(),
+                                       tag,
+                                       data.data(),
+                                       dlen,
+                                       enc.data(),
+                                       ctlen,
+                                       nthreads);
+      tag[0] ^= 1;
+
+      EXPECT_FALSE(flg);
+    }
+
+    // ranges reaching past end of cipher text, including one whose end
+    // overflows, are rejected, leaving plain text buffer untouched
+    const size_t bad[][2] = { { ctlen, 1 }, { ctlen + 1, 0 }, { 1, ~0ul } };
+
+    for (const auto& r : bad) {
+      uint8_t dec[1] = { 0xff };
+
+      const bool flg = decrypt_range<slen, rounds, tlen>(ctx,
+                                                         nonce.data(),
+                                                         tag,
+                                                         data.data(),
+                                                         dlen,
+                                                         enc.data(),
+                                                         ctlen,
+                                                         r[0],
+                                                         r[1],
+                                                         dec);
+
+      EXPECT_FALSE(flg);
+      EXPECT_EQ(dec[0], 0xff);
+    }
+  }
+}
+
+TEST(Range, DumboMatchesEncrypt)
+{
+  test_range<160, 80, 64>();
+}
+
+TEST(Range, JumboMatchesEncrypt)
+{
+  test_range<176, 90, 64>();
+}
+
+TEST(Range, DeliriumMatchesEncrypt)
+{
+  test_range<200, 18, 128>();
+}
@@ -0,0 +1,153 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <gtest/gtest.h>
+#include <vector>
+
+// Splits N -bytes buffer into randomly sized ( possibly empty ) fragments
+template<typename iov_t>
+static std::vector<iov_t>
+split(uint8_t* const buf, const size_t len, std::mt19937& gen)
+{
+  std::vector<iov_t> iov;
+
+  size_t off = 0;
+  while (off < len) {
+    const size_t take = std::min<size_t>(len - off, gen() % 30);
+    iov.push_back({ buf + off, take });
+    off += take;
+  }
+  if (gen() & 1) {
+    iov.push_back({ buf + off, 0 });
+  }
+
+  return iov;
+}
+
+// Checks that scatter-gather {en, de}cryption, over randomly split associated
+// data, plain text & cipher text, agrees with contiguous `encrypt`, for many
+// associated data & plain text lengths, crossing block boundaries
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_iov()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::mt19937 gen(slen);
+
+  for (size_t dlen : { 0, 1, 7, 8, 9, 13, 20, 21, 40, 77 }) {
+    for (size_t ctlen : { 0, 1, 19, 20, 21, 22, 25, 64, 90 }) {
+      std::vector<uint8_t> key(16), nonce(12), data(dlen), txt(ctlen);
+      std::vector<uint8_t> enc(ctlen), encv(ctlen), decv(ctlen);
+      uint8_t tag[tbytes], tagv[tbytes];
+
+      random_data(key.data(), key.size());
+      random_data(nonce.data(), nonce.size());
+      random_data(data.data(), dlen);
+      random_data(txt.data(), ctlen);
+
+      encrypt<slen, rounds, tlen>(key.data(),
+                                  nonce.data(),
+                                  data.data(),
+                                  dlen,
+                                  txt.data(),
+                                  enc.data(),
+                                  ctlen,
+                                  tag);
+
+      const auto d = split<iovec_t>(data.data(), dlen, gen);
+      const auto t = split<iovec_t>(txt.data(), ctlen, gen);
+      const auto e = split<iovec_mut_t>(encv.data(), ctlen, gen);
+
+      encryptv<slen, rounds, tlen>(key.data(),
+                                   nonce.data(),
+                                   d.data(),
+                                   d.size(),
+                                   t.data(),
+                                   t.size(),
+                                   e.data(),
+                                   e.size(),
+                                   tagv);
+
+      EXPECT_EQ(enc, encv);
+      EXPECT_EQ(std::memcmp(tag, tagv, tbytes), 0);
+
+      const auto c = split<iovec_t>(enc.data(), ctlen, gen);
+      const auto p = split<iovec_mut_t>(decv.data(), ctlen, gen);
+
+      bool flg = decryptv<slen, rounds, tlen>(key.data(),
+                                              nonce.data(),
+                                              tag,
+                                              d.data(),
+                                              d.size(),
+                                              c.data(),
+                                              c.size(),
+                                              p.data(),
+                                              p.size());
+
+      EXPECT_TRUE(flg);
+      EXPECT_EQ(txt, decv);
+
+      tag[0] ^= 1;
+      flg = decryptv<slen, rounds, tlen>(key.data(),
+                                         nonce.data(),
+                                         tag,
+                                         d.data(),
+                                         d.size(),
+                                         c.data(),
+                                         c.size(),
+                                         p.data(),
+                                         p.size());
+
+      EXPECT_FALSE(flg);
+      EXPECT_EQ(decv, std::vector<uint8_t>(ctlen, 0));
+    }
+  }
+}
+
+TEST(ScatterGather, DumboMatchesEncrypt)
+{
+  test_iov<160, 80, 64>();
+}
+
+TEST(ScatterGather, JumboMatchesEncrypt)
+{
+  test_iov<176, 90, 64>();
+}
+
+TEST(ScatterGather, DeliriumMatchesEncrypt)
+{
+  test_iov<200, 18, 128>();
+}
+
+// Checks that mismatching total lengths of input & output fragments are
+// rejected, without touching output fragments beyond their bounds
+TEST(ScatterGather, LengthMismatch)
+{
+  uint8_t key[16]{}, nonce[12]{}, tag[8];
+  uint8_t txt[32]{}, enc[48];
+
+  const elephant::iovec_t t[]{ { txt, sizeof(txt) } };
+  const elephant::iovec_mut_t e[]{ { enc, 16 } };
+
+  std::memset(enc, 0xff, sizeof(enc));
+  std::memset(tag, 0xff, sizeof(tag));
+
+  dumbo::encryptv(key, nonce, nullptr, 0, t, 1, e, 1, tag);
+
+  EXPECT_EQ(std::vector<uint8_t>(tag, tag + 8), std::vector<uint8_t>(8, 0));
+  EXPECT_EQ(std::vector<uint8_t>(enc, enc + 48),
+            std::vector<uint8_t>(48, 0xff));
+
+  const elephant::iovec_t c[]{ { txt, sizeof(txt) } };
+  const elephant::iovec_mut_t p[]{ { enc, 16 } };
+
+  const bool flg = dumbo::decryptv(key, nonce, tag, nullptr, 0, c, 1, p, 1);
+
+  EXPECT_FALSE(flg);
+  EXPECT_EQ(std::vector<uint8_t>(enc, enc + 16), std::vector<uint8_t>(16, 0));
+  EXPECT_EQ(std::vector<uint8_t>(enc + 16, enc + 48),
+            std::vector<uint8_t>(32, 0xff));
+}
@@ -0,0 +1,138 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that sector API produces same cipher text & tags reference ( KAT
+// verified ) `encrypt` computes for each sector, that decryption ( both
+// out-of-place & in-place ) gives plain text back & that a tampered sector
+// gets zeroed & flagged, while rest of its lane group still decrypts
+template<const size_t slen,
+         const size_t rounds,
+         const size_t tlen,
+         const size_t lanes>
+static void
+test_sector(const size_t seclen, const size_t cnt, const size_t nthreads)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> key(16);
+  random_data(key.data(), key.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+  const sector_table_t<slen, rounds> tab(ctx, seclen);
+
+  std::vector<uint8_t> txt(seclen * cnt), enc(seclen * cnt);
+  std::vector<uint8_t> dec(seclen * cnt), tags(tbytes * cnt);
+  std::vector<uint32_t> gens(cnt);
+
+  random_data(txt.data(), txt.size());
+  random_data(reinterpret_cast<uint8_t*>(gens.data()), 4 * cnt);
+
+  const uint64_t first = 0x0123456789abcdeful;
+  const uint8_t data[1]{}; // empty associated data
+
+  encrypt_sectors<slen, rounds, tlen, lanes>(tab,
+                                             first,
+                                             gens.data(),
+                                             txt.data(),
+                                             enc.data(),
+                                             cnt,
+                                             tags.data(),
+                                             nthreads);
+
+  for (size_t s = 0; s < cnt; s++) {
+    uint8_t nonce[12];
+    std::vector<uint8_t> enc_(seclen), tag(tbytes);
+
+    sector_nonce(first + s, gens[s], nonce);
+    encrypt<slen, rounds, tlen>(ctx,
+                                nonce,
+                                data,
+                                0,
+                                txt.data() + s * seclen,
+                                enc_.data(),
+                                seclen,
+                                tag.data());
+
+    EXPECT_EQ(std::memcmp(enc_.data(), enc.data() + s * seclen, seclen), 0);
+    EXPECT_EQ(std::memcmp(tag.data(), tags.data() + s * tbytes, tbytes), 0);
+  }
+
+  std::unique_ptr<bool[]> ok(new bool[cnt + 1]);
+
+  auto open = [&](const uint8_t* in, uint8_t* out, bool* flgs = nullptr) {
+    return decrypt_sectors<slen, rounds, tlen, lanes>(
+      tab, first, gens.data(), tags.data(), in, out, cnt, nthreads, flgs);
+  };
+
+  bool flg = open(enc.data(), dec.data(), ok.get());
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(dec, txt);
+
+  auto buf = enc;
+  flg = open(buf.data(), buf.data());
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(buf, txt);
+
+  if (cnt < 3) {
+    return;
+  }
+
+  // tamper with sector 2 & fill output with a marker, which must survive
+  // nowhere but in sector 2, where it must be zeroed
+  enc[seclen * 2 + seclen / 2] ^= 1;
+  std::memset(dec.data(), 0xa5, dec.size());
+
+  flg = open(enc.data(), dec.data(), ok.get());
+  EXPECT_FALSE(flg);
+
+  for (size_t s = 0; s < cnt; s++) {
+    EXPECT_EQ(ok[s], s != 2);
+
+    for (size_t i = 0; i < seclen; i++) {
+      const uint8_t exp = (s == 2) ? 0 : txt[s * seclen + i];
+      EXPECT_EQ(dec[s * seclen + i], exp);
+    }
+  }
+
+  buf = enc;
+  flg = open(buf.data(), buf.data());
+  EXPECT_FALSE(flg);
+
+  for (size_t s = 0; s < cnt; s++) {
+    for (size_t i = 0; i < seclen; i++) {
+      const uint8_t exp = (s == 2) ? 0 : txt[s * seclen + i];
+      EXPECT_EQ(buf[s * seclen + i], exp);
+    }
+  }
+}
+
+TEST(Sector, DumboMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 3ul, 33ul, 70ul }) {
+    test_sector<160, 80, 64, 32>(512, cnt, 2);
+    test_sector<160, 80, 64, 8>(100, cnt, 1);
+  }
+}
+
+TEST(Sector, JumboMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 3ul, 33ul, 70ul }) {
+    test_sector<176, 90, 64, 32>(512, cnt, 2);
+    test_sector<176, 90, 64, 8>(100, cnt, 1);
+  }
+}
+
+TEST(Sector, DeliriumMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 3ul, 33ul, 70ul }) {
+    test_sector<200, 18, 128, 32>(4096, cnt, 3);
+    test_sector<200, 18, 128, 16>(199, cnt, 2);
+    test_sector<200, 18, 128, 32>(200, cnt, 1);
+  }
+}
@@ -0,0 +1,223 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <vector>
+
+// Checks that segmented stream, written in randomly sized pieces ( inline & on
+// thread pool ), is read back by `read_all`, while any flipped bit makes it
+// fail, & that reader rejects headers declaring too long segments, before
+// sizing any buffer off of them
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_segment()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::mt19937 gen(slen);
+  thread_pool_t pool(2);
+
+  std::vector<uint8_t> key(16), nonce(12);
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  for (size_t trial = 0; trial < 8; trial++) {
+    const uint32_t seg_len = 1 + gen() % 64;
+    const size_t len = gen() % 512;
+    thread_pool_t* const tp = (trial & 1) ? &pool : nullptr;
+
+    std::vector<uint8_t> txt(len), enc, dec;
+    random_data(txt.data(), len);
+
+    segment_writer_t<slen, rounds, tlen> wr(
+      ctx, nonce.data(), seg_len, [&](const uint8_t* buf, size_t n) {
+        enc.insert(enc.end(), buf, buf + n);
+        return true;
+      },
+      tp);
+
+    for (size_t off = 0; off < len;) {
+      const size_t take = std::min<size_t>(gen() % 100, len - off);
+      ASSERT_TRUE(wr.write(txt.data() + off, take));
+      off += take;
+    }
+    ASSERT_TRUE(wr.finish());
+
+    auto src = [&](uint64_t off, uint8_t* buf, size_t n) -> size_t {
+      if (off >= enc.size()) {
+        return 0;
+      }
+      n = std::min<size_t>(n, enc.size() - off);
+      std::memcpy(buf, enc.data() + off, n);
+      return n;
+    };
+    auto sink = [&](const uint8_t* buf, size_t n) {
+      dec.insert(dec.end(), buf, buf + n);
+      return true;
+    };
+
+    {
+      segment_reader_t<slen, rounds, tlen> rd(ctx, src, enc.size());
+      ASSERT_TRUE(rd.valid());
+      EXPECT_EQ(rd.plain_len(), len);
+      EXPECT_TRUE(rd.read_all(sink, tp));
+      EXPECT_EQ(dec, txt);
+    }
+
+    {
+      const size_t body = enc.size() - SEGMENT_HEADER_LEN;
+      const size_t pos = SEGMENT_HEADER_LEN + gen() % body;
+      enc[pos] ^= 1;
+
+      dec.clear();
+      segment_reader_t<slen, rounds, tlen> rd(ctx, src, enc.size());
+      EXPECT_FALSE(rd.valid() && rd.read_all(sink, tp));
+
+      enc[pos] ^= 1;
+    }
+
+    {
+      // segment length is accepted only up to caller's bound
+      segment_reader_t<slen, rounds, tlen> rd0(ctx, src, enc.size(), seg_len);
+      segment_reader_t<slen, rounds, tlen> rd1(
+        ctx, src, enc.size(), seg_len - 1);
+
+      EXPECT_TRUE(rd0.valid());
+      EXPECT_FALSE(rd1.valid());
+    }
+  }
+
+  // forged header, declaring segment length just past default bound, over a
+  // stream short enough that it'd otherwise be parsed as single segment
+  segment_header_t h;
+  h.sbytes = slen >> 3;
+  h.tbytes = tbytes;
+  h.seg_len = SEGMENT_MAX_LEN + 1;
+
+  std::vector<uint8_t> forged(SEGMENT_HEADER_LEN + tbytes);
+  h.encode(forged.data());
+
+  auto src = [&](uint64_t off, uint8_t* buf, size_t n) -> size_t {
+    n = std::min<size_t>(n, forged.size() - off);
+    std::memcpy(buf, forged.data() + off, n);
+    return n;
+  };
+
+  segment_reader_t<slen, rounds, tlen> rd(ctx, src, forged.size());
+  EXPECT_FALSE(rd.valid());
+  EXPECT_FALSE(rd.read_all([](const uint8_t*, size_t) { return true; }));
+
+  h.seg_len = SEGMENT_MAX_LEN;
+  h.encode(forged.data());
+
+  segment_reader_t<slen, rounds, tlen> rd_(ctx, src, forged.size());
+  EXPECT_TRUE(rd_.valid());
+}
+
+// Checks that explicitly given `depth`, smaller than pool derived default, is
+// honoured by both writer ( # -of segments handed over but not yet emitted to
+// sink ) & `read_all` ( # -of segments read before next one is emitted )
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_segment_depth()
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+  constexpr uint32_t seg_len = 16;
+  constexpr size_t seg_cnt = 32;
+
+  thread_pool_t pool(4);
+
+  std::vector<uint8_t> key(16), nonce(12);
+  random_data(key.data(), key.size());
+  random_data(nonce.data(), nonce.size());
+
+  const key_ctx_t<slen, rounds> ctx{ key.data() };
+
+  std::vector<uint8_t> txt(seg_len * seg_cnt), enc, dec;
+  random_data(txt.data(), txt.size());
+
+  for (size_t depth = 1; depth <= 3; depth++) {
+    enc.clear();
+    dec.clear();
+
+    segment_writer_t<slen, rounds, tlen> wr(
+      ctx, nonce.data(), seg_len, [&](const uint8_t* buf, size_t n) {
+        enc.insert(enc.end(), buf, buf + n);
+        return true;
+      },
+      &pool,
+      depth);
+
+    ASSERT_TRUE(wr.write(txt.data(), txt.size()));
+
+    // last segment is still being filled, while at most `depth` -many are in
+    // flight, so all others must've reached sink by now
+    const size_t emitted =
+      (enc.size() - SEGMENT_HEADER_LEN) / (seg_len + tbytes);
+    EXPECT_GE(emitted, seg_cnt - 1 - depth);
+
+    ASSERT_TRUE(wr.finish());
+
+    std::mutex mtx;
+    size_t pending = 0, max_pending = 0;
+
+    auto src = [&](uint64_t off, uint8_t* buf, size_t n) -> size_t {
+      if (off >= SEGMENT_HEADER_LEN) {
+        std::lock_guard<std::mutex> lock(mtx);
+        max_pending = std::max(max_pending, ++pending);
+      }
+
+      n = std::min<size_t>(n, enc.size() - off);
+      std::memcpy(buf, enc.data() + off, n);
+      return n;
+    };
+    auto sink = [&](const uint8_t* buf, size_t n) {
+      pending = 0;
+      dec.insert(dec.end(), buf, buf + n);
+      return true;
+    };
+
+    segment_reader_t<slen, rounds, tlen> rd(ctx, src, enc.size());
+    ASSERT_TRUE(rd.valid());
+    EXPECT_TRUE(rd.read_all(sink, &pool, depth));
+    EXPECT_EQ(dec, txt);
+    EXPECT_EQ(max_pending, depth);
+  }
+}
+
+TEST(Segment, DumboRoundTrip)
+{
+  test_segment<160, 80, 64>();
+}
+
+TEST(Segment, JumboRoundTrip)
+{
+  test_segment<176, 90, 64>();
+}
+
+TEST(Segment, DeliriumRoundTrip)
+{
+  test_segment<200, 18, 128>();
+}
+
+TEST(Segment, DumboHonoursDepth)
+{
+  test_segment_depth<160, 80, 64>();
+}
+
+TEST(Segment, JumboHonoursDepth)
+{
+  test_segment_depth<176, 90, 64>();
+}
+
+TEST(Segment, DeliriumHonoursDepth)
+{
+  test_segment_depth<200, 18, 128>();
+}
@@ -0,0 +1,240 @@
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "steal.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Checks that work-stealing executor, with records small enough to be grouped
+// through lanes, large enough to be split into block ranges & everything in
+// between, under a few keys, gives same cipher texts & tags reference ( KAT
+// verified ) `encrypt` computes, decrypts them back & flags ( & zeroes ) only
+// tampered ones; then runs another job, under fresh keys but same key
+// identifiers, which must not be served from workers' caches
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_executor(const size_t nthreads, const elephant::ws_opts_t opts)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+  constexpr size_t cnt = 60;
+
+  ws_executor_t<slen, rounds, tlen> ex(nthreads, opts);
+
+  for (size_t job = 0; job < 2; job++) {
+    std::vector<uint8_t> keys(16 * 3), nonces(12 * cnt);
+    random_data(keys.data(), keys.size());
+    random_data(nonces.data(), nonces.size());
+
+    std::vector<std::vector<uint8_t>> data(cnt), txt(cnt), enc(cnt), dec(cnt);
+    std::vector<std::vector<uint8_t>> ref(cnt), tags(cnt), rtags(cnt);
+    std::vector<ws_record_t> recs(cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      const size_t len = (i % 10 == 0) ? 5000 + i * 50 : (i * 37) % 400;
+      const size_t dlen = (i % 7 == 0) ? 1500 : i % 30;
+
+      data[i].resize(dlen);
+      txt[i].resize(len);
+      enc[i].resize(len);
+      dec[i].resize(len);
+      ref[i].resize(len);
+      tags[i].resize(tbytes);
+      rtags[i].resize(tbytes);
+
+      random_data(data[i].data(), dlen);
+      random_data(txt[i].data(), len);
+
+      const uint8_t* const key = keys.data() + 16 * (i % 3);
+      const uint8_t* const nonce = nonces.data() + 12 * i;
+
+      const key_ctx_t<slen, rounds> ctx{ key };
+      encrypt<slen, rounds, tlen>(ctx,
+                                  nonce,
+                                  data[i].data(),
+                                  dlen,
+                                  txt[i].data(),
+                                  ref[i].data(),
+                                  len,
+                                  rtags[i].data());
+
+      recs[i].key_id = i % 3;
+      recs[i].key = key;
+      recs[i].nonce = nonce;
+      recs[i].data = data[i].data();
+      recs[i].dlen = dlen;
+      recs[i].in = txt[i].data();
+      recs[i].out = enc[i].data();
+      recs[i].len = len;
+      recs[i].tag = tags[i].data();
+    }
+
+    ex.encrypt(recs.data(), cnt);
+
+    for (size_t i = 0; i < cnt; i++) {
+      EXPECT_EQ(enc[i], ref[i]);
+      EXPECT_EQ(tags[i], rtags[i]);
+
+      recs[i].in = enc[i].data();
+      recs[i].out = dec[i].data();
+    }
+
+    bool flg = ex.decrypt(recs.data(), cnt);
+    EXPECT_TRUE(flg);
+
+    for (size_t i = 0; i < cnt; i++) {
+      EXPECT_TRUE(recs[i].ok);
+      EXPECT_EQ(dec[i], txt[i]);
+    }
+
+    // a grouped, a single & a split record
+    for (const size_t i : { 1ul, 13ul, 20ul }) {
+      tags[i][0] ^= 1;
+    }
+
+    flg = ex.decrypt(recs.data(), cnt);
+    EXPECT_FALSE(flg);
+
+    for (size_t i = 0; i < cnt; i++) {
+      const bool bad = (i == 1) || (i == 13) || (i == 20);
+      const auto exp = bad ? std::vector<uint8_t>(dec[i].size(), 0) : txt[i];
+
+      EXPECT_EQ(recs[i].ok, !bad);
+      EXPECT_EQ(dec[i], exp);
+    }
+  }
+
+  const ws_stats_t st = ex.stats();
+  EXPECT_GT(st.parts, 0ul);
+  EXPECT_LE(st.lanes.fill_ratio(), 1.);
+}
+
+TEST(Steal, DumboMatchesEncrypt)
+{
+  test_executor<160, 80, 64>(3, { 256, 8, 1024, 2, false });
+  // zero cache slots must be treated as one, not divide by zero
+  test_executor<160, 80, 64>(2, { 256, 8, 1024, 0, false });
+}
+
+TEST(Steal, JumboMatchesEncrypt)
+{
+  test_executor<176, 90, 64>(3, { 256, 8, 1024, 64, false });
+}
+
+TEST(Steal, DeliriumMatchesEncrypt)
+{
+  test_executor<200, 18, 128>(1, { 256, 32, 2048, 1, false });
+  test_executor<200, 18, 128>(2, { 256, 32, 2048, 1, false });
+}
+
+// Checks that `{en, de}crypt_batch`, over records under a mix of repeated &
+// distinct keys, matches `encrypt` record by record, decrypts back & flags
+// only tampered record, zeroing its plain text
+template<const size_t slen, const size_t rounds, const size_t tlen>
+static void
+test_batch_records(const size_t cnt, const size_t dlen, const size_t ctlen)
+{
+  using namespace elephant;
+  constexpr size_t tbytes = tlen >> 3;
+
+  std::vector<uint8_t> keys(16 * cnt), nonces(12 * cnt), data(dlen * cnt);
+  std::vector<uint8_t> txt(ctlen * cnt), enc(ctlen * cnt), dec(ctlen * cnt);
+  std::vector<uint8_t> tags(tbytes * cnt);
+
+  random_data(keys.data(), keys.size());
+  random_data(nonces.data(), nonces.size());
+  random_data(data.data(), data.size());
+  random_data(txt.data(), txt.size());
+
+  // every third record reuses first key
+  for (size_t i = 0; i < cnt; i += 3) {
+    std::memcpy(keys.data() + 16 * i, keys.data(), 16);
+  }
+
+  encrypt_batch<slen, rounds, tlen>(keys.data(),
+                                    nonces.data(),
+                                    data.data(),
+                                    dlen,
+                                    txt.data(),
+                                    enc.data(),
+                                    ctlen,
+                                    tags.data(),
+                                    cnt);
+
+  for (size_t i = 0; i < cnt; i++) {
+    std::vector<uint8_t> enc_(ctlen), tag(tbytes);
+
+    const key_ctx_t<slen, rounds> ctx{ keys.data() + 16 * i };
+    encrypt<slen, rounds, tlen>(ctx,
+                                nonces.data() + 12 * i,
+                                data.data() + dlen * i,
+                                dlen,
+                                txt.data() + ctlen * i,
+                                enc_.data(),
+                                ctlen,
+                                tag.data());
+
+    EXPECT_EQ(std::memcmp(enc_.data(), enc.data() + ctlen * i, ctlen), 0);
+    EXPECT_EQ(std::memcmp(tag.data(), tags.data() + tbytes * i, tbytes), 0);
+  }
+
+  std::unique_ptr<bool[]> flags(new bool[cnt + 1]);
+
+  auto open = [&]() {
+    return decrypt_batch<slen, rounds, tlen>(keys.data(),
+                                             nonces.data(),
+                                             tags.data(),
+                                             data.data(),
+                                             dlen,
+                                             enc.data(),
+                                             dec.data(),
+                                             ctlen,
+                                             flags.get(),
+                                             cnt);
+  };
+
+  bool flg = open();
+  EXPECT_TRUE(flg);
+  EXPECT_EQ(dec, txt);
+
+  if (cnt < 2) {
+    return;
+  }
+
+  tags[tbytes] ^= 1;
+  flg = open();
+  EXPECT_FALSE(flg);
+
+  const std::vector<uint8_t> zeros(ctlen, 0);
+
+  for (size_t i = 0; i < cnt; i++) {
+    EXPECT_EQ(flags[i], i != 1);
+
+    const uint8_t* const exp = (i == 1) ? zeros.data() : &txt[ctlen * i];
+    EXPECT_EQ(std::memcmp(dec.data() + ctlen * i, exp, ctlen), 0);
+  }
+}
+
+TEST(Steal, DumboBatchMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 50ul }) {
+    test_batch_records<160, 80, 64>(cnt, 10, 100);
+  }
+}
+
+TEST(Steal, JumboBatchMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 50ul }) {
+    test_batch_records<176, 90, 64>(cnt, 0, 33);
+  }
+}
+
+TEST(Steal, DeliriumBatchMatchesEncrypt)
+{
+  for (const size_t cnt : { 0ul, 1ul, 50ul }) {
+    test_batch_records<200, 18, 128>(cnt, 7, 1000);
+  }
+  test_batch_records<200, 18, 128>(3, 0, 140000);
+}
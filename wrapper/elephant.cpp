@@ -1,12 +1,33 @@
 #include "delirium.hpp"
 #include "dumbo.hpp"
 #include "jumbo.hpp"
+#include "steal.hpp"
+#include <exception>
 
 // Thin C wrapper on top of underlying C++ implementation of Elephant
 // authenticated encryption with associated data ( Dumbo, Jumbo & Delirium ),
 // which can be used for producing shared library object with conformant C-ABI &
 // used from other languages such as Rust, Python
 
+// Opaque context handles, expanding secret key once ( see
+// `elephant::aead_ctx_t` ), created by `*_ctx_new` & destroyed, after zeroing
+// expanded key & mask table, by `*_ctx_free`; `*_ctx_new` returns NULL, when
+// `max_len` is above 16 MiB ( `max_table_len` ) or context can't be allocated
+struct dumbo_ctx_t : dumbo::aead_ctx_t
+{
+  using dumbo::aead_ctx_t::aead_ctx_t;
+};
+
+struct jumbo_ctx_t : jumbo::aead_ctx_t
+{
+  using jumbo::aead_ctx_t::aead_ctx_t;
+};
+
+struct delirium_ctx_t : delirium::aead_ctx_t
+{
+  using delirium::aead_ctx_t::aead_ctx_t;
+};
+
 // Function prototype
 extern "C"
 {
@@ -75,6 +96,195 @@ extern "C"
     uint8_t* const __restrict,       // M -bytes decrypted text
     const size_t // byte length of encrypted/ decrypted text = M | >= 0
   );
+
+  bool spongent160_permute_bulk(
+    uint8_t* const, // `cnt` -many 20 -bytes states, back to back
+    const size_t,   // # -of states = cnt | >= 0
+    const size_t,   // index of first round to apply
+    const size_t,   // # -of rounds to apply | first + rounds <= 80
+    const size_t    // # -of threads to use | > 0
+  );
+
+  bool spongent176_permute_bulk(
+    uint8_t* const, // `cnt` -many 22 -bytes states, back to back
+    const size_t,   // # -of states = cnt | >= 0
+    const size_t,   // index of first round to apply
+    const size_t,   // # -of rounds to apply | first + rounds <= 90
+    const size_t    // # -of threads to use | > 0
+  );
+
+  bool keccak200_permute_bulk(
+    uint8_t* const, // `cnt` -many 25 -bytes states, back to back
+    const size_t,   // # -of states = cnt | >= 0
+    const size_t,   // index of first round to apply
+    const size_t,   // # -of rounds to apply | first + rounds <= 18
+    const size_t    // # -of threads to use | > 0
+  );
+
+  void dumbo_encrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes encrypted texts
+    const size_t,             // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict, // `cnt` -many 64 -bit authentication tags
+    const size_t               // # -of records = cnt | >= 0
+  );
+
+  bool dumbo_decrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many 64 -bit tags
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes decrypted texts
+    const size_t,          // byte length of each encrypted text = M | >= 0
+    bool* const __restrict, // `cnt` -many verification flags
+    const size_t            // # -of records = cnt | >= 0
+  );
+
+  void jumbo_encrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes encrypted texts
+    const size_t,             // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict, // `cnt` -many 64 -bit authentication tags
+    const size_t               // # -of records = cnt | >= 0
+  );
+
+  bool jumbo_decrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many 64 -bit tags
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes decrypted texts
+    const size_t,          // byte length of each encrypted text = M | >= 0
+    bool* const __restrict, // `cnt` -many verification flags
+    const size_t            // # -of records = cnt | >= 0
+  );
+
+  void delirium_encrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes encrypted texts
+    const size_t,             // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict, // `cnt` -many 128 -bit authentication tags
+    const size_t               // # -of records = cnt | >= 0
+  );
+
+  bool delirium_decrypt_batch(
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict, // `cnt` -many 128 -bit tags
+    const uint8_t* const __restrict, // `cnt` -many N -bytes associated data
+    const size_t, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict,       // `cnt` -many M -bytes decrypted texts
+    const size_t,          // byte length of each encrypted text = M | >= 0
+    bool* const __restrict, // `cnt` -many verification flags
+    const size_t            // # -of records = cnt | >= 0
+  );
+  dumbo_ctx_t* dumbo_ctx_new(
+    const uint8_t* const, // 128 -bit secret key
+    const size_t // longest message, mask table is built for | 0 = no table
+  );
+
+  void dumbo_ctx_encrypt(
+    dumbo_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes plain text
+    uint8_t* const __restrict,       // M -bytes encrypted text
+    const size_t,             // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict // 64 -bit authentication tag
+  );
+
+  bool dumbo_ctx_decrypt(
+    dumbo_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // 64 -bit authentication tag
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes encrypted text
+    uint8_t* const __restrict,       // M -bytes decrypted text
+    const size_t // byte length of encrypted/ decrypted text = M | >= 0
+  );
+
+  void dumbo_ctx_free(dumbo_ctx_t* const // context handle
+  );
+
+  jumbo_ctx_t* jumbo_ctx_new(
+    const uint8_t* const, // 128 -bit secret key
+    const size_t // longest message, mask table is built for | 0 = no table
+  );
+
+  void jumbo_ctx_encrypt(
+    jumbo_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes plain text
+    uint8_t* const __restrict,       // M -bytes encrypted text
+    const size_t,             // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict // 64 -bit authentication tag
+  );
+
+  bool jumbo_ctx_decrypt(
+    jumbo_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // 64 -bit authentication tag
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes encrypted text
+    uint8_t* const __restrict,       // M -bytes decrypted text
+    const size_t // byte length of encrypted/ decrypted text = M | >= 0
+  );
+
+  void jumbo_ctx_free(jumbo_ctx_t* const // context handle
+  );
+
+  delirium_ctx_t* delirium_ctx_new(
+    const uint8_t* const, // 128 -bit secret key
+    const size_t // longest message, mask table is built for | 0 = no table
+  );
+
+  void delirium_ctx_encrypt(
+    delirium_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes plain text
+    uint8_t* const __restrict,       // M -bytes encrypted text
+    const size_t,             // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict // 128 -bit authentication tag
+  );
+
+  bool delirium_ctx_decrypt(
+    delirium_ctx_t* const,                // context handle
+    const uint8_t* const __restrict, // 96 -bit nonce
+    const uint8_t* const __restrict, // 128 -bit authentication tag
+    const uint8_t* const __restrict, // N -bytes associated data
+    const size_t, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict, // M -bytes encrypted text
+    uint8_t* const __restrict,       // M -bytes decrypted text
+    const size_t // byte length of encrypted/ decrypted text = M | >= 0
+  );
+
+  void delirium_ctx_free(delirium_ctx_t* const // context handle
+  );
+
 }
 
 // Function implementation
@@ -166,4 +376,284 @@ extern "C"
     using namespace delirium;
     return decrypt(key, nonce, tag, data, dlen, enc, txt, ctlen);
   }
+
+  bool spongent160_permute_bulk(
+    uint8_t* const states, // `cnt` -many 20 -bytes states, back to back
+    const size_t cnt,      // # -of states = cnt | >= 0
+    const size_t first,    // index of first round to apply
+    const size_t rounds,   // # -of rounds to apply | first + rounds <= 80
+    const size_t nthreads  // # -of threads to use | > 0
+  )
+  {
+    return dumbo::permute_bulk(states, cnt, first, rounds, nthreads);
+  }
+
+  bool spongent176_permute_bulk(
+    uint8_t* const states, // `cnt` -many 22 -bytes states, back to back
+    const size_t cnt,      // # -of states = cnt | >= 0
+    const size_t first,    // index of first round to apply
+    const size_t rounds,   // # -of rounds to apply | first + rounds <= 90
+    const size_t nthreads  // # -of threads to use | > 0
+  )
+  {
+    return jumbo::permute_bulk(states, cnt, first, rounds, nthreads);
+  }
+
+  bool keccak200_permute_bulk(
+    uint8_t* const states, // `cnt` -many 25 -bytes states, back to back
+    const size_t cnt,      // # -of states = cnt | >= 0
+    const size_t first,    // index of first round to apply
+    const size_t rounds,   // # -of rounds to apply | first + rounds <= 18
+    const size_t nthreads  // # -of threads to use | > 0
+  )
+  {
+    return delirium::permute_bulk(states, cnt, first, rounds, nthreads);
+  }
+
+  void dumbo_encrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict txt, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    const size_t ctlen, // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict tags, // `cnt` -many 64 -bit tags
+    const size_t cnt                // # -of records = cnt | >= 0
+  )
+  {
+    dumbo::encrypt_batch(keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+  }
+
+  bool dumbo_decrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict tags,   // `cnt` -many 64 -bit tags
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict txt, // `cnt` -many M -bytes decrypted texts
+    const size_t ctlen, // byte length of each encrypted text = M | >= 0
+    bool* const __restrict flags, // `cnt` -many verification flags
+    const size_t cnt              // # -of records = cnt | >= 0
+  )
+  {
+    return dumbo::decrypt_batch(
+      keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+  }
+
+  void jumbo_encrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict txt, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    const size_t ctlen, // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict tags, // `cnt` -many 64 -bit tags
+    const size_t cnt                // # -of records = cnt | >= 0
+  )
+  {
+    jumbo::encrypt_batch(keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+  }
+
+  bool jumbo_decrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict tags,   // `cnt` -many 64 -bit tags
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict txt, // `cnt` -many M -bytes decrypted texts
+    const size_t ctlen, // byte length of each encrypted text = M | >= 0
+    bool* const __restrict flags, // `cnt` -many verification flags
+    const size_t cnt              // # -of records = cnt | >= 0
+  )
+  {
+    return jumbo::decrypt_batch(
+      keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+  }
+
+  void delirium_encrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict txt, // `cnt` -many M -bytes plain texts
+    uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    const size_t ctlen, // byte length of each plain text = M | >= 0
+    uint8_t* const __restrict tags, // `cnt` -many 128 -bit tags
+    const size_t cnt                // # -of records = cnt | >= 0
+  )
+  {
+    delirium::encrypt_batch(
+      keys, nonces, data, dlen, txt, enc, ctlen, tags, cnt);
+  }
+
+  bool delirium_decrypt_batch(
+    const uint8_t* const __restrict keys,   // `cnt` -many 128 -bit secret keys
+    const uint8_t* const __restrict nonces, // `cnt` -many 96 -bit nonces
+    const uint8_t* const __restrict tags,   // `cnt` -many 128 -bit tags
+    const uint8_t* const __restrict data, // `cnt` -many N -bytes assoc. data
+    const size_t dlen, // byte length of each associated data = N | >= 0
+    const uint8_t* const __restrict enc, // `cnt` -many M -bytes encrypted texts
+    uint8_t* const __restrict txt, // `cnt` -many M -bytes decrypted texts
+    const size_t ctlen, // byte length of each encrypted text = M | >= 0
+    bool* const __restrict flags, // `cnt` -many verification flags
+    const size_t cnt              // # -of records = cnt | >= 0
+  )
+  {
+    return delirium::decrypt_batch(
+      keys, nonces, tags, data, dlen, enc, txt, ctlen, flags, cnt);
+  }
+
+  dumbo_ctx_t* dumbo_ctx_new(
+    const uint8_t* const key, // 128 -bit secret key
+    const size_t max_len // longest message, mask table is built for | 0 = none
+  )
+  {
+    if (max_len > dumbo_ctx_t::max_table_len) {
+      return nullptr;
+    }
+
+    try {
+      return new dumbo_ctx_t(key, max_len);
+    } catch (const std::exception&) {
+      return nullptr;
+    }
+  }
+
+  void dumbo_ctx_encrypt(
+    dumbo_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict txt, // M -bytes plain text
+    uint8_t* const __restrict enc,       // M -bytes encrypted text
+    const size_t ctlen, // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict tag // 64 -bit authentication tag
+  )
+  {
+    ctx->encrypt(nonce, data, dlen, txt, enc, ctlen, tag);
+  }
+
+  bool dumbo_ctx_decrypt(
+    dumbo_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict enc, // M -bytes encrypted text
+    uint8_t* const __restrict txt,       // M -bytes decrypted text
+    const size_t ctlen // byte length of encrypted/ decrypted text = M | >= 0
+  )
+  {
+    return ctx->decrypt(nonce, tag, data, dlen, enc, txt, ctlen);
+  }
+
+  void dumbo_ctx_free(dumbo_ctx_t* const ctx // context handle
+  )
+  {
+    delete ctx;
+  }
+
+  jumbo_ctx_t* jumbo_ctx_new(
+    const uint8_t* const key, // 128 -bit secret key
+    const size_t max_len // longest message, mask table is built for | 0 = none
+  )
+  {
+    if (max_len > jumbo_ctx_t::max_table_len) {
+      return nullptr;
+    }
+
+    try {
+      return new jumbo_ctx_t(key, max_len);
+    } catch (const std::exception&) {
+      return nullptr;
+    }
+  }
+
+  void jumbo_ctx_encrypt(
+    jumbo_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict txt, // M -bytes plain text
+    uint8_t* const __restrict enc,       // M -bytes encrypted text
+    const size_t ctlen, // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict tag // 64 -bit authentication tag
+  )
+  {
+    ctx->encrypt(nonce, data, dlen, txt, enc, ctlen, tag);
+  }
+
+  bool jumbo_ctx_decrypt(
+    jumbo_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict tag,   // 64 -bit authentication tag
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict enc, // M -bytes encrypted text
+    uint8_t* const __restrict txt,       // M -bytes decrypted text
+    const size_t ctlen // byte length of encrypted/ decrypted text = M | >= 0
+  )
+  {
+    return ctx->decrypt(nonce, tag, data, dlen, enc, txt, ctlen);
+  }
+
+  void jumbo_ctx_free(jumbo_ctx_t* const ctx // context handle
+  )
+  {
+    delete ctx;
+  }
+
+  delirium_ctx_t* delirium_ctx_new(
+    const uint8_t* const key, // 128 -bit secret key
+    const size_t max_len // longest message, mask table is built for | 0 = none
+  )
+  {
+    if (max_len > delirium_ctx_t::max_table_len) {
+      return nullptr;
+    }
+
+    try {
+      return new delirium_ctx_t(key, max_len);
+    } catch (const std::exception&) {
+      return nullptr;
+    }
+  }
+
+  void delirium_ctx_encrypt(
+    delirium_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict txt, // M -bytes plain text
+    uint8_t* const __restrict enc,       // M -bytes encrypted text
+    const size_t ctlen, // byte length of plain/ encrypted text = M | >= 0
+    uint8_t* const __restrict tag // 128 -bit authentication tag
+  )
+  {
+    ctx->encrypt(nonce, data, dlen, txt, enc, ctlen, tag);
+  }
+
+  bool delirium_ctx_decrypt(
+    delirium_ctx_t* const ctx,                  // context handle
+    const uint8_t* const __restrict nonce, // 96 -bit nonce
+    const uint8_t* const __restrict tag,   // 128 -bit authentication tag
+    const uint8_t* const __restrict data,  // N -bytes associated data
+    const size_t dlen, // byte length of associated data = N | >= 0
+    const uint8_t* const __restrict enc, // M -bytes encrypted text
+    uint8_t* const __restrict txt,       // M -bytes decrypted text
+    const size_t ctlen // byte length of encrypted/ decrypted text = M | >= 0
+  )
+  {
+    return ctx->decrypt(nonce, tag, data, dlen, enc, txt, ctlen);
+  }
+
+  void delirium_ctx_free(delirium_ctx_t* const ctx // context handle
+  )
+  {
+    delete ctx;
+  }
 }
@@ -0,0 +1,1431 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "bulk.hpp"
+#include "delirium.hpp"
+#include "dumbo.hpp"
+#include "jumbo.hpp"
+#include "steal.hpp"
+#include <exception>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+// Native CPython extension module over Elephant authenticated encryption with
+// associated data ( Dumbo, Jumbo & Delirium ), imported by `elephant.py`
+//
+// Inputs can be any object exporting contiguous buffer ( bytes, bytearray,
+// memoryview, numpy array etc. ), which is read in place, without copying,
+// while outputs are either written straight into freshly allocated bytes
+// objects or into caller provided writable buffers ( bytearray, memoryview
+// etc. ), passed as keyword arguments.
+namespace {
+
+// Contiguous view of a buffer protocol exporting object, released on scope
+// exit
+struct view_t
+{
+  Py_buffer buf{};
+  bool held = false;
+
+  view_t() = default;
+  view_t(const view_t&) = delete;
+  view_t& operator=(const view_t&) = delete;
+
+  ~view_t()
+  {
+    if (held) {
+      PyBuffer_Release(&buf);
+    }
+  }
+
+  // Acquires read-only ( or writable ) view, setting Python exception on
+  // failure
+  bool acquire(PyObject* const obj, const bool writable)
+  {
+    const int flags = writable ? PyBUF_WRITABLE : PyBUF_SIMPLE;
+    held = PyObject_GetBuffer(obj, &buf, flags) == 0;
+    return held;
+  }
+
+  inline uint8_t* ptr() const { return static_cast<uint8_t*>(buf.buf); }
+  inline size_t len() const { return static_cast<size_t>(buf.len); }
+};
+
+// Output buffer, either caller provided ( & returned back as is ) or freshly
+// allocated bytes object, which is written in place
+struct out_t
+{
+  PyObject* obj = nullptr; // new reference, handed over to caller by `take`
+  view_t view;
+  uint8_t* ptr = nullptr;
+
+  out_t() = default;
+  out_t(const out_t&) = delete;
+  out_t& operator=(const out_t&) = delete;
+
+  ~out_t() { Py_XDECREF(obj); }
+
+  // Sets up `len` -bytes output, from given object ( if not None ) or by
+  // allocating a bytes object
+  bool acquire(PyObject* const given, const size_t len, const char* const what)
+  {
+    if ((given == nullptr) || (given == Py_None)) {
+      obj = PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(len));
+      if (obj == nullptr) {
+        return false;
+      }
+
+      ptr = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(obj));
+      return true;
+    }
+
+    if (!view.acquire(given, true)) {
+      return false;
+    }
+    if (view.len() != len) {
+      PyErr_Format(PyExc_ValueError,
+                   "%s must be a writable buffer of %zu bytes, got %zu bytes",
+                   what,
+                   len,
+                   view.len());
+      return false;
+    }
+
+    Py_INCREF(given);
+    obj = given;
+    ptr = view.ptr();
+    return true;
+  }
+
+  // Hands over ( new reference to ) output object
+  PyObject* take()
+  {
+    PyObject* const o = obj;
+    obj = nullptr;
+    return o;
+  }
+};
+
+// Whether byte ranges [a, a + alen) & [b, b + blen) overlap
+inline bool
+overlaps(const uint8_t* const a,
+         const size_t alen,
+         const uint8_t* const b,
+         const size_t blen)
+{
+  return (alen > 0) && (blen > 0) && (a < b + blen) && (b < a + alen);
+}
+
+// Acquires read-only views of inputs, checking length of those with a fixed
+// one ( expected length > 0 )
+bool
+acquire_inputs(PyObject* const* const objs,
+               view_t* const views,
+               const size_t* const lens,
+               const char* const* const names,
+               const size_t cnt)
+{
+  for (size_t i = 0; i < cnt; i++) {
+    if (!views[i].acquire(objs[i], false)) {
+      return false;
+    }
+    if ((lens[i] > 0) && (views[i].len() != lens[i])) {
+      PyErr_Format(PyExc_ValueError,
+                   "%s must be %zu bytes, got %zu bytes",
+                   names[i],
+                   lens[i],
+                   views[i].len());
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Name of Elephant variant, with `slen` -bit permutation state
+template<const size_t slen>
+constexpr const char*
+variant_name()
+{
+  if constexpr (slen == 160) {
+    return "dumbo";
+  } else if constexpr (slen == 176) {
+    return "jumbo";
+  } else {
+    return "delirium";
+  }
+}
+
+// Name of permutation, with `slen` -bit state
+template<const size_t slen>
+constexpr const char*
+permutation_name()
+{
+  if constexpr (slen == 160) {
+    return "spongent160";
+  } else if constexpr (slen == 176) {
+    return "spongent176";
+  } else {
+    return "keccak200";
+  }
+}
+
+// Collects arguments of a vectorcall ( METH_FASTCALL | METH_KEYWORDS )
+// function `{prefix}{sep}{fname}`, taking `nreq` -many required & `nargs_ -
+// nreq` -many optional ones, into `out`; first `maxpos` -many can be passed
+// positionally, all of them by keyword, while optional ones not passed are
+// left as nullptr
+bool
+parse_args(const char* const prefix,
+           const char* const fname,
+           PyObject* const* const args,
+           const Py_ssize_t nargs,
+           PyObject* const kwnames,
+           const char* const* const names,
+           const size_t nreq,
+           const size_t maxpos,
+           const size_t nargs_,
+           PyObject** const out,
+           const char* const sep = "_")
+{
+  const size_t npos = static_cast<size_t>(nargs);
+  if (npos > maxpos) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s%s%s() takes at most %zu positional arguments "
+                 "( %zu given )",
+                 prefix,
+                 sep,
+                 fname,
+                 maxpos,
+                 npos);
+    return false;
+  }
+
+  for (size_t i = 0; i < nargs_; i++) {
+    out[i] = i < npos ? args[i] : nullptr;
+  }
+
+  const Py_ssize_t nkw = kwnames == nullptr ? 0 : PyTuple_GET_SIZE(kwnames);
+  for (Py_ssize_t k = 0; k < nkw; k++) {
+    PyObject* const kw = PyTuple_GET_ITEM(kwnames, k);
+
+    size_t i = 0;
+    while ((i < nargs_) && (PyUnicode_CompareWithASCIIString(kw, names[i]))) {
+      i++;
+    }
+
+    if (i == nargs_) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s%s%s() got an unexpected keyword argument '%U'",
+                   prefix,
+                   sep,
+                   fname,
+                   kw);
+      return false;
+    }
+    if (out[i] != nullptr) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s%s%s() got multiple values for argument '%s'",
+                   prefix,
+                   sep,
+                   fname,
+                   names[i]);
+      return false;
+    }
+
+    out[i] = args[npos + static_cast<size_t>(k)];
+  }
+
+  for (size_t i = 0; i < nreq; i++) {
+    if (out[i] == nullptr) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s%s%s() missing required argument '%s'",
+                   prefix,
+                   sep,
+                   fname,
+                   names[i]);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Sets up outputs for encrypting inputs `in` ( last one being plain text ),
+// into `oenc` & `otag`, when not None, checking that none of them overlap,
+// runs `seal(enc, tag)` & returns (cipher, tag)
+template<const size_t tlen, typename Seal>
+PyObject*
+seal_message(const view_t* const in,
+             const size_t nin,
+             PyObject* const oenc,
+             PyObject* const otag,
+             Seal&& seal)
+{
+  constexpr size_t tbytes = tlen >> 3;
+  const size_t ctlen = in[nin - 1].len();
+
+  out_t enc, tag;
+  if (!enc.acquire(oenc, ctlen, "out") || !tag.acquire(otag, tbytes, "tag")) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < nin; i++) {
+    if (overlaps(enc.ptr, ctlen, in[i].ptr(), in[i].len()) ||
+        overlaps(tag.ptr, tbytes, in[i].ptr(), in[i].len())) {
+      PyErr_SetString(PyExc_ValueError, "outputs must not overlap inputs");
+      return nullptr;
+    }
+  }
+  if (overlaps(enc.ptr, ctlen, tag.ptr, tbytes)) {
+    PyErr_SetString(PyExc_ValueError, "out & tag must not overlap");
+    return nullptr;
+  }
+
+  seal(enc.ptr, tag.ptr);
+
+  PyObject* const res = PyTuple_New(2);
+  if (res == nullptr) {
+    return nullptr;
+  }
+
+  PyTuple_SET_ITEM(res, 0, enc.take());
+  PyTuple_SET_ITEM(res, 1, tag.take());
+  return res;
+}
+
+// Sets up output for decrypting inputs `in` ( last one being cipher text ),
+// into `otxt`, when not None, checking that it doesn't overlap inputs, runs
+// `open(txt)` & returns (flag, text)
+template<typename Open>
+PyObject*
+open_message(const view_t* const in,
+             const size_t nin,
+             PyObject* const otxt,
+             Open&& open)
+{
+  const size_t ctlen = in[nin - 1].len();
+
+  out_t txt;
+  if (!txt.acquire(otxt, ctlen, "out")) {
+    return nullptr;
+  }
+
+  for (size_t i = 0; i < nin; i++) {
+    if (overlaps(txt.ptr, ctlen, in[i].ptr(), in[i].len())) {
+      PyErr_SetString(PyExc_ValueError, "outputs must not overlap inputs");
+      return nullptr;
+    }
+  }
+
+  const bool flag = open(txt.ptr);
+
+  PyObject* const res = PyTuple_New(2);
+  if (res == nullptr) {
+    return nullptr;
+  }
+
+  PyTuple_SET_ITEM(res, 0, PyBool_FromLong(flag));
+  PyTuple_SET_ITEM(res, 1, txt.take());
+  return res;
+}
+
+// encrypt(key, nonce, data, text, *, out=None, tag=None) -> (cipher, tag)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+aead_encrypt(PyObject*,
+             PyObject* const* const args,
+             const Py_ssize_t nargs,
+             PyObject* const kwnames)
+{
+  static const char* const names[]{ "key", "nonce", "data", "text",
+                                     "out", "tag" };
+
+  PyObject* objs[6];
+  const char* const prefix = variant_name<slen>();
+  if (!parse_args(
+        prefix, "encrypt", args, nargs, kwnames, names, 4, 4, 6, objs)) {
+    return nullptr;
+  }
+
+  view_t in[4];
+  constexpr size_t lens[]{ 16, 12, 0, 0 };
+  if (!acquire_inputs(objs, in, lens, names, 4)) {
+    return nullptr;
+  }
+
+  auto seal = [&](uint8_t* const enc, uint8_t* const tag) {
+    elephant::encrypt<slen, rounds, tlen>(in[0].ptr(),
+                                          in[1].ptr(),
+                                          in[2].ptr(),
+                                          in[2].len(),
+                                          in[3].ptr(),
+                                          enc,
+                                          in[3].len(),
+                                          tag);
+  };
+  return seal_message<tlen>(in, 4, objs[4], objs[5], seal);
+}
+
+// decrypt(key, nonce, tag, data, enc, *, out=None) -> (flag, text)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+aead_decrypt(PyObject*,
+             PyObject* const* const args,
+             const Py_ssize_t nargs,
+             PyObject* const kwnames)
+{
+  constexpr size_t tbytes = tlen >> 3;
+  static const char* const names[]{ "key", "nonce", "tag",
+                                     "data", "enc", "out" };
+
+  PyObject* objs[6];
+  const char* const prefix = variant_name<slen>();
+  if (!parse_args(
+        prefix, "decrypt", args, nargs, kwnames, names, 5, 5, 6, objs)) {
+    return nullptr;
+  }
+
+  view_t in[5];
+  constexpr size_t lens[]{ 16, 12, tbytes, 0, 0 };
+  if (!acquire_inputs(objs, in, lens, names, 5)) {
+    return nullptr;
+  }
+
+  auto open = [&](uint8_t* const txt) {
+    return elephant::decrypt<slen, rounds, tlen>(in[0].ptr(),
+                                                 in[1].ptr(),
+                                                 in[2].ptr(),
+                                                 in[3].ptr(),
+                                                 in[3].len(),
+                                                 in[4].ptr(),
+                                                 txt,
+                                                 in[4].len());
+  };
+  return open_message(in, 5, objs[5], open);
+}
+
+// Records of a batch argument, given either as a sequence of buffers ( of
+// any length, unless fixed ) or as a single C-contiguous 2-D buffer ( say
+// numpy array of shape (cnt, len) ), whose rows are records. Where allowed,
+// a single 1-D buffer ( or None, meaning empty ) is broadcast to all records.
+struct rows_t
+{
+  view_t whole;
+  std::unique_ptr<view_t[]> items;
+  size_t cnt = 0;
+  size_t width = 0;
+  bool stacked = false;
+  bool broadcast = false;
+
+  inline const uint8_t* ptr(const size_t i) const
+  {
+    if (!stacked) {
+      return items[i].ptr();
+    }
+    return whole.ptr() + (broadcast ? 0 : i * width);
+  }
+
+  inline size_t len(const size_t i) const
+  {
+    return stacked ? width : items[i].len();
+  }
+
+  // Acquires records, checking each is `fixed` -bytes ( if > 0 ) & that there
+  // are `expect` -many of them ( if > 0 ), setting Python exception on failure
+  bool acquire(PyObject* const obj,
+               const char* const name,
+               const size_t fixed,
+               const bool may_broadcast,
+               const size_t expect)
+  {
+    if (may_broadcast && (obj == Py_None)) {
+      stacked = broadcast = true;
+      return true;
+    }
+
+    if (PyObject_CheckBuffer(obj)) {
+      if (PyObject_GetBuffer(obj, &whole.buf, PyBUF_C_CONTIGUOUS) != 0) {
+        return false;
+      }
+      whole.held = true;
+
+      const Py_buffer& b = whole.buf;
+      if ((b.itemsize == 1) && (b.ndim == 2)) {
+        cnt = static_cast<size_t>(b.shape[0]);
+        width = static_cast<size_t>(b.shape[1]);
+      } else if ((b.ndim <= 1) && may_broadcast) {
+        cnt = 1;
+        width = whole.len();
+        broadcast = true;
+      } else {
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a sequence of buffers or a 2-D uint8 buffer",
+                     name);
+        return false;
+      }
+
+      stacked = true;
+      if ((fixed > 0) && (width != fixed)) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s must be %zu bytes each, got %zu bytes",
+                     name,
+                     fixed,
+                     width);
+        return false;
+      }
+    } else {
+      PyObject* const seq = PySequence_Fast(obj, "");
+      if (seq == nullptr) {
+        PyErr_Format(PyExc_TypeError,
+                     "%s must be a sequence of buffers or a 2-D uint8 buffer",
+                     name);
+        return false;
+      }
+
+      cnt = static_cast<size_t>(PySequence_Fast_GET_SIZE(seq));
+      items.reset(new view_t[cnt]);
+
+      PyObject** const elems = PySequence_Fast_ITEMS(seq);
+      for (size_t i = 0; i < cnt; i++) {
+        if (!items[i].acquire(elems[i], false)) {
+          Py_DECREF(seq);
+          return false;
+        }
+        if ((fixed > 0) && (items[i].len() != fixed)) {
+          PyErr_Format(PyExc_ValueError,
+                       "%s[%zu] must be %zu bytes, got %zu bytes",
+                       name,
+                       i,
+                       fixed,
+                       items[i].len());
+          Py_DECREF(seq);
+          return false;
+        }
+      }
+      Py_DECREF(seq);
+    }
+
+    if ((expect > 0) && !broadcast && (cnt != expect)) {
+      PyErr_Format(PyExc_ValueError,
+                   "%s must hold %zu records, got %zu",
+                   name,
+                   expect,
+                   cnt);
+      return false;
+    }
+    return true;
+  }
+};
+
+// Output records of a batch, either rows of a freshly allocated 2-D numpy
+// array ( when inputs were stacked ) or a list of freshly allocated bytes
+struct out_rows_t
+{
+  PyObject* obj = nullptr; // new reference, handed over to caller by `take`
+  view_t view;
+  std::vector<uint8_t*> ptrs;
+
+  out_rows_t() = default;
+  out_rows_t(const out_rows_t&) = delete;
+  out_rows_t& operator=(const out_rows_t&) = delete;
+
+  ~out_rows_t() { Py_XDECREF(obj); }
+
+  bool acquire(const rows_t& in);
+
+  PyObject* take()
+  {
+    PyObject* const o = obj;
+    obj = nullptr;
+    return o;
+  }
+};
+
+// Calls `numpy.empty(shape, dtype=dtype)`, importing numpy on first use
+PyObject*
+numpy_empty(PyObject* const shape, const char* const dtype)
+{
+  static PyObject* empty = nullptr; // guarded by GIL
+
+  if (empty == nullptr) {
+    PyObject* const np = PyImport_ImportModule("numpy");
+    if (np == nullptr) {
+      return nullptr;
+    }
+
+    empty = PyObject_GetAttrString(np, "empty");
+    Py_DECREF(np);
+    if (empty == nullptr) {
+      return nullptr;
+    }
+  }
+
+  PyObject* const args = PyTuple_Pack(1, shape);
+  PyObject* const kwargs = Py_BuildValue("{s:s}", "dtype", dtype);
+
+  PyObject* arr = nullptr;
+  if ((args != nullptr) && (kwargs != nullptr)) {
+    arr = PyObject_Call(empty, args, kwargs);
+  }
+
+  Py_XDECREF(args);
+  Py_XDECREF(kwargs);
+  return arr;
+}
+
+// Allocates numpy array of shape (rows, cols) ( or (rows,), if cols = 0 ) &
+// acquires writable view of it
+PyObject*
+numpy_array(const size_t rows,
+            const size_t cols,
+            const char* const dtype,
+            view_t& view)
+{
+  PyObject* const shape = cols == 0 ? Py_BuildValue("(n)", rows)
+                                    : Py_BuildValue("(nn)", rows, cols);
+  if (shape == nullptr) {
+    return nullptr;
+  }
+
+  PyObject* const arr = numpy_empty(shape, dtype);
+  Py_DECREF(shape);
+
+  if ((arr != nullptr) && !view.acquire(arr, true)) {
+    Py_DECREF(arr);
+    return nullptr;
+  }
+  return arr;
+}
+
+bool
+out_rows_t::acquire(const rows_t& in)
+{
+  ptrs.resize(in.cnt);
+
+  if (in.stacked) {
+    obj = numpy_array(in.cnt, in.width, "uint8", view);
+    if (obj == nullptr) {
+      return false;
+    }
+
+    for (size_t i = 0; i < in.cnt; i++) {
+      ptrs[i] = view.ptr() + i * in.width;
+    }
+    return true;
+  }
+
+  obj = PyList_New(static_cast<Py_ssize_t>(in.cnt));
+  if (obj == nullptr) {
+    return false;
+  }
+
+  for (size_t i = 0; i < in.cnt; i++) {
+    PyObject* const b =
+      PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(in.len(i)));
+    if (b == nullptr) {
+      return false;
+    }
+
+    PyList_SET_ITEM(obj, static_cast<Py_ssize_t>(i), b);
+    ptrs[i] = reinterpret_cast<uint8_t*>(PyBytes_AS_STRING(b));
+  }
+  return true;
+}
+
+// encrypt_batch(keys, nonces, data, texts) -> (ciphers, tags)
+//
+// Records are {en, de}crypted on process wide work-stealing executor, with
+// GIL released.
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+aead_encrypt_batch(PyObject*,
+                   PyObject* const* const args,
+                   const Py_ssize_t nargs,
+                   PyObject* const kwnames)
+{
+  constexpr size_t tbytes = tlen >> 3;
+  static const char* const names[]{ "keys", "nonces", "data", "texts" };
+
+  PyObject* objs[4];
+  const char* const prefix = variant_name<slen>();
+  if (!parse_args(
+        prefix, "encrypt_batch", args, nargs, kwnames, names, 4, 4, 4, objs)) {
+    return nullptr;
+  }
+
+  rows_t txt, keys, nonces, data;
+  if (!txt.acquire(objs[3], "texts", 0, false, 0)) {
+    return nullptr;
+  }
+
+  const size_t cnt = txt.cnt;
+  if (!keys.acquire(objs[0], "keys", 16, true, cnt) ||
+      !nonces.acquire(objs[1], "nonces", 12, false, cnt) ||
+      !data.acquire(objs[2], "data", 0, true, cnt)) {
+    return nullptr;
+  }
+
+  out_rows_t enc;
+  if (!enc.acquire(txt)) {
+    return nullptr;
+  }
+
+  view_t tview;
+  PyObject* const tags = numpy_array(cnt, tbytes, "uint8", tview);
+  if (tags == nullptr) {
+    return nullptr;
+  }
+
+  std::vector<elephant::ws_record_t> recs(cnt);
+  for (size_t i = 0; i < cnt; i++) {
+    recs[i].key = keys.ptr(i);
+    recs[i].nonce = nonces.ptr(i);
+    recs[i].data = data.ptr(i);
+    recs[i].dlen = data.len(i);
+    recs[i].in = txt.ptr(i);
+    recs[i].out = enc.ptrs[i];
+    recs[i].len = txt.len(i);
+    recs[i].tag = tview.ptr() + i * tbytes;
+  }
+
+  Py_BEGIN_ALLOW_THREADS;
+  elephant::assign_key_ids(recs.data(), cnt);
+  elephant::default_ws_executor<slen, rounds, tlen>().encrypt(recs.data(), cnt);
+  Py_END_ALLOW_THREADS;
+
+  return Py_BuildValue("(NN)", enc.take(), tags);
+}
+
+// decrypt_batch(keys, nonces, tags, data, ciphers) -> (flags, texts)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+aead_decrypt_batch(PyObject*,
+                   PyObject* const* const args,
+                   const Py_ssize_t nargs,
+                   PyObject* const kwnames)
+{
+  constexpr size_t tbytes = tlen >> 3;
+  static const char* const names[]{
+    "keys", "nonces", "tags", "data", "ciphers"
+  };
+
+  PyObject* objs[5];
+  const char* const prefix = variant_name<slen>();
+  if (!parse_args(
+        prefix, "decrypt_batch", args, nargs, kwnames, names, 5, 5, 5, objs)) {
+    return nullptr;
+  }
+
+  rows_t enc, keys, nonces, tags, data;
+  if (!enc.acquire(objs[4], "ciphers", 0, false, 0)) {
+    return nullptr;
+  }
+
+  const size_t cnt = enc.cnt;
+  if (!keys.acquire(objs[0], "keys", 16, true, cnt) ||
+      !nonces.acquire(objs[1], "nonces", 12, false, cnt) ||
+      !tags.acquire(objs[2], "tags", tbytes, false, cnt) ||
+      !data.acquire(objs[3], "data", 0, true, cnt)) {
+    return nullptr;
+  }
+
+  out_rows_t txt;
+  if (!txt.acquire(enc)) {
+    return nullptr;
+  }
+
+  view_t fview;
+  PyObject* const flags = numpy_array(cnt, 0, "bool", fview);
+  if (flags == nullptr) {
+    return nullptr;
+  }
+
+  std::vector<elephant::ws_record_t> recs(cnt);
+  for (size_t i = 0; i < cnt; i++) {
+    recs[i].key = keys.ptr(i);
+    recs[i].nonce = nonces.ptr(i);
+    recs[i].data = data.ptr(i);
+    recs[i].dlen = data.len(i);
+    recs[i].in = enc.ptr(i);
+    recs[i].out = txt.ptrs[i];
+    recs[i].len = enc.len(i);
+    recs[i].tag = const_cast<uint8_t*>(tags.ptr(i));
+  }
+
+  Py_BEGIN_ALLOW_THREADS;
+  elephant::assign_key_ids(recs.data(), cnt);
+  elephant::default_ws_executor<slen, rounds, tlen>().decrypt(recs.data(), cnt);
+
+  for (size_t i = 0; i < cnt; i++) {
+    fview.ptr()[i] = recs[i].ok;
+  }
+  Py_END_ALLOW_THREADS;
+
+  return Py_BuildValue("(NN)", flags, txt.take());
+}
+
+// Reads optional non-negative integer argument, falling back to `def`
+bool
+size_arg(PyObject* const obj, const size_t def, size_t& val)
+{
+  if ((obj == nullptr) || (obj == Py_None)) {
+    val = def;
+    return true;
+  }
+
+  val = PyLong_AsSize_t(obj);
+  return !PyErr_Occurred();
+}
+
+// permute_bulk(states, first=0, rounds=None, nthreads=1, *, out=None) ->
+// states
+//
+// Rounds default to all rounds left after `first`. Output may be same buffer
+// as input, in which case states are permuted in place.
+template<const size_t slen>
+PyObject*
+permute_bulk(PyObject*,
+             PyObject* const* const args,
+             const Py_ssize_t nargs,
+             PyObject* const kwnames)
+{
+  constexpr size_t sbytes = slen >> 3;
+  constexpr size_t rmax = elephant::max_rounds<slen>();
+  static const char* const names[]{ "states", "first", "rounds",
+                                     "nthreads", "out" };
+
+  PyObject* objs[5];
+  const char* const prefix = permutation_name<slen>();
+  if (!parse_args(
+        prefix, "permute_bulk", args, nargs, kwnames, names, 1, 4, 5, objs)) {
+    return nullptr;
+  }
+
+  size_t first = 0, rounds = 0, nthreads = 0;
+  if (!size_arg(objs[1], 0, first) ||
+      !size_arg(objs[2], first <= rmax ? rmax - first : 0, rounds) ||
+      !size_arg(objs[3], 1, nthreads)) {
+    return nullptr;
+  }
+
+  if ((first > rmax) || (rounds > rmax - first)) {
+    PyErr_Format(PyExc_ValueError,
+                 "first + rounds must be at most %zu, got %zu + %zu",
+                 rmax,
+                 first,
+                 rounds);
+    return nullptr;
+  }
+  if (nthreads == 0) {
+    PyErr_SetString(PyExc_ValueError, "nthreads must be positive");
+    return nullptr;
+  }
+
+  view_t in;
+  if (!in.acquire(objs[0], false)) {
+    return nullptr;
+  }
+  if (in.len() % sbytes != 0) {
+    PyErr_Format(PyExc_ValueError,
+                 "states must be a multiple of %zu bytes, got %zu bytes",
+                 sbytes,
+                 in.len());
+    return nullptr;
+  }
+
+  out_t out;
+  if (!out.acquire(objs[4], in.len(), "out")) {
+    return nullptr;
+  }
+
+  Py_BEGIN_ALLOW_THREADS;
+  std::memmove(out.ptr, in.ptr(), in.len());
+  elephant::permute_bulk<slen>(
+    out.ptr, in.len() / sbytes, first, rounds, nthreads);
+  Py_END_ALLOW_THREADS;
+
+  return out.take();
+}
+
+// Casts vectorcall function to generic method pointer, as method table wants
+template<typename F>
+PyCFunction
+method(F f)
+{
+  return reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(f));
+}
+
+constexpr int FASTCALL = METH_FASTCALL | METH_KEYWORDS;
+
+PyDoc_STRVAR(
+  dumbo_encrypt_doc,
+  "dumbo_encrypt(key, nonce, data, text, *, out=None, tag=None)\n--\n\n"
+  "Encrypts M ( >=0 ) -bytes plain text, with Dumbo AEAD, while using 16\n"
+  "-bytes secret key, 12 -bytes public message nonce & N ( >=0 ) -bytes\n"
+  "associated data, while producing M -bytes cipher text & 8 -bytes\n"
+  "authentication tag ( in order ), written into `out` & `tag`, when given");
+
+PyDoc_STRVAR(
+  dumbo_decrypt_doc,
+  "dumbo_decrypt(key, nonce, tag, data, enc, *, out=None)\n--\n\n"
+  "Decrypts M ( >=0 ) -bytes cipher text, with Dumbo AEAD, while using 16\n"
+  "-bytes secret key, 12 -bytes public message nonce, 8 -bytes\n"
+  "authentication tag & N ( >=0 ) -bytes associated data, while producing\n"
+  "boolean verification flag & M -bytes plain text ( in order ), written\n"
+  "into `out`, when given; plain text is zeroed, if verification fails");
+
+PyDoc_STRVAR(
+  jumbo_encrypt_doc,
+  "jumbo_encrypt(key, nonce, data, text, *, out=None, tag=None)\n--\n\n"
+  "Encrypts M ( >=0 ) -bytes plain text, with Jumbo AEAD, while using 16\n"
+  "-bytes secret key, 12 -bytes public message nonce & N ( >=0 ) -bytes\n"
+  "associated data, while producing M -bytes cipher text & 8 -bytes\n"
+  "authentication tag ( in order ), written into `out` & `tag`, when given");
+
+PyDoc_STRVAR(
+  jumbo_decrypt_doc,
+  "jumbo_decrypt(key, nonce, tag, data, enc, *, out=None)\n--\n\n"
+  "Decrypts M ( >=0 ) -bytes cipher text, with Jumbo AEAD, while using 16\n"
+  "-bytes secret key, 12 -bytes public message nonce, 8 -bytes\n"
+  "authentication tag & N ( >=0 ) -bytes associated data, while producing\n"
+  "boolean verification flag & M -bytes plain text ( in order ), written\n"
+  "into `out`, when given; plain text is zeroed, if verification fails");
+
+PyDoc_STRVAR(
+  delirium_encrypt_doc,
+  "delirium_encrypt(key, nonce, data, text, *, out=None, tag=None)\n--\n\n"
+  "Encrypts M ( >=0 ) -bytes plain text, with Delirium AEAD, while using 16\n"
+  "-bytes secret key, 12 -bytes public message nonce & N ( >=0 ) -bytes\n"
+  "associated data, while producing M -bytes cipher text & 16 -bytes\n"
+  "authentication tag ( in order ), written into `out` & `tag`, when given");
+
+PyDoc_STRVAR(
+  delirium_decrypt_doc,
+  "delirium_decrypt(key, nonce, tag, data, enc, *, out=None)\n--\n\n"
+  "Decrypts M ( >=0 ) -bytes cipher text, with Delirium AEAD, while using\n"
+  "16 -bytes secret key, 12 -bytes public message nonce, 16 -bytes\n"
+  "authentication tag & N ( >=0 ) -bytes associated data, while producing\n"
+  "boolean verification flag & M -bytes plain text ( in order ), written\n"
+  "into `out`, when given; plain text is zeroed, if verification fails");
+
+PyDoc_STRVAR(
+  spongent160_permute_bulk_doc,
+  "spongent160_permute_bulk(states, first=0, rounds=None, nthreads=1, *, "
+  "out=None)\n--\n\n"
+  "Applies `rounds` -many ( by default, all remaining ) rounds of\n"
+  "Spongent-pi[160] permutation, starting from round `first`, on each of\n"
+  "20 -bytes states, concatenated in `states`, using `nthreads` -many\n"
+  "threads, returning permuted states | first + rounds <= 80");
+
+PyDoc_STRVAR(
+  spongent176_permute_bulk_doc,
+  "spongent176_permute_bulk(states, first=0, rounds=None, nthreads=1, *, "
+  "out=None)\n--\n\n"
+  "Applies `rounds` -many ( by default, all remaining ) rounds of\n"
+  "Spongent-pi[176] permutation, starting from round `first`, on each of\n"
+  "22 -bytes states, concatenated in `states`, using `nthreads` -many\n"
+  "threads, returning permuted states | first + rounds <= 90");
+
+PyDoc_STRVAR(
+  keccak200_permute_bulk_doc,
+  "keccak200_permute_bulk(states, first=0, rounds=None, nthreads=1, *, "
+  "out=None)\n--\n\n"
+  "Applies `rounds` -many ( by default, all remaining ) rounds of\n"
+  "Keccak-f[200] permutation, starting from round `first`, on each of 25\n"
+  "-bytes states, concatenated in `states`, using `nthreads` -many threads,\n"
+  "returning permuted states | first + rounds <= 18");
+
+PyDoc_STRVAR(
+  dumbo_encrypt_batch_doc,
+  "dumbo_encrypt_batch(keys, nonces, data, texts)\n--\n\n"
+  "Encrypts many records, with Dumbo AEAD, crossing into native code once &\n"
+  "releasing GIL meanwhile. Each argument is either a sequence of buffers\n"
+  "or a 2-D uint8 array, with one record per row, while `keys` & `data`\n"
+  "may also be a single buffer ( or None, for `data` ), shared by all\n"
+  "records. Returns cipher texts ( 2-D array, if texts were, else list of\n"
+  "bytes ) & 8 -bytes tags, as 2-D uint8 array ( in order )");
+
+PyDoc_STRVAR(
+  dumbo_decrypt_batch_doc,
+  "dumbo_decrypt_batch(keys, nonces, tags, data, ciphers)\n--\n\n"
+  "Verifies & decrypts many records, with Dumbo AEAD, crossing into native\n"
+  "code once & releasing GIL meanwhile, taking arguments just like\n"
+  "`dumbo_encrypt_batch`. Returns verification flags, as bool array, & plain\n"
+  "texts ( 2-D array, if cipher texts were, else list of bytes ), where\n"
+  "plain text of each record failing verification is zeroed ( in order )");
+
+PyDoc_STRVAR(
+  jumbo_encrypt_batch_doc,
+  "jumbo_encrypt_batch(keys, nonces, data, texts)\n--\n\n"
+  "Encrypts many records, with Jumbo AEAD, crossing into native code once &\n"
+  "releasing GIL meanwhile. Each argument is either a sequence of buffers\n"
+  "or a 2-D uint8 array, with one record per row, while `keys` & `data`\n"
+  "may also be a single buffer ( or None, for `data` ), shared by all\n"
+  "records. Returns cipher texts ( 2-D array, if texts were, else list of\n"
+  "bytes ) & 8 -bytes tags, as 2-D uint8 array ( in order )");
+
+PyDoc_STRVAR(
+  jumbo_decrypt_batch_doc,
+  "jumbo_decrypt_batch(keys, nonces, tags, data, ciphers)\n--\n\n"
+  "Verifies & decrypts many records, with Jumbo AEAD, crossing into native\n"
+  "code once & releasing GIL meanwhile, taking arguments just like\n"
+  "`jumbo_encrypt_batch`. Returns verification flags, as bool array, & plain\n"
+  "texts ( 2-D array, if cipher texts were, else list of bytes ), where\n"
+  "plain text of each record failing verification is zeroed ( in order )");
+
+PyDoc_STRVAR(
+  delirium_encrypt_batch_doc,
+  "delirium_encrypt_batch(keys, nonces, data, texts)\n--\n\n"
+  "Encrypts many records, with Delirium AEAD, crossing into native code\n"
+  "once & releasing GIL meanwhile. Each argument is either a sequence of\n"
+  "buffers or a 2-D uint8 array, with one record per row, while `keys` &\n"
+  "`data` may also be a single buffer ( or None, for `data` ), shared by\n"
+  "all records. Returns cipher texts ( 2-D array, if texts were, else list\n"
+  "of bytes ) & 16 -bytes tags, as 2-D uint8 array ( in order )");
+
+PyDoc_STRVAR(
+  delirium_decrypt_batch_doc,
+  "delirium_decrypt_batch(keys, nonces, tags, data, ciphers)\n--\n\n"
+  "Verifies & decrypts many records, with Delirium AEAD, crossing into native\n"
+  "code once & releasing GIL meanwhile, taking arguments just like\n"
+  "`delirium_encrypt_batch`. Returns verification flags, as bool array, &\n"
+  "plain texts ( 2-D array, if cipher texts were, else list of bytes ),\n"
+  "where plain text of each record failing verification is zeroed ( in\n"
+  "order )");
+
+PyMethodDef methods[]{
+  { "dumbo_encrypt",
+    method(aead_encrypt<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>),
+    FASTCALL,
+    dumbo_encrypt_doc },
+  { "dumbo_decrypt",
+    method(aead_decrypt<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>),
+    FASTCALL,
+    dumbo_decrypt_doc },
+  { "jumbo_encrypt",
+    method(aead_encrypt<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>),
+    FASTCALL,
+    jumbo_encrypt_doc },
+  { "jumbo_decrypt",
+    method(aead_decrypt<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>),
+    FASTCALL,
+    jumbo_decrypt_doc },
+  { "delirium_encrypt",
+    method(aead_encrypt<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>),
+    FASTCALL,
+    delirium_encrypt_doc },
+  { "delirium_decrypt",
+    method(aead_decrypt<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>),
+    FASTCALL,
+    delirium_decrypt_doc },
+  { "spongent160_permute_bulk",
+    method(permute_bulk<160>),
+    FASTCALL,
+    spongent160_permute_bulk_doc },
+  { "spongent176_permute_bulk",
+    method(permute_bulk<176>),
+    FASTCALL,
+    spongent176_permute_bulk_doc },
+  { "keccak200_permute_bulk",
+    method(permute_bulk<200>),
+    FASTCALL,
+    keccak200_permute_bulk_doc },
+  { "dumbo_encrypt_batch",
+    method(aead_encrypt_batch<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>),
+    FASTCALL,
+    dumbo_encrypt_batch_doc },
+  { "dumbo_decrypt_batch",
+    method(aead_decrypt_batch<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>),
+    FASTCALL,
+    dumbo_decrypt_batch_doc },
+  { "jumbo_encrypt_batch",
+    method(aead_encrypt_batch<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>),
+    FASTCALL,
+    jumbo_encrypt_batch_doc },
+  { "jumbo_decrypt_batch",
+    method(aead_decrypt_batch<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>),
+    FASTCALL,
+    jumbo_decrypt_batch_doc },
+  { "delirium_encrypt_batch",
+    method(
+      aead_encrypt_batch<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>),
+    FASTCALL,
+    delirium_encrypt_batch_doc },
+  { "delirium_decrypt_batch",
+    method(
+      aead_decrypt_batch<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>),
+    FASTCALL,
+    delirium_decrypt_batch_doc },
+  { nullptr, nullptr, 0, nullptr }
+};
+
+// Name of Python class wrapping AEAD context of Elephant variant, with
+// `slen` -bit permutation state
+template<const size_t slen>
+constexpr const char*
+context_name()
+{
+  if constexpr (slen == 160) {
+    return "DumboContext";
+  } else if constexpr (slen == 176) {
+    return "JumboContext";
+  } else {
+    return "DeliriumContext";
+  }
+}
+
+// Context object, owning AEAD context ( see `elephant::aead_ctx_t` ) until
+// closed, after which its expanded key & mask table are already zeroed
+template<const size_t slen, const size_t rounds, const size_t tlen>
+struct context_t
+{
+  PyObject_HEAD
+  elephant::aead_ctx_t<slen, rounds, tlen>* ctx;
+};
+
+// Context of object, setting Python exception, if it's closed
+template<const size_t slen, const size_t rounds, const size_t tlen>
+elephant::aead_ctx_t<slen, rounds, tlen>*
+context_of(PyObject* const self)
+{
+  auto* const obj = reinterpret_cast<context_t<slen, rounds, tlen>*>(self);
+  if (obj->ctx == nullptr) {
+    PyErr_Format(
+      PyExc_ValueError, "%s is already closed", context_name<slen>());
+  }
+  return obj->ctx;
+}
+
+// Context(key, max_len=0), expanding key once & building mask table for
+// messages of up to `max_len` -bytes, when it's positive
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_new(PyTypeObject* const type, PyObject* const args, PyObject* const kw)
+{
+  using ctx_t = elephant::aead_ctx_t<slen, rounds, tlen>;
+
+  static const char* const names[]{ "key", "max_len", nullptr };
+  static const std::string fmt = std::string("O|n:") + context_name<slen>();
+
+  PyObject* key = nullptr;
+  Py_ssize_t max_len = 0;
+  if (!PyArg_ParseTupleAndKeywords(
+        args, kw, fmt.c_str(), const_cast<char**>(names), &key, &max_len)) {
+    return nullptr;
+  }
+  if ((max_len < 0) ||
+      (static_cast<size_t>(max_len) > ctx_t::max_table_len)) {
+    PyErr_Format(PyExc_ValueError,
+                 "max_len must be in [0, %zu], got %zd",
+                 ctx_t::max_table_len,
+                 max_len);
+    return nullptr;
+  }
+
+  view_t in[1];
+  constexpr size_t lens[]{ 16 };
+  if (!acquire_inputs(&key, in, lens, names, 1)) {
+    return nullptr;
+  }
+
+  auto* const obj =
+    reinterpret_cast<context_t<slen, rounds, tlen>*>(type->tp_alloc(type, 0));
+  if (obj == nullptr) {
+    return nullptr;
+  }
+
+  try {
+    obj->ctx = new ctx_t(in[0].ptr(), static_cast<size_t>(max_len));
+  } catch (const std::bad_alloc&) {
+    Py_DECREF(obj);
+    return PyErr_NoMemory();
+  } catch (const std::exception& e) {
+    Py_DECREF(obj);
+    PyErr_SetString(PyExc_RuntimeError, e.what());
+    return nullptr;
+  }
+
+  return reinterpret_cast<PyObject*>(obj);
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+void
+context_dealloc(PyObject* const self)
+{
+  auto* const obj = reinterpret_cast<context_t<slen, rounds, tlen>*>(self);
+  PyTypeObject* const type = Py_TYPE(self);
+
+  delete obj->ctx;
+  type->tp_free(self);
+  Py_DECREF(type);
+}
+
+// encrypt(nonce, data, text, *, out=None, tag=None) -> (cipher, tag)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_encrypt(PyObject* const self,
+                PyObject* const* const args,
+                const Py_ssize_t nargs,
+                PyObject* const kwnames)
+{
+  static const char* const names[]{ "nonce", "data", "text", "out", "tag" };
+
+  PyObject* objs[5];
+  const char* const prefix = context_name<slen>();
+  if (!parse_args(
+        prefix, "encrypt", args, nargs, kwnames, names, 3, 3, 5, objs, ".")) {
+    return nullptr;
+  }
+
+  auto* const ctx = context_of<slen, rounds, tlen>(self);
+  if (ctx == nullptr) {
+    return nullptr;
+  }
+
+  view_t in[3];
+  constexpr size_t lens[]{ 12, 0, 0 };
+  if (!acquire_inputs(objs, in, lens, names, 3)) {
+    return nullptr;
+  }
+
+  auto seal = [&](uint8_t* const enc, uint8_t* const tag) {
+    ctx->encrypt(in[0].ptr(),
+                 in[1].ptr(),
+                 in[1].len(),
+                 in[2].ptr(),
+                 enc,
+                 in[2].len(),
+                 tag);
+  };
+  return seal_message<tlen>(in, 3, objs[3], objs[4], seal);
+}
+
+// decrypt(nonce, tag, data, enc, *, out=None) -> (flag, text)
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_decrypt(PyObject* const self,
+                PyObject* const* const args,
+                const Py_ssize_t nargs,
+                PyObject* const kwnames)
+{
+  constexpr size_t tbytes = tlen >> 3;
+  static const char* const names[]{ "nonce", "tag", "data", "enc", "out" };
+
+  PyObject* objs[5];
+  const char* const prefix = context_name<slen>();
+  if (!parse_args(
+        prefix, "decrypt", args, nargs, kwnames, names, 4, 4, 5, objs, ".")) {
+    return nullptr;
+  }
+
+  auto* const ctx = context_of<slen, rounds, tlen>(self);
+  if (ctx == nullptr) {
+    return nullptr;
+  }
+
+  view_t in[4];
+  constexpr size_t lens[]{ 12, tbytes, 0, 0 };
+  if (!acquire_inputs(objs, in, lens, names, 4)) {
+    return nullptr;
+  }
+
+  auto open = [&](uint8_t* const txt) {
+    return ctx->decrypt(in[0].ptr(),
+                        in[1].ptr(),
+                        in[2].ptr(),
+                        in[2].len(),
+                        in[3].ptr(),
+                        txt,
+                        in[3].len());
+  };
+  return open_message(in, 4, objs[4], open);
+}
+
+// close(), zeroing & releasing context; closing again does nothing
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_close(PyObject* const self, PyObject*)
+{
+  auto* const obj = reinterpret_cast<context_t<slen, rounds, tlen>*>(self);
+
+  delete obj->ctx;
+  obj->ctx = nullptr;
+  Py_RETURN_NONE;
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_enter(PyObject* const self, PyObject*)
+{
+  if (context_of<slen, rounds, tlen>(self) == nullptr) {
+    return nullptr;
+  }
+
+  Py_INCREF(self);
+  return self;
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_exit(PyObject* const self, PyObject* const)
+{
+  return context_close<slen, rounds, tlen>(self, nullptr);
+}
+
+template<const size_t slen, const size_t rounds, const size_t tlen>
+PyObject*
+context_closed(PyObject* const self, void*)
+{
+  auto* const obj = reinterpret_cast<context_t<slen, rounds, tlen>*>(self);
+  return PyBool_FromLong(obj->ctx == nullptr);
+}
+
+PyDoc_STRVAR(
+  context_encrypt_doc,
+  "encrypt(nonce, data, text, *, out=None, tag=None)\n--\n\n"
+  "Encrypts M ( >=0 ) -bytes plain text, under context's key, while using\n"
+  "12 -bytes public message nonce & N ( >=0 ) -bytes associated data,\n"
+  "while producing M -bytes cipher text & authentication tag ( in order ),\n"
+  "written into `out` & `tag`, when given");
+
+PyDoc_STRVAR(
+  context_decrypt_doc,
+  "decrypt(nonce, tag, data, enc, *, out=None)\n--\n\n"
+  "Decrypts M ( >=0 ) -bytes cipher text, under context's key, while using\n"
+  "12 -bytes public message nonce, authentication tag & N ( >=0 ) -bytes\n"
+  "associated data, while producing boolean verification flag & M -bytes\n"
+  "plain text ( in order ), written into `out`, when given; plain text is\n"
+  "zeroed, if verification fails");
+
+PyDoc_STRVAR(context_close_doc,
+             "close()\n--\n\n"
+             "Zeroes expanded key & mask table, releasing them; context can't\n"
+             "be used afterwards. Called on leaving `with` block.");
+
+PyDoc_STRVAR(
+  dumbo_context_doc,
+  "DumboContext(key, max_len=0)\n--\n\n"
+  "Dumbo AEAD context, expanding 16 -bytes secret key once, so that its\n"
+  "`encrypt` & `decrypt` skip all key derivation permutation calls. When\n"
+  "`max_len` > 0 ( at most 16 MiB ), a mask table is also built for\n"
+  "messages of up to that many bytes, pushing blocks of long enough ones\n"
+  "through multi-state permutation lanes. Use it as context manager, which\n"
+  "zeroes & releases context on exit");
+
+PyDoc_STRVAR(
+  jumbo_context_doc,
+  "JumboContext(key, max_len=0)\n--\n\n"
+  "Jumbo AEAD context, expanding 16 -bytes secret key once, so that its\n"
+  "`encrypt` & `decrypt` skip all key derivation permutation calls. When\n"
+  "`max_len` > 0 ( at most 16 MiB ), a mask table is also built for\n"
+  "messages of up to that many bytes, pushing blocks of long enough ones\n"
+  "through multi-state permutation lanes. Use it as context manager, which\n"
+  "zeroes & releases context on exit");
+
+PyDoc_STRVAR(
+  delirium_context_doc,
+  "DeliriumContext(key, max_len=0)\n--\n\n"
+  "Delirium AEAD context, expanding 16 -bytes secret key once, so that its\n"
+  "`encrypt` & `decrypt` skip all key derivation permutation calls. When\n"
+  "`max_len` > 0 ( at most 16 MiB ), a mask table is also built for\n"
+  "messages of up to that many bytes, pushing blocks of long enough ones\n"
+  "through multi-state permutation lanes. Use it as context manager, which\n"
+  "zeroes & releases context on exit");
+
+// Creates context class of Elephant variant & adds it to module
+template<const size_t slen, const size_t rounds, const size_t tlen>
+bool
+add_context_type(PyObject* const mod, const char* const doc)
+{
+  static const std::string qualname =
+    std::string("_elephant.") + context_name<slen>();
+
+  static PyMethodDef cmethods[]{
+    { "encrypt",
+      method(context_encrypt<slen, rounds, tlen>),
+      FASTCALL,
+      context_encrypt_doc },
+    { "decrypt",
+      method(context_decrypt<slen, rounds, tlen>),
+      FASTCALL,
+      context_decrypt_doc },
+    { "close",
+      context_close<slen, rounds, tlen>,
+      METH_NOARGS,
+      context_close_doc },
+    { "__enter__", context_enter<slen, rounds, tlen>, METH_NOARGS, nullptr },
+    { "__exit__", context_exit<slen, rounds, tlen>, METH_VARARGS, nullptr },
+    { nullptr, nullptr, 0, nullptr }
+  };
+
+  static PyGetSetDef getset[]{
+    { "closed",
+      context_closed<slen, rounds, tlen>,
+      nullptr,
+      "whether context was closed",
+      nullptr },
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+  };
+
+  static PyType_Slot slots[]{
+    { Py_tp_new, reinterpret_cast<void*>(context_new<slen, rounds, tlen>) },
+    { Py_tp_dealloc,
+      reinterpret_cast<void*>(context_dealloc<slen, rounds, tlen>) },
+    { Py_tp_methods, cmethods },
+    { Py_tp_getset, getset },
+    { Py_tp_doc, const_cast<char*>(doc) },
+    { 0, nullptr }
+  };
+
+  static PyType_Spec spec{ qualname.c_str(),
+                           sizeof(context_t<slen, rounds, tlen>),
+                           0,
+                           Py_TPFLAGS_DEFAULT,
+                           slots };
+
+  PyObject* const type = PyType_FromSpec(&spec);
+  if (type == nullptr) {
+    return false;
+  }
+
+  const int ret =
+    PyModule_AddType(mod, reinterpret_cast<PyTypeObject*>(type));
+  Py_DECREF(type);
+  return ret == 0;
+}
+
+PyModuleDef module{ PyModuleDef_HEAD_INIT,
+                    "_elephant",
+                    "Native Elephant AEAD ( Dumbo, Jumbo & Delirium )",
+                    -1,
+                    methods,
+                    nullptr,
+                    nullptr,
+                    nullptr,
+                    nullptr };
+
+}
+
+PyMODINIT_FUNC
+PyInit__elephant()
+{
+  PyObject* const mod = PyModule_Create(&module);
+  if (mod == nullptr) {
+    return nullptr;
+  }
+
+  if (!add_context_type<dumbo::SLEN, dumbo::ROUNDS, dumbo::TLEN>(
+        mod, dumbo_context_doc) ||
+      !add_context_type<jumbo::SLEN, jumbo::ROUNDS, jumbo::TLEN>(
+        mod, jumbo_context_doc) ||
+      !add_context_type<delirium::SLEN, delirium::ROUNDS, delirium::TLEN>(
+        mod, delirium_context_doc)) {
+    Py_DECREF(mod);
+    return nullptr;
+  }
+
+  return mod;
+}
@@ -2,245 +2,74 @@
 
 """
   Before using `elephant` library module, make sure you've run
-  `make lib` and generated shared library object, which is loaded
-  here; then all function calls are forwarded to respective C++
-  implementation, executed on host CPU.
+  `make pyext` and built native extension module `_elephant`, which
+  is imported here; then all function calls are forwarded to respective
+  C++ implementation, executed on host CPU.
+
+  Inputs can be any object exporting contiguous buffer ( say bytes,
+  bytearray, memoryview or numpy array ), which is read without copying,
+  while outputs are returned as freshly allocated bytes, unless caller
+  passes writable buffers ( say bytearray or memoryview ) of right length
+  as `out` ( & `tag`, when encrypting ) keyword arguments, which are
+  written in place & returned back.
+
+  Many records can be {en, de}crypted in one call, using `*_batch`
+  functions, which take lists of records ( or 2-D numpy arrays, one
+  record per row ) & release GIL, while records are processed on a
+  native work-stealing thread pool; tags & verification flags come back
+  as numpy arrays.
+
+  Repeated {en, de}cryptions under one key should go through context
+  classes ( say `DumboContext` ), which expand secret key once, optionally
+  building mask table for messages up to `max_len` bytes; use them as
+  context managers, so that key material is zeroed on leaving `with` block.
 
   Author: Anjan Roy <hello@itzmeanjan.in>
-  
+
   Project: https://github.com/itzmeanjan/elephant
 """
 
-from typing import Tuple
-from ctypes import c_size_t, CDLL, c_bool
-import numpy as np
-from posixpath import exists, abspath
-
-SO_PATH: str = abspath("../libelephant.so")
-assert exists(SO_PATH), "Use `make lib` to generate shared library object !"
-
-SO_LIB: CDLL = CDLL(SO_PATH)
-
-u8 = np.uint8
-len_t = c_size_t
-uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags="CONTIGUOUS")
-bool_t = c_bool
-
-
-def dumbo_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
-    """
-    Encrypts M ( >=0 ) -bytes plain text, with Dumbo AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce &
-    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 8 -bytes authentication tag ( in order )
-    """
-    assert len(key) == 16, "Dumbo takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Dumbo takes 12 -bytes nonce !"
-
-    ad_len = len(data)
-    ct_len = len(text)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(8, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.dumbo_encrypt.argtypes = args
-
-    SO_LIB.dumbo_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
-
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
-
-    return enc_, tag_
-
-
-def dumbo_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
-    """
-    Decrypts M ( >=0 ) -bytes cipher text, with Dumbo AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce,
-    8 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
-    producing boolean flag denoting verification status ( which must hold truth
-    value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
-
-    If authentication check fails ( i.e. boolean verification flag is false ),
-    decrypted text bytes are zeroed.
-    """
-    assert len(key) == 16, "Dumbo takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Dumbo takes 12 -bytes nonce !"
-    assert len(tag) == 8, "Dumbo takes 8 -bytes authentication tag !"
-
-    ad_len = len(data)
-    ct_len = len(enc)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.dumbo_decrypt.argtypes = args
-    SO_LIB.dumbo_decrypt.restype = bool_t
-
-    f = SO_LIB.dumbo_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
-
-    dec_ = dec.tobytes()
-
-    return f, dec_
-
-
-def jumbo_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
-    """
-    Encrypts M ( >=0 ) -bytes plain text, with Jumbo AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce &
-    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 8 -bytes authentication tag ( in order )
-    """
-    assert len(key) == 16, "Jumbo takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Jumbo takes 12 -bytes nonce !"
-
-    ad_len = len(data)
-    ct_len = len(text)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(8, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.jumbo_encrypt.argtypes = args
-
-    SO_LIB.jumbo_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
-
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
-
-    return enc_, tag_
-
-
-def jumbo_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
-    """
-    Decrypts M ( >=0 ) -bytes cipher text, with Jumbo AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce,
-    8 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
-    producing boolean flag denoting verification status ( which must hold truth
-    value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
-
-    If authentication check fails ( i.e. boolean verification flag is false ),
-    decrypted text bytes are zeroed.
-    """
-    assert len(key) == 16, "Jumbo takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Jumbo takes 12 -bytes nonce !"
-    assert len(tag) == 8, "Jumbo takes 8 -bytes authentication tag !"
-
-    ad_len = len(data)
-    ct_len = len(enc)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.jumbo_decrypt.argtypes = args
-    SO_LIB.jumbo_decrypt.restype = bool_t
-
-    f = SO_LIB.jumbo_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
-
-    dec_ = dec.tobytes()
-
-    return f, dec_
-
-
-def delirium_encrypt(
-    key: bytes, nonce: bytes, data: bytes, text: bytes
-) -> Tuple[bytes, bytes]:
-    """
-    Encrypts M ( >=0 ) -bytes plain text, with Delirium AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce &
-    N ( >=0 ) -bytes associated data, while producing M -bytes cipher text
-    & 16 -bytes authentication tag ( in order )
-    """
-    assert len(key) == 16, "Delirium takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Delirium takes 12 -bytes nonce !"
-
-    ad_len = len(data)
-    ct_len = len(text)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    text_ = np.frombuffer(text, dtype=u8)
-    enc = np.empty(ct_len, dtype=u8)
-    tag = np.empty(16, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t, uint8_tp]
-    SO_LIB.delirium_encrypt.argtypes = args
-
-    SO_LIB.delirium_encrypt(key_, nonce_, data_, ad_len, text_, enc, ct_len, tag)
-
-    enc_ = enc.tobytes()
-    tag_ = tag.tobytes()
-
-    return enc_, tag_
-
-
-def delirium_decrypt(
-    key: bytes, nonce: bytes, tag: bytes, data: bytes, enc: bytes
-) -> Tuple[bool, bytes]:
-    """
-    Decrypts M ( >=0 ) -bytes cipher text, with Delirium AEAD,
-    while using 16 -bytes secret key, 12 -bytes public message nonce,
-    16 -bytes authentication tag & N ( >=0 ) -bytes associated data, while
-    producing boolean flag denoting verification status ( which must hold truth
-    value, check before consuming decrypted output bytes ) & M -bytes
-    plain text ( in order )
-
-    If authentication check fails ( i.e. boolean verification flag is false ),
-    decrypted text bytes are zeroed.
-    """
-    assert len(key) == 16, "Delirium takes 16 -bytes secret key !"
-    assert len(nonce) == 12, "Delirium takes 12 -bytes nonce !"
-    assert len(tag) == 16, "Delirium takes 16 -bytes authentication tag !"
-
-    ad_len = len(data)
-    ct_len = len(enc)
-
-    key_ = np.frombuffer(key, dtype=u8)
-    nonce_ = np.frombuffer(nonce, dtype=u8)
-    tag_ = np.frombuffer(tag, dtype=u8)
-    data_ = np.frombuffer(data, dtype=u8)
-    enc_ = np.frombuffer(enc, dtype=u8)
-    dec = np.empty(ct_len, dtype=u8)
-
-    args = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, len_t, uint8_tp, uint8_tp, len_t]
-    SO_LIB.delirium_decrypt.argtypes = args
-    SO_LIB.delirium_decrypt.restype = bool_t
-
-    f = SO_LIB.delirium_decrypt(key_, nonce_, tag_, data_, ad_len, enc_, dec, ct_len)
-
-    dec_ = dec.tobytes()
-
-    return f, dec_
+from _elephant import (
+    dumbo_encrypt,
+    dumbo_decrypt,
+    dumbo_encrypt_batch,
+    dumbo_decrypt_batch,
+    jumbo_encrypt,
+    jumbo_decrypt,
+    jumbo_encrypt_batch,
+    jumbo_decrypt_batch,
+    delirium_encrypt,
+    delirium_decrypt,
+    delirium_encrypt_batch,
+    delirium_decrypt_batch,
+    DumboContext,
+    JumboContext,
+    DeliriumContext,
+    spongent160_permute_bulk,
+    spongent176_permute_bulk,
+    keccak200_permute_bulk,
+)
+
+__all__ = [
+    "dumbo_encrypt",
+    "dumbo_decrypt",
+    "dumbo_encrypt_batch",
+    "dumbo_decrypt_batch",
+    "jumbo_encrypt",
+    "jumbo_decrypt",
+    "jumbo_encrypt_batch",
+    "jumbo_decrypt_batch",
+    "delirium_encrypt",
+    "delirium_decrypt",
+    "delirium_encrypt_batch",
+    "delirium_decrypt_batch",
+    "DumboContext",
+    "JumboContext",
+    "DeliriumContext",
+    "spongent160_permute_bulk",
+    "spongent176_permute_bulk",
+    "keccak200_permute_bulk",
+]
 
 
 if __name__ == "__main__":
@@ -2,9 +2,12 @@
 
 import elephant
 import numpy as np
+from ctypes import CDLL, c_bool, c_size_t, c_void_p
+from posixpath import abspath, exists
 from random import Random, randint
 
 u8 = np.uint8
+uint8_tp = np.ctypeslib.ndpointer(dtype=u8, ndim=1, flags="CONTIGUOUS")
 
 
 def test_dumbo_kat():
@@ -357,5 +360,447 @@ def test_delirium_authentication():
         assert dec[i] == 0, "Unverified plain text must not be released !"
 
 
+def load_lib() -> CDLL:
+    """
+    Loads shared library object, generated using `make lib`, so that its C-ABI
+    can be exercised through ctypes
+    """
+    path = abspath("../libelephant.so")
+    assert exists(path), "Use `make lib` to generate shared library object !"
+    return CDLL(path)
+
+
+def check_abi(variant: str, tbytes: int):
+    """
+    Test that {en, de}cryption routines exported from shared library object
+    produce same cipher text & tag as native extension module does, decrypt
+    them back & zero plain text, when verification fails
+    """
+    rng = Random()
+    lib = load_lib()
+
+    encrypt = getattr(lib, f"{variant}_encrypt")
+    encrypt.argtypes = [uint8_tp, uint8_tp, uint8_tp, c_size_t]
+    encrypt.argtypes += [uint8_tp, uint8_tp, c_size_t, uint8_tp]
+    encrypt.restype = None
+
+    decrypt = getattr(lib, f"{variant}_decrypt")
+    decrypt.argtypes = [uint8_tp, uint8_tp, uint8_tp, uint8_tp, c_size_t]
+    decrypt.argtypes += [uint8_tp, uint8_tp, c_size_t]
+    decrypt.restype = c_bool
+
+    def arr(b: bytes) -> np.ndarray:
+        return np.frombuffer(b, dtype=u8)
+
+    for dlen, ctlen in [(0, 0), (1, 0), (0, 1), (33, 100), (100, 3000)]:
+        key = rng.randbytes(16)
+        nonce = rng.randbytes(12)
+        data = rng.randbytes(dlen)
+        txt = rng.randbytes(ctlen)
+
+        enc = np.empty(ctlen, dtype=u8)
+        tag = np.empty(tbytes, dtype=u8)
+        encrypt(arr(key), arr(nonce), arr(data), dlen, arr(txt), enc, ctlen, tag)
+
+        enc_, tag_ = getattr(elephant, f"{variant}_encrypt")(key, nonce, data, txt)
+        assert enc.tobytes() == enc_ and tag.tobytes() == tag_
+
+        dec = np.empty(ctlen, dtype=u8)
+        flg = decrypt(arr(key), arr(nonce), tag, arr(data), dlen, enc, dec, ctlen)
+        assert flg and dec.tobytes() == txt
+
+        tag[0] ^= 1
+        flg = decrypt(arr(key), arr(nonce), tag, arr(data), dlen, enc, dec, ctlen)
+        assert not flg and not dec.any()
+
+
+def check_ctx_abi(variant: str, tbytes: int):
+    """
+    Test that context handles of shared library object, with & without mask
+    table, {en, de}crypt just like native extension module does, reject
+    tampering & that creating one with too large `max_len` gives NULL
+    """
+    rng = Random()
+    lib = load_lib()
+
+    ctx_new = getattr(lib, f"{variant}_ctx_new")
+    ctx_new.argtypes = [uint8_tp, c_size_t]
+    ctx_new.restype = c_void_p
+
+    encrypt = getattr(lib, f"{variant}_ctx_encrypt")
+    encrypt.argtypes = [c_void_p, uint8_tp, uint8_tp, c_size_t]
+    encrypt.argtypes += [uint8_tp, uint8_tp, c_size_t, uint8_tp]
+    encrypt.restype = None
+
+    decrypt = getattr(lib, f"{variant}_ctx_decrypt")
+    decrypt.argtypes = [c_void_p, uint8_tp, uint8_tp, uint8_tp, c_size_t]
+    decrypt.argtypes += [uint8_tp, uint8_tp, c_size_t]
+    decrypt.restype = c_bool
+
+    ctx_free = getattr(lib, f"{variant}_ctx_free")
+    ctx_free.argtypes = [c_void_p]
+    ctx_free.restype = None
+
+    def arr(b: bytes) -> np.ndarray:
+        return np.frombuffer(b, dtype=u8)
+
+    key = rng.randbytes(16)
+
+    for max_len in [0, 4096]:
+        ctx = ctx_new(arr(key), max_len)
+        assert ctx is not None
+
+        for dlen, ctlen in [(0, 0), (7, 1), (64, 1000), (100, 5000)]:
+            nonce = rng.randbytes(12)
+            data = rng.randbytes(dlen)
+            txt = rng.randbytes(ctlen)
+
+            enc = np.empty(ctlen, dtype=u8)
+            tag = np.empty(tbytes, dtype=u8)
+            encrypt(ctx, arr(nonce), arr(data), dlen, arr(txt), enc, ctlen, tag)
+
+            enc_, tag_ = getattr(elephant, f"{variant}_encrypt")(key, nonce, data, txt)
+            assert enc.tobytes() == enc_ and tag.tobytes() == tag_
+
+            dec = np.empty(ctlen, dtype=u8)
+            flg = decrypt(ctx, arr(nonce), tag, arr(data), dlen, enc, dec, ctlen)
+            assert flg and dec.tobytes() == txt
+
+            tag[-1] ^= 1
+            flg = decrypt(ctx, arr(nonce), tag, arr(data), dlen, enc, dec, ctlen)
+            assert not flg and not dec.any()
+
+        ctx_free(ctx)
+
+    assert ctx_new(arr(key), (1 << 24) + 1) is None
+    assert ctx_new(arr(key), 2**64 - 1) is None
+
+
+def test_dumbo_abi():
+    check_abi("dumbo", 8)
+    check_ctx_abi("dumbo", 8)
+
+
+def test_jumbo_abi():
+    check_abi("jumbo", 8)
+    check_ctx_abi("jumbo", 8)
+
+
+def test_delirium_abi():
+    check_abi("delirium", 16)
+    check_ctx_abi("delirium", 16)
+
+
+def test_buffers():
+    """
+    Test that {en, de}cryption reads inputs from any contiguous buffer, writes
+    into caller's `out` ( & `tag` ) buffers in place, returning them back, &
+    rejects wrongly sized or overlapping buffers with ValueError
+    """
+    rng = Random()
+
+    cases = [
+        (elephant.dumbo_encrypt, elephant.dumbo_decrypt, 8),
+        (elephant.jumbo_encrypt, elephant.jumbo_decrypt, 8),
+        (elephant.delirium_encrypt, elephant.delirium_decrypt, 16),
+    ]
+
+    for encrypt, decrypt, tbytes in cases:
+        key = rng.randbytes(16)
+        nonce = rng.randbytes(12)
+        data = rng.randbytes(40)
+        txt = rng.randbytes(32)
+
+        enc, tag = encrypt(key, nonce, data, txt)
+
+        for wrap in (bytearray, memoryview, lambda b: np.frombuffer(b, dtype=u8)):
+            args = [wrap(b) for b in (key, nonce, data, txt)]
+            assert encrypt(*args) == (enc, tag)
+
+            args = [wrap(b) for b in (key, nonce, tag, data, enc)]
+            assert decrypt(*args) == (True, txt)
+
+        # outputs written in place, including into a slice of larger buffer
+        out = bytearray(len(txt))
+        otag = bytearray(tbytes)
+        res = encrypt(key, nonce, data, txt, out=out, tag=otag)
+        assert res[0] is out and res[1] is otag
+        assert out == enc and otag == tag
+
+        buf = bytearray(8 + len(txt))
+        view = memoryview(buf)[8:]
+        flg, dec = decrypt(key, nonce, tag, data, enc=enc, out=view)
+        assert flg and dec is view and buf[8:] == txt
+
+        flg, dec = decrypt(key, nonce, tag, data[1:], enc, out=view)
+        assert not flg and dec is view and buf[8:] == bytes(len(txt))
+
+        txt_ = bytearray(txt)
+        enc_ = bytearray(enc)
+        data_ = bytearray(data)
+        tag_ = bytearray(len(txt) + tbytes)
+
+        for call in [
+            lambda: encrypt(key[1:], nonce, data, txt),
+            lambda: encrypt(key, nonce + b"\x00", data, txt),
+            lambda: decrypt(key, nonce, tag[1:], data, enc),
+            lambda: encrypt(key, nonce, data, txt, out=bytearray(len(txt) + 1)),
+            lambda: encrypt(key, nonce, data, txt, tag=bytearray(tbytes - 1)),
+            lambda: decrypt(key, nonce, tag, data, enc, out=bytearray(len(enc) - 1)),
+            lambda: encrypt(key, nonce, data, txt_, out=txt_),
+            lambda: encrypt(
+                key, nonce, data_, txt, out=memoryview(data_)[: len(txt)]
+            ),
+            lambda: encrypt(
+                key,
+                nonce,
+                data,
+                txt,
+                out=memoryview(tag_)[: len(txt)],
+                tag=memoryview(tag_)[len(txt) - 1 : -1],
+            ),
+            lambda: decrypt(key, nonce, tag, data, enc_, out=enc_),
+            lambda: decrypt(
+                key, nonce, tag, data_, enc, out=memoryview(data_)[4 : 4 + len(enc)]
+            ),
+        ]:
+            try:
+                call()
+                assert False, "wrongly sized or overlapping buffers must be rejected !"
+            except ValueError:
+                pass
+
+
+def test_context():
+    """
+    Test that context classes, with & without mask table, {en, de}crypt just
+    like single message functions do, reject tampering, can't be used once
+    closed & refuse negative or too large `max_len` with ValueError
+    """
+    rng = Random()
+
+    cases = [
+        (elephant.DumboContext, elephant.dumbo_encrypt, 8),
+        (elephant.JumboContext, elephant.jumbo_encrypt, 8),
+        (elephant.DeliriumContext, elephant.delirium_encrypt, 16),
+    ]
+
+    for cls, encrypt, tbytes in cases:
+        key = rng.randbytes(16)
+
+        for max_len in [0, 4096]:
+            with cls(key, max_len) as ctx:
+                for dlen, ctlen in [(0, 0), (7, 1), (64, 1000), (100, 5000)]:
+                    nonce = rng.randbytes(12)
+                    data = rng.randbytes(dlen)
+                    txt = rng.randbytes(ctlen)
+
+                    enc, tag = ctx.encrypt(nonce, data, txt)
+                    assert (enc, tag) == encrypt(key, nonce, data, txt)
+                    assert ctx.decrypt(nonce, tag, data, enc) == (True, txt)
+
+                    tag = flip_bit(tag)
+                    flg, dec = ctx.decrypt(nonce, tag, data, enc)
+                    assert not flg and dec == bytes(ctlen)
+
+            assert ctx.closed
+            try:
+                ctx.encrypt(rng.randbytes(12), b"", b"")
+                assert False, f"[{cls.__name__}] closed context must be rejected !"
+            except ValueError:
+                pass
+
+        for max_len in [-1, (1 << 24) + 1, 2**62]:
+            try:
+                cls(key, max_len)
+                assert False, f"[{cls.__name__}] must reject max_len = {max_len} !"
+            except ValueError:
+                pass
+
+
+def test_batch():
+    """
+    Test that batch {en, de}cryption, over lists of variable length records as
+    well as 2-D numpy arrays, under a mix of repeated & distinct keys, matches
+    single message {en, de}cryption record by record, flags ( & zeroes ) only
+    tampered record & handles empty batches
+    """
+    rng = Random()
+
+    def rows(recs: list) -> np.ndarray:
+        return np.frombuffer(b"".join(recs), dtype=u8).reshape(len(recs), -1)
+
+    for name, tbytes in [("dumbo", 8), ("jumbo", 8), ("delirium", 16)]:
+        encrypt = getattr(elephant, f"{name}_encrypt")
+        encrypt_batch = getattr(elephant, f"{name}_encrypt_batch")
+        decrypt_batch = getattr(elephant, f"{name}_decrypt_batch")
+
+        cnt = 20
+        shared = rng.randbytes(16)
+
+        keys = [shared if i % 3 == 0 else rng.randbytes(16) for i in range(cnt)]
+        nonces = [rng.randbytes(12) for _ in range(cnt)]
+        data = [rng.randbytes(i % 5) for i in range(cnt)]
+        txts = [rng.randbytes(i * 13) for i in range(cnt)]
+
+        encs, tags = encrypt_batch(keys, nonces, data, txts)
+        assert isinstance(encs, list) and tags.shape == (cnt, tbytes)
+
+        for i in range(cnt):
+            enc, tag = encrypt(keys[i], nonces[i], data[i], txts[i])
+            assert encs[i] == enc and tags[i].tobytes() == tag
+
+        flags, decs = decrypt_batch(keys, nonces, tags, data, encs)
+        assert flags.all() and decs == txts
+
+        # one tampered tag, among records sharing its key
+        tags[3, 0] ^= 1
+        flags, decs = decrypt_batch(keys, nonces, tags, data, encs)
+        assert list(flags) == [i != 3 for i in range(cnt)]
+        assert decs[3] == bytes(len(txts[3]))
+        assert decs[:3] + decs[4:] == txts[:3] + txts[4:]
+
+        # equal length records, as 2-D arrays, with shared key & no data
+        txts = [rng.randbytes(50) for _ in range(cnt)]
+        encs, tags = encrypt_batch(shared, rows(nonces), None, rows(txts))
+        assert encs.shape == (cnt, 50) and tags.shape == (cnt, tbytes)
+
+        for i in range(cnt):
+            enc, tag = encrypt(shared, nonces[i], b"", txts[i])
+            assert encs[i].tobytes() == enc and tags[i].tobytes() == tag
+
+        encs_, tags_ = encrypt_batch([shared] * cnt, nonces, [b""] * cnt, txts)
+        assert b"".join(encs_) == encs.tobytes() and np.array_equal(tags_, tags)
+
+        flags, decs = decrypt_batch(shared, rows(nonces), tags, None, encs)
+        assert flags.all() and decs.tobytes() == b"".join(txts)
+
+        # empty batches
+        encs, tags = encrypt_batch([], [], [], [])
+        assert encs == [] and tags.shape == (0, tbytes)
+
+        flags, decs = decrypt_batch([], [], [], [], [])
+        assert flags.shape == (0,) and decs == []
+
+        empty = np.empty((0, 50), dtype=u8)
+        encs, tags = encrypt_batch(shared, np.empty((0, 12), dtype=u8), None, empty)
+        assert encs.shape == (0, 50) and tags.shape == (0, tbytes)
+
+
+def spongent_permute(state: bytes, slen: int, first: int, rounds: int) -> bytes:
+    """
+    Reference ( bit by bit ) Spongent-π[slen] permutation, applying rounds
+    [first, first + rounds) on single (slen >> 3) -bytes state, as defined in
+    section 2.{3, 4}.1 of Elephant specification
+    """
+    sbox = [0xE, 0xD, 0xB, 0x0, 0x2, 0x1, 0x4, 0xF]
+    sbox += [0x7, 0xA, 0x8, 0x5, 0x9, 0xC, 0x3, 0x6]
+    sbytes = slen >> 3
+    st = bytearray(state)
+
+    lc = 0x75 if slen == 160 else 0x45
+    for _ in range(first):
+        lc = ((lc << 1) | (((lc >> 6) ^ (lc >> 5)) & 1)) & 0x7F
+
+    for _ in range(rounds):
+        st[0] ^= lc
+        st[sbytes - 1] ^= int(f"{lc:08b}"[::-1], base=2)
+        lc = ((lc << 1) | (((lc >> 6) ^ (lc >> 5)) & 1)) & 0x7F
+
+        st = bytearray((sbox[b >> 4] << 4) | sbox[b & 0xF] for b in st)
+
+        out = bytearray(sbytes)
+        for i in range(slen):
+            j = i if i == slen - 1 else (i * (slen >> 2)) % (slen - 1)
+            out[j >> 3] |= ((st[i >> 3] >> (i & 7)) & 1) << (j & 7)
+        st = out
+
+    return bytes(st)
+
+
+def keccak200_permute(state: bytes, first: int, rounds: int) -> bytes:
+    """
+    Reference Keccak-f[200] permutation, applying rounds [first, first + rounds)
+    on single 25 -bytes state, as defined in section 3.3 of FIPS 202
+    """
+    rot = [0, 1, 6, 4, 3, 4, 4, 6, 7, 4, 3, 2, 3, 1, 7, 1, 5, 7, 5, 0, 2, 2, 5, 0, 6]
+    rc = [0x01, 0x82, 0x8A, 0x00, 0x8B, 0x01, 0x81, 0x09, 0x8A]
+    rc += [0x88, 0x09, 0x0A, 0x8B, 0x8B, 0x89, 0x03, 0x02, 0x80]
+
+    def rotl(v: int, n: int) -> int:
+        return ((v << n) | (v >> (8 - n))) & 0xFF
+
+    a = list(state)
+    for r in range(first, first + rounds):
+        c = [a[x] ^ a[x + 5] ^ a[x + 10] ^ a[x + 15] ^ a[x + 20] for x in range(5)]
+        d = [c[(x + 4) % 5] ^ rotl(c[(x + 1) % 5], 1) for x in range(5)]
+        a = [a[i] ^ d[i % 5] for i in range(25)]
+        a = [rotl(a[i], rot[i]) for i in range(25)]
+        b = [a[5 * j + (3 * i + j) % 5] for i in range(5) for j in range(5)]
+        a = [
+            b[5 * i + j] ^ (~b[5 * i + (j + 1) % 5] & b[5 * i + (j + 2) % 5] & 0xFF)
+            for i in range(5)
+            for j in range(5)
+        ]
+        a[0] ^= rc[r]
+
+    return bytes(a)
+
+
+def test_permute_bulk():
+    """
+    Test that bulk permutation, over many states & threads, full or reduced
+    rounds, agrees with reference permutation, applied on each state alone,
+    & that invalid arguments are rejected with ValueError
+    """
+    rng = Random()
+
+    cases = [
+        (elephant.spongent160_permute_bulk, 160, 80),
+        (elephant.spongent176_permute_bulk, 176, 90),
+        (elephant.keccak200_permute_bulk, 200, 18),
+    ]
+
+    def reference(slen: int, state: bytes, first: int, rounds: int) -> bytes:
+        if slen == 200:
+            return keccak200_permute(state, first, rounds)
+        return spongent_permute(state, slen, first, rounds)
+
+    for func, slen, rmax in cases:
+        sbytes = slen >> 3
+
+        for cnt, first, rounds, nthreads in [
+            (1, 0, rmax, 1),
+            (33, 0, rmax, 2),
+            (70, 3, rmax - 5, 3),
+            (5, rmax, 0, 1),
+        ]:
+            states = rng.randbytes(cnt * sbytes)
+            out = func(states, first, rounds, nthreads)
+
+            for i in range(cnt):
+                st = states[i * sbytes : (i + 1) * sbytes]
+                assert out[i * sbytes : (i + 1) * sbytes] == reference(
+                    slen, st, first, rounds
+                ), f"[{func.__name__}] state {i} differs from reference !"
+
+        # in-place, into caller's buffer
+        buf = bytearray(rng.randbytes(4 * sbytes))
+        exp = func(bytes(buf))
+        assert func(buf, out=buf) is buf and bytes(buf) == exp
+
+        for args in [
+            (bytes(sbytes), 1, rmax),
+            (bytes(sbytes), rmax + 1, 0),
+            (bytes(sbytes), 0, rmax, 0),
+            (bytes(sbytes + 1),),
+        ]:
+            try:
+                func(*args)
+                assert False, f"[{func.__name__}] must reject {args[1:]} !"
+            except ValueError:
+                pass
+
+
 if __name__ == "__main__":
     print("Execute test cases using `pytest`")